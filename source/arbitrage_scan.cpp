@@ -0,0 +1,375 @@
+/// @file arbitrage_scan.cpp
+/// @brief Implementation of @ref arbitrage_scan_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "arbitrage_scan.h"
+#include "error.h"
+#include "galactic_market.h"
+#include "item_market.h"
+#include "market_history.h"
+#include "regional_market.h"
+#include "station_attribute.h"
+#include "station_attributes.h"
+#include "station_market.h"
+#include "task_scheduler.h"
+#include "universe_topology.h"
+
+/// @brief Best price of one item at one station.
+struct quote_t
+{
+    float price;
+    unsigned station_ix;
+};
+
+/// @brief Every station which trades one item.
+struct item_quotes_t
+{
+    uint64_t item_id;
+    /// @brief Lowest sell order of each station.
+    std::vector<quote_t> sells;
+    /// @brief Highest buy order of each station.
+    std::vector<quote_t> buys;
+};
+
+/// @brief A pair of indices into @ref item_quotes_t::sells and
+/// @ref item_quotes_t::buys waiting in the search heap.
+struct candidate_t
+{
+    float margin;
+    unsigned sell_ix;
+    unsigned buy_ix;
+};
+
+/// @brief Strict order of opportunities, best first, which doesn't depend on
+/// the order stations were visited in.
+static bool better(const arbitrage_scan_t::opportunity_t& lhs, const arbitrage_scan_t::opportunity_t& rhs)
+{
+    if (lhs.score != rhs.score)
+        return lhs.score > rhs.score;
+    if (lhs.item_id != rhs.item_id)
+        return lhs.item_id < rhs.item_id;
+    if (lhs.source_station_id != rhs.source_station_id)
+        return lhs.source_station_id < rhs.source_station_id;
+    return lhs.destination_station_id < rhs.destination_station_id;
+}
+
+void arbitrage_scan_t::initialize_from_market
+(
+    const galactic_market_t& galactic_market,
+    unsigned num_opportunities,
+    float sell_fraction,
+    float hauling_cost,
+    const universe_topology_t* topology,
+    const station_attributes_t* station_attributes,
+    const market_history_t* market_history,
+    unsigned history_days,
+    uint64_t min_daily_volume
+) {
+    
+    this->opportunities_.clear();
+    if (num_opportunities == 0)
+        return;
+    
+    // Solar system of each station, if known
+    std::unordered_map<uint64_t, uint64_t> station_systems;
+    if (station_attributes != nullptr)
+    {
+        for (const station_attribute_t& cur_station : station_attributes->stations())
+            station_systems.emplace(cur_station.station_id(), cur_station.system_id());
+    }
+    
+    // One pass over every station gathers the best prices of each item
+    std::vector<uint64_t> station_ids;
+    std::vector<uint64_t> region_ids;
+    std::vector<uint64_t> system_ids;
+    std::unordered_map<uint64_t, unsigned> item_ixs;
+    std::vector<item_quotes_t> items;
+    for (const std::pair<const uint64_t, regional_market_t>& cur_region : galactic_market.regions())
+    {
+        for (const std::pair<const uint64_t, station_market_t>& cur_station : cur_region.second.stations())
+        {
+            
+            unsigned station_ix = station_ids.size();
+            station_ids.push_back(cur_station.first);
+            region_ids.push_back(cur_region.first);
+            std::unordered_map<uint64_t, uint64_t>::const_iterator system = station_systems.find(cur_station.first);
+            system_ids.push_back(system == station_systems.end() ? 0 : system->second);
+            
+            for (const std::pair<const uint64_t, item_market_t>& cur_item : cur_station.second.items())
+            {
+                
+                const item_market_t& item_market = cur_item.second;
+                if (item_market.sell_orders().empty() && item_market.buy_orders().empty())
+                    continue;
+                
+                std::pair<std::unordered_map<uint64_t, unsigned>::iterator, bool> found = item_ixs.try_emplace(cur_item.first, items.size());
+                if (found.second)
+                    items.push_back({cur_item.first, {}, {}});
+                item_quotes_t& item_quotes = items[found.first->second];
+                if (!item_market.sell_orders().empty())
+                    item_quotes.sells.push_back({item_market.min_sell_order(), station_ix});
+                if (!item_market.buy_orders().empty())
+                    item_quotes.buys.push_back({item_market.max_buy_order(), station_ix});
+                    
+            }
+            
+        }
+    }
+    
+    // Each item keeps at most num_opportunities pairs, which are merged below
+    unsigned num_items = items.size();
+    std::vector< std::vector<opportunity_t> > item_opportunities(num_items);
+    task_scheduler_t::instance().parallel_for
+    (
+        num_items,
+        16,
+        [&](unsigned item_ix)
+        {
+            
+            item_quotes_t& item_quotes = items[item_ix];
+            std::vector<quote_t>& sells = item_quotes.sells;
+            std::vector<quote_t>& buys = item_quotes.buys;
+            if (sells.empty() || buys.empty())
+                return;
+            
+            // Cheapest sell orders and highest buy orders first, breaking ties by
+            // station so that the results don't depend on hash order
+            std::sort
+            (
+                sells.begin(),
+                sells.end(),
+                [&station_ids](const quote_t& lhs, const quote_t& rhs)
+                {
+                    return lhs.price != rhs.price ? lhs.price < rhs.price : station_ids[lhs.station_ix] < station_ids[rhs.station_ix];
+                }
+            );
+            std::sort
+            (
+                buys.begin(),
+                buys.end(),
+                [&station_ids](const quote_t& lhs, const quote_t& rhs)
+                {
+                    return lhs.price != rhs.price ? lhs.price > rhs.price : station_ids[lhs.station_ix] < station_ids[rhs.station_ix];
+                }
+            );
+            
+            // Volume only depends on the region of the destination
+            std::vector<float> daily_volumes(buys.size(), 1.0f);
+            float max_daily_volume = 1.0f;
+            if (market_history != nullptr)
+            {
+                std::unordered_map<uint64_t, float> region_volumes;
+                max_daily_volume = 0.0f;
+                for (unsigned buy_ix = 0, num_buys = buys.size(); buy_ix < num_buys; buy_ix++)
+                {
+                    uint64_t region_id = region_ids[buys[buy_ix].station_ix];
+                    std::pair<std::unordered_map<uint64_t, float>::iterator, bool> found = region_volumes.try_emplace(region_id, 0.0f);
+                    if (found.second)
+                    {
+                        // Days without trades are missing from the history,
+                        // so spread the volume over the whole window
+                        market_history_t::summary_t summary;
+                        bool has_volume
+                          = market_history->summarize_recent(region_id, item_quotes.item_id, history_days, summary)
+                         && summary.volume >= min_daily_volume * uint64_t(history_days);
+                        if (has_volume)
+                            found.first->second = float(summary.volume) / float(history_days);
+                    }
+                    daily_volumes[buy_ix] = found.first->second;
+                    max_daily_volume = std::max(max_daily_volume, found.first->second);
+                }
+            }
+            
+            auto margin = [&](unsigned sell_ix, unsigned buy_ix) -> float
+            {
+                return buys[buy_ix].price * sell_fraction - sells[sell_ix].price * (1.0f + hauling_cost);
+            };
+            
+            // Visit pairs from the best margin down.  Each pair is pushed once:
+            // (sell_ix, buy_ix + 1) always and (sell_ix + 1, buy_ix) only from the
+            // first buy order.
+            auto heap_order = [](const candidate_t& lhs, const candidate_t& rhs)
+            {
+                return lhs.margin < rhs.margin;
+            };
+            std::vector<candidate_t> candidates(1, candidate_t{margin(0, 0), 0, 0});
+            std::vector<opportunity_t>& best = item_opportunities[item_ix];
+            while (!candidates.empty())
+            {
+                
+                std::pop_heap(candidates.begin(), candidates.end(), heap_order);
+                candidate_t cur_candidate = candidates.back();
+                candidates.pop_back();
+                
+                // Jumps and volume can only shrink the score below the margin
+                // times the largest volume
+                if (!(cur_candidate.margin > 0.0f))
+                    break;
+                if (best.size() == num_opportunities && !(cur_candidate.margin * max_daily_volume > best.front().score))
+                    break;
+                
+                if (cur_candidate.buy_ix + 1 < buys.size())
+                {
+                    candidates.push_back({margin(cur_candidate.sell_ix, cur_candidate.buy_ix + 1), cur_candidate.sell_ix, cur_candidate.buy_ix + 1});
+                    std::push_heap(candidates.begin(), candidates.end(), heap_order);
+                }
+                if (cur_candidate.buy_ix == 0 && cur_candidate.sell_ix + 1 < sells.size())
+                {
+                    candidates.push_back({margin(cur_candidate.sell_ix + 1, 0), cur_candidate.sell_ix + 1, 0});
+                    std::push_heap(candidates.begin(), candidates.end(), heap_order);
+                }
+                
+                const quote_t& sell = sells[cur_candidate.sell_ix];
+                const quote_t& buy = buys[cur_candidate.buy_ix];
+                opportunity_t new_opportunity;
+                new_opportunity.item_id = item_quotes.item_id;
+                new_opportunity.source_station_id = station_ids[sell.station_ix];
+                new_opportunity.destination_station_id = station_ids[buy.station_ix];
+                new_opportunity.buy_price = sell.price;
+                new_opportunity.sell_price = buy.price;
+                new_opportunity.margin = cur_candidate.margin;
+                new_opportunity.jumps = universe_topology_t::unreachable;
+                new_opportunity.daily_volume = market_history != nullptr ? daily_volumes[cur_candidate.buy_ix] : 0.0f;
+                new_opportunity.score = cur_candidate.margin * daily_volumes[cur_candidate.buy_ix];
+                if (topology != nullptr)
+                {
+                    uint64_t source_system_id = system_ids[sell.station_ix];
+                    uint64_t destination_system_id = system_ids[buy.station_ix];
+                    if (source_system_id == 0 || destination_system_id == 0)
+                        continue;
+                    new_opportunity.jumps = topology->distance(source_system_id, destination_system_id);
+                    if (new_opportunity.jumps == universe_topology_t::unreachable)
+                        continue;
+                    new_opportunity.score /= float(1 + unsigned(new_opportunity.jumps));
+                }
+                if (!(new_opportunity.score > 0.0f))
+                    continue;
+                
+                // Keep the best num_opportunities with the worst at the front
+                if (best.size() == num_opportunities)
+                {
+                    if (!better(new_opportunity, best.front()))
+                        continue;
+                    std::pop_heap(best.begin(), best.end(), better);
+                    best.back() = new_opportunity;
+                } else {
+                    best.push_back(new_opportunity);
+                }
+                std::push_heap(best.begin(), best.end(), better);
+                
+            }
+            
+        }
+    );
+    
+    // Merge the items and keep the overall best
+    for (const std::vector<opportunity_t>& cur_opportunities : item_opportunities)
+        this->opportunities_.insert(this->opportunities_.end(), cur_opportunities.begin(), cur_opportunities.end());
+    if (this->opportunities_.size() > num_opportunities)
+    {
+        std::partial_sort(this->opportunities_.begin(), this->opportunities_.begin() + num_opportunities, this->opportunities_.end(), better);
+        this->opportunities_.resize(num_opportunities);
+    } else {
+        std::sort(this->opportunities_.begin(), this->opportunities_.end(), better);
+    }
+    
+}
+
+void arbitrage_scan_t::write_to_json_file
+(
+    std::ostream& file,
+    const std::unordered_map<uint64_t, std::string_view>& item_names,
+    unsigned indent_start,
+    unsigned spaces_per_tab
+) const {
+    std::string buffer;
+    this->write_to_json_buffer(buffer, item_names, indent_start, spaces_per_tab);
+    file << buffer;
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when encoding arbitrage_scan_t object.\n");
+}
+
+void arbitrage_scan_t::write_to_json_buffer
+(
+    std::string& buffer,
+    const std::unordered_map<uint64_t, std::string_view>& item_names,
+    unsigned indent_start,
+    unsigned spaces_per_tab
+) const {
+    
+    std::string indent_1(indent_start + 1 * spaces_per_tab, ' ');
+    std::string_view indent_0(indent_1.data(), indent_start);
+    
+    // Prettify empty arrays.
+    if (this->opportunities_.empty())
+    {
+        buffer += "[]";
+        return;
+    }
+    
+    // It is recommended not to start a new line before the opening brace, to
+    // enable chaining.
+    buffer += "[\n";
+    
+    // One line per opportunity
+    for (unsigned ix = 0, last_ix = this->opportunities_.size() - 1; ix <= last_ix; ix++)
+    {
+        
+        const opportunity_t& cur_opportunity = this->opportunities_[ix];
+        buffer += indent_1;
+        buffer += "{\"item_id\": ";
+        buffer += std::to_string(cur_opportunity.item_id);
+        std::unordered_map<uint64_t, std::string_view>::const_iterator name_match = item_names.find(cur_opportunity.item_id);
+        if (name_match != item_names.end())
+        {
+            buffer += ", \"item_name\": \"";
+            buffer += name_match->second;
+            buffer += '\"';
+        }
+        buffer += ", \"source_station_id\": ";
+        buffer += std::to_string(cur_opportunity.source_station_id);
+        buffer += ", \"destination_station_id\": ";
+        buffer += std::to_string(cur_opportunity.destination_station_id);
+        buffer += ", \"buy_price\": ";
+        buffer += std::to_string(cur_opportunity.buy_price);
+        buffer += ", \"sell_price\": ";
+        buffer += std::to_string(cur_opportunity.sell_price);
+        buffer += ", \"margin\": ";
+        buffer += std::to_string(cur_opportunity.margin);
+        if (cur_opportunity.jumps != universe_topology_t::unreachable)
+        {
+            buffer += ", \"jumps\": ";
+            buffer += std::to_string(unsigned(cur_opportunity.jumps));
+        }
+        buffer += ", \"daily_volume\": ";
+        buffer += std::to_string(cur_opportunity.daily_volume);
+        buffer += ", \"score\": ";
+        buffer += std::to_string(cur_opportunity.score);
+        buffer += '}';
+        
+        if (ix == last_ix)
+            buffer += '\n';
+        else
+            buffer += ",\n";
+            
+    }
+    
+    // It is recommended to not put a newline on the last brace to allow
+    // comma chaining when this object is an element of an array.
+    buffer += indent_0;
+    buffer += ']';
+    
+}
+
@@ -0,0 +1,156 @@
+/// @file arbitrage_scan.h
+/// @brief Declaration of @ref arbitrage_scan_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_ARBITRAGE_SCAN
+#define HEADER_GUARD_ARBITRAGE_SCAN
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "error.h"
+
+class galactic_market_t;
+class market_history_t;
+class station_attributes_t;
+class universe_topology_t;
+
+/// @brief Items which can be bought from the lowest sell order at one
+/// station and sold straight into the highest buy order at another for more
+/// than they cost, after sales tax and hauling.
+///
+/// One pass over the market gathers, for every item, the lowest sell order
+/// and highest buy order of each station that trades it.  Each item is then
+/// searched on its own core: with sell orders sorted cheapest first and buy
+/// orders highest first, the margin of a pair can only fall as either index
+/// rises, so a heap visits pairs from the best margin down and stops as soon
+/// as no remaining pair can beat the best ones found.  Most items stop after
+/// a handful of pairs instead of trying every pair of stations.
+///
+/// Pairs are ranked by @ref opportunity_t::score, which is the margin per
+/// unit, times the average daily volume of the destination region when
+/// history is given, divided by one plus the jumps between the stations
+/// when a topology is given.
+class arbitrage_scan_t
+{
+        
+    public:
+        
+        /// @brief One item bought at one station and sold at another.
+        struct opportunity_t
+        {
+            uint64_t item_id;
+            /// @brief Station whose lowest sell order is bought from.
+            uint64_t source_station_id;
+            /// @brief Station whose highest buy order is sold to.
+            uint64_t destination_station_id;
+            /// @brief Lowest sell order at the source.
+            float buy_price;
+            /// @brief Highest buy order at the destination.
+            float sell_price;
+            /// @brief ISK made per unit after sales tax and hauling.
+            float margin;
+            /// @brief Jumps between the stations, or
+            /// @ref universe_topology_t::unreachable without a topology.
+            uint8_t jumps;
+            /// @brief Average units traded per day in the destination region,
+            /// or 0 without history.
+            float daily_volume;
+            float score;
+        };
+        
+        /// @brief Default constructor
+        inline arbitrage_scan_t() = default;
+        
+        // Add member read and write functions
+        
+        /// @brief Best first.  Only valid after @ref initialize_from_market.
+        inline const std::vector<opportunity_t>& opportunities() const
+        {
+            return this->opportunities_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Find the best num_opportunities pairs of stations across
+        /// every item of galactic_market, clearing previous content.
+        ///
+        /// @exception error_message_t
+        void initialize_from_market
+        (
+            const galactic_market_t& galactic_market,
+            unsigned num_opportunities,
+            /// [in] Fraction of the sale price kept after sales tax.  No
+            /// broker fee is paid since both orders already exist.
+            float sell_fraction = 1.0f,
+            /// [in] Cost of hauling goods between two stations as a fraction
+            /// of their value, as in @ref best_price_index_t::hauling_cost.
+            float hauling_cost = 0.0f,
+            /// [in] If not null, pairs are weighted by the jumps between their
+            /// stations, and pairs without a route are left out.
+            const universe_topology_t* topology = nullptr,
+            /// [in] The solar system of each station.  Required with topology.
+            const station_attributes_t* station_attributes = nullptr,
+            /// [in] If not null, pairs are weighted by the daily volume of the
+            /// destination region over its last history_days days, and
+            /// destinations trading fewer than min_daily_volume units a day
+            /// are left out.
+            const market_history_t* market_history = nullptr,
+            unsigned history_days = 7,
+            uint64_t min_daily_volume = 0
+        );
+        
+        // Add encoders/decoders here
+        
+        /// @brief Serialize the content of this file into a file that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_file
+        (
+            /// [out] Stream to append serialized object content to.
+            std::ostream& file,
+            /// [in] Allows human readable names to be displayed with each
+            /// item.
+            const std::unordered_map<uint64_t, std::string_view>& item_names,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Serialize the content of this file into a string that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_buffer
+        (
+            /// [out] This string is overwritten with serialzed JSON content.
+            std::string& buffer,
+            /// [in] Allows human readable names to be displayed with each
+            /// item.
+            const std::unordered_map<uint64_t, std::string_view>& item_names,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+    protected:
+        
+        /// @brief See @ref opportunities.
+        std::vector<opportunity_t> opportunities_;
+        
+};
+
+#endif // Header Guard
+
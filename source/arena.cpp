@@ -0,0 +1,47 @@
+/// @file arena.cpp
+/// @brief Implementation of @ref arena_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arena.h"
+
+constexpr size_t arena_t::default_chunk_size;
+
+arena_t::arena_t(size_t initial_capacity)
+  : cursor_(nullptr),
+    end_(nullptr),
+    bytes_allocated_(0),
+    bytes_reserved_(0)
+{
+    if (initial_capacity != 0)
+    {
+        this->chunks_.emplace_back(new char[initial_capacity]);
+        this->cursor_ = this->chunks_.back().get();
+        this->end_ = this->cursor_ + initial_capacity;
+        this->bytes_reserved_ = initial_capacity;
+    }
+}
+
+void* arena_t::allocate_from_new_chunk(size_t num_bytes, size_t alignment)
+{
+    
+    // Grow geometrically so that an underestimated arena doesn't degrade into
+    // one chunk per allocation.  The remainder of the old chunk is abandoned.
+    size_t chunk_size = std::max(std::max(num_bytes + alignment, arena_t::default_chunk_size), this->bytes_reserved_ / 2);
+    this->chunks_.emplace_back(new char[chunk_size]);
+    this->cursor_ = this->chunks_.back().get();
+    this->end_ = this->cursor_ + chunk_size;
+    this->bytes_reserved_ += chunk_size;
+    
+    return this->allocate(num_bytes, alignment);
+    
+}
+
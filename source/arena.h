@@ -0,0 +1,175 @@
+/// @file arena.h
+/// @brief Declaration of @ref arena_t and @ref arena_allocator_t classes
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_ARENA
+#define HEADER_GUARD_ARENA
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/// @brief Monotonic bump allocator.  Memory is handed out from large chunks
+/// and is only released, all at once, when the arena is destroyed.
+///
+/// This is used to build market containers with a handful of bulk
+/// allocations instead of one per hash node and price vector.  It is not
+/// thread safe, so each arena should only be filled by one thread at a time.
+class arena_t
+{
+        
+    public:
+        
+        /// @brief Initialization constructor.
+        arena_t
+        (
+            /// [in] If not zero, the first chunk is allocated immediately with
+            /// exactly this many bytes.
+            size_t initial_capacity = 0
+        );
+        
+        /// @brief Smallest chunk allocated when the arena runs out.
+        static constexpr size_t default_chunk_size = 64 * 1024;
+        
+        arena_t(const arena_t&) = delete;
+        arena_t& operator=(const arena_t&) = delete;
+        
+        // Add member read and write functions
+        
+        /// @brief Sum of the sizes of all allocations so far, including
+        /// alignment padding.
+        inline size_t bytes_allocated() const
+        {
+            return this->bytes_allocated_;
+        }
+        
+        /// @brief Sum of the sizes of all chunks.
+        inline size_t bytes_reserved() const
+        {
+            return this->bytes_reserved_;
+        }
+        
+        inline unsigned num_chunks() const
+        {
+            return this->chunks_.size();
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Return suitably aligned uninitialized memory which stays
+        /// valid until this arena is destroyed.
+        inline void* allocate(size_t num_bytes, size_t alignment)
+        {
+            uintptr_t cursor = reinterpret_cast<uintptr_t>(this->cursor_);
+            uintptr_t aligned = (cursor + alignment - 1) & ~uintptr_t(alignment - 1);
+            if (this->cursor_ == nullptr || aligned + num_bytes > reinterpret_cast<uintptr_t>(this->end_))
+                return this->allocate_from_new_chunk(num_bytes, alignment);
+            this->bytes_allocated_ += aligned + num_bytes - cursor;
+            this->cursor_ = reinterpret_cast<char*>(aligned + num_bytes);
+            return reinterpret_cast<void*>(aligned);
+        }
+        
+    protected:
+        
+        /// @brief Slow path of @ref allocate.
+        void* allocate_from_new_chunk(size_t num_bytes, size_t alignment);
+        
+        /// @brief Every chunk ever allocated.  The last one is current.
+        std::vector< std::unique_ptr<char[]> > chunks_;
+        
+        /// @brief Next free byte in the current chunk.
+        char* cursor_;
+        
+        /// @brief One past the last byte of the current chunk.
+        char* end_;
+        
+        /// @brief See @ref bytes_allocated.
+        size_t bytes_allocated_;
+        
+        /// @brief See @ref bytes_reserved.
+        size_t bytes_reserved_;
+        
+};
+
+/// @brief Standard library allocator which takes memory from an
+/// @ref arena_t.  Deallocation is a no-op.
+///
+/// A null arena falls back to the global heap, so containers using this
+/// allocator still work when default constructed.  Copies of a container go
+/// to the heap, so that they never outlive the arena of the original, while
+/// moves keep using the arena of the source.
+template <typename T>
+class arena_allocator_t
+{
+        
+    public:
+        
+        typedef T value_type;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+        typedef std::false_type propagate_on_container_copy_assignment;
+        typedef std::false_type is_always_equal;
+        
+        inline arena_allocator_t(arena_t* arena = nullptr) noexcept
+          : arena_(arena)
+        {
+            // All work done in initializer list
+        }
+        
+        template <typename U>
+        inline arena_allocator_t(const arena_allocator_t<U>& other) noexcept
+          : arena_(other.arena())
+        {
+            // All work done in initializer list
+        }
+        
+        inline arena_t* arena() const
+        {
+            return this->arena_;
+        }
+        
+        inline T* allocate(size_t num_elements)
+        {
+            if (this->arena_ != nullptr)
+                return static_cast<T*>(this->arena_->allocate(num_elements * sizeof(T), alignof(T)));
+            return static_cast<T*>(::operator new(num_elements * sizeof(T)));
+        }
+        
+        inline void deallocate(T* pointer, size_t)
+        {
+            if (this->arena_ == nullptr)
+                ::operator delete(pointer);
+        }
+        
+        inline arena_allocator_t select_on_container_copy_construction() const
+        {
+            return arena_allocator_t();
+        }
+        
+    protected:
+        
+        /// @brief Source of memory, or null for the global heap.  Not owned.
+        arena_t* arena_;
+        
+};
+
+template <typename T, typename U>
+inline bool operator==(const arena_allocator_t<T>& lhs, const arena_allocator_t<U>& rhs)
+{
+    return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const arena_allocator_t<T>& lhs, const arena_allocator_t<U>& rhs)
+{
+    return lhs.arena() != rhs.arena();
+}
+
+#endif // Header Guard
+
@@ -19,6 +19,11 @@ void args::blueprint_converter_t::clear()
     this->valid_ = false;
     this->ccp_yaml_in_.clear();
     this->custom_json_out_.clear();
+    this->ccp_jumps_in_.clear();
+    this->stargates_out_.clear();
+    this->ccp_materials_in_.clear();
+    this->ccp_types_in_.clear();
+    this->reprocessing_out_.clear();
 }
 
 void args::blueprint_converter_t::parse(unsigned argc, char const* const* argv)
@@ -32,31 +37,119 @@ void args::blueprint_converter_t::parse(unsigned argc, char const* const* argv)
     arg_slices.initialize_from_command_line(argc, argv);
     args::arg_map_t::const_iterator not_found = arg_slices.storage().end();
     
+    // Parse --ccp-jumps-in
+    // Note this argument is optional
+    args::arg_map_t::const_iterator ccp_jumps_in_iter = arg_slices.storage().find("--ccp-jumps-in");
+    if (ccp_jumps_in_iter != not_found)
+    {
+        if (ccp_jumps_in_iter->second.size() != 1)
+        {
+            std::string message("Error.  --ccp-jumps-in takes exactly one argument.  ");
+            message += std::to_string(ccp_jumps_in_iter->second.size());
+            message += " passed.";
+            throw error_message_t(error_code_t::ARG_WRONG_NUMBER_OF_PARAMETERS_CCP_JUMPS_IN, message);
+        }
+        this->ccp_jumps_in_ = ccp_jumps_in_iter->second.front();
+    }
+    
+    // Parse --stargates-out
+    // Note this argument is required with --ccp-jumps-in
+    if (!this->ccp_jumps_in_.empty())
+    {
+        args::arg_map_t::const_iterator stargates_out_iter = arg_slices.storage().find("--stargates-out");
+        if (stargates_out_iter == not_found)
+            throw error_message_t(error_code_t::ARG_MISSING_STARGATES_OUT, "Error.  --stargates-out <file.json> is required with --ccp-jumps-in");
+        if (stargates_out_iter->second.size() != 1)
+        {
+            std::string message("Error.  --stargates-out takes exactly one argument.  ");
+            message += std::to_string(stargates_out_iter->second.size());
+            message += " passed.";
+            throw error_message_t(error_code_t::ARG_WRONG_NUMBER_OF_PARAMETERS_STARGATES_OUT, message);
+        }
+        this->stargates_out_ = stargates_out_iter->second.front();
+    }
+    
+    // Parse --ccp-materials-in
+    // Note this argument is optional
+    args::arg_map_t::const_iterator ccp_materials_in_iter = arg_slices.storage().find("--ccp-materials-in");
+    if (ccp_materials_in_iter != not_found)
+    {
+        if (ccp_materials_in_iter->second.size() != 1)
+        {
+            std::string message("Error.  --ccp-materials-in takes exactly one argument.  ");
+            message += std::to_string(ccp_materials_in_iter->second.size());
+            message += " passed.";
+            throw error_message_t(error_code_t::ARG_WRONG_NUMBER_OF_PARAMETERS_CCP_MATERIALS_IN, message);
+        }
+        this->ccp_materials_in_ = ccp_materials_in_iter->second.front();
+    }
+    
+    // Parse --ccp-types-in and --reprocessing-out
+    // Note --ccp-types-in is optional and --reprocessing-out is required with
+    // --ccp-materials-in
+    if (!this->ccp_materials_in_.empty())
+    {
+        
+        args::arg_map_t::const_iterator ccp_types_in_iter = arg_slices.storage().find("--ccp-types-in");
+        if (ccp_types_in_iter != not_found)
+        {
+            if (ccp_types_in_iter->second.size() != 1)
+            {
+                std::string message("Error.  --ccp-types-in takes exactly one argument.  ");
+                message += std::to_string(ccp_types_in_iter->second.size());
+                message += " passed.";
+                throw error_message_t(error_code_t::ARG_WRONG_NUMBER_OF_PARAMETERS_CCP_TYPES_IN, message);
+            }
+            this->ccp_types_in_ = ccp_types_in_iter->second.front();
+        }
+        
+        args::arg_map_t::const_iterator reprocessing_out_iter = arg_slices.storage().find("--reprocessing-out");
+        if (reprocessing_out_iter == not_found)
+            throw error_message_t(error_code_t::ARG_MISSING_REPROCESSING_OUT, "Error.  --reprocessing-out <file.json> is required with --ccp-materials-in");
+        if (reprocessing_out_iter->second.size() != 1)
+        {
+            std::string message("Error.  --reprocessing-out takes exactly one argument.  ");
+            message += std::to_string(reprocessing_out_iter->second.size());
+            message += " passed.";
+            throw error_message_t(error_code_t::ARG_WRONG_NUMBER_OF_PARAMETERS_REPROCESSING_OUT, message);
+        }
+        this->reprocessing_out_ = reprocessing_out_iter->second.front();
+        
+    }
+    
     // Parse --ccp-yaml-in
+    // Note this argument is optional with --ccp-jumps-in or --ccp-materials-in
     args::arg_map_t::const_iterator ccp_yaml_in_iter = arg_slices.storage().find("--ccp-yaml-in");
-    if (ccp_yaml_in_iter == not_found)
+    if (ccp_yaml_in_iter == not_found && this->ccp_jumps_in_.empty() && this->ccp_materials_in_.empty())
         throw error_message_t(error_code_t::ARG_MISSING_CCP_YAML_IN, "Error.  Missing required argument --ccp-yaml-in <file.yaml>");
-    if (ccp_yaml_in_iter->second.size() != 1)
+    if (ccp_yaml_in_iter != not_found)
     {
-        std::string message("Error.  --ccp-yaml-in takes exactly one argument.  ");
-        message += std::to_string(ccp_yaml_in_iter->second.size());
-        message += " passed.";
-        throw error_message_t(error_code_t::ARG_WRONG_NUMBER_OF_PARAMETERS_CCP_YAML_IN, message);
+        if (ccp_yaml_in_iter->second.size() != 1)
+        {
+            std::string message("Error.  --ccp-yaml-in takes exactly one argument.  ");
+            message += std::to_string(ccp_yaml_in_iter->second.size());
+            message += " passed.";
+            throw error_message_t(error_code_t::ARG_WRONG_NUMBER_OF_PARAMETERS_CCP_YAML_IN, message);
+        }
+        this->ccp_yaml_in_ = ccp_yaml_in_iter->second.front();
     }
-    this->ccp_yaml_in_ = ccp_yaml_in_iter->second.front();
     
     // Parse --custom-json-out
-    args::arg_map_t::const_iterator custom_json_out_iter = arg_slices.storage().find("--custom-json-out");
-    if (custom_json_out_iter == not_found)
-        throw error_message_t(error_code_t::ARG_MISSING_CUSTOM_JSON_OUT, "Error.  Missing required argument --custom-json-out <file.yaml>");
-    if (custom_json_out_iter->second.size() != 1)
+    // Note this argument is required with --ccp-yaml-in
+    if (!this->ccp_yaml_in_.empty())
     {
-        std::string message("Error.  --custom-json-out takes exactly one argument.  ");
-        message += std::to_string(custom_json_out_iter->second.size());
-        message += " passed.";
-        throw error_message_t(error_code_t::ARG_WRONG_NUMBER_OF_PARAMETERS_CUSTOM_JSON_OUT, message);
+        args::arg_map_t::const_iterator custom_json_out_iter = arg_slices.storage().find("--custom-json-out");
+        if (custom_json_out_iter == not_found)
+            throw error_message_t(error_code_t::ARG_MISSING_CUSTOM_JSON_OUT, "Error.  Missing required argument --custom-json-out <file.yaml>");
+        if (custom_json_out_iter->second.size() != 1)
+        {
+            std::string message("Error.  --custom-json-out takes exactly one argument.  ");
+            message += std::to_string(custom_json_out_iter->second.size());
+            message += " passed.";
+            throw error_message_t(error_code_t::ARG_WRONG_NUMBER_OF_PARAMETERS_CUSTOM_JSON_OUT, message);
+        }
+        this->custom_json_out_ = custom_json_out_iter->second.front();
     }
-    this->custom_json_out_ = custom_json_out_iter->second.front();
     
     // If an error wasn't thrown by now, parsing must have been successful
     this->valid_ = true;
@@ -126,6 +219,56 @@ void args::blueprint_converter_t::read_from_json_structure(const Json::Value& js
         throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/custom_json_out was not found or not of type \"string\".");
     this->custom_json_out_ = json_custom_json_out.asString();
     
+    // Decode ccp_jumps_in
+    // This is optional and left empty if missing.
+    const Json::Value json_ccp_jumps_in = json_root["ccp_jumps_in"];
+    if (!json_ccp_jumps_in.isNull())
+    {
+        if (!json_ccp_jumps_in.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/ccp_jumps_in was not of type \"string\".");
+        this->ccp_jumps_in_ = json_ccp_jumps_in.asString();
+    }
+    
+    // Decode stargates_out
+    // This is optional and left empty if missing.
+    const Json::Value json_stargates_out = json_root["stargates_out"];
+    if (!json_stargates_out.isNull())
+    {
+        if (!json_stargates_out.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/stargates_out was not of type \"string\".");
+        this->stargates_out_ = json_stargates_out.asString();
+    }
+    
+    // Decode ccp_materials_in
+    // This is optional and left empty if missing.
+    const Json::Value json_ccp_materials_in = json_root["ccp_materials_in"];
+    if (!json_ccp_materials_in.isNull())
+    {
+        if (!json_ccp_materials_in.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/ccp_materials_in was not of type \"string\".");
+        this->ccp_materials_in_ = json_ccp_materials_in.asString();
+    }
+    
+    // Decode ccp_types_in
+    // This is optional and left empty if missing.
+    const Json::Value json_ccp_types_in = json_root["ccp_types_in"];
+    if (!json_ccp_types_in.isNull())
+    {
+        if (!json_ccp_types_in.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/ccp_types_in was not of type \"string\".");
+        this->ccp_types_in_ = json_ccp_types_in.asString();
+    }
+    
+    // Decode reprocessing_out
+    // This is optional and left empty if missing.
+    const Json::Value json_reprocessing_out = json_root["reprocessing_out"];
+    if (!json_reprocessing_out.isNull())
+    {
+        if (!json_reprocessing_out.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/reprocessing_out was not of type \"string\".");
+        this->reprocessing_out_ = json_reprocessing_out.asString();
+    }
+    
 }
 
 void args::blueprint_converter_t::write_to_json_file(std::ostream& file, unsigned indent_start, unsigned spaces_per_tab) const
@@ -162,6 +305,36 @@ void args::blueprint_converter_t::write_to_json_buffer(std::string& buffer, unsi
     buffer += indent_1;
     buffer += "\"custom_json_out\": \"";
     buffer += this->custom_json_out_;
+    buffer += "\",\n";
+    
+    // Encode ccp_jumps_in
+    buffer += indent_1;
+    buffer += "\"ccp_jumps_in\": \"";
+    buffer += this->ccp_jumps_in_;
+    buffer += "\",\n";
+    
+    // Encode stargates_out
+    buffer += indent_1;
+    buffer += "\"stargates_out\": \"";
+    buffer += this->stargates_out_;
+    buffer += "\",\n";
+    
+    // Encode ccp_materials_in
+    buffer += indent_1;
+    buffer += "\"ccp_materials_in\": \"";
+    buffer += this->ccp_materials_in_;
+    buffer += "\",\n";
+    
+    // Encode ccp_types_in
+    buffer += indent_1;
+    buffer += "\"ccp_types_in\": \"";
+    buffer += this->ccp_types_in_;
+    buffer += "\",\n";
+    
+    // Encode reprocessing_out
+    buffer += indent_1;
+    buffer += "\"reprocessing_out\": \"";
+    buffer += this->reprocessing_out_;
     buffer += "\"\n";
     
     // It is recommended to not put a newline on the last brace to allow
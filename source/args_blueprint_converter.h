@@ -50,6 +50,31 @@ namespace args
                 return this->custom_json_out_;
             }
             
+            inline const std::string& ccp_jumps_in() const
+            {
+                return this->ccp_jumps_in_;
+            }
+            
+            inline const std::string& stargates_out() const
+            {
+                return this->stargates_out_;
+            }
+            
+            inline const std::string& ccp_materials_in() const
+            {
+                return this->ccp_materials_in_;
+            }
+            
+            inline const std::string& ccp_types_in() const
+            {
+                return this->ccp_types_in_;
+            }
+            
+            inline const std::string& reprocessing_out() const
+            {
+                return this->reprocessing_out_;
+            }
+            
             // Add special-purpose functions here
             
             /// @brief Invalidate this args argument and reset all members to their
@@ -142,7 +167,8 @@ namespace args
             /// Path to CCP's static blueprint data export (SDE) downloaded from
             /// https://developers.eveonline.com/resource/resources.
             /// As of writting, the blueprint file is in sde/fsd/blueprints.yaml
-            /// after extracting the SDE zip.
+            /// after extracting the SDE zip.  Required unless --ccp-jumps-in is
+            /// given.
             ///
             /// Note: This string is the path to a file on your filesystem
             std::string ccp_yaml_in_;
@@ -155,6 +181,55 @@ namespace args
             /// Note: This string is the path to a file on your filesystem
             std::string custom_json_out_;
             
+            /// --ccp-jumps-in <file.yaml>
+            ///
+            /// Path to the list of stargate jumps in CCP's static data export.
+            /// As of writting, this is sde/bsd/mapSolarSystemJumps.yaml after
+            /// extracting the SDE zip.  Optional, but --ccp-yaml-in and
+            /// --custom-json-out may be left out if it is given.
+            ///
+            /// Note: This string is the path to a file on your filesystem
+            std::string ccp_jumps_in_;
+            
+            /// --stargates-out <file.json>
+            ///
+            /// A JSON file of stargates to generate from --ccp-jumps-in, which
+            /// eve_industry reads with --stargates-in.
+            ///
+            /// Note: This string is the path to a file on your filesystem
+            std::string stargates_out_;
+            
+            /// --ccp-materials-in <file.yaml>
+            ///
+            /// Path to the materials each item reprocesses into in CCP's
+            /// static data export.  As of writting, this is
+            /// sde/fsd/typeMaterials.yaml after extracting the SDE zip.
+            /// Optional, but --ccp-yaml-in and --custom-json-out may be left
+            /// out if it is given.
+            ///
+            /// Note: This string is the path to a file on your filesystem
+            std::string ccp_materials_in_;
+            
+            /// --ccp-types-in <file.yaml>
+            ///
+            /// Path to the item types in CCP's static data export, which is
+            /// sde/fsd/types.yaml as of writting.  Only the number of units
+            /// reprocessed at a time is read from it.  Optional.  Without it,
+            /// items are assumed to be reprocessed one unit at a time, which
+            /// is wrong for ores and a few other items.
+            ///
+            /// Note: This string is the path to a file on your filesystem
+            std::string ccp_types_in_;
+            
+            /// --reprocessing-out <file.json>
+            ///
+            /// A JSON file of reprocessing materials to generate from
+            /// --ccp-materials-in, which eve_industry reads with
+            /// --reprocessing-in.
+            ///
+            /// Note: This string is the path to a file on your filesystem
+            std::string reprocessing_out_;
+            
     };
     
 }
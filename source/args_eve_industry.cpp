@@ -5,6 +5,8 @@
 /// * Date Created = Thursday September 14 2017
 /// * Documentation is generated by doxygen, see documentation/html_out/index.html
 
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -19,14 +21,32 @@ const std::vector<std::string_view> args::eve_industry_t::mode_names_ =
 {
     "FETCH_ITEM_ATTRIBUTES",
     "FETCH_PRICES",
-    "CALCULATE_BLUEPRINT_PROFITS"
+    "CALCULATE_BLUEPRINT_PROFITS",
+    "UPDATE_HISTORY",
+    "DIFF_PRICES",
+    "APPLY_PRICE_DELTA",
+    "SCHEDULE_PRODUCTION",
+    "PRICE_SENSITIVITY",
+    "INVENTION_RISK",
+    "BUILD_TOPOLOGY",
+    "SCAN_ARBITRAGE",
+    "EVALUATE_REPROCESSING"
 };
 
 const std::vector<std::string_view> args::eve_industry_t::mode_values_ =
 {
     "fetch-item-attributes",
     "fetch-prices",
-    "calculate-blueprint-profits"
+    "calculate-blueprint-profits",
+    "update-history",
+    "diff-prices",
+    "apply-price-delta",
+    "schedule-production",
+    "price-sensitivity",
+    "invention-risk",
+    "build-topology",
+    "scan-arbitrage",
+    "evaluate-reprocessing"
 };
 
 std::string args::eve_industry_t::valid_mode_values() const
@@ -103,6 +123,34 @@ std::string_view find_argument
     return std::string_view();
 }
 
+/// @brief Decode a non-negative decimal integer.
+///
+/// @return false if str is empty or contains anything other than digits.
+bool parse_unsigned(std::string_view str, uint64_t& value)
+{
+    if (str.empty() || str.size() > 19)
+        return false;
+    value = 0;
+    for (char cur_char : str)
+    {
+        if (cur_char < '0' || cur_char > '9')
+            return false;
+        value = value * 10 + uint64_t(cur_char - '0');
+    }
+    return true;
+}
+
+/// @brief Decode a decimal floating point number.
+///
+/// @return false if str is empty or contains anything after the number.
+bool parse_double(std::string_view str, double& value)
+{
+    std::string terminated(str);
+    char* end;
+    value = std::strtod(terminated.c_str(), &end);
+    return !terminated.empty() && *end == '\0';
+}
+
 /// @brief Search for a particular argument within argv and return true if it
 /// was found.
 bool find_existence
@@ -175,8 +223,9 @@ void args::eve_industry_t::parse(unsigned argc, char const* const* argv)
     
     // Parse --item-attributes-in
     // Note this argument is required for FETCH_PRICES
-    // and optional for CALCULATE_BLUEPRINT_PROFITS
-    if (this->mode_ == mode_t::FETCH_PRICES || this->mode_ == mode_t::CALCULATE_BLUEPRINT_PROFITS)
+    // and optional for CALCULATE_BLUEPRINT_PROFITS, PRICE_SENSITIVITY,
+    // INVENTION_RISK, SCAN_ARBITRAGE and EVALUATE_REPROCESSING
+    if (this->mode_ == mode_t::FETCH_PRICES || this->mode_ == mode_t::CALCULATE_BLUEPRINT_PROFITS || this->mode_ == mode_t::PRICE_SENSITIVITY || this->mode_ == mode_t::INVENTION_RISK || this->mode_ == mode_t::SCAN_ARBITRAGE || this->mode_ == mode_t::EVALUATE_REPROCESSING)
     {
         this->item_attributes_in_ = find_argument("--item-attributes-in", argc, argv);
         if (this->item_attributes_in_.empty() && this->mode_ == mode_t::FETCH_PRICES)
@@ -202,7 +251,7 @@ void args::eve_industry_t::parse(unsigned argc, char const* const* argv)
     }
     
     // Parse --prices-out
-    if (this->mode_ == mode_t::FETCH_PRICES)
+    if (this->mode_ == mode_t::FETCH_PRICES || this->mode_ == mode_t::APPLY_PRICE_DELTA)
     {
         this->prices_out_ = find_argument("--prices-out", argc, argv);
         if (this->prices_out_.empty())
@@ -215,7 +264,7 @@ void args::eve_industry_t::parse(unsigned argc, char const* const* argv)
     }
     
     // Parse --prices-in
-    if (this->mode_ == mode_t::CALCULATE_BLUEPRINT_PROFITS)
+    if (this->mode_ == mode_t::CALCULATE_BLUEPRINT_PROFITS || this->mode_ == mode_t::UPDATE_HISTORY || this->mode_ == mode_t::DIFF_PRICES || this->mode_ == mode_t::APPLY_PRICE_DELTA || this->mode_ == mode_t::PRICE_SENSITIVITY || this->mode_ == mode_t::INVENTION_RISK || this->mode_ == mode_t::SCAN_ARBITRAGE || this->mode_ == mode_t::EVALUATE_REPROCESSING)
     {
         this->prices_in_ = find_argument("--prices-in", argc, argv);
         if (this->prices_in_.empty())
@@ -227,8 +276,161 @@ void args::eve_industry_t::parse(unsigned argc, char const* const* argv)
         }
     }
     
+    // Parse --new-prices-in and --delta-out
+    if (this->mode_ == mode_t::DIFF_PRICES)
+    {
+        
+        this->new_prices_in_ = find_argument("--new-prices-in", argc, argv);
+        if (this->new_prices_in_.empty())
+        {
+            std::string message("Error.  --new-prices-in FILE is required for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::NEW_PRICES_IN_MISSING, message);
+        }
+        
+        this->delta_out_ = find_argument("--delta-out", argc, argv);
+        if (this->delta_out_.empty())
+        {
+            std::string message("Error.  --delta-out FILE is required for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::DELTA_OUT_MISSING, message);
+        }
+        
+    }
+    
+    // Parse --delta-in
+    if (this->mode_ == mode_t::APPLY_PRICE_DELTA)
+    {
+        this->delta_in_ = find_argument("--delta-in", argc, argv);
+        if (this->delta_in_.empty())
+        {
+            std::string message("Error.  --delta-in FILE is required for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::DELTA_IN_MISSING, message);
+        }
+    }
+    
+    // Parse --stargates-in and --topology-in
+    // Note these arguments are optional for FETCH_PRICES, which prefers
+    // --topology-in if both are given
+    if (this->mode_ == mode_t::FETCH_PRICES)
+    {
+        this->stargates_in_ = find_argument("--stargates-in", argc, argv);
+        this->topology_in_ = find_argument("--topology-in", argc, argv);
+    }
+    
+    // Parse --reprocessing-in, --reprocess-out and --reprocess-yield-percent
+    // Note --reprocess-yield-percent is optional for EVALUATE_REPROCESSING
+    if (this->mode_ == mode_t::EVALUATE_REPROCESSING)
+    {
+        
+        this->reprocessing_in_ = find_argument("--reprocessing-in", argc, argv);
+        if (this->reprocessing_in_.empty())
+        {
+            std::string message("Error.  --reprocessing-in FILE is required for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::REPROCESSING_IN_MISSING, message);
+        }
+        
+        this->reprocess_out_ = find_argument("--reprocess-out", argc, argv);
+        if (this->reprocess_out_.empty())
+        {
+            std::string message("Error.  --reprocess-out FILE is required for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::REPROCESS_OUT_MISSING, message);
+        }
+        
+        std::string reprocess_yield_percent_string(find_argument("--reprocess-yield-percent", argc, argv));
+        if (!reprocess_yield_percent_string.empty())
+        {
+            char* end;
+            this->reprocess_yield_percent_ = std::strtod(reprocess_yield_percent_string.c_str(), &end);
+            if (*end != '\0' || !(this->reprocess_yield_percent_ > 0.0 && this->reprocess_yield_percent_ <= 100.0))
+            {
+                std::string message("Error.  Invalid argument \"");
+                message += reprocess_yield_percent_string;
+                message += "\" for --reprocess-yield-percent.  Expected a percentage in (0, 100].\n";
+                throw error_message_t(error_code_t::REPROCESS_YIELD_INVALID, message);
+            }
+        }
+        
+    }
+    
+    // Parse --arbitrage-out, --top, --topology-in and --station-attributes-in
+    // Note all but --arbitrage-out are optional for SCAN_ARBITRAGE, but
+    // --topology-in needs --station-attributes-in to place each station
+    if (this->mode_ == mode_t::SCAN_ARBITRAGE)
+    {
+        
+        this->arbitrage_out_ = find_argument("--arbitrage-out", argc, argv);
+        if (this->arbitrage_out_.empty())
+        {
+            std::string message("Error.  --arbitrage-out FILE is required for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::ARBITRAGE_OUT_MISSING, message);
+        }
+        
+        std::string_view num_opportunities_string = find_argument("--top", argc, argv);
+        if (!num_opportunities_string.empty())
+        {
+            uint64_t num_opportunities;
+            if (!parse_unsigned(num_opportunities_string, num_opportunities) || num_opportunities == 0 || num_opportunities > 1000000)
+            {
+                std::string message("Error.  Invalid argument \"");
+                message += num_opportunities_string;
+                message += "\" for --top.  Expected a number of opportunities between 1 and 1000000.\n";
+                throw error_message_t(error_code_t::ARBITRAGE_LIMIT_INVALID, message);
+            }
+            this->num_opportunities_ = num_opportunities;
+        }
+        
+        this->topology_in_ = find_argument("--topology-in", argc, argv);
+        this->station_attributes_in_ = find_argument("--station-attributes-in", argc, argv);
+        if (!this->topology_in_.empty() && this->station_attributes_in_.empty())
+        {
+            std::string message("Error.  --station-attributes-in FILE is required with --topology-in for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::STATION_ATTRIBUTES_IN_MISSING, message);
+        }
+        
+    }
+    
+    // Parse --stargates-in and --topology-out
+    if (this->mode_ == mode_t::BUILD_TOPOLOGY)
+    {
+        
+        this->stargates_in_ = find_argument("--stargates-in", argc, argv);
+        if (this->stargates_in_.empty())
+        {
+            std::string message("Error.  --stargates-in FILE is required for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::STARGATES_IN_MISSING, message);
+        }
+        
+        this->topology_out_ = find_argument("--topology-out", argc, argv);
+        if (this->topology_out_.empty())
+        {
+            std::string message("Error.  --topology-out FILE is required for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::TOPOLOGY_OUT_MISSING, message);
+        }
+        
+    }
+    
     // Parse --blueprints-in
-    if (this->mode_ == mode_t::CALCULATE_BLUEPRINT_PROFITS)
+    // Note this argument is optional for FETCH_PRICES
+    if (this->mode_ == mode_t::FETCH_PRICES)
+        this->blueprints_in_ = find_argument("--blueprints-in", argc, argv);
+    if (this->mode_ == mode_t::CALCULATE_BLUEPRINT_PROFITS || this->mode_ == mode_t::SCHEDULE_PRODUCTION || this->mode_ == mode_t::PRICE_SENSITIVITY || this->mode_ == mode_t::INVENTION_RISK)
     {
         this->blueprints_in_ = find_argument("--blueprints-in", argc, argv);
         if (this->blueprints_in_.empty())
@@ -253,6 +455,148 @@ void args::eve_industry_t::parse(unsigned argc, char const* const* argv)
         }
     }
     
+    // Parse --sensitivity-out and --scenarios-in
+    // Note --scenarios-in is optional for PRICE_SENSITIVITY
+    if (this->mode_ == mode_t::PRICE_SENSITIVITY)
+    {
+        
+        this->sensitivity_out_ = find_argument("--sensitivity-out", argc, argv);
+        if (this->sensitivity_out_.empty())
+        {
+            std::string message("Error.  --sensitivity-out FILE is required for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::SENSITIVITY_OUT_MISSING, message);
+        }
+        
+        this->scenarios_in_ = find_argument("--scenarios-in", argc, argv);
+        
+    }
+    
+    // Parse --risk-out, --trials, --invention-attempts and --seed
+    // Note all but --risk-out are optional for INVENTION_RISK
+    if (this->mode_ == mode_t::INVENTION_RISK)
+    {
+        
+        this->risk_out_ = find_argument("--risk-out", argc, argv);
+        if (this->risk_out_.empty())
+        {
+            std::string message("Error.  --risk-out FILE is required for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::RISK_OUT_MISSING, message);
+        }
+        
+        const std::string_view limit_names[] = {"--trials", "--invention-attempts"};
+        unsigned* const limit_values[] = {&this->num_trials_, &this->invention_attempts_};
+        const uint64_t limit_maximums[] = {100000000, 10000};
+        for (unsigned ix = 0; ix < 2; ix++)
+        {
+            std::string_view limit_string = find_argument(limit_names[ix], argc, argv);
+            if (limit_string.empty())
+                continue;
+            uint64_t limit_value;
+            if (!parse_unsigned(limit_string, limit_value) || limit_value == 0 || limit_value > limit_maximums[ix])
+            {
+                std::string message("Error.  Invalid argument \"");
+                message += limit_string;
+                message += "\" for ";
+                message += limit_names[ix];
+                message += ".  Expected an integer between 1 and ";
+                message += std::to_string(limit_maximums[ix]);
+                message += ".\n";
+                throw error_message_t(error_code_t::RISK_LIMIT_INVALID, message);
+            }
+            *limit_values[ix] = limit_value;
+        }
+        
+        std::string_view seed_string = find_argument("--seed", argc, argv);
+        if (!seed_string.empty() && !parse_unsigned(seed_string, this->seed_))
+        {
+            std::string message("Error.  Invalid argument \"");
+            message += seed_string;
+            message += "\" for --seed.  Expected a non-negative integer.\n";
+            throw error_message_t(error_code_t::RISK_LIMIT_INVALID, message);
+        }
+        
+    }
+    
+    // Parse --profits-in and --schedule-out
+    if (this->mode_ == mode_t::SCHEDULE_PRODUCTION)
+    {
+        
+        this->profits_in_ = find_argument("--profits-in", argc, argv);
+        if (this->profits_in_.empty())
+        {
+            std::string message("Error.  --profits-in FILE is required for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::PROFITS_IN_MISSING, message);
+        }
+        
+        this->schedule_out_ = find_argument("--schedule-out", argc, argv);
+        if (this->schedule_out_.empty())
+        {
+            std::string message("Error.  --schedule-out FILE is required for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::SCHEDULE_OUT_MISSING, message);
+        }
+        
+    }
+    
+    // Parse --characters, --manufacturing-slots, --science-slots, --capital
+    // and --schedule-hours
+    // Note these arguments are optional for SCHEDULE_PRODUCTION
+    if (this->mode_ == mode_t::SCHEDULE_PRODUCTION)
+    {
+        
+        const std::string_view slot_names[] = {"--characters", "--manufacturing-slots", "--science-slots"};
+        unsigned* const slot_values[] = {&this->num_characters_, &this->manufacturing_slots_, &this->science_slots_};
+        for (unsigned ix = 0; ix < 3; ix++)
+        {
+            std::string_view slot_string = find_argument(slot_names[ix], argc, argv);
+            if (slot_string.empty())
+                continue;
+            uint64_t slot_value;
+            if (!parse_unsigned(slot_string, slot_value) || slot_value > 10000)
+            {
+                std::string message("Error.  Invalid argument \"");
+                message += slot_string;
+                message += "\" for ";
+                message += slot_names[ix];
+                message += ".  Expected an integer between 0 and 10000.\n";
+                throw error_message_t(error_code_t::SCHEDULE_LIMIT_INVALID, message);
+            }
+            *slot_values[ix] = slot_value;
+        }
+        
+        std::string_view capital_string = find_argument("--capital", argc, argv);
+        if (!capital_string.empty())
+        {
+            if (!parse_double(capital_string, this->capital_) || !(this->capital_ >= 0.0))
+            {
+                std::string message("Error.  Invalid argument \"");
+                message += capital_string;
+                message += "\" for --capital.  Expected a non-negative amount of ISK.\n";
+                throw error_message_t(error_code_t::SCHEDULE_LIMIT_INVALID, message);
+            }
+        }
+        
+        std::string_view schedule_hours_string = find_argument("--schedule-hours", argc, argv);
+        if (!schedule_hours_string.empty())
+        {
+            if (!parse_double(schedule_hours_string, this->schedule_hours_) || !(this->schedule_hours_ > 0.0 && this->schedule_hours_ <= 8760.0))
+            {
+                std::string message("Error.  Invalid argument \"");
+                message += schedule_hours_string;
+                message += "\" for --schedule-hours.  Expected a number of hours greater than 0 and at most 8760.\n";
+                throw error_message_t(error_code_t::SCHEDULE_LIMIT_INVALID, message);
+            }
+        }
+        
+    }
+    
     // Parse --dont-cull-stations
     this->cull_stations_ = !find_existence("--dont-cull-stations", argc, argv);
     
@@ -269,7 +613,7 @@ void args::eve_industry_t::parse(unsigned argc, char const* const* argv)
     }
     
     // Parse decryptor_optimization_strategy
-    if (this->mode_ == mode_t::CALCULATE_BLUEPRINT_PROFITS)
+    if (this->mode_ == mode_t::CALCULATE_BLUEPRINT_PROFITS || this->mode_ == mode_t::PRICE_SENSITIVITY)
     {
         std::string_view decryptor_optimization_strategy_string = find_argument("--decryptor-optimization-strategy", argc, argv);
         if (!decryptor_optimization_strategy_string.empty())
@@ -277,6 +621,103 @@ void args::eve_industry_t::parse(unsigned argc, char const* const* argv)
         // else use default value set by clear()
     }
     
+    // Parse --history-out
+    if (this->mode_ == mode_t::UPDATE_HISTORY)
+    {
+        this->history_out_ = find_argument("--history-out", argc, argv);
+        if (this->history_out_.empty())
+        {
+            std::string message("Error.  --history-out FILE is required for ");
+            message += mode_values_[unsigned(this->mode_)];
+            message += " mode.\n";
+            throw error_message_t(error_code_t::HISTORY_OUT_MISSING, message);
+        }
+    }
+    
+    // Parse --history-in, --history-days, and --history-min-volume
+    // Note these arguments are optional for CALCULATE_BLUEPRINT_PROFITS,
+    // SCHEDULE_PRODUCTION, PRICE_SENSITIVITY, INVENTION_RISK and
+    // SCAN_ARBITRAGE
+    if (this->mode_ == mode_t::CALCULATE_BLUEPRINT_PROFITS || this->mode_ == mode_t::SCHEDULE_PRODUCTION || this->mode_ == mode_t::PRICE_SENSITIVITY || this->mode_ == mode_t::INVENTION_RISK || this->mode_ == mode_t::SCAN_ARBITRAGE)
+    {
+        
+        this->history_in_ = find_argument("--history-in", argc, argv);
+        
+        std::string_view history_days_string = find_argument("--history-days", argc, argv);
+        if (!history_days_string.empty())
+        {
+            uint64_t history_days;
+            if (!parse_unsigned(history_days_string, history_days) || history_days == 0 || history_days > 3650)
+            {
+                std::string message("Error.  Invalid argument \"");
+                message += history_days_string;
+                message += "\" for --history-days.  Expected a number of days between 1 and 3650.\n";
+                throw error_message_t(error_code_t::HISTORY_DAYS_INVALID, message);
+            }
+            this->history_days_ = history_days;
+        }
+        
+        std::string_view history_min_volume_string = find_argument("--history-min-volume", argc, argv);
+        if (!history_min_volume_string.empty() && !parse_unsigned(history_min_volume_string, this->history_min_volume_))
+        {
+            std::string message("Error.  Invalid argument \"");
+            message += history_min_volume_string;
+            message += "\" for --history-min-volume.  Expected a non-negative integer.\n";
+            throw error_message_t(error_code_t::HISTORY_DAYS_INVALID, message);
+        }
+        
+    }
+    
+    // Parse --cross-station, --hauling-cost-percent, --build-intermediates,
+    // --runs-per-job and --profiles-in
+    // Note these arguments are optional for CALCULATE_BLUEPRINT_PROFITS and,
+    // except --build-intermediates, PRICE_SENSITIVITY and INVENTION_RISK.
+    // SCAN_ARBITRAGE only uses --hauling-cost-percent and --profiles-in.
+    if (this->mode_ == mode_t::CALCULATE_BLUEPRINT_PROFITS || this->mode_ == mode_t::PRICE_SENSITIVITY || this->mode_ == mode_t::INVENTION_RISK || this->mode_ == mode_t::SCAN_ARBITRAGE)
+    {
+        
+        this->cross_station_ = find_existence("--cross-station", argc, argv);
+        this->build_intermediates_ = this->mode_ == mode_t::CALCULATE_BLUEPRINT_PROFITS && find_existence("--build-intermediates", argc, argv);
+        this->profiles_in_ = find_argument("--profiles-in", argc, argv);
+        
+        std::string_view runs_per_job_string = find_argument("--runs-per-job", argc, argv);
+        if (!runs_per_job_string.empty())
+        {
+            uint64_t runs_per_job;
+            if (!parse_unsigned(runs_per_job_string, runs_per_job) || runs_per_job == 0 || runs_per_job > 1000000)
+            {
+                std::string message("Error.  Invalid argument \"");
+                message += runs_per_job_string;
+                message += "\" for --runs-per-job.  Expected a number of runs between 1 and 1000000.\n";
+                throw error_message_t(error_code_t::RUNS_PER_JOB_INVALID, message);
+            }
+            this->runs_per_job_ = runs_per_job;
+        }
+        
+        std::string hauling_cost_percent_string(find_argument("--hauling-cost-percent", argc, argv));
+        if (!hauling_cost_percent_string.empty())
+        {
+            char* end;
+            this->hauling_cost_percent_ = std::strtod(hauling_cost_percent_string.c_str(), &end);
+            if (*end != '\0' || !(this->hauling_cost_percent_ >= 0.0 && this->hauling_cost_percent_ < 100.0))
+            {
+                std::string message("Error.  Invalid argument \"");
+                message += hauling_cost_percent_string;
+                message += "\" for --hauling-cost-percent.  Expected a percentage in [0, 100).\n";
+                throw error_message_t(error_code_t::HAULING_COST_INVALID, message);
+            }
+        }
+        
+    }
+    
+    // Parse --stats-out
+    // Note this argument is optional for all modes
+    this->stats_out_ = find_argument("--stats-out", argc, argv);
+    
+    // Parse --trace-out
+    // Note this argument is optional for all modes
+    this->trace_out_ = find_argument("--trace-out", argc, argv);
+    
 }
 
 void args::eve_industry_t::clear()
@@ -294,6 +735,41 @@ void args::eve_industry_t::clear()
     this->cull_orders_ = false;
     this->output_order_ = blueprint_profit_t::sort_strategy_t::PROFIT_PER_SECOND;
     this->decryptor_optimization_strategy_ = blueprint_profit_t::sort_strategy_t::PROFIT_PER_SECOND;
+    this->stats_out_.clear();
+    this->trace_out_.clear();
+    this->history_out_.clear();
+    this->history_in_.clear();
+    this->history_days_ = 7;
+    this->history_min_volume_ = 0;
+    this->new_prices_in_.clear();
+    this->delta_out_.clear();
+    this->delta_in_.clear();
+    this->cross_station_ = false;
+    this->hauling_cost_percent_ = 0.0;
+    this->build_intermediates_ = false;
+    this->runs_per_job_ = 1;
+    this->profits_in_.clear();
+    this->schedule_out_.clear();
+    this->num_characters_ = 1;
+    this->manufacturing_slots_ = 11;
+    this->science_slots_ = 11;
+    this->capital_ = 0.0;
+    this->schedule_hours_ = 24.0;
+    this->profiles_in_.clear();
+    this->scenarios_in_.clear();
+    this->sensitivity_out_.clear();
+    this->risk_out_.clear();
+    this->num_trials_ = 100000;
+    this->invention_attempts_ = 10;
+    this->seed_ = 0;
+    this->stargates_in_.clear();
+    this->topology_in_.clear();
+    this->topology_out_.clear();
+    this->arbitrage_out_.clear();
+    this->num_opportunities_ = 100;
+    this->reprocessing_in_.clear();
+    this->reprocess_out_.clear();
+    this->reprocess_yield_percent_ = 50.0;
 }
 
 void args::eve_industry_t::read_from_json_file(std::istream& file)
@@ -423,6 +899,356 @@ void args::eve_industry_t::read_from_json_json(const Json::Value& json_root)
     const std::string& decryptor_optimization_strategy_string = json_decryptor_optimization_strategy.asString();
     this->decryptor_optimization_strategy_ = string_to_sort_strategy(std::string_view(decryptor_optimization_strategy_string));
     
+    // Parse root/stats_out
+    // This is optional and left empty if missing.
+    const Json::Value& json_stats_out = json_root["stats_out"];
+    if (!json_stats_out.isNull())
+    {
+        if (!json_stats_out.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/stats_out was not of type \"string\".\n");
+        this->stats_out_ = json_stats_out.asString();
+    }
+    
+    // Parse root/trace_out
+    // This is optional and left empty if missing.
+    const Json::Value& json_trace_out = json_root["trace_out"];
+    if (!json_trace_out.isNull())
+    {
+        if (!json_trace_out.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/trace_out was not of type \"string\".\n");
+        this->trace_out_ = json_trace_out.asString();
+    }
+    
+    // Parse root/history_out
+    // This is optional and left empty if missing.
+    const Json::Value& json_history_out = json_root["history_out"];
+    if (!json_history_out.isNull())
+    {
+        if (!json_history_out.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/history_out was not of type \"string\".\n");
+        this->history_out_ = json_history_out.asString();
+    }
+    
+    // Parse root/history_in
+    // This is optional and left empty if missing.
+    const Json::Value& json_history_in = json_root["history_in"];
+    if (!json_history_in.isNull())
+    {
+        if (!json_history_in.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/history_in was not of type \"string\".\n");
+        this->history_in_ = json_history_in.asString();
+    }
+    
+    // Parse root/history_days
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_history_days = json_root["history_days"];
+    if (!json_history_days.isNull())
+    {
+        if (!json_history_days.isUInt() || json_history_days.asUInt() == 0)
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/history_days was not of type \"positive integer\".\n");
+        this->history_days_ = json_history_days.asUInt();
+    }
+    
+    // Parse root/history_min_volume
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_history_min_volume = json_root["history_min_volume"];
+    if (!json_history_min_volume.isNull())
+    {
+        if (!json_history_min_volume.isUInt64())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/history_min_volume was not of type \"unsigned integer\".\n");
+        this->history_min_volume_ = json_history_min_volume.asUInt64();
+    }
+    
+    // Parse root/new_prices_in
+    // This is optional and left empty if missing.
+    const Json::Value& json_new_prices_in = json_root["new_prices_in"];
+    if (!json_new_prices_in.isNull())
+    {
+        if (!json_new_prices_in.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/new_prices_in was not of type \"string\".\n");
+        this->new_prices_in_ = json_new_prices_in.asString();
+    }
+    
+    // Parse root/delta_out
+    // This is optional and left empty if missing.
+    const Json::Value& json_delta_out = json_root["delta_out"];
+    if (!json_delta_out.isNull())
+    {
+        if (!json_delta_out.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/delta_out was not of type \"string\".\n");
+        this->delta_out_ = json_delta_out.asString();
+    }
+    
+    // Parse root/delta_in
+    // This is optional and left empty if missing.
+    const Json::Value& json_delta_in = json_root["delta_in"];
+    if (!json_delta_in.isNull())
+    {
+        if (!json_delta_in.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/delta_in was not of type \"string\".\n");
+        this->delta_in_ = json_delta_in.asString();
+    }
+    
+    // Parse root/cross_station
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_cross_station = json_root["cross_station"];
+    if (!json_cross_station.isNull())
+    {
+        if (!json_cross_station.isBool())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/cross_station was not of type \"bool\".\n");
+        this->cross_station_ = json_cross_station.asBool();
+    }
+    
+    // Parse root/hauling_cost_percent
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_hauling_cost_percent = json_root["hauling_cost_percent"];
+    if (!json_hauling_cost_percent.isNull())
+    {
+        if (!json_hauling_cost_percent.isNumeric())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/hauling_cost_percent was not of type \"float\".\n");
+        this->hauling_cost_percent_ = json_hauling_cost_percent.asDouble();
+    }
+    
+    // Parse root/build_intermediates
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_build_intermediates = json_root["build_intermediates"];
+    if (!json_build_intermediates.isNull())
+    {
+        if (!json_build_intermediates.isBool())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/build_intermediates was not of type \"bool\".\n");
+        this->build_intermediates_ = json_build_intermediates.asBool();
+    }
+    
+    // Parse root/runs_per_job
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_runs_per_job = json_root["runs_per_job"];
+    if (!json_runs_per_job.isNull())
+    {
+        if (!json_runs_per_job.isUInt() || json_runs_per_job.asUInt() == 0)
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/runs_per_job was not of type \"positive integer\".\n");
+        this->runs_per_job_ = json_runs_per_job.asUInt();
+    }
+    
+    // Parse root/profits_in
+    // This is optional and left empty if missing.
+    const Json::Value& json_profits_in = json_root["profits_in"];
+    if (!json_profits_in.isNull())
+    {
+        if (!json_profits_in.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/profits_in was not of type \"string\".\n");
+        this->profits_in_ = json_profits_in.asString();
+    }
+    
+    // Parse root/schedule_out
+    // This is optional and left empty if missing.
+    const Json::Value& json_schedule_out = json_root["schedule_out"];
+    if (!json_schedule_out.isNull())
+    {
+        if (!json_schedule_out.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/schedule_out was not of type \"string\".\n");
+        this->schedule_out_ = json_schedule_out.asString();
+    }
+    
+    // Parse root/num_characters
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_num_characters = json_root["num_characters"];
+    if (!json_num_characters.isNull())
+    {
+        if (!json_num_characters.isUInt())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/num_characters was not of type \"unsigned integer\".\n");
+        this->num_characters_ = json_num_characters.asUInt();
+    }
+    
+    // Parse root/manufacturing_slots
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_manufacturing_slots = json_root["manufacturing_slots"];
+    if (!json_manufacturing_slots.isNull())
+    {
+        if (!json_manufacturing_slots.isUInt())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/manufacturing_slots was not of type \"unsigned integer\".\n");
+        this->manufacturing_slots_ = json_manufacturing_slots.asUInt();
+    }
+    
+    // Parse root/science_slots
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_science_slots = json_root["science_slots"];
+    if (!json_science_slots.isNull())
+    {
+        if (!json_science_slots.isUInt())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/science_slots was not of type \"unsigned integer\".\n");
+        this->science_slots_ = json_science_slots.asUInt();
+    }
+    
+    // Parse root/capital
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_capital = json_root["capital"];
+    if (!json_capital.isNull())
+    {
+        if (!json_capital.isNumeric())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/capital was not of type \"float\".\n");
+        this->capital_ = json_capital.asDouble();
+    }
+    
+    // Parse root/schedule_hours
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_schedule_hours = json_root["schedule_hours"];
+    if (!json_schedule_hours.isNull())
+    {
+        if (!json_schedule_hours.isNumeric())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/schedule_hours was not of type \"float\".\n");
+        this->schedule_hours_ = json_schedule_hours.asDouble();
+    }
+    
+    // Parse root/profiles_in
+    // This is optional and left empty if missing.
+    const Json::Value& json_profiles_in = json_root["profiles_in"];
+    if (!json_profiles_in.isNull())
+    {
+        if (!json_profiles_in.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/profiles_in was not of type \"string\".\n");
+        this->profiles_in_ = json_profiles_in.asString();
+    }
+    
+    // Parse root/scenarios_in
+    // This is optional and left empty if missing.
+    const Json::Value& json_scenarios_in = json_root["scenarios_in"];
+    if (!json_scenarios_in.isNull())
+    {
+        if (!json_scenarios_in.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/scenarios_in was not of type \"string\".\n");
+        this->scenarios_in_ = json_scenarios_in.asString();
+    }
+    
+    // Parse root/sensitivity_out
+    // This is optional and left empty if missing.
+    const Json::Value& json_sensitivity_out = json_root["sensitivity_out"];
+    if (!json_sensitivity_out.isNull())
+    {
+        if (!json_sensitivity_out.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/sensitivity_out was not of type \"string\".\n");
+        this->sensitivity_out_ = json_sensitivity_out.asString();
+    }
+    
+    // Parse root/risk_out
+    // This is optional and left empty if missing.
+    const Json::Value& json_risk_out = json_root["risk_out"];
+    if (!json_risk_out.isNull())
+    {
+        if (!json_risk_out.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/risk_out was not of type \"string\".\n");
+        this->risk_out_ = json_risk_out.asString();
+    }
+    
+    // Parse root/num_trials
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_num_trials = json_root["num_trials"];
+    if (!json_num_trials.isNull())
+    {
+        if (!json_num_trials.isUInt())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/num_trials was not of type \"unsigned integer\".\n");
+        this->num_trials_ = json_num_trials.asUInt();
+    }
+    
+    // Parse root/invention_attempts
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_invention_attempts = json_root["invention_attempts"];
+    if (!json_invention_attempts.isNull())
+    {
+        if (!json_invention_attempts.isUInt())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/invention_attempts was not of type \"unsigned integer\".\n");
+        this->invention_attempts_ = json_invention_attempts.asUInt();
+    }
+    
+    // Parse root/seed
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_seed = json_root["seed"];
+    if (!json_seed.isNull())
+    {
+        if (!json_seed.isUInt64())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/seed was not of type \"unsigned integer\".\n");
+        this->seed_ = json_seed.asUInt64();
+    }
+    
+    // Parse root/stargates_in
+    // This is optional and left empty if missing.
+    const Json::Value& json_stargates_in = json_root["stargates_in"];
+    if (!json_stargates_in.isNull())
+    {
+        if (!json_stargates_in.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/stargates_in was not of type \"string\".\n");
+        this->stargates_in_ = json_stargates_in.asString();
+    }
+    
+    // Parse root/topology_in
+    // This is optional and left empty if missing.
+    const Json::Value& json_topology_in = json_root["topology_in"];
+    if (!json_topology_in.isNull())
+    {
+        if (!json_topology_in.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/topology_in was not of type \"string\".\n");
+        this->topology_in_ = json_topology_in.asString();
+    }
+    
+    // Parse root/topology_out
+    // This is optional and left empty if missing.
+    const Json::Value& json_topology_out = json_root["topology_out"];
+    if (!json_topology_out.isNull())
+    {
+        if (!json_topology_out.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/topology_out was not of type \"string\".\n");
+        this->topology_out_ = json_topology_out.asString();
+    }
+    
+    // Parse root/arbitrage_out
+    // This is optional and left empty if missing.
+    const Json::Value& json_arbitrage_out = json_root["arbitrage_out"];
+    if (!json_arbitrage_out.isNull())
+    {
+        if (!json_arbitrage_out.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/arbitrage_out was not of type \"string\".\n");
+        this->arbitrage_out_ = json_arbitrage_out.asString();
+    }
+    
+    // Parse root/num_opportunities
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_num_opportunities = json_root["num_opportunities"];
+    if (!json_num_opportunities.isNull())
+    {
+        if (!json_num_opportunities.isUInt())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/num_opportunities was not of type \"unsigned integer\".\n");
+        this->num_opportunities_ = json_num_opportunities.asUInt();
+    }
+    
+    // Parse root/reprocessing_in
+    // This is optional and left empty if missing.
+    const Json::Value& json_reprocessing_in = json_root["reprocessing_in"];
+    if (!json_reprocessing_in.isNull())
+    {
+        if (!json_reprocessing_in.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/reprocessing_in was not of type \"string\".\n");
+        this->reprocessing_in_ = json_reprocessing_in.asString();
+    }
+    
+    // Parse root/reprocess_out
+    // This is optional and left empty if missing.
+    const Json::Value& json_reprocess_out = json_root["reprocess_out"];
+    if (!json_reprocess_out.isNull())
+    {
+        if (!json_reprocess_out.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/reprocess_out was not of type \"string\".\n");
+        this->reprocess_out_ = json_reprocess_out.asString();
+    }
+    
+    // Parse root/reprocess_yield_percent
+    // This is optional and left at its default value if missing.
+    const Json::Value& json_reprocess_yield_percent = json_root["reprocess_yield_percent"];
+    if (!json_reprocess_yield_percent.isNull())
+    {
+        if (!json_reprocess_yield_percent.isNumeric())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <args>/reprocess_yield_percent was not of type \"float\".\n");
+        this->reprocess_yield_percent_ = json_reprocess_yield_percent.asDouble();
+    }
+    
 }
 
 void args::eve_industry_t::write_to_json_file(std::ostream& file, unsigned indent_start, unsigned spaces_per_tab) const
@@ -510,7 +1336,217 @@ void args::eve_industry_t::write_to_json_buffer(std::string& buffer, unsigned in
     buffer += indent_1;
     buffer += "\"decryptor_optimization_strategy\": \"";
     buffer += sort_strategy_to_string(this->decryptor_optimization_strategy_);
-    buffer += "\"\n";
+    buffer += "\",\n";
+    
+    // Encode stats_out
+    buffer += indent_1;
+    buffer += "\"stats_out\": \"";
+    buffer += this->stats_out_;
+    buffer += "\",\n";
+    
+    // Encode trace_out
+    buffer += indent_1;
+    buffer += "\"trace_out\": \"";
+    buffer += this->trace_out_;
+    buffer += "\",\n";
+    
+    // Encode history_out
+    buffer += indent_1;
+    buffer += "\"history_out\": \"";
+    buffer += this->history_out_;
+    buffer += "\",\n";
+    
+    // Encode history_in
+    buffer += indent_1;
+    buffer += "\"history_in\": \"";
+    buffer += this->history_in_;
+    buffer += "\",\n";
+    
+    // Encode history_days
+    buffer += indent_1;
+    buffer += "\"history_days\": ";
+    buffer += std::to_string(this->history_days_);
+    buffer += ",\n";
+    
+    // Encode history_min_volume
+    buffer += indent_1;
+    buffer += "\"history_min_volume\": ";
+    buffer += std::to_string(this->history_min_volume_);
+    buffer += ",\n";
+    
+    // Encode new_prices_in
+    buffer += indent_1;
+    buffer += "\"new_prices_in\": \"";
+    buffer += this->new_prices_in_;
+    buffer += "\",\n";
+    
+    // Encode delta_out
+    buffer += indent_1;
+    buffer += "\"delta_out\": \"";
+    buffer += this->delta_out_;
+    buffer += "\",\n";
+    
+    // Encode delta_in
+    buffer += indent_1;
+    buffer += "\"delta_in\": \"";
+    buffer += this->delta_in_;
+    buffer += "\",\n";
+    
+    // Encode cross_station
+    buffer += indent_1;
+    buffer += "\"cross_station\": ";
+    buffer += this->cross_station_ ? "true" : "false";
+    buffer += ",\n";
+    
+    // Encode hauling_cost_percent
+    buffer += indent_1;
+    buffer += "\"hauling_cost_percent\": ";
+    buffer += std::to_string(this->hauling_cost_percent_);
+    buffer += ",\n";
+    
+    // Encode build_intermediates
+    buffer += indent_1;
+    buffer += "\"build_intermediates\": ";
+    buffer += this->build_intermediates_ ? "true" : "false";
+    buffer += ",\n";
+    
+    // Encode runs_per_job
+    buffer += indent_1;
+    buffer += "\"runs_per_job\": ";
+    buffer += std::to_string(this->runs_per_job_);
+    buffer += ",\n";
+    
+    // Encode profits_in
+    buffer += indent_1;
+    buffer += "\"profits_in\": \"";
+    buffer += this->profits_in_;
+    buffer += "\",\n";
+    
+    // Encode schedule_out
+    buffer += indent_1;
+    buffer += "\"schedule_out\": \"";
+    buffer += this->schedule_out_;
+    buffer += "\",\n";
+    
+    // Encode num_characters
+    buffer += indent_1;
+    buffer += "\"num_characters\": ";
+    buffer += std::to_string(this->num_characters_);
+    buffer += ",\n";
+    
+    // Encode manufacturing_slots
+    buffer += indent_1;
+    buffer += "\"manufacturing_slots\": ";
+    buffer += std::to_string(this->manufacturing_slots_);
+    buffer += ",\n";
+    
+    // Encode science_slots
+    buffer += indent_1;
+    buffer += "\"science_slots\": ";
+    buffer += std::to_string(this->science_slots_);
+    buffer += ",\n";
+    
+    // Encode capital
+    buffer += indent_1;
+    buffer += "\"capital\": ";
+    buffer += std::to_string(this->capital_);
+    buffer += ",\n";
+    
+    // Encode schedule_hours
+    buffer += indent_1;
+    buffer += "\"schedule_hours\": ";
+    buffer += std::to_string(this->schedule_hours_);
+    buffer += ",\n";
+    
+    // Encode profiles_in
+    buffer += indent_1;
+    buffer += "\"profiles_in\": \"";
+    buffer += this->profiles_in_;
+    buffer += "\",\n";
+    
+    // Encode scenarios_in
+    buffer += indent_1;
+    buffer += "\"scenarios_in\": \"";
+    buffer += this->scenarios_in_;
+    buffer += "\",\n";
+    
+    // Encode sensitivity_out
+    buffer += indent_1;
+    buffer += "\"sensitivity_out\": \"";
+    buffer += this->sensitivity_out_;
+    buffer += "\",\n";
+    
+    // Encode risk_out
+    buffer += indent_1;
+    buffer += "\"risk_out\": \"";
+    buffer += this->risk_out_;
+    buffer += "\",\n";
+    
+    // Encode num_trials
+    buffer += indent_1;
+    buffer += "\"num_trials\": ";
+    buffer += std::to_string(this->num_trials_);
+    buffer += ",\n";
+    
+    // Encode invention_attempts
+    buffer += indent_1;
+    buffer += "\"invention_attempts\": ";
+    buffer += std::to_string(this->invention_attempts_);
+    buffer += ",\n";
+    
+    // Encode seed
+    buffer += indent_1;
+    buffer += "\"seed\": ";
+    buffer += std::to_string(this->seed_);
+    buffer += ",\n";
+    
+    // Encode stargates_in
+    buffer += indent_1;
+    buffer += "\"stargates_in\": \"";
+    buffer += this->stargates_in_;
+    buffer += "\",\n";
+    
+    // Encode topology_in
+    buffer += indent_1;
+    buffer += "\"topology_in\": \"";
+    buffer += this->topology_in_;
+    buffer += "\",\n";
+    
+    // Encode topology_out
+    buffer += indent_1;
+    buffer += "\"topology_out\": \"";
+    buffer += this->topology_out_;
+    buffer += "\",\n";
+    
+    // Encode arbitrage_out
+    buffer += indent_1;
+    buffer += "\"arbitrage_out\": \"";
+    buffer += this->arbitrage_out_;
+    buffer += "\",\n";
+    
+    // Encode num_opportunities
+    buffer += indent_1;
+    buffer += "\"num_opportunities\": ";
+    buffer += std::to_string(this->num_opportunities_);
+    buffer += ",\n";
+    
+    // Encode reprocessing_in
+    buffer += indent_1;
+    buffer += "\"reprocessing_in\": \"";
+    buffer += this->reprocessing_in_;
+    buffer += "\",\n";
+    
+    // Encode reprocess_out
+    buffer += indent_1;
+    buffer += "\"reprocess_out\": \"";
+    buffer += this->reprocess_out_;
+    buffer += "\",\n";
+    
+    // Encode reprocess_yield_percent
+    buffer += indent_1;
+    buffer += "\"reprocess_yield_percent\": ";
+    buffer += std::to_string(this->reprocess_yield_percent_);
+    buffer += "\n";
     
     // It is recommended to not put a newline on the last brace to allow
     // comma chaining when this object is an element of an array.
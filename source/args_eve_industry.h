@@ -8,6 +8,7 @@
 #ifndef HEADER_GUARD_ARGS_EVE_INDUSTRY
 #define HEADER_GUARD_ARGS_EVE_INDUSTRY
 
+#include <cstdint>
 #include <fstream>
 #include <string_view>
 #include <vector>
@@ -19,12 +20,12 @@
 
 namespace args
 {
-
+    
     /// @brief Command line argument parsing and validation for eve_industry
     /// program.
     class eve_industry_t
     {
-        
+            
         public:
             
             /// @brief Specifies the high level operation to be performed by
@@ -37,16 +38,88 @@ namespace args
                 /// * Outputs: --item-attributes-out
                 FETCH_ITEM_ATTRIBUTES,
                 /// Pull market prices for all requested items for all requested
-                /// stations
+                /// stations.  With --blueprints-in, only orders for items which
+                /// some blueprint uses are kept, and large regions are queried
+                /// one item type at a time when that is fewer bytes.  With
+                /// --topology-in or --stargates-in, buy orders placed at other
+                /// stations also count at each requested station within their
+                /// range.
                 /// * Inputs: EvE API, --item-attributes-in, --station-attributes-in
                 /// * Outputs: --prices-out
                 FETCH_PRICES,
                 /// Read market data from a previous FETCH_PRICES operation and
                 /// calculate the ratios on (output material value) / (input material value)
                 /// for each blueprint.
+                /// With --build-intermediates, inputs which can be manufactured
+                /// from another blueprint are built when that is cheaper.
+                /// --runs-per-job sets the size of each manufacturing job.
+                /// --profiles-in applies the skills, structure bonuses and
+                /// taxes of one or more characters.
                 /// * Inputs: --prices-in, --blueprints-in
                 /// * Outputs: --profits-out
                 CALCULATE_BLUEPRINT_PROFITS,
+                /// Append a snapshot of market data from a previous
+                /// FETCH_PRICES operation, plus the daily trade history of
+                /// every item in it, to a @ref market_history_t file.
+                /// * Inputs: EvE API, --prices-in
+                /// * Outputs: --history-out
+                UPDATE_HISTORY,
+                /// Compare the best prices of two FETCH_PRICES snapshots and
+                /// write only what changed.
+                /// * Inputs: --prices-in, --new-prices-in
+                /// * Outputs: --delta-out
+                DIFF_PRICES,
+                /// Bring an old snapshot up to date with a delta written by
+                /// DIFF_PRICES.
+                /// * Inputs: --prices-in, --delta-in
+                /// * Outputs: --prices-out
+                APPLY_PRICE_DELTA,
+                /// Choose how many jobs of which blueprints to run with a
+                /// limited number of job slots and capital, using the results
+                /// of CALCULATE_BLUEPRINT_PROFITS.  With --history-in, jobs
+                /// are capped by how much of each product the market trades.
+                /// * Inputs: --profits-in, --blueprints-in
+                /// * Outputs: --schedule-out
+                SCHEDULE_PRODUCTION,
+                /// Report how the profit of the best decryptor of each
+                /// blueprint at each station changes with the price of each
+                /// item it buys or sells, then re-evaluate the profits with
+                /// each set of prices in --scenarios-in.  Accepts the same
+                /// options as CALCULATE_BLUEPRINT_PROFITS except
+                /// --build-intermediates, and uses the first profile of
+                /// --profiles-in.
+                /// * Inputs: --prices-in, --blueprints-in
+                /// * Outputs: --sensitivity-out
+                PRICE_SENSITIVITY,
+                /// Simulate --trials batches of --invention-attempts
+                /// invention jobs for every T2 blueprint and decryptor at each
+                /// station, reporting the mean, percentiles and probability of
+                /// loss of each.  Accepts the same options as
+                /// PRICE_SENSITIVITY except --decryptor-optimization-strategy.
+                /// * Inputs: --prices-in, --blueprints-in
+                /// * Outputs: --risk-out
+                INVENTION_RISK,
+                /// Find the number of jumps between every pair of solar systems
+                /// and cache them in a @ref universe_topology_t file, which
+                /// FETCH_PRICES maps into memory with --topology-in.
+                /// * Inputs: --stargates-in
+                /// * Outputs: --topology-out
+                BUILD_TOPOLOGY,
+                /// Find the items which can be bought from a sell order at one
+                /// station and sold to a buy order at another for more than
+                /// they cost after sales tax and --hauling-cost-percent, and
+                /// report the best --top pairs.  --history-in weights pairs by
+                /// the volume traded at the destination and --topology-in by
+                /// the jumps between the stations.
+                /// * Inputs: --prices-in
+                /// * Outputs: --arbitrage-out
+                SCAN_ARBITRAGE,
+                /// Value the materials every item reprocesses into at each
+                /// station, at --reprocess-yield-percent, and compare it with
+                /// the item's own best orders there.
+                /// * Inputs: --prices-in, --reprocessing-in
+                /// * Outputs: --reprocess-out
+                EVALUATE_REPROCESSING,
                 /// This must be last.
                 NUM_ENUMS
             };
@@ -125,6 +198,181 @@ namespace args
                 return this->decryptor_optimization_strategy_;
             }
             
+            inline const std::string& stats_out() const
+            {
+                return this->stats_out_;
+            }
+            
+            inline const std::string& trace_out() const
+            {
+                return this->trace_out_;
+            }
+            
+            inline const std::string& history_out() const
+            {
+                return this->history_out_;
+            }
+            
+            inline const std::string& history_in() const
+            {
+                return this->history_in_;
+            }
+            
+            inline unsigned history_days() const
+            {
+                return this->history_days_;
+            }
+            
+            inline uint64_t history_min_volume() const
+            {
+                return this->history_min_volume_;
+            }
+            
+            inline const std::string& new_prices_in() const
+            {
+                return this->new_prices_in_;
+            }
+            
+            inline const std::string& delta_out() const
+            {
+                return this->delta_out_;
+            }
+            
+            inline const std::string& delta_in() const
+            {
+                return this->delta_in_;
+            }
+            
+            inline bool cross_station() const
+            {
+                return this->cross_station_;
+            }
+            
+            inline double hauling_cost_percent() const
+            {
+                return this->hauling_cost_percent_;
+            }
+            
+            inline bool build_intermediates() const
+            {
+                return this->build_intermediates_;
+            }
+            
+            inline unsigned runs_per_job() const
+            {
+                return this->runs_per_job_;
+            }
+            
+            inline const std::string& profits_in() const
+            {
+                return this->profits_in_;
+            }
+            
+            inline const std::string& schedule_out() const
+            {
+                return this->schedule_out_;
+            }
+            
+            inline unsigned num_characters() const
+            {
+                return this->num_characters_;
+            }
+            
+            inline unsigned manufacturing_slots() const
+            {
+                return this->manufacturing_slots_;
+            }
+            
+            inline unsigned science_slots() const
+            {
+                return this->science_slots_;
+            }
+            
+            inline double capital() const
+            {
+                return this->capital_;
+            }
+            
+            inline double schedule_hours() const
+            {
+                return this->schedule_hours_;
+            }
+            
+            inline const std::string& profiles_in() const
+            {
+                return this->profiles_in_;
+            }
+            
+            inline const std::string& scenarios_in() const
+            {
+                return this->scenarios_in_;
+            }
+            
+            inline const std::string& sensitivity_out() const
+            {
+                return this->sensitivity_out_;
+            }
+            
+            inline const std::string& risk_out() const
+            {
+                return this->risk_out_;
+            }
+            
+            inline unsigned num_trials() const
+            {
+                return this->num_trials_;
+            }
+            
+            inline unsigned invention_attempts() const
+            {
+                return this->invention_attempts_;
+            }
+            
+            inline uint64_t seed() const
+            {
+                return this->seed_;
+            }
+            
+            inline const std::string& stargates_in() const
+            {
+                return this->stargates_in_;
+            }
+            
+            inline const std::string& topology_in() const
+            {
+                return this->topology_in_;
+            }
+            
+            inline const std::string& topology_out() const
+            {
+                return this->topology_out_;
+            }
+            
+            inline const std::string& arbitrage_out() const
+            {
+                return this->arbitrage_out_;
+            }
+            
+            inline unsigned num_opportunities() const
+            {
+                return this->num_opportunities_;
+            }
+            
+            inline const std::string& reprocessing_in() const
+            {
+                return this->reprocessing_in_;
+            }
+            
+            inline const std::string& reprocess_out() const
+            {
+                return this->reprocess_out_;
+            }
+            
+            inline double reprocess_yield_percent() const
+            {
+                return this->reprocess_yield_percent_;
+            }
+            
             // Add more operators here if desired.
             
             /// @brief Extract arguments from the command line and validate them.
@@ -284,6 +532,145 @@ namespace args
             /// @brief See @ref blueprint_profit_t::sort_strategy_t
             blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy_;
             
+            /// @brief Optional filename of a JSON file to write
+            /// @ref stats_t "counters and stage timings" to when the program
+            /// exits.  Empty if statistics should not be collected.
+            std::string stats_out_;
+            
+            /// @brief Optional filename of a Chrome Trace Event JSON file to
+            /// write a @ref trace_t "per-thread timeline" to when the program
+            /// exits.  Empty if tracing is disabled.
+            std::string trace_out_;
+            
+            /// @brief Filename of a @ref market_history_t file to append to.
+            /// Created if it doesn't exist.
+            std::string history_out_;
+            
+            /// @brief Optional filename of a @ref market_history_t file.  If
+            /// present, sell prices are replaced by averages over the last
+            /// @ref history_days_ days before profits are calculated.
+            std::string history_in_;
+            
+            /// @brief Length of the averaging window used with
+            /// @ref history_in_.
+            unsigned history_days_;
+            
+            /// @brief Items which traded fewer units per day than this over
+            /// the averaging window are treated as having no market.
+            uint64_t history_min_volume_;
+            
+            /// @brief Newer of the two price files compared by DIFF_PRICES mode.
+            std::string new_prices_in_;
+            
+            /// @brief Where DIFF_PRICES mode writes the @ref price_delta_t between
+            /// --prices-in and --new-prices-in.
+            std::string delta_out_;
+            
+            /// @brief A @ref price_delta_t which APPLY_PRICE_DELTA mode applies to
+            /// --prices-in.
+            std::string delta_in_;
+            
+            /// @brief If true, CALCULATE_BLUEPRINT_PROFITS buys each material and
+            /// sells each product at whichever station is best instead of only
+            /// at the station being evaluated.
+            bool cross_station_;
+            
+            /// @brief Cost of moving goods between stations in --cross-station mode,
+            /// as a percentage of their value.
+            double hauling_cost_percent_;
+            
+            /// @brief True to build intermediate materials from their own blueprints
+            /// whenever that is cheaper than buying them, see @ref
+            /// build_tree_t.
+            bool build_intermediates_;
+            
+            /// @brief Number of runs in each manufacturing job evaluated by
+            /// CALCULATE_BLUEPRINT_PROFITS.  Invented blueprints are limited to
+            /// the runs of one copy.
+            unsigned runs_per_job_;
+            
+            /// @brief A @ref galactic_profits_t from CALCULATE_BLUEPRINT_PROFITS which
+            /// SCHEDULE_PRODUCTION allocates job slots to.
+            std::string profits_in_;
+            
+            /// @brief Where SCHEDULE_PRODUCTION writes the chosen @ref
+            /// production_schedule_t.
+            std::string schedule_out_;
+            
+            /// @brief Number of characters whose job slots SCHEDULE_PRODUCTION fills.
+            unsigned num_characters_;
+            
+            /// @brief Manufacturing slots of each character for SCHEDULE_PRODUCTION.
+            unsigned manufacturing_slots_;
+            
+            /// @brief Science slots of each character for SCHEDULE_PRODUCTION.
+            unsigned science_slots_;
+            
+            /// @brief ISK available to SCHEDULE_PRODUCTION for materials, or 0 for no
+            /// limit.
+            double capital_;
+            
+            /// @brief Length of the schedule made by SCHEDULE_PRODUCTION, in hours.
+            double schedule_hours_;
+            
+            /// @brief Optional path to an @ref industry_profiles_t file.  Profits are
+            /// calculated once per profile.
+            std::string profiles_in_;
+            
+            /// @brief Path to a price_scenarios_t file of price overrides to try.
+            /// Optional for PRICE_SENSITIVITY mode.
+            std::string scenarios_in_;
+            
+            /// @brief Path to write a price_sensitivity_t report to.  Required for
+            /// PRICE_SENSITIVITY mode.
+            std::string sensitivity_out_;
+            
+            /// @brief Path to write an invention_risk_t report to.  Required for
+            /// INVENTION_RISK mode.
+            std::string risk_out_;
+            
+            /// @brief Number of batches of invention jobs INVENTION_RISK simulates.
+            unsigned num_trials_;
+            
+            /// @brief Invention jobs started by each batch INVENTION_RISK simulates.
+            unsigned invention_attempts_;
+            
+            /// @brief Seed of the random numbers INVENTION_RISK draws.
+            uint64_t seed_;
+            
+            /// @brief Path to a JSON file of stargate connections.  Required
+            /// by BUILD_TOPOLOGY.  If given, FETCH_PRICES counts buy orders at
+            /// other stations within range of each station in
+            /// --station-attributes-in.
+            std::string stargates_in_;
+            
+            /// @brief Optional path to a universe_topology_t binary file written by
+            /// BUILD_TOPOLOGY.  FETCH_PRICES uses it instead of --stargates-in
+            /// to count buy orders at other stations within range of each
+            /// station in --station-attributes-in.
+            std::string topology_in_;
+            
+            /// @brief Path to the universe_topology_t binary file BUILD_TOPOLOGY
+            /// writes.
+            std::string topology_out_;
+            
+            /// @brief Path to the arbitrage_scan_t report written by SCAN_ARBITRAGE.
+            std::string arbitrage_out_;
+            
+            /// @brief Number of opportunities SCAN_ARBITRAGE reports.
+            unsigned num_opportunities_;
+            
+            /// @brief Path to the reprocessing_t materials file read by
+            /// EVALUATE_REPROCESSING.
+            std::string reprocessing_in_;
+            
+            /// @brief Path to the reprocess_values_t report written by
+            /// EVALUATE_REPROCESSING.
+            std::string reprocess_out_;
+            
+            /// @brief Percentage of each material EVALUATE_REPROCESSING recovers.
+            double reprocess_yield_percent_;
+            
     };
     
 } // Namespace args
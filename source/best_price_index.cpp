@@ -0,0 +1,137 @@
+/// @file best_price_index.cpp
+/// @brief Implementation of @ref best_price_index_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+#include "best_price_index.h"
+#include "error.h"
+#include "galactic_market.h"
+#include "item_market.h"
+#include "item_quantities.h"
+#include "item_quantity.h"
+#include "regional_market.h"
+#include "station_market.h"
+
+/// @brief Message of the exception thrown when an item can't be priced.
+static std::string no_orders_message(uint64_t item_id)
+{
+    std::string message("Error.  Could not find an order to trade item with id ");
+    message += std::to_string(item_id);
+    message += " at any station.";
+    return message;
+}
+
+void best_price_index_t::initialize_from_market(const galactic_market_t& galactic_market)
+{
+    
+    this->items_.clear();
+    float infinity = std::numeric_limits<float>::infinity();
+    
+    // One pass over every order in the galaxy
+    for (const std::pair<const uint64_t, regional_market_t>& cur_region : galactic_market.regions())
+    {
+        for (const std::pair<const uint64_t, station_market_t>& cur_station : cur_region.second.stations())
+        {
+            
+            uint64_t station_id = cur_station.first;
+            for (const std::pair<const uint64_t, item_market_t>& cur_item : cur_station.second.items())
+            {
+                
+                std::pair<std::unordered_map<uint64_t, entry_t>::iterator, bool> found = this->items_.try_emplace
+                (
+                    cur_item.first,
+                    entry_t{infinity, 0, -infinity, 0}
+                );
+                entry_t& entry = found.first->second;
+                
+                if (!cur_item.second.sell_orders().empty())
+                {
+                    float min_sell_order = cur_item.second.min_sell_order();
+                    if (min_sell_order < entry.min_sell_order)
+                    {
+                        entry.min_sell_order = min_sell_order;
+                        entry.min_sell_station_id = station_id;
+                    }
+                }
+                
+                if (!cur_item.second.buy_orders().empty())
+                {
+                    float max_buy_order = cur_item.second.max_buy_order();
+                    if (max_buy_order > entry.max_buy_order)
+                    {
+                        entry.max_buy_order = max_buy_order;
+                        entry.max_buy_station_id = station_id;
+                    }
+                }
+                
+            }
+            
+        }
+    }
+    
+}
+
+float best_price_index_t::price(uint64_t item_id, const station_market_t& home, side_t side) const
+{
+    
+    std::unordered_map<uint64_t, entry_t>::const_iterator entry = this->items_.find(item_id);
+    if (entry == this->items_.end())
+        throw error_message_t(error_code_t::NO_ORDERS, no_orders_message(item_id));
+    
+    station_market_t::item_map_t::const_iterator local = home.items().find(item_id);
+    bool has_local = local != home.items().end() && !local->second.sell_orders().empty();
+    if (side == side_t::BUY)
+    {
+        
+        // If the cheapest station is home, the home price is at least as
+        // good as the hauled price so no special case is needed.
+        float hauled = entry->second.min_sell_order * (1.0f + this->hauling_cost_);
+        float best = has_local ? std::min(local->second.min_sell_order(), hauled) : hauled;
+        if (std::isinf(best))
+            throw error_message_t(error_code_t::NO_ORDERS, no_orders_message(item_id));
+        return best;
+        
+    } else {
+        
+        // Selling into a buy order at home needs no hauling
+        float hauled = entry->second.max_buy_order;
+        if (entry->second.max_buy_station_id != home.station_id())
+            hauled *= 1.0f - this->hauling_cost_;
+        float best = has_local ? std::max(local->second.min_sell_order(), hauled) : hauled;
+        if (std::isinf(best))
+            throw error_message_t(error_code_t::NO_ORDERS, no_orders_message(item_id));
+        return best;
+        
+    }
+    
+}
+
+float best_price_index_t::total_value
+(
+    const item_quantities_t& materials,
+    const station_market_t& home,
+    side_t side,
+    unsigned material_efficiency,
+    unsigned runs,
+    float material_multiplier
+) const {
+    
+    float accumulator = 0.0f;
+    for (const item_quantity_t& cur_item_quantity : materials.materials_list())
+    {
+        uint64_t rounded_modified_materials = item_quantities_t::batch_quantity(cur_item_quantity.quantity(), material_efficiency, runs, material_multiplier);
+        accumulator += float(rounded_modified_materials) * this->price(cur_item_quantity.item_id(), home, side);
+    }
+    
+    return accumulator;
+    
+}
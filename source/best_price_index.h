@@ -0,0 +1,139 @@
+/// @file best_price_index.h
+/// @brief Declaration of @ref best_price_index_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_BEST_PRICE_INDEX
+#define HEADER_GUARD_BEST_PRICE_INDEX
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "error.h"
+
+class galactic_market_t;
+class item_quantities_t;
+class station_market_t;
+
+/// @brief The best station anywhere in the galaxy to buy or sell each item.
+///
+/// Built once from a @ref galactic_market_t so that cross-station profit
+/// calculations can find the best source for every material with one hash
+/// lookup instead of searching every station for every blueprint.
+///
+/// Hauling is charged as a fraction of the value of the goods, the way
+/// courier contracts are usually priced.  Because it doesn't depend on the
+/// route, the best remote station for an item is the same from every home
+/// station, so a single global extreme per item is enough.
+class best_price_index_t
+{
+        
+    public:
+        
+        /// @brief Which side of a blueprint a price is needed for.
+        enum class side_t : uint32_t
+        {
+            /// Input materials are bought at the lowest sell order.
+            BUY,
+            /// Products are listed at home at its lowest sell order, or
+            /// hauled to and sold into the highest buy order elsewhere.
+            SELL,
+            /// This must be last
+            NUM_ENUMS
+        };
+        
+        /// @brief Best prices of one item across all stations.
+        struct entry_t
+        {
+            /// @brief Lowest sell order at any station, or infinity if there
+            /// are none.
+            float min_sell_order;
+            uint64_t min_sell_station_id;
+            /// @brief Highest buy order at any station, or minus infinity if
+            /// there are none.  Unlike a remote sell order, this is a price
+            /// somebody is actually paying, so hauled products are valued at
+            /// it.
+            float max_buy_order;
+            uint64_t max_buy_station_id;
+        };
+        
+        /// @brief Default constructor
+        inline best_price_index_t()
+          : hauling_cost_(0.0f)
+        {
+            // All work done in initializer list
+        }
+        
+        // Add member read and write functions
+        
+        inline const std::unordered_map<uint64_t, entry_t>& items() const
+        {
+            return this->items_;
+        }
+        
+        /// @brief Cost of hauling goods between two stations as a fraction of
+        /// their value, for example 0.02 for 2%.
+        inline float hauling_cost() const
+        {
+            return this->hauling_cost_;
+        }
+        
+        inline void hauling_cost(float new_hauling_cost)
+        {
+            this->hauling_cost_ = new_hauling_cost;
+        }
+        
+        // Add special-purpose functions here
+        
+        inline void clear()
+        {
+            this->items_.clear();
+        }
+        
+        /// @brief Find the best prices of every item in galactic_market,
+        /// clearing previous content.
+        void initialize_from_market(const galactic_market_t& galactic_market);
+        
+        /// @brief Price of one unit of an item for a blueprint built at home,
+        /// either bought at home or hauled in from the cheapest station for
+        /// @ref side_t::BUY, or listed at home or hauled out to the highest
+        /// buy order for @ref side_t::SELL.
+        ///
+        /// @exception error_message_t if there is no order to buy from or
+        /// sell into.
+        float price(uint64_t item_id, const station_market_t& home, side_t side) const;
+        
+        /// @brief Combined ISK value of a job's worth of materials, each
+        /// priced with @ref price.  Quantities are rounded the same way as
+        /// @ref item_quantities_t::total_sell_value.
+        ///
+        /// @exception error_message_t
+        float total_value
+        (
+            const item_quantities_t& materials,
+            /// [in] Station where the blueprint is run.
+            const station_market_t& home,
+            side_t side,
+            /// [in] Ranges from [0 to 10].
+            unsigned material_efficiency,
+            /// [in] Number of runs in one manufacturing job.
+            unsigned runs = 1,
+            /// [in] See @ref item_quantities_t::batch_quantity.
+            float material_multiplier = 1.0f
+        ) const;
+        
+    protected:
+        
+        /// @brief See @ref entry_t.  Items with no orders at any station are
+        /// left out.
+        std::unordered_map<uint64_t, entry_t> items_;
+        
+        /// @brief See @ref hauling_cost.
+        float hauling_cost_;
+        
+};
+
+#endif // Header Guard
+
@@ -1,33 +1,122 @@
 /// @file blueprint_converter.cpp
 /// Program entry point for blueprint_converter utility.
-///
+/// 
 /// * Contact conor.gardner@arm.com if you have questions about this code.
 /// * Date Created = Wednesday December 6 2017
 /// * Documentation is generated by doxygen, see html/index.html
 
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <omp.h>
+#include <sstream>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "args_blueprint_converter.h"
 #include "blueprints.h"
 #include "error.h"
+#include "item_quantities.h"
+#include "item_quantity.h"
+#include "reprocessing.h"
+#include "universe_topology.h"
 #include "yaml-cpp/yaml.h"
 
+/// @brief Split CCP's blueprint YAML into chunks of whole top level map
+/// entries, so that each chunk can be parsed on its own core.
+///
+/// Every key of the top level map starts in the first column and everything
+/// belonging to it is indented, so a new entry starts at every line which
+/// doesn't begin with whitespace, a comment, or a document marker.  Text
+/// before the first entry is dropped.
+std::vector<std::string_view> split_top_level_entries(std::string_view buffer)
+{
+    
+    std::vector<std::string_view> chunks;
+    
+    std::string_view::size_type chunk_start = std::string_view::npos;
+    for (std::string_view::size_type line_start = 0, size = buffer.size(); line_start < size;)
+    {
+        
+        char first = buffer[line_start];
+        if (first != ' ' && first != '\t' && first != '\r' && first != '\n' && first != '#' && first != '-' && first != '.')
+        {
+            if (chunk_start != std::string_view::npos)
+                chunks.push_back(buffer.substr(chunk_start, line_start - chunk_start));
+            chunk_start = line_start;
+        }
+        
+        std::string_view::size_type line_end = buffer.find('\n', line_start);
+        if (line_end == std::string_view::npos)
+            break;
+        line_start = line_end + 1;
+        
+    }
+    if (chunk_start != std::string_view::npos)
+        chunks.push_back(buffer.substr(chunk_start));
+    
+    return chunks;
+    
+}
+
+/// @brief Read a YAML file whose root is a map, and parse each chunk of top
+/// level entries into its own small tree in parallel rather than building one
+/// tree for the whole file on one core.
+///
+/// @return The tree of each chunk, in input order.  Each is a map.
+///
+/// @exception error_message_t
+std::vector<YAML::Node> load_top_level_map(const std::string& path, std::string_view arg_name)
+{
+    
+    // Read the entire input file into RAM at once
+    std::ifstream file(path, std::ios::binary);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_READ_FAILED, "Error.  Failed to open \"" + path + "\" for reading.\n");
+    std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    
+    // The trees hold their own copies of the text
+    std::vector<std::string_view> chunks = split_top_level_entries(buffer);
+    unsigned num_chunks = chunks.size();
+    std::vector<YAML::Node> chunk_roots(num_chunks);
+    std::vector<std::string> parse_errors(num_chunks);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (unsigned ix = 0; ix < num_chunks; ix++)
+    {
+        try
+        {
+            chunk_roots[ix] = YAML::Load(std::string(chunks[ix]));
+        } catch (const YAML::Exception& error) {
+            parse_errors[ix] = error.what();
+        }
+    }
+    for (const std::string& cur_parse_error : parse_errors)
+    {
+        if (!cur_parse_error.empty())
+            throw error_message_t(error_code_t::YAML_SYNTAX_ERROR, "Error.  Failed to parse " + std::string(arg_name) + ".  " + cur_parse_error + '\n');
+    }
+    for (const YAML::Node& cur_chunk_root : chunk_roots)
+    {
+        if (!cur_chunk_root.IsMap())
+            throw error_message_t(error_code_t::YAML_SCHEMA_VIOLATION, "Error.  " + std::string(arg_name) + " was not of type \"map\".");
+    }
+    
+    return chunk_roots;
+    
+}
+
 // Generates a mapping of T2 blueprints to the T1 blueprint they were invented
 // from.
-std::unordered_map<uint64_t, uint64_t> generate_invention_back_map(const YAML::Node& ccp_yaml_in)
+std::unordered_map<uint64_t, uint64_t> generate_invention_back_map(const std::vector<YAML::const_iterator>& ccp_yaml_in)
 {
     
-    // Validate top-level node type
-    if (!ccp_yaml_in.IsMap())
-        throw error_message_t(error_code_t::YAML_SCHEMA_VIOLATION, "Error.  ccp_yaml_in was not of type \"map\".");
-    
     // Initial allocation for return value
     std::unordered_map<uint64_t, uint64_t> invention_back_map;
     
     // Iterate through each input blueprint
-    for (YAML::const_iterator cur_node = ccp_yaml_in.begin(), end = ccp_yaml_in.end(); cur_node != end; cur_node++)
+    for (const YAML::const_iterator& cur_node : ccp_yaml_in)
     {
         
         // Decode ID of current T1 blueprint
@@ -179,14 +268,19 @@ bool convert_item_quantities
 
 /// @brief Copy fields from a YAML blueprint to eve_industry's blueprint format.
 ///
+/// Only reads its inputs, so many blueprints can be converted at once.
+/// Warnings are written to warnings rather than std::cerr so that they can be
+/// printed in input order afterwards.
+///
 /// @return True if the output blueprint was written successfully.  If false
 /// is returned, then the output_blueprint may be full of garbage.
 bool convert_blueprint
 (
     const YAML::const_iterator& input_blueprint,
-    const YAML::Node& all_blueprints,
+    const std::unordered_map<uint64_t, YAML::Node>& all_blueprints,
     const std::unordered_map<uint64_t, uint64_t>& invention_back_map,
-    blueprint_t& output_blueprint
+    blueprint_t& output_blueprint,
+    std::ostream& warnings
 ){
     
     blueprint_t::manufacture_t& manufacture = output_blueprint.manufacture();
@@ -199,7 +293,7 @@ bool convert_blueprint
     const YAML::Node& yaml_cur_blueprint_id = input_blueprint->first;
     if (!yaml_cur_blueprint_id.IsScalar())
     {
-        std::cerr << "Error, key in blueprint map was not a scalar.\n";
+        warnings << "Error, key in blueprint map was not a scalar.\n";
         return false;
     }
     uint64_t cur_blueprint_id = yaml_cur_blueprint_id.as<uint64_t>();
@@ -209,7 +303,7 @@ bool convert_blueprint
     const YAML::Node& yaml_cur_blueprint_root = input_blueprint->second;
     if (!yaml_cur_blueprint_root.IsMap())
     {
-        std::cerr << "Warning.  Blueprint " << cur_blueprint_id << " was not of type \"map\".  Skipping.\n";
+        warnings << "Warning.  Blueprint " << cur_blueprint_id << " was not of type \"map\".  Skipping.\n";
         return false;
     }
     
@@ -217,10 +311,10 @@ bool convert_blueprint
     const YAML::Node& yaml_cur_blueprint_activities = yaml_cur_blueprint_root["activities"];
     if (!yaml_cur_blueprint_activities.IsDefined())
     {
-        std::cerr << "Warning.  Blueprint " << cur_blueprint_id << " did not contain key \"activities\".  Skipping.\n";
+        warnings << "Warning.  Blueprint " << cur_blueprint_id << " did not contain key \"activities\".  Skipping.\n";
         return false;
     } else if (!yaml_cur_blueprint_activities.IsMap()) {
-        std::cerr << "Warning.  Blueprint " << cur_blueprint_id << "->activities was not of type \"map\".  Skipping.\n";
+        warnings << "Warning.  Blueprint " << cur_blueprint_id << "->activities was not of type \"map\".  Skipping.\n";
         return false;
     }
     
@@ -230,10 +324,10 @@ bool convert_blueprint
     const YAML::Node& yaml_cur_blueprint_manufacture = yaml_cur_blueprint_activities["manufacturing"];
     if (!yaml_cur_blueprint_manufacture.IsDefined())
     {
-        std::cerr << "Warning.  Blueprint " << cur_blueprint_id << "->activities did not contain key \"manufacturing\".  Skipping.\n";
+        warnings << "Warning.  Blueprint " << cur_blueprint_id << "->activities did not contain key \"manufacturing\".  Skipping.\n";
         return false;
     } else if (!yaml_cur_blueprint_manufacture.IsMap()) {
-        std::cerr << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing was not of type \"map\".  Skipping.\n";
+        warnings << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing was not of type \"map\".  Skipping.\n";
         return false;
     }
     
@@ -241,10 +335,10 @@ bool convert_blueprint
     const YAML::Node& yaml_cur_manufacture_time = yaml_cur_blueprint_manufacture["time"];
     if (!yaml_cur_manufacture_time.IsDefined())
     {
-        std::cerr << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing did not contain key \"time\".  Skipping.\n";
+        warnings << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing did not contain key \"time\".  Skipping.\n";
         return false;
     } else if (!yaml_cur_manufacture_time.IsScalar()) {
-        std::cerr << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing->time was not of type \"scalar\".  Skipping.\n";
+        warnings << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing->time was not of type \"scalar\".  Skipping.\n";
         return false;
     }
     manufacture.time(yaml_cur_manufacture_time.as<uint64_t>());
@@ -253,10 +347,10 @@ bool convert_blueprint
     const YAML::Node& yaml_cur_manufacture_materials = yaml_cur_blueprint_manufacture["materials"];
     if (!yaml_cur_manufacture_materials.IsDefined())
     {
-        std::cerr << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing did not contain key \"materials\".  Skipping.\n";
+        warnings << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing did not contain key \"materials\".  Skipping.\n";
         return false;
     } else if (!convert_item_quantities(yaml_cur_manufacture_materials, manufacture.input_materials())) {
-        std::cerr << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing->materials could not be parsed.  Skipping.\n";
+        warnings << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing->materials could not be parsed.  Skipping.\n";
         return false;
     }
     
@@ -264,10 +358,10 @@ bool convert_blueprint
     const YAML::Node& yaml_cur_manufacture_products = yaml_cur_blueprint_manufacture["products"];
     if (!yaml_cur_manufacture_products.IsDefined())
     {
-        std::cerr << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing did not contain key \"products\".  Skipping.\n";
+        warnings << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing did not contain key \"products\".  Skipping.\n";
         return false;
     } else if (!convert_item_quantities(yaml_cur_manufacture_products, manufacture.output_materials())) {
-        std::cerr << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing->products could not be parsed.  Skipping.\n";
+        warnings << "Warning.  Blueprint " << cur_blueprint_id << "->activities->manufacturing->products could not be parsed.  Skipping.\n";
         return false;
     }
     
@@ -295,10 +389,10 @@ bool convert_blueprint
         const YAML::Node& yaml_cur_copying_time = yaml_cur_blueprint_copying["time"];
         if (!yaml_cur_copying_time.IsDefined())
         {
-            std::cerr << "Warning.  Blueprint " << cur_blueprint_id << "->activities->copying did not contain key \"time\".  Skipping.\n";
+            warnings << "Warning.  Blueprint " << cur_blueprint_id << "->activities->copying did not contain key \"time\".  Skipping.\n";
             return false;
         } else if (!yaml_cur_copying_time.IsScalar()) {
-            std::cerr << "Warning.  Blueprint " << cur_blueprint_id << "->activities->copying->time was not of type \"scalar\".  Skipping.\n";
+            warnings << "Warning.  Blueprint " << cur_blueprint_id << "->activities->copying->time was not of type \"scalar\".  Skipping.\n";
             return false;
         }
         copy.time(yaml_cur_copying_time.as<uint64_t>());
@@ -309,7 +403,7 @@ bool convert_blueprint
         {
             if (!convert_item_quantities(yaml_cur_copying_materials, copy.input_materials()))
             {
-                std::cerr << "Warning.  Blueprint " << cur_blueprint_id << "->activities->copying->materials could not be parsed.  Skipping.\n";
+                warnings << "Warning.  Blueprint " << cur_blueprint_id << "->activities->copying->materials could not be parsed.  Skipping.\n";
                 return false;
             }
         } else {
@@ -329,10 +423,10 @@ bool convert_blueprint
         // The input YAML attaches invention info on the input T1 blueprint
         // The output JSON attaches invention info on the output T2 blueprint
         uint64_t cur_t1_id = cur_invention_dependency->second;
-        const YAML::Node& yaml_cur_t1_input_root = all_blueprints[cur_t1_id];
-        if (!yaml_cur_t1_input_root.IsDefined())
+        const std::unordered_map<uint64_t, YAML::Node>::const_iterator yaml_cur_t1_input = all_blueprints.find(cur_t1_id);
+        if (yaml_cur_t1_input == all_blueprints.end())
         {
-            std::cerr
+            warnings
              << "Error.  Could not find T1 blueprint with ID "
              << cur_t1_id
              << " required to invent T2 blueprint with ID "
@@ -340,13 +434,14 @@ bool convert_blueprint
              << ".\n";
             return false;
         }
+        const YAML::Node& yaml_cur_t1_input_root = yaml_cur_t1_input->second;
         invent.invented_from_blueprint_id(cur_t1_id);
         
         // Parse YAML T1 -> activities
         const YAML::Node& yaml_cur_t1_input_activities = yaml_cur_t1_input_root["activities"];
         if (!yaml_cur_t1_input_activities.IsDefined())
         {
-            std::cerr
+            warnings
              << "Warning.  Blueprint T1 blueprint "
              << cur_t1_id
              << " required to invent T2 blueprint "
@@ -354,7 +449,7 @@ bool convert_blueprint
              << " did not contain field \"activities\".  Skipping T2.\n";
             return false;
         } else if (!yaml_cur_t1_input_activities.IsMap()) {
-            std::cerr
+            warnings
              << "Warning.  Blueprint T1 blueprint "
              << cur_t1_id
              << "->activities required to invent T2 blueprint "
@@ -367,7 +462,7 @@ bool convert_blueprint
         const YAML::Node& yaml_cur_t1_input_invention = yaml_cur_t1_input_activities["invention"];
         if (!yaml_cur_t1_input_invention.IsDefined())
         {
-            std::cerr
+            warnings
              << "Warning.  Blueprint T1 blueprint "
              << cur_t1_id
              << " required to invent T2 blueprint "
@@ -375,7 +470,7 @@ bool convert_blueprint
              << " did not contain field \"activities->invention\".  Skipping T2.\n";
             return false;
         } else if (!yaml_cur_t1_input_invention.IsMap()) {
-            std::cerr
+            warnings
              << "Warning.  Blueprint T1 blueprint "
              << cur_t1_id
              << "->activities->invention required to invent T2 blueprint "
@@ -388,7 +483,7 @@ bool convert_blueprint
         const YAML::Node& yaml_cur_t1_input_time = yaml_cur_t1_input_invention["time"];
         if (!yaml_cur_t1_input_time.IsDefined())
         {
-            std::cerr
+            warnings
              << "Warning.  Blueprint T1 blueprint "
              << cur_t1_id
              << " required to invent T2 blueprint "
@@ -396,7 +491,7 @@ bool convert_blueprint
              << " did not contain field \"activities->invention->time\".  Skipping T2.\n";
             return false;
         } else if (!yaml_cur_t1_input_time.IsScalar()) {
-            std::cerr
+            warnings
              << "Warning.  Blueprint T1 blueprint "
              << cur_t1_id
              << "->activities->invention->time required to invent T2 blueprint "
@@ -410,7 +505,7 @@ bool convert_blueprint
         const YAML::Node& yaml_cur_t1_input_materials = yaml_cur_t1_input_invention["materials"];
         if (!yaml_cur_t1_input_materials.IsDefined())
         {
-            std::cerr
+            warnings
              << "Warning.  Blueprint T1 blueprint "
              << cur_t1_id
              << " required to invent T2 blueprint "
@@ -418,7 +513,7 @@ bool convert_blueprint
              << " did not contain field \"activities->invention->materials\".  Skipping T2.\n";
             return false;
         } else if (!convert_item_quantities(yaml_cur_t1_input_materials, invent.input_materials())) {
-            std::cerr
+            warnings
              << "Warning.  Blueprint T1 blueprint "
              << cur_t1_id
              << " required to invent T2 blueprint "
@@ -434,10 +529,10 @@ bool convert_blueprint
         const YAML::Node& yaml_cur_blueprint_max_production_limit = yaml_cur_blueprint_root["maxProductionLimit"];
         if (!yaml_cur_blueprint_max_production_limit.IsDefined())
         {
-            std::cerr << "Warning.  Blueprint " << cur_blueprint_id << " did not contain key \"maxProductionLimit\".  Skipping.\n";
+            warnings << "Warning.  Blueprint " << cur_blueprint_id << " did not contain key \"maxProductionLimit\".  Skipping.\n";
             return false;
         } else if (!yaml_cur_blueprint_max_production_limit.IsScalar()) {
-            std::cerr << "Warning.  Blueprint " << cur_blueprint_id << "->maxProductionLimit was not of type \"scalar\".  Skipping.\n";
+            warnings << "Warning.  Blueprint " << cur_blueprint_id << "->maxProductionLimit was not of type \"scalar\".  Skipping.\n";
             return false;
         }
         invent.runs(yaml_cur_blueprint_max_production_limit.as<uint64_t>());
@@ -446,7 +541,7 @@ bool convert_blueprint
         const YAML::Node& yaml_cur_t1_input_products = yaml_cur_t1_input_invention["products"];
         if (!yaml_cur_t1_input_products.IsDefined())
         {
-            std::cerr
+            warnings
              << "Warning.  Blueprint T1 blueprint "
              << cur_t1_id
              << " required to invent T2 blueprint "
@@ -454,7 +549,7 @@ bool convert_blueprint
              << " did not contain field \"activities->invention->products\".  Skipping T2.\n";
             return false;
         } else if (!yaml_cur_t1_input_products.IsSequence()) {
-            std::cerr
+            warnings
              << "Warning.  Blueprint T1 blueprint "
              << cur_t1_id
              << "->activities->invention->products required to invent T2 blueprint "
@@ -473,7 +568,7 @@ bool convert_blueprint
             // Parse  YAML root -> activities -> invention -> products[product_ix]
             if (!yaml_cur_product.IsMap())
             {
-                std::cerr
+                warnings
                  << "Warning.  Blueprint T1 blueprint "
                  << cur_t1_id
                  << "activities->invention->products["
@@ -488,7 +583,7 @@ bool convert_blueprint
             const YAML::Node yaml_cur_product_type_id = yaml_cur_product["typeID"];
             if (!yaml_cur_product_type_id.IsDefined())
             {
-                std::cerr
+                warnings
                  << "Warning.  Blueprint T1 blueprint "
                  << cur_t1_id
                  << "activities->invention->products["
@@ -507,7 +602,7 @@ bool convert_blueprint
                 const YAML::Node& yaml_cur_probability = yaml_cur_product["probability"];
                 if (!yaml_cur_probability.IsDefined())
                 {
-                    std::cerr
+                    warnings
                      << "Warning.  Blueprint T1 blueprint "
                      << cur_t1_id
                      << " required to invent T2 blueprint "
@@ -517,7 +612,7 @@ bool convert_blueprint
                      << "]->probability\".  Skipping T2.\n";
                     return false;
                 } else if (!yaml_cur_probability.IsScalar()) {
-                    std::cerr
+                    warnings
                      << "Warning.  Blueprint T1 blueprint "
                      << cur_t1_id
                      << "->activities->invention->products["
@@ -538,7 +633,7 @@ bool convert_blueprint
         }
         if (!probability_found)
         {
-            std::cerr
+            warnings
              << "Warning.  Blueprint T1 blueprint "
              << cur_t1_id
              << "->activities->invention->products did not contain element with typeID"
@@ -557,6 +652,125 @@ bool convert_blueprint
     
 }
 
+/// @brief Convert CCP's list of stargate jumps, which names each gate from
+/// both ends, into a stargates file for eve_industry.
+///
+/// @exception error_message_t
+void convert_stargates(const std::string& ccp_jumps_in, const std::string& stargates_out)
+{
+    
+    YAML::Node ccp_jumps;
+    try
+    {
+        ccp_jumps = YAML::LoadFile(ccp_jumps_in);
+    } catch (const YAML::BadFile&) {
+        throw error_message_t(error_code_t::FILE_READ_FAILED, "Error.  Failed to open \"" + ccp_jumps_in + "\" for reading.\n");
+    } catch (const YAML::Exception& error) {
+        throw error_message_t(error_code_t::YAML_SYNTAX_ERROR, "Error.  Failed to parse ccp_jumps_in.  " + std::string(error.what()) + '\n');
+    }
+    if (!ccp_jumps.IsSequence())
+        throw error_message_t(error_code_t::YAML_SCHEMA_VIOLATION, "Error.  ccp_jumps_in was not of type \"sequence\".\n");
+    
+    universe_topology_t topology;
+    for (const YAML::Node& cur_jump : ccp_jumps)
+    {
+        const YAML::Node from_system_id = cur_jump["fromSolarSystemID"];
+        const YAML::Node from_region_id = cur_jump["fromRegionID"];
+        const YAML::Node to_system_id = cur_jump["toSolarSystemID"];
+        const YAML::Node to_region_id = cur_jump["toRegionID"];
+        if (!from_system_id.IsScalar() || !from_region_id.IsScalar() || !to_system_id.IsScalar() || !to_region_id.IsScalar())
+            throw error_message_t(error_code_t::YAML_SCHEMA_VIOLATION, "Error.  ccp_jumps_in/<jump> is missing fromSolarSystemID, fromRegionID, toSolarSystemID or toRegionID.\n");
+        topology.add_system(from_system_id.as<uint64_t>(), from_region_id.as<uint64_t>());
+        topology.add_system(to_system_id.as<uint64_t>(), to_region_id.as<uint64_t>());
+        topology.add_stargate(from_system_id.as<uint64_t>(), to_system_id.as<uint64_t>());
+    }
+    
+    std::cerr << topology.num_systems() << " solar systems with stargates.\n";
+    
+    std::ofstream stargates_out_file(stargates_out);
+    if (!stargates_out_file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to open \"" + stargates_out + "\" for writing.\n");
+    stargates_out_file << topology << '\n';
+    
+}
+
+/// @brief Convert CCP's list of the materials each item type reprocesses
+/// into, and optionally the portion size of each type, into a reprocessing
+/// file for eve_industry.
+///
+/// @exception error_message_t
+void convert_reprocessing(const std::string& ccp_materials_in, const std::string& ccp_types_in, const std::string& reprocessing_out)
+{
+    
+    // Only portionSize is kept from the much larger types file
+    std::unordered_map<uint64_t, unsigned> portion_sizes;
+    if (!ccp_types_in.empty())
+    {
+        for (const YAML::Node& cur_chunk_root : load_top_level_map(ccp_types_in, "ccp_types_in"))
+        {
+            for (YAML::const_iterator cur_type = cur_chunk_root.begin(), end = cur_chunk_root.end(); cur_type != end; cur_type++)
+            {
+                const YAML::Node portion_size = cur_type->second["portionSize"];
+                if (portion_size.IsDefined() && portion_size.IsScalar() && portion_size.as<unsigned>() > 1)
+                    portion_sizes.emplace(cur_type->first.as<uint64_t>(), portion_size.as<unsigned>());
+            }
+        }
+    }
+    
+    reprocessing_t reprocessing;
+    unsigned failure_count = 0;
+    for (const YAML::Node& cur_chunk_root : load_top_level_map(ccp_materials_in, "ccp_materials_in"))
+    {
+        for (YAML::const_iterator cur_type = cur_chunk_root.begin(), end = cur_chunk_root.end(); cur_type != end; cur_type++)
+        {
+            
+            uint64_t item_id = cur_type->first.as<uint64_t>();
+            const YAML::Node materials = cur_type->second["materials"];
+            if (!materials.IsDefined() || !materials.IsSequence())
+            {
+                std::cerr << "Warning.  Type " << item_id << " has no materials.\n";
+                failure_count++;
+                continue;
+            }
+            
+            item_quantities_t new_materials;
+            bool converted = true;
+            for (const YAML::Node& cur_material : materials)
+            {
+                const YAML::Node material_id = cur_material["materialTypeID"];
+                const YAML::Node quantity = cur_material["quantity"];
+                if (!material_id.IsDefined() || !material_id.IsScalar() || !quantity.IsDefined() || !quantity.IsScalar())
+                {
+                    converted = false;
+                    break;
+                }
+                item_quantity_t new_item_quantity;
+                new_item_quantity.item_id(material_id.as<uint64_t>());
+                new_item_quantity.quantity(quantity.as<uint64_t>());
+                new_materials.materials_list().emplace_back(std::move(new_item_quantity));
+            }
+            if (!converted)
+            {
+                std::cerr << "Warning.  A material of type " << item_id << " is missing materialTypeID or quantity.\n";
+                failure_count++;
+                continue;
+            }
+            
+            std::unordered_map<uint64_t, unsigned>::const_iterator portion_size = portion_sizes.find(item_id);
+            reprocessing.add_type(item_id, portion_size == portion_sizes.end() ? 1 : portion_size->second, new_materials);
+            
+        }
+    }
+    
+    std::cerr << failure_count << " reprocessable types failed.  " << reprocessing.types().size() << " succeeded.\n";
+    
+    std::ofstream reprocessing_out_file(reprocessing_out);
+    if (!reprocessing_out_file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to open \"" + reprocessing_out + "\" for writing.\n");
+    reprocessing_out_file << reprocessing << '\n';
+    
+}
+
 int main(int argc, char** argv)
 {
     
@@ -567,21 +781,55 @@ int main(int argc, char** argv)
         args::blueprint_converter_t args;
         args.parse(argc, argv);
         
-        // Parse input file
-        YAML::Node ccp_yaml_in = YAML::LoadFile(args.ccp_yaml_in());
+        // Stargates and reprocessing materials are converted on their own if
+        // no blueprints were given
+        if (!args.ccp_jumps_in().empty())
+            convert_stargates(args.ccp_jumps_in(), args.stargates_out());
+        if (!args.ccp_materials_in().empty())
+            convert_reprocessing(args.ccp_materials_in(), args.ccp_types_in(), args.reprocessing_out());
+        if (args.ccp_yaml_in().empty())
+            return 0;
+        
+        // Gather every blueprint in input order
+        std::vector<YAML::Node> chunk_roots = load_top_level_map(args.ccp_yaml_in(), "ccp_yaml_in");
+        std::vector<YAML::const_iterator> ccp_yaml_in;
+        for (const YAML::Node& cur_chunk_root : chunk_roots)
+        {
+            for (YAML::const_iterator cur_node = cur_chunk_root.begin(), end = cur_chunk_root.end(); cur_node != end; cur_node++)
+                ccp_yaml_in.push_back(cur_node);
+        }
         
         // Calculate invention dependencies
         const std::unordered_map<uint64_t, uint64_t> invention_back_map = generate_invention_back_map(ccp_yaml_in);
         
-        blueprints_t blueprints_out;
+        // Index T1 blueprints by ID for invention lookups.  Keys were checked
+        // by generate_invention_back_map.
+        std::unordered_map<uint64_t, YAML::Node> all_blueprints;
+        all_blueprints.reserve(ccp_yaml_in.size());
+        for (const YAML::const_iterator& cur_node : ccp_yaml_in)
+            all_blueprints.emplace(cur_node->first.as<uint64_t>(), cur_node->second);
+        
+        // Convert each YAML input blueprint in parallel
+        unsigned num_blueprints = ccp_yaml_in.size();
+        std::vector<blueprint_t> new_blueprints(num_blueprints);
+        std::vector<char> converted(num_blueprints);
+        std::vector<std::string> warnings(num_blueprints);
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (unsigned ix = 0; ix < num_blueprints; ix++)
+        {
+            std::ostringstream cur_warnings;
+            converted[ix] = convert_blueprint(ccp_yaml_in[ix], all_blueprints, invention_back_map, new_blueprints[ix], cur_warnings);
+            warnings[ix] = cur_warnings.str();
+        }
         
-        // Iterate through each YAML input blueprint
+        // Keep the output and warnings in input order
+        blueprints_t blueprints_out;
         unsigned failure_count = 0;
-        for (YAML::const_iterator cur_node = ccp_yaml_in.begin(), end = ccp_yaml_in.end(); cur_node != end; cur_node++)
+        for (unsigned ix = 0; ix < num_blueprints; ix++)
         {
-            blueprint_t new_blueprint;
-            if (convert_blueprint(cur_node, ccp_yaml_in, invention_back_map, new_blueprint))
-                blueprints_out.add_blueprint(std::move(new_blueprint));
+            std::cerr << warnings[ix];
+            if (converted[ix])
+                blueprints_out.add_blueprint(std::move(new_blueprints[ix]));
             else
                 failure_count++;
         }
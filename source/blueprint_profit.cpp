@@ -7,35 +7,197 @@
 
 #include <iostream>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
+#include "best_price_index.h"
 #include "blueprint.h"
 #include "blueprint_profit.h"
 #include "blueprints.h"
+#include "build_tree.h"
 #include "error.h"
+#include "industry_profile.h"
+#include "item_quantities.h"
+#include "item_quantity.h"
 #include "json.h"
 #include "manufacturability.h"
 #include "station_market.h"
 
+/// @brief Cost of one list of input materials for a job of several runs.
+/// The amount of each material is scaled by material_multiplier.
+///
+/// Prices come from build_costs if it isn't null, else from best_prices if it
+/// isn't null, else from the home station.  Inputs which are cheaper to build
+/// are appended to built_inputs and the time to build them is added to
+/// built_time.
+///
+/// @exception error_message_t
+static float input_cost
+(
+    const item_quantities_t& materials,
+    unsigned material_efficiency,
+    const station_market_t& station_market,
+    const best_price_index_t* best_prices,
+    const build_tree_t::item_costs_t* build_costs,
+    unsigned runs,
+    float material_multiplier,
+    float& built_time,
+    std::vector<uint64_t>& built_inputs
+){
+    
+    if (build_costs == nullptr)
+    {
+        if (best_prices == nullptr)
+            return materials.total_sell_value(station_market, material_efficiency, runs, material_multiplier);
+        return best_prices->total_value(materials, station_market, best_price_index_t::side_t::BUY, material_efficiency, runs, material_multiplier);
+    }
+    
+    float accumulator = 0.0f;
+    for (const item_quantity_t& cur_item_quantity : materials.materials_list())
+    {
+        
+        build_tree_t::item_costs_t::const_iterator cur_cost = build_costs->find(cur_item_quantity.item_id());
+        if (cur_cost == build_costs->end() || std::isinf(cur_cost->second.unit_cost))
+        {
+            std::string message("Error.  Could not find sell order for item with id ");
+            message += std::to_string(cur_item_quantity.item_id());
+            message += '.';
+            throw error_message_t(error_code_t::NO_ORDERS, message);
+        }
+        
+        uint64_t rounded_modified_materials = item_quantities_t::batch_quantity(cur_item_quantity.quantity(), material_efficiency, runs, material_multiplier);
+        accumulator += float(rounded_modified_materials) * cur_cost->second.unit_cost;
+        if (cur_cost->second.built)
+        {
+            built_time += float(rounded_modified_materials) * cur_cost->second.unit_time;
+            built_inputs.push_back(cur_item_quantity.item_id());
+        }
+        
+    }
+    
+    return accumulator;
+    
+}
+
+/// @brief Value of the output materials, sold at home or at the best station.
+///
+/// @exception error_message_t
+static float products_value(const item_quantities_t& materials, const station_market_t& station_market, const best_price_index_t* best_prices, unsigned runs)
+{
+    // Material efficiency does not affect output amount
+    if (best_prices == nullptr)
+        return materials.total_sell_value(station_market, 0, runs);
+    return best_prices->total_value(materials, station_market, best_price_index_t::side_t::SELL, 0, runs);
+}
+
+blueprint_profit_t::job_t blueprint_profit_t::job
+(
+    const blueprint_t& blueprint,
+    const blueprint_t* t1_blueprint,
+    const decryptor_t& decryptor,
+    unsigned runs_per_job,
+    const industry_profile_t::modifiers_t& modifiers
+){
+    
+    const blueprint_t::manufacture_t& manufacture = blueprint.manufacture();
+    job_t ret;
+    
+    if (t1_blueprint == nullptr)
+    {
+        unsigned time = runs_per_job * manufacture.time();
+        if (modifiers.manufacturing_time_multiplier != 1.0f)
+            time = unsigned(std::lround(double(time) * modifiers.manufacturing_time_multiplier));
+        ret.runs = runs_per_job;
+        ret.invention_probability = 0.0f;
+        ret.invented_runs = 0;
+        ret.effective_num_t1_copies = 0.0f;
+        ret.science_time = 0.0f;
+        ret.manufacturing_time = float(time);
+        return ret;
+    }
+    
+    // An invented copy can't run more jobs than it was invented with
+    const blueprint_t::invent_t& invent = blueprint.invent();
+    ret.invented_runs = decryptor.modify_max_runs(invent.runs());
+    ret.runs = std::min(runs_per_job, ret.invented_runs);
+    ret.invention_probability = decryptor.modify_probability(invent.probability());
+    
+    // Calculate the effective number of T1 blueprints that must be copied
+    // and invented per T2 manufacturing job
+    ret.effective_num_t1_copies
+      = float(ret.runs) / (
+            ret.invention_probability
+          * float(ret.invented_runs)
+      );
+    
+    // Calculate copy and invention time, weighted like their cost, plus the
+    // time of the manufacturing job itself.  Time efficiency only applies to
+    // the invented blueprint.
+    float te_modifier = float(100 - decryptor.modify_time_efficiency(invent.time_efficiency())) / 100.0f;
+    ret.science_time = modifiers.science_time_multiplier * ret.effective_num_t1_copies * float(t1_blueprint->copy().time() + invent.time());
+    ret.manufacturing_time = modifiers.manufacturing_time_multiplier * te_modifier * float(ret.runs * manufacture.time());
+    return ret;
+    
+}
+
 void blueprint_profit_t::initialize_from_market
 (
     const blueprint_t& blueprint_of_interest,
     const blueprints_t& all_blueprints,
     const station_market_t& station_market,
-    const decryptor_t& decryptor
+    const decryptor_t& decryptor,
+    const best_price_index_t* best_prices,
+    const build_tree_t::item_costs_t* build_costs,
+    unsigned runs_per_job,
+    const industry_profile_t::modifiers_t& modifiers
 ){
     
-    // calculate profits for each decryptor
+    this->calculate_total_cost(blueprint_of_interest, all_blueprints, station_market, decryptor, best_prices, build_costs, runs_per_job, modifiers);
+    if (!this->manufacturability_.is_ok())
+        return;
+    
+    // Calculate output value, less sales tax and broker fees
+    try
+    {
+        this->output_value_ = modifiers.sell_fraction * products_value(blueprint_of_interest.manufacture().output_materials(), station_market, best_prices, this->runs_);
+    } catch (const error_message_t& error) {
+        if (error == error_code_t::NO_ORDERS)
+        {
+            this->manufacturability_.status(manufacturability_t::status_t::MISSING_MARKET_DATA);
+            this->manufacturability_.message(error.message());
+        } else {
+            throw error;
+        }
+    }
+    
+}
+
+void blueprint_profit_t::calculate_total_cost
+(
+    const blueprint_t& blueprint_of_interest,
+    const blueprints_t& all_blueprints,
+    const station_market_t& station_market,
+    const decryptor_t& decryptor,
+    const best_price_index_t* best_prices,
+    const build_tree_t::item_costs_t* build_costs,
+    unsigned runs_per_job,
+    const industry_profile_t::modifiers_t& modifiers
+){
     
     this->blueprint_id_ = blueprint_of_interest.blueprint_id();
     
     // This will get overwritten if an error occurs
     this->manufacturability_.status(manufacturability_t::status_t::OK);
+    this->manufacturability_.message("");
     
     this->decryptor_ = decryptor;
+    this->runs_ = runs_per_job;
+    this->built_inputs_.clear();
     
     // If this is a T1 blueprint, then the calculation is easy and requires no
     // decryptors
@@ -72,17 +234,11 @@ void blueprint_profit_t::initialize_from_market
             return;
         }
         
-        // Calculate the effective number of T1 blueprints that must be copied
-        // and invented per T2 manufacturing run
-        float effective_num_t1_copies
-          = 1.0f / (
-                decryptor.modify_probability(invent.probability())
-              * float(decryptor.modify_max_runs(invent.runs()))
-          );
-        
-        // Calculate manufacturing time
-        float te_modifier = float(100 - decryptor.modify_time_efficiency(invent.time_efficiency())) / 100.0f;
-        this->time_ = te_modifier * effective_num_t1_copies * float(copy.time() + invent.time());
+        job_t job = blueprint_profit_t::job(blueprint_of_interest, &t1_blueprint, decryptor, runs_per_job, modifiers);
+        this->runs_ = job.runs;
+        this->science_time_ = job.science_time;
+        this->manufacturing_time_ = job.manufacturing_time;
+        float effective_num_t1_copies = job.effective_num_t1_copies;
         
         // Mark blueprint as unmanufacturable if there are no market orders for
         // an input item.
@@ -91,9 +247,14 @@ void blueprint_profit_t::initialize_from_market
             
             // Look up decryptor price
             float decryptor_cost = 0.0f;
-            if (decryptor != decryptor_t::type_t::NO_DECRYPTOR)
+            if (decryptor != decryptor_t::type_t::NO_DECRYPTOR && (best_prices != nullptr || build_costs != nullptr))
             {
-                std::unordered_map<uint64_t, item_market_t>::const_iterator decryptor_market_data = station_market.items().find(decryptor.item_id());
+                item_quantities_t decryptor_materials;
+                decryptor_materials.materials_list().emplace_back(decryptor.item_id(), 1);
+                float unused_time = 0.0f;
+                decryptor_cost = input_cost(decryptor_materials, 0, station_market, best_prices, build_costs, 1, 1.0f, unused_time, this->built_inputs_);
+            } else if (decryptor != decryptor_t::type_t::NO_DECRYPTOR) {
+                station_market_t::item_map_t::const_iterator decryptor_market_data = station_market.items().find(decryptor.item_id());
                 if (decryptor_market_data == station_market.items().end())
                 {
                     // No market orders for the decryptor.  Abort
@@ -107,22 +268,22 @@ void blueprint_profit_t::initialize_from_market
                 decryptor_cost = decryptor_market_data->second.min_sell_order();
             }
             
-            // Calculate input material cost
+            // Calculate input material cost.  Intermediates built for the
+            // copy and invention jobs are weighted the same as their cost.
+            // Structure bonuses only reduce manufacturing materials.
             unsigned me = decryptor.modify_material_efficiency(invent.material_efficiency());
+            float invent_built_time = 0.0f;
+            float manufacture_built_time = 0.0f;
+            float manufacture_cost = input_cost(manufacture.input_materials(), me, station_market, best_prices, build_costs, this->runs_, modifiers.material_multiplier, manufacture_built_time, this->built_inputs_);
             this->total_cost_
               = effective_num_t1_copies * (
-                    copy.input_materials().total_sell_value(station_market, 0)
-                  + invent.input_materials().total_sell_value(station_market, 0)
+                    input_cost(copy.input_materials(), 0, station_market, best_prices, build_costs, 1, 1.0f, invent_built_time, this->built_inputs_)
+                  + input_cost(invent.input_materials(), 0, station_market, best_prices, build_costs, 1, 1.0f, invent_built_time, this->built_inputs_)
                   + decryptor_cost
                 )
-                + manufacture.input_materials().total_sell_value(station_market, me);
-            
-            // Calculate output material value
-            this->output_value_ = manufacture.output_materials().total_sell_value(station_market, 0);
-            
-            // Market calculation successful
-            this->manufacturability_.status(manufacturability_t::status_t::OK);
-            this->manufacturability_.message("");
+                + manufacture_cost
+                + modifiers.job_fee_fraction * manufacture_cost;
+            this->manufacturing_time_ += effective_num_t1_copies * invent_built_time + manufacture_built_time;
             
         } catch (const error_message_t& error) {
             if (error.error_code() == error_code_t::NO_ORDERS)
@@ -139,35 +300,31 @@ void blueprint_profit_t::initialize_from_market
         
         // This is a T1 blueprint
         
-        this->time_ = manufacture.time();
+        job_t job = blueprint_profit_t::job(blueprint_of_interest, nullptr, decryptor, runs_per_job, modifiers);
+        this->science_time_ = job.science_time;
+        this->manufacturing_time_ = job.manufacturing_time;
         
         // Calculate total cost, or mark this item as unmanufacturable if there
         // is insufficient market data.
         try
         {
-            this->total_cost_ = manufacture.input_materials().total_sell_value
-            (
-                station_market,
-                manufacture.material_efficiency()
-            );
-        } catch (const error_message_t& error) {
-            if (error == error_code_t::NO_ORDERS)
-            {
-                this->manufacturability_.status(manufacturability_t::status_t::MISSING_MARKET_DATA);
-                this->manufacturability_.message(error.message());
-            } else {
-                throw error;
-            }
-        }
-        
-        // Calculate output value
-        try
-        {
-            this->output_value_ = manufacture.output_materials().total_sell_value
+            float built_time = 0.0f;
+            float manufacture_cost = input_cost
             (
+                manufacture.input_materials(),
+                manufacture.material_efficiency(),
                 station_market,
-                0 // Material efficiency does not affect output amount
+                best_prices,
+                build_costs,
+                this->runs_,
+                modifiers.material_multiplier,
+                built_time,
+                this->built_inputs_
             );
+            // The job fee is charged on the estimated value of the inputs,
+            // which their market cost stands in for
+            this->total_cost_ = manufacture_cost + modifiers.job_fee_fraction * manufacture_cost;
+            this->manufacturing_time_ += built_time;
         } catch (const error_message_t& error) {
             if (error == error_code_t::NO_ORDERS)
             {
@@ -180,6 +337,48 @@ void blueprint_profit_t::initialize_from_market
         
     }
     
+    this->time_ = unsigned(this->science_time_ + this->manufacturing_time_);
+    
+    // The same intermediate can feed several jobs
+    std::sort(this->built_inputs_.begin(), this->built_inputs_.end());
+    this->built_inputs_.erase(std::unique(this->built_inputs_.begin(), this->built_inputs_.end()), this->built_inputs_.end());
+    
+}
+
+void blueprint_profit_t::initialize_from_totals
+(
+    uint64_t blueprint_id,
+    const decryptor_t& decryptor,
+    const job_t& job,
+    float total_cost,
+    float output_value
+){
+    this->manufacturability_.status(manufacturability_t::status_t::OK);
+    this->manufacturability_.message("");
+    this->decryptor_ = decryptor;
+    this->blueprint_id_ = blueprint_id;
+    this->runs_ = job.runs;
+    this->time_ = unsigned(job.science_time + job.manufacturing_time);
+    this->science_time_ = job.science_time;
+    this->manufacturing_time_ = job.manufacturing_time;
+    this->total_cost_ = total_cost;
+    this->output_value_ = output_value;
+    this->built_inputs_.clear();
+}
+
+float blueprint_profit_t::profit(sort_strategy_t strategy) const
+{
+    switch (strategy)
+    {
+        case sort_strategy_t::PROFIT_AMOUNT:
+            return this->profit_amount();
+        case sort_strategy_t::PROFIT_PERCENT:
+            return this->profit_percent();
+        case sort_strategy_t::PROFIT_PER_SECOND:
+            return this->profit_per_second();
+        default:
+            throw error_message_t(error_code_t::UNKNOWN_SORT_STRATEGY, "Error.  Encountered unknown enum for sort_strategy_t while comparing blueprint profits.\n");
+    }
 }
 
 void blueprint_profit_t::read_from_json_file(std::istream& file)
@@ -243,12 +442,27 @@ void blueprint_profit_t::read_from_json_structure(const Json::Value& json_root)
     if (this->manufacturability_.is_ok())
     {
         
+        // Parse optional runs.  Older files always describe a single run.
+        const Json::Value& json_runs = json_root["runs"];
+        if (json_runs.isNull())
+        {
+            this->runs_ = 1;
+        } else if (json_runs.isUInt() && json_runs.asUInt() != 0) {
+            this->runs_ = json_runs.asUInt();
+        } else {
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error <blueprint_profit>/runs was not of type \"positive integer\".\n");
+        }
+        
         // Parse time
         const Json::Value& json_time = json_root["time"];
         if (!json_time.isUInt())
             throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error <blueprint_profit>/time was not found or not of type \"unsigned integer\".\n");
         this->time_ = json_time.asUInt();
         
+        // Reports don't record how the time splits between slots
+        this->science_time_ = 0.0f;
+        this->manufacturing_time_ = float(this->time_);
+        
         // Parse total_cost
         const Json::Value& json_total_cost = json_root["total_cost"];
         if (!json_total_cost.isNumeric())
@@ -261,6 +475,21 @@ void blueprint_profit_t::read_from_json_structure(const Json::Value& json_root)
             throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error <blueprint_profit>/output_value was not found or not of type \"float\".\n");
         this->output_value_ = json_output_value.asFloat();
         
+        // Parse optional built_inputs
+        this->built_inputs_.clear();
+        const Json::Value& json_built_inputs = json_root["built_inputs"];
+        if (!json_built_inputs.isNull())
+        {
+            if (!json_built_inputs.isArray())
+                throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error <blueprint_profit>/built_inputs was not of type \"array\".\n");
+            for (const Json::Value& json_cur_built_input : json_built_inputs)
+            {
+                if (!json_cur_built_input.isUInt64())
+                    throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error <blueprint_profit>/built_inputs contained an element not of type \"unsigned integer\".\n");
+                this->built_inputs_.push_back(json_cur_built_input.asUInt64());
+            }
+        }
+        
     }
     
     // Ignore derivable stats like profit_amount
@@ -330,6 +559,11 @@ void blueprint_profit_t::write_to_json_buffer
         
         // Encode base statistics
         
+        buffer += indent_1;
+        buffer += "\"runs\": ";
+        buffer += std::to_string(this->runs_);
+        buffer += ",\n";
+        
         buffer += indent_1;
         buffer += "\"time\": ";
         buffer += std::to_string(this->time_);
@@ -359,8 +593,28 @@ void blueprint_profit_t::write_to_json_buffer
         buffer += indent_1;
         buffer += "\"profit_per_second\": ";
         buffer += std::to_string(this->profit_per_second());
+        buffer += ",\n";
+        
+        buffer += indent_1;
+        buffer += "\"profit_per_hour\": ";
+        buffer += std::to_string(this->profit_per_hour());
+        
+        // Only present when a build tree was used and something was built
+        if (!this->built_inputs_.empty())
+        {
+            buffer += ",\n";
+            buffer += indent_1;
+            buffer += "\"built_inputs\": [";
+            for (unsigned ix = 0, num_built_inputs = this->built_inputs_.size(); ix < num_built_inputs; ix++)
+            {
+                if (ix != 0)
+                    buffer += ", ";
+                buffer += std::to_string(this->built_inputs_[ix]);
+            }
+            buffer += ']';
+        }
         buffer += '\n';
-    
+        
     } else {
         
         buffer += '\n';
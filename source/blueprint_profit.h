@@ -11,9 +11,13 @@
 #include <fstream>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
+#include "best_price_index.h"
+#include "build_tree.h"
 #include "decryptor.h"
 #include "error.h"
+#include "industry_profile.h"
 #include "json.h"
 #include "manufacturability.h"
 
@@ -38,8 +42,41 @@ class blueprint_profit_t
             NUM_ENUMS
         };
         
-        /// @brief Default constructor
-        inline blueprint_profit_t() = default;
+        /// @brief Size and duration of one manufacturing job, before any
+        /// inputs are built.  Shared by @ref calculate_total_cost and
+        /// @ref profit_matrix_t so that both agree.
+        struct job_t
+        {
+            /// @brief Runs in the job, capped at the runs of one invented
+            /// copy.
+            unsigned runs;
+            /// @brief Chance that one invention job succeeds, or 0 for T1
+            /// blueprints.
+            float invention_probability;
+            /// @brief Runs of each invented T2 copy, or 0 for T1 blueprints.
+            unsigned invented_runs;
+            /// @brief T1 copies copied and invented per job, or 0 for T1
+            /// blueprints.
+            float effective_num_t1_copies;
+            /// @brief See @ref science_time.
+            float science_time;
+            /// @brief See @ref manufacturing_time.
+            float manufacturing_time;
+        };
+        
+        /// @brief Default constructor.  Costs and values start at 0 so that
+        /// a blueprint which could not be priced never reads garbage.
+        inline blueprint_profit_t()
+          : blueprint_id_(0),
+            runs_(0),
+            time_(0),
+            science_time_(0.0f),
+            manufacturing_time_(0.0f),
+            total_cost_(0.0f),
+            output_value_(0.0f)
+        {
+            // All work done in initializer list
+        }
         
         // Add member initialization constructors here
         // Try to use initializer lists when possible.
@@ -68,6 +105,25 @@ class blueprint_profit_t
             return this->time_;
         }
         
+        /// @brief Seconds of science slot time per job.  Zero for blueprints
+        /// which aren't invented and for decoded reports.
+        float science_time() const
+        {
+            return this->science_time_;
+        }
+        
+        /// @brief Seconds of manufacturing slot time per job, including any
+        /// @ref built_inputs.
+        float manufacturing_time() const
+        {
+            return this->manufacturing_time_;
+        }
+        
+        unsigned runs() const
+        {
+            return this->runs_;
+        }
+        
         float total_cost() const
         {
             return this->total_cost_;
@@ -78,6 +134,13 @@ class blueprint_profit_t
             return this->output_value_;
         }
         
+        /// @brief IDs of the input materials which were built rather than
+        /// bought, sorted.  Always empty unless a build tree was used.
+        const std::vector<uint64_t>& built_inputs() const
+        {
+            return this->built_inputs_;
+        }
+        
         // Add special-purpose functions here
         
         /// @brief Choose the optimal decryptor 
@@ -92,7 +155,60 @@ class blueprint_profit_t
             const station_market_t& station_market,
             /// [in] Selects a decryptor to modify time, input materials, and
             /// output if this is a T2 blueprint.
-            const decryptor_t& decryptor
+            const decryptor_t& decryptor,
+            /// [in] If not null, each material is bought and each product is
+            /// sold at whichever station is best, and station_market is only
+            /// used as the home station where the blueprint is run.
+            const best_price_index_t* best_prices = nullptr,
+            /// [in] If not null, inputs are priced from this table so that
+            /// intermediates we can build ourselves use their build cost
+            /// when that is cheaper than the market.
+            const build_tree_t::item_costs_t* build_costs = nullptr,
+            /// [in] Number of runs in one manufacturing job.  Material
+            /// efficiency is rounded once per job, so larger jobs waste less.
+            /// Invented blueprints are limited to the runs of one copy.
+            unsigned runs_per_job = 1,
+            /// [in] Skill, structure and tax modifiers of the character
+            /// running the job.
+            const industry_profile_t::modifiers_t& modifiers = industry_profile_t::no_modifiers
+        );
+        
+        /// @brief Same as @ref initialize_from_market, but stops after the
+        /// time and total cost.  The output value is left unset and the
+        /// products don't need a market.
+        void calculate_total_cost
+        (
+            const blueprint_t& blueprint_of_interest,
+            const blueprints_t& all_blueprints,
+            const station_market_t& station_market,
+            const decryptor_t& decryptor,
+            const best_price_index_t* best_prices = nullptr,
+            const build_tree_t::item_costs_t* build_costs = nullptr,
+            unsigned runs_per_job = 1,
+            const industry_profile_t::modifiers_t& modifiers = industry_profile_t::no_modifiers
+        );
+        
+        /// @brief Describe one job of blueprint.  t1_blueprint is the
+        /// blueprint invented from, which must be copyable, or null if
+        /// blueprint isn't invented.
+        static job_t job
+        (
+            const blueprint_t& blueprint,
+            const blueprint_t* t1_blueprint,
+            const decryptor_t& decryptor,
+            unsigned runs_per_job,
+            const industry_profile_t::modifiers_t& modifiers
+        );
+        
+        /// @brief Fill in a job whose total cost and output value were
+        /// calculated elsewhere, for example by @ref profit_matrix_t.
+        void initialize_from_totals
+        (
+            uint64_t blueprint_id,
+            const decryptor_t& decryptor,
+            const job_t& job,
+            float total_cost,
+            float output_value
         );
         
         inline float profit_amount() const
@@ -110,6 +226,16 @@ class blueprint_profit_t
             return this->profit_amount() / this->time_;
         }
         
+        inline float profit_per_hour() const
+        {
+            return this->profit_per_second() * 3600.0f;
+        }
+        
+        /// @brief Profit measured by strategy.
+        ///
+        /// @exception error_message_t
+        float profit(sort_strategy_t strategy) const;
+        
         // Add encoders/decoders here
         
         /// @brief Open a file conforming to data/json/schema.json and use it to initialize
@@ -192,15 +318,27 @@ class blueprint_profit_t
         /// with this ID.
         uint64_t blueprint_id_;
         
-        /// @brief Total time to produce 1 final output item including copy and
+        /// @brief Number of runs in the manufacturing job that @ref time_,
+        /// @ref total_cost_ and @ref output_value_ describe.
+        unsigned runs_;
+        
+        /// @brief Total time to run one manufacturing job including copy and
         /// invention time.
         ///
-        /// Assumes that all input materials are purchased and not manufactured.
-        /// Invention time is weighted using the invention probability.
+        /// Includes the time to manufacture any @ref built_inputs.  All other
+        /// input materials are assumed to be purchased.  Invention time is
+        /// weighted using the invention probability.  Sum of
+        /// @ref science_time_ and @ref manufacturing_time_.
         ///
         /// Only valid if @ref manufacturability_t::is_ok() == true
         unsigned time_;
         
+        /// @brief See @ref science_time.
+        float science_time_;
+        
+        /// @brief See @ref manufacturing_time.
+        float manufacturing_time_;
+        
         /// @brief Sum of all costs including input materials, datacores,
         /// decryptors.
         ///
@@ -210,7 +348,7 @@ class blueprint_profit_t
         /// Only valid if @ref manufacturability_t::is_ok() == true
         float total_cost_;
         
-        /// @brief Value of the output items produced by one manufacturing run.
+        /// @brief Value of the output items produced by one manufacturing job.
         /// 
         /// For example, a mjolnir fury light missil run produces 5000 missiles.
         /// If these missiles sell for 87 ISK each then this value would be 435000.
@@ -218,6 +356,9 @@ class blueprint_profit_t
         /// Only valid if @ref manufacturability_t::is_ok() == true
         float output_value_;
         
+        /// @brief See @ref built_inputs.
+        std::vector<uint64_t> built_inputs_;
+        
 };
 
 /// @brief Convenience alias to allow printing directly via cout or similar.
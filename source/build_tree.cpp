@@ -0,0 +1,227 @@
+/// @file build_tree.cpp
+/// @brief Implementation of @ref build_tree_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "best_price_index.h"
+#include "blueprint.h"
+#include "blueprint_profit.h"
+#include "blueprints.h"
+#include "build_tree.h"
+#include "decryptor.h"
+#include "error.h"
+#include "item_quantities.h"
+#include "item_quantity.h"
+#include "station_market.h"
+
+void build_tree_t::initialize_from_blueprints(const blueprints_t& blueprints)
+{
+    
+    this->clear();
+    
+    // Find what every blueprint makes and what it consumes
+    std::unordered_set<uint64_t> materials;
+    for (const std::pair<const uint64_t, blueprint_t>& cur_blueprint : blueprints.storage())
+    {
+        
+        for (const item_quantity_t& cur_output : cur_blueprint.second.manufacture().output_materials().materials_list())
+            this->producers_[cur_output.item_id()].push_back(cur_blueprint.first);
+        
+        for (const item_quantity_t& cur_input : cur_blueprint.second.manufacture().input_materials().materials_list())
+            materials.insert(cur_input.item_id());
+        
+        // Copy and invent accessors throw if the blueprint can't do either
+        if (cur_blueprint.second.copy().valid())
+        {
+            for (const item_quantity_t& cur_input : cur_blueprint.second.copy().input_materials().materials_list())
+                materials.insert(cur_input.item_id());
+        }
+        if (cur_blueprint.second.invent().valid())
+        {
+            for (const item_quantity_t& cur_input : cur_blueprint.second.invent().input_materials().materials_list())
+                materials.insert(cur_input.item_id());
+        }
+        
+    }
+    for
+    (
+        decryptor_t::type_t cur_decryptor = decryptor_t::type_t(unsigned(decryptor_t::type_t::NO_DECRYPTOR) + 1);
+        cur_decryptor != decryptor_t::type_t::NUM_ENUMS;
+        cur_decryptor = decryptor_t::type_t(unsigned(cur_decryptor) + 1)
+    ){
+        materials.insert(decryptor_t(cur_decryptor).item_id());
+    }
+    this->materials_.assign(materials.begin(), materials.end());
+    std::sort(this->materials_.begin(), this->materials_.end());
+    
+    // Products which aren't used by any other blueprint are roots of the DAG.
+    // Visiting products in sorted order keeps the build order stable between
+    // runs.
+    std::vector<uint64_t> products;
+    products.reserve(this->producers_.size());
+    for (const std::pair<const uint64_t, std::vector<uint64_t> >& cur_product : this->producers_)
+        products.push_back(cur_product.first);
+    std::sort(products.begin(), products.end());
+    
+    // Iterative depth first search, appending each product once all of the
+    // products it is built from have been appended.  Products are marked on
+    // the stack while their inputs are being explored and done once they are
+    // appended.  An input which is still on the stack closes a cycle and is
+    // skipped, so it is priced at market by the product that consumes it.
+    enum class mark_t : uint8_t
+    {
+        ON_STACK,
+        DONE
+    };
+    std::unordered_map<uint64_t, mark_t> marks;
+    std::vector< std::pair<uint64_t, bool> > stack;
+    this->build_order_.reserve(products.size());
+    for (uint64_t cur_root : products)
+    {
+        
+        if (marks.count(cur_root) != 0)
+            continue;
+        stack.emplace_back(cur_root, false);
+        
+        while (!stack.empty())
+        {
+            
+            std::pair<uint64_t, bool> cur = stack.back();
+            stack.pop_back();
+            
+            // Second visit, every dependency is already in the build order
+            if (cur.second)
+            {
+                marks[cur.first] = mark_t::DONE;
+                this->build_order_.push_back(cur.first);
+                continue;
+            }
+            
+            // A product can be pushed by several consumers before it is
+            // explored.  Only the first one explores it, and a later pop
+            // finds it either done or, inside a cycle, still on the stack.
+            if (marks.count(cur.first) != 0)
+                continue;
+            marks.emplace(cur.first, mark_t::ON_STACK);
+            stack.emplace_back(cur.first, true);
+            
+            for (uint64_t cur_blueprint_id : this->producers_[cur.first])
+            {
+                const blueprint_t& blueprint = blueprints.storage().at(cur_blueprint_id);
+                for (const item_quantity_t& cur_input : blueprint.manufacture().input_materials().materials_list())
+                {
+                    // Done inputs are already in the build order and inputs
+                    // on the stack close a cycle, so only unmarked ones are
+                    // explored.
+                    uint64_t input_id = cur_input.item_id();
+                    if (this->producers_.count(input_id) != 0 && marks.count(input_id) == 0)
+                        stack.emplace_back(input_id, false);
+                }
+            }
+            
+        }
+        
+    }
+    
+}
+
+void build_tree_t::resolve
+(
+    const blueprints_t& blueprints,
+    const station_market_t& home,
+    const best_price_index_t* best_prices,
+    item_costs_t& costs,
+    unsigned runs_per_job,
+    const industry_profile_t::modifiers_t& modifiers
+) const {
+    
+    costs.clear();
+    costs.reserve(this->materials_.size() + this->build_order_.size());
+    
+    // Start with every item at its market price
+    float infinity = std::numeric_limits<float>::infinity();
+    auto market_price = [&](uint64_t item_id) -> float
+    {
+        if (best_prices != nullptr)
+        {
+            try
+            {
+                return best_prices->price(item_id, home, best_price_index_t::side_t::BUY);
+            } catch (const error_message_t& error) {
+                if (error != error_code_t::NO_ORDERS)
+                    throw error;
+                return infinity;
+            }
+        }
+        station_market_t::item_map_t::const_iterator local = home.items().find(item_id);
+        if (local == home.items().end() || local->second.sell_orders().empty())
+            return infinity;
+        return local->second.min_sell_order();
+    };
+    for (uint64_t cur_material : this->materials_)
+        costs.emplace(cur_material, item_cost_t{market_price(cur_material), 0.0f, false});
+    for (uint64_t cur_product : this->build_order_)
+        costs.emplace(cur_product, item_cost_t{market_price(cur_product), 0.0f, false});
+    
+    // Cost products dependencies first, so each blueprint sees the final cost
+    // of everything it consumes
+    blueprint_profit_t candidate;
+    for (uint64_t cur_product : this->build_order_)
+    {
+        
+        item_cost_t& cost = costs.at(cur_product);
+        for (uint64_t cur_blueprint_id : this->producers_.at(cur_product))
+        {
+            
+            const blueprint_t& blueprint = blueprints.storage().at(cur_blueprint_id);
+            
+            // Units of this product made per run
+            unsigned quantity = 0;
+            for (const item_quantity_t& cur_output : blueprint.manufacture().output_materials().materials_list())
+            {
+                if (cur_output.item_id() == cur_product)
+                    quantity += cur_output.quantity();
+            }
+            if (quantity == 0)
+                continue;
+            
+            // T2 blueprints try every decryptor, including none
+            decryptor_t::type_t last_decryptor = blueprint.invent().valid() ? decryptor_t::type_t::NUM_ENUMS : decryptor_t::type_t(unsigned(decryptor_t::type_t::NO_DECRYPTOR) + 1);
+            for
+            (
+                decryptor_t::type_t cur_decryptor = decryptor_t::type_t::NO_DECRYPTOR;
+                cur_decryptor != last_decryptor;
+                cur_decryptor = decryptor_t::type_t(unsigned(cur_decryptor) + 1)
+            ){
+                
+                candidate.calculate_total_cost(blueprint, blueprints, home, cur_decryptor, best_prices, &costs, runs_per_job, modifiers);
+                if (!candidate.manufacturability().is_ok())
+                    continue;
+                
+                float units_per_job = float(quantity) * float(candidate.runs());
+                float unit_cost = candidate.total_cost() / units_per_job;
+                if (unit_cost < cost.unit_cost)
+                {
+                    cost.unit_cost = unit_cost;
+                    cost.unit_time = float(candidate.time()) / units_per_job;
+                    cost.built = true;
+                }
+                
+            }
+            
+        }
+        
+    }
+    
+}
+
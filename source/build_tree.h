@@ -0,0 +1,121 @@
+/// @file build_tree.h
+/// @brief Declaration of @ref build_tree_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_BUILD_TREE
+#define HEADER_GUARD_BUILD_TREE
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "error.h"
+#include "industry_profile.h"
+
+class best_price_index_t;
+class blueprints_t;
+class station_market_t;
+
+/// @brief Decides, for every item that one of our blueprints can make,
+/// whether it is cheaper to buy it or to build it.
+///
+/// The products of all blueprints form a DAG where each product points at
+/// the products it is built from.  The DAG is ordered once, dependencies
+/// first, so that @ref resolve can cost every intermediate exactly once per
+/// station, using the already resolved cost of its own inputs.
+class build_tree_t
+{
+        
+    public:
+        
+        /// @brief The cheapest way to get one unit of an item.
+        struct item_cost_t
+        {
+            /// @brief ISK per unit, or infinity if it can neither be bought
+            /// nor built.
+            float unit_cost;
+            /// @brief Seconds of manufacturing per unit, including the
+            /// intermediates it is built from.  Zero if the item is bought.
+            float unit_time;
+            /// @brief True if building is cheaper than buying.
+            bool built;
+        };
+        
+        /// @brief Resolved cost of every item which is an input to, or a
+        /// product of, any blueprint.
+        typedef std::unordered_map<uint64_t, item_cost_t> item_costs_t;
+        
+        /// @brief Default constructor
+        inline build_tree_t() = default;
+        
+        // Add member read and write functions
+        
+        /// @brief Every product, ordered so that products which are inputs
+        /// of other products come first.
+        inline const std::vector<uint64_t>& build_order() const
+        {
+            return this->build_order_;
+        }
+        
+        // Add special-purpose functions here
+        
+        inline void clear()
+        {
+            this->producers_.clear();
+            this->materials_.clear();
+            this->build_order_.clear();
+        }
+        
+        /// @brief Find the blueprints which make each product and order the
+        /// products, clearing previous content.
+        ///
+        /// Cycles, which only happen with unusual blueprint sets, are broken
+        /// arbitrarily.  The item that closes a cycle, found still on the
+        /// search stack, is priced at market when building the items that
+        /// depend on it.
+        void initialize_from_blueprints(const blueprints_t& blueprints);
+        
+        /// @brief Cost every material at one station.
+        ///
+        /// Each item starts at its market price.  Products are then visited
+        /// in @ref build_order and replaced by their build cost when that is
+        /// cheaper, trying every decryptor for invented blueprints.
+        void resolve
+        (
+            /// [in] Must be the same blueprints passed to
+            /// @ref initialize_from_blueprints.
+            const blueprints_t& blueprints,
+            /// [in] Station where everything is built.
+            const station_market_t& home,
+            /// [in] If not null, materials are bought at the best station in
+            /// the galaxy instead of at home.
+            const best_price_index_t* best_prices,
+            /// [out] Overwritten with the cost of every item.
+            item_costs_t& costs,
+            /// [in] Intermediates are built in jobs of this many runs, see
+            /// @ref blueprint_profit_t::initialize_from_market.
+            unsigned runs_per_job = 1,
+            /// [in] Skill and structure bonuses of whoever builds the
+            /// intermediates.
+            const industry_profile_t::modifiers_t& modifiers = industry_profile_t::no_modifiers
+        ) const;
+        
+    protected:
+        
+        /// @brief Product ID -> IDs of every blueprint which makes it.
+        std::unordered_map< uint64_t, std::vector<uint64_t> > producers_;
+        
+        /// @brief Every item used as an input by any blueprint, including
+        /// decryptors.
+        std::vector<uint64_t> materials_;
+        
+        /// @brief See @ref build_order.
+        std::vector<uint64_t> build_order_;
+        
+};
+
+#endif // Header Guard
+
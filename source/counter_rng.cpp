@@ -0,0 +1,42 @@
+/// @file counter_rng.cpp
+/// @brief Implementation of @ref counter_rng_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <cstdint>
+
+#include "counter_rng.h"
+
+void counter_rng_t::count_successes
+(
+    float probability,
+    unsigned attempts,
+    uint64_t first_trial,
+    unsigned num_trials,
+    unsigned* successes
+) const {
+    
+    // An attempt succeeds if the top 32 bits of its random number are below
+    // the threshold
+    uint64_t threshold;
+    if (!(probability > 0.0f))
+        threshold = 0;
+    else if (probability >= 1.0f)
+        threshold = uint64_t(1) << 32;
+    else
+        threshold = uint64_t(double(probability) * 4294967296.0);
+    
+    for (unsigned ix = 0; ix < num_trials; ix++)
+        successes[ix] = 0;
+    
+    // Trials are independent, so the inner loop vectorizes
+    for (unsigned attempt = 0; attempt < attempts; attempt++)
+    {
+        #pragma omp simd
+        for (unsigned ix = 0; ix < num_trials; ix++)
+            successes[ix] += unsigned(((*this)((first_trial + ix) * attempts + attempt) >> 32) < threshold);
+    }
+    
+}
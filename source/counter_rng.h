@@ -0,0 +1,79 @@
+/// @file counter_rng.h
+/// @brief Declaration of @ref counter_rng_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_COUNTER_RNG
+#define HEADER_GUARD_COUNTER_RNG
+
+#include <cstdint>
+
+/// @brief Counter-based random number generator.
+///
+/// The n-th random number is a hash of a key and n, with no state carried
+/// from one number to the next.  Any block of numbers can be generated on
+/// its own, so loops over many numbers vectorize, and the results of a
+/// parallel simulation don't depend on how it was split between threads.
+class counter_rng_t
+{
+        
+    public:
+        
+        /// @brief Constructor
+        inline counter_rng_t(uint64_t seed = 0)
+          : key_(counter_rng_t::mix(seed))
+        {
+            // All work done in initializer list
+        }
+        
+        // Add member read and write functions
+        
+        /// @brief Scrambled from the seed passed to the constructor.
+        inline uint64_t key() const
+        {
+            return this->key_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief SplitMix64 finalizer.  Consecutive inputs give unrelated
+        /// outputs.
+        static inline uint64_t mix(uint64_t value)
+        {
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+            return value ^ (value >> 31);
+        }
+        
+        /// @brief The counter-th random number of this generator's stream.
+        inline uint64_t operator()(uint64_t counter) const
+        {
+            return counter_rng_t::mix(this->key_ + (counter + 1) * 0x9e3779b97f4a7c15ull);
+        }
+        
+        /// @brief Simulate num_trials trials, each of which makes a number of
+        /// attempts that succeed with the same probability.
+        ///
+        /// Trial t uses random numbers t * attempts to (t + 1) * attempts - 1,
+        /// so splitting trials into blocks gives the same results.
+        void count_successes
+        (
+            float probability,
+            unsigned attempts,
+            /// [in] Index of the first trial simulated.
+            uint64_t first_trial,
+            unsigned num_trials,
+            /// [out] Number of successful attempts of each trial.
+            unsigned* successes
+        ) const;
+        
+    protected:
+        
+        /// @brief See @ref key.
+        uint64_t key_;
+        
+};
+
+#endif // Header Guard
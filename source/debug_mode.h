@@ -14,6 +14,9 @@
 #include "error.h"
 #include "json.h"
 
+class stats_t;
+class trace_t;
+
 /// @brief Enables or diables extra diagnostics or special modes suitable for
 /// testing the program or learning about its structure.
 class debug_mode_t
@@ -25,7 +28,9 @@ class debug_mode_t
         // Try to use initializer lists when possible.
         
         inline debug_mode_t(bool verbose = true)
-          : verbose_(verbose)
+          : verbose_(verbose),
+            stats_(nullptr),
+            trace_(nullptr)
         {
             // All work done in initializer list
         }
@@ -44,6 +49,26 @@ class debug_mode_t
             this->verbose_ = new_verbose;
         }
         
+        inline stats_t* stats() const
+        {
+            return this->stats_;
+        }
+        
+        inline void stats(stats_t* new_stats)
+        {
+            this->stats_ = new_stats;
+        }
+        
+        inline trace_t* trace() const
+        {
+            return this->trace_;
+        }
+        
+        inline void trace(trace_t* new_trace)
+        {
+            this->trace_ = new_trace;
+        }
+        
         // Add special-purpose functions here
         
         /// @brief Open a file conforming to data/json/schema.json and use it to initialize
@@ -135,6 +160,16 @@ class debug_mode_t
         /// stdout during normal program operation.
         bool verbose_;
         
+        /// @brief Destination for counters and stage timers, or null if
+        /// --stats-out was not requested.  Not owned by this object, and
+        /// shared between all copies of it.
+        stats_t* stats_;
+        
+        /// @brief Destination for timeline events, or null if --trace-out
+        /// was not requested.  Not owned by this object, and shared between
+        /// all copies of it.
+        trace_t* trace_;
+        
 };
 
 /// @brief Convenience alias to allow printing directly via cout or similar.
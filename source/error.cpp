@@ -17,6 +17,7 @@ const std::vector<std::string_view> error_message_t::error_names_ =
     "JSON_SCHEMA_VIOLATION",
     "YAML_SCHEMA_VIOLATION",
     "YAML_MISSING_INVENTION_DEPENDENCY",
+    "YAML_SYNTAX_ERROR",
     "MODE_MISSING",
     "MODE_INVALID",
     "ITEM_ATTRIBUTES_OUT_MISSING",
@@ -43,6 +44,37 @@ const std::vector<std::string_view> error_message_t::error_names_ =
     "ARG_MISSING_CCP_YAML_IN",
     "ARG_WRONG_NUMBER_OF_PARAMETERS_CCP_YAML_IN",
     "ARG_MISSING_CUSTOM_JSON_OUT",
-    "ARG_WRONG_NUMBER_OF_PARAMETERS_CUSTOM_JSON_OUT"
+    "ARG_WRONG_NUMBER_OF_PARAMETERS_CUSTOM_JSON_OUT",
+    "HISTORY_OUT_MISSING",
+    "HISTORY_DAYS_INVALID",
+    "HISTORY_FILE_CORRUPT",
+    "NEW_PRICES_IN_MISSING",
+    "DELTA_OUT_MISSING",
+    "DELTA_IN_MISSING",
+    "HAULING_COST_INVALID",
+    "RUNS_PER_JOB_INVALID",
+    "PROFITS_IN_MISSING",
+    "SCHEDULE_OUT_MISSING",
+    "SCHEDULE_LIMIT_INVALID",
+    "SENSITIVITY_OUT_MISSING",
+    "INVENTION_ROW_INVALID",
+    "RISK_OUT_MISSING",
+    "RISK_LIMIT_INVALID",
+    "JUMP_DISTANCES_MISSING",
+    "TOPOLOGY_FILE_CORRUPT",
+    "TOPOLOGY_OUT_MISSING",
+    "STARGATES_IN_MISSING",
+    "ARG_WRONG_NUMBER_OF_PARAMETERS_CCP_JUMPS_IN",
+    "ARG_MISSING_STARGATES_OUT",
+    "ARG_WRONG_NUMBER_OF_PARAMETERS_STARGATES_OUT",
+    "ARBITRAGE_OUT_MISSING",
+    "ARBITRAGE_LIMIT_INVALID",
+    "ARG_WRONG_NUMBER_OF_PARAMETERS_CCP_MATERIALS_IN",
+    "ARG_WRONG_NUMBER_OF_PARAMETERS_CCP_TYPES_IN",
+    "ARG_MISSING_REPROCESSING_OUT",
+    "ARG_WRONG_NUMBER_OF_PARAMETERS_REPROCESSING_OUT",
+    "REPROCESSING_IN_MISSING",
+    "REPROCESS_OUT_MISSING",
+    "REPROCESS_YIELD_INVALID"
 };
 
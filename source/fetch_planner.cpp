@@ -0,0 +1,44 @@
+/// @file fetch_planner.cpp
+/// @brief Implementation of @ref fetch_planner_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <cstdint>
+
+#include "fetch_planner.h"
+
+double fetch_planner_t::full_region_cost(unsigned num_pages, uint64_t page_bytes) const
+{
+    // Page 1 has already been paid for
+    unsigned remaining_pages = num_pages > 1 ? num_pages - 1 : 0;
+    return double(remaining_pages) * (1.0 + double(page_bytes) / double(this->bytes_per_request_));
+}
+
+double fetch_planner_t::per_type_cost(unsigned num_pages, uint64_t page_bytes, unsigned num_page_types) const
+{
+    
+    unsigned num_items = this->item_ids_.size();
+    
+    // Each item gets an equal share of the region.  There are at least as
+    // many types in the region as on page 1, and at least as many as we ask
+    // for.
+    unsigned num_region_types = std::max(std::max(num_page_types, num_items), 1u);
+    double region_bytes = double(num_pages) * double(page_bytes);
+    double per_type_bytes = region_bytes * double(num_items) / double(num_region_types);
+    
+    return double(num_items) + per_type_bytes / double(this->bytes_per_request_);
+    
+}
+
+fetch_planner_t::strategy_t fetch_planner_t::plan(unsigned num_pages, uint64_t page_bytes, unsigned num_page_types) const
+{
+    if (this->item_ids_.empty() || num_pages <= 1)
+        return strategy_t::FULL_REGION;
+    if (this->per_type_cost(num_pages, page_bytes, num_page_types) < this->full_region_cost(num_pages, page_bytes))
+        return strategy_t::PER_TYPE;
+    return strategy_t::FULL_REGION;
+}
+
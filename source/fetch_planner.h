@@ -0,0 +1,107 @@
+/// @file fetch_planner.h
+/// @brief Declaration of @ref fetch_planner_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_FETCH_PLANNER
+#define HEADER_GUARD_FETCH_PLANNER
+
+#include <cstdint>
+#include <vector>
+
+/// @brief Decides whether to page through every order of a region or to
+/// query each relevant item type on its own.
+///
+/// Each strategy is costed in request equivalents.  A request costs 1, plus
+/// its payload divided by @ref bytes_per_request, the number of bytes which
+/// take as long to download as one request takes to set up.  Paging through
+/// the region costs one request per remaining page.  Querying by type costs
+/// one request per item, and downloads each item's share of the region.
+/// That share is estimated by splitting the region evenly between the larger
+/// of the number of distinct types on page 1 and the number of items queried.
+/// Page 1 can undercount the types in the region, which biases the estimate
+/// towards fetching the full region, but items with more orders than average
+/// still make querying by type cost more than estimated.
+class fetch_planner_t
+{
+        
+    public:
+        
+        /// @brief How the orders of one region are fetched.
+        enum class strategy_t
+        {
+            /// Fetch every page of the region.
+            FULL_REGION,
+            /// Fetch the orders of each item in @ref item_ids separately.
+            PER_TYPE
+        };
+        
+        /// @brief Default constructor.  Always fetches full regions.
+        inline fetch_planner_t()
+          : bytes_per_request_(256 * 1024)
+        {
+            // All work done in initializer list
+        }
+        
+        // Add member read and write functions
+        
+        /// @brief Items whose orders are needed, sorted.  If empty, every
+        /// region is fetched in full.
+        inline const std::vector<uint64_t>& item_ids() const
+        {
+            return this->item_ids_;
+        }
+        
+        inline void item_ids(const std::vector<uint64_t>& new_item_ids)
+        {
+            this->item_ids_ = new_item_ids;
+        }
+        
+        /// @brief Payload bytes that cost as much time as the overhead of one
+        /// request.
+        inline uint64_t bytes_per_request() const
+        {
+            return this->bytes_per_request_;
+        }
+        
+        inline void bytes_per_request(uint64_t new_bytes_per_request)
+        {
+            this->bytes_per_request_ = new_bytes_per_request;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Estimated cost of fetching the pages of a region after
+        /// page 1, in request equivalents.
+        double full_region_cost(unsigned num_pages, uint64_t page_bytes) const;
+        
+        /// @brief Estimated cost of querying every item in @ref item_ids, in
+        /// request equivalents.
+        double per_type_cost(unsigned num_pages, uint64_t page_bytes, unsigned num_page_types) const;
+        
+        /// @brief Choose the cheaper strategy for a region once page 1 has
+        /// been fetched.
+        strategy_t plan
+        (
+            /// [in] Number of pages in the region, from the X-Pages header.
+            unsigned num_pages,
+            /// [in] Size of page 1 in bytes.
+            uint64_t page_bytes,
+            /// [in] Number of distinct item types on page 1.
+            unsigned num_page_types
+        ) const;
+        
+    protected:
+        
+        /// @brief See @ref item_ids.
+        std::vector<uint64_t> item_ids_;
+        
+        /// @brief See @ref bytes_per_request.
+        uint64_t bytes_per_request_;
+        
+};
+
+#endif // Header Guard
+
@@ -0,0 +1,376 @@
+/// @file fetch_scheduler.cpp
+/// @brief Implementation of @ref fetch_scheduler_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "error.h"
+#include "fetch_planner.h"
+#include "fetch_scheduler.h"
+#include "ingest_filter.h"
+#include "json.h"
+#include "page_fetcher.h"
+#include "progress_reporter.h"
+#include "raw_order.h"
+#include "raw_regional_market.h"
+#include "regional_market.h"
+#include "station_attributes.h"
+#include "task_scheduler.h"
+
+void fetch_scheduler_t::add_region(uint64_t region_id)
+{
+    if (std::find(this->region_ids_.begin(), this->region_ids_.end(), region_id) == this->region_ids_.end())
+        this->region_ids_.push_back(region_id);
+}
+
+void fetch_scheduler_t::add_regions(const station_attributes_t& station_attributes)
+{
+    for (const station_attribute_t& cur_station : station_attributes.stations())
+        this->add_region(cur_station.region_id());
+}
+
+std::string fetch_scheduler_t::base_url(uint64_t region_id)
+{
+    std::string ret("https://esi.tech.ccp.is/latest/markets/");
+    ret += std::to_string(region_id);
+    ret += "/orders/?datasource=tranquility&order_type=all";
+    return ret;
+}
+
+std::string fetch_scheduler_t::type_url(uint64_t region_id, uint64_t item_id)
+{
+    std::string ret(fetch_scheduler_t::base_url(region_id));
+    ret += "&type_id=";
+    ret += std::to_string(item_id);
+    return ret;
+}
+
+bool fetch_scheduler_t::task_after(const task_t& a, const task_t& b) const
+{
+    
+    // Probe every region before anything else so that sizes are known early.
+    bool a_is_probe = a.page == 1 && a.type_ix == whole_region_;
+    bool b_is_probe = b.page == 1 && b.type_ix == whole_region_;
+    if (a_is_probe != b_is_probe)
+        return b_is_probe;
+    
+    // Largest region first
+    unsigned a_num_pages = this->regions_[a.region_ix].num_pages;
+    unsigned b_num_pages = this->regions_[b.region_ix].num_pages;
+    if (a_num_pages != b_num_pages)
+        return a_num_pages < b_num_pages;
+    
+    if (a.region_ix != b.region_ix)
+        return a.region_ix > b.region_ix;
+    if (a.type_ix != b.type_ix)
+        return a.type_ix > b.type_ix;
+    return a.page > b.page;
+    
+}
+
+void fetch_scheduler_t::push_task(unsigned region_ix, unsigned page, unsigned type_ix)
+{
+    
+    this->regions_[region_ix].num_outstanding++;
+    this->tasks_.push_back({region_ix, page, type_ix});
+    std::push_heap
+    (
+        this->tasks_.begin(),
+        this->tasks_.end(),
+        [this](const task_t& a, const task_t& b){ return this->task_after(a, b); }
+    );
+    
+    this->progress_->total(this->progress_->total() + 1);
+    
+    // The I/O task doesn't know which page it will fetch until it runs, so
+    // pages queued later but ranked higher still go first.
+    task_scheduler_t::instance().submit(*this->group_, task_scheduler_t::pool_t::IO, [this]{ this->fetch_next_page(); });
+    
+}
+
+void fetch_scheduler_t::push_page(unsigned region_ix, unsigned page_ix, Json::Value& json_payload)
+{
+    
+    region_state_t& region = this->regions_[region_ix];
+    region.num_orders_fetched += json_payload.size();
+    
+    if (region.pages.size() <= page_ix)
+        region.pages.resize(page_ix + 1);
+    region.pages[page_ix].reset(new page_t);
+    page_t* page = region.pages[page_ix].get();
+    page->payload = std::move(json_payload);
+    
+    region.decodes.push_back
+    (
+        task_scheduler_t::instance().submit(*this->group_, task_scheduler_t::pool_t::CPU, [this, region_ix, page]{ this->decode_page(region_ix, page); })
+    );
+    
+}
+
+bool fetch_scheduler_t::region_finished(const region_state_t& region) const
+{
+    if (region.num_outstanding != 0)
+        return false;
+    return region.failed || region.num_pages_known || region.last_page_seen;
+}
+
+void fetch_scheduler_t::decode_page(unsigned region_ix, page_t* page)
+{
+    
+    // regions_ is never resized during a fetch and the page belongs to this
+    // task alone until the region is aggregated.
+    region_state_t& region = this->regions_[region_ix];
+    
+    try
+    {
+        region.raw_regional_market.decode_page(page->payload, page->orders);
+    } catch (const error_message_t& error) {
+        
+        std::string message("\nWarning.  Failed to decode market orders for region ");
+        message += std::to_string(region.region_id);
+        message += ".  ";
+        message += error.message();
+        std::cout << message << std::flush;
+        
+        std::lock_guard<std::mutex> lock(this->queue_lock_);
+        region.decode_failed = true;
+        
+    }
+    page->payload = Json::Value();
+    
+}
+
+void fetch_scheduler_t::finish_region(unsigned region_ix)
+{
+    
+    // Every fetch and decode of the region has finished, so the lock is not
+    // needed here.
+    region_state_t& region = this->regions_[region_ix];
+    regional_market_t& regional_market = (*this->output_)[region_ix];
+    regional_market.region_id(region.region_id);
+    
+    if (!region.decode_failed)
+    {
+        
+        // Skip pages that were never filled in because of a failure
+        std::vector< std::vector<raw_order_t> > pages;
+        pages.reserve(region.pages.size());
+        for (std::unique_ptr<page_t>& cur_page : region.pages)
+            if (cur_page != nullptr)
+                pages.emplace_back(std::move(cur_page->orders));
+        
+        region.raw_regional_market.initialize_from_pages(pages, region.num_orders_fetched);
+        pages.clear();
+        
+        regional_market.initialize_from_raw_regional_market(region.raw_regional_market);
+        
+    }
+    
+    region.pages.clear();
+    region.decodes.clear();
+    region.raw_regional_market.clear();
+    
+}
+
+void fetch_scheduler_t::fetch_next_page()
+{
+    
+    auto heap_compare = [this](const task_t& a, const task_t& b){ return this->task_after(a, b); };
+    
+    // One I/O task is submitted per queued page, so the heap is never empty
+    // here, although this may not be the page the task was submitted for.
+    std::unique_lock<std::mutex> lock(this->queue_lock_);
+    std::pop_heap(this->tasks_.begin(), this->tasks_.end(), heap_compare);
+    task_t task = this->tasks_.back();
+    this->tasks_.pop_back();
+    
+    // regions_ is never resized during a fetch, so this reference stays
+    // valid while the lock is released.
+    region_state_t& region = this->regions_[task.region_ix];
+    
+    // Fetch without holding the lock.  Pages of regions which already failed
+    // are dropped.
+    bool fetched = false;
+    Json::Value json_payload;
+    unsigned num_pages = 0;
+    fetch_planner_t::strategy_t strategy = fetch_planner_t::strategy_t::FULL_REGION;
+    if (!region.failed)
+    {
+        
+        uint64_t region_id = region.region_id;
+        lock.unlock();
+        
+        try
+        {
+            
+            uint64_t num_bytes = page_fetcher_t::fetch_page
+            (
+                task.type_ix == whole_region_ ? fetch_scheduler_t::base_url(region_id) : fetch_scheduler_t::type_url(region_id, this->fetch_planner_.item_ids()[task.type_ix]),
+                task.page,
+                this->readers_[task_scheduler_t::current_worker()].get(),
+                this->debug_mode_,
+                json_payload,
+                task.page == 1 ? &num_pages : nullptr
+            );
+            this->progress_->increment(1, num_bytes);
+            fetched = true;
+            
+            // Now that the size of the region is known, decide how to fetch
+            // the rest of it
+            if (task.page == 1 && task.type_ix == whole_region_ && num_pages > 1 && !this->fetch_planner_.item_ids().empty())
+            {
+                std::unordered_set<uint64_t> page_types;
+                for (const Json::Value& json_cur_order : json_payload)
+                    page_types.insert(json_cur_order["type_id"].asUInt64());
+                strategy = this->fetch_planner_.plan(num_pages, num_bytes, page_types.size());
+            }
+            
+        } catch (const error_message_t& error) {
+            std::string message("\nWarning.  Failed to fetch page ");
+            message += std::to_string(task.page);
+            message += " of region ";
+            message += std::to_string(region_id);
+            message += ".  ";
+            message += error.message();
+            std::cout << message << std::flush;
+        }
+        
+        lock.lock();
+        
+    }
+    
+    if (!fetched)
+    {
+        region.failed = true;
+    } else if (task.type_ix != whole_region_) {
+        
+        // Pages of one item type can arrive in any order
+        if (task.page == 1)
+        {
+            for (unsigned page = 2; page <= num_pages; page++)
+                this->push_task(task.region_ix, page, task.type_ix);
+        }
+        if (!json_payload.empty())
+            this->push_page(task.region_ix, region.pages.size(), json_payload);
+        
+    } else if (json_payload.empty()) {
+        // The last page is indicated by an empty page
+        region.last_page_seen = true;
+    } else {
+        
+        // The probe tells us how many more pages or item types to queue
+        if (task.page == 1 && num_pages != 0)
+        {
+            region.num_pages = num_pages;
+            region.num_pages_known = true;
+            if (strategy == fetch_planner_t::strategy_t::PER_TYPE)
+            {
+                region.per_type = true;
+                for (unsigned type_ix = 0, num_types = this->fetch_planner_.item_ids().size(); type_ix < num_types; type_ix++)
+                    this->push_task(task.region_ix, 1, type_ix);
+            } else {
+                region.pages.resize(num_pages);
+                for (unsigned page = 2; page <= num_pages; page++)
+                    this->push_task(task.region_ix, page);
+            }
+        }
+        
+        // The type queries return the relevant orders of page 1 again, so it
+        // is dropped if the region is fetched by type
+        if (!region.per_type)
+            this->push_page(task.region_ix, task.page - 1, json_payload);
+        
+        // Without a page count, walk forward one page at a time
+        if (!region.num_pages_known)
+        {
+            region.num_pages = task.page + 1;
+            this->push_task(task.region_ix, task.page + 1);
+        }
+        
+    }
+    
+    // Aggregation is CPU work, so hand it over rather than keep this I/O
+    // worker from fetching.  It waits for every decode of the region.
+    region.num_outstanding--;
+    if (this->region_finished(region))
+    {
+        unsigned region_ix = task.region_ix;
+        task_scheduler_t::instance().submit(*this->group_, task_scheduler_t::pool_t::CPU, [this, region_ix]{ this->finish_region(region_ix); }, region.decodes);
+    }
+    
+}
+
+std::vector<regional_market_t> fetch_scheduler_t::fetch()
+{
+    
+    unsigned num_regions = this->region_ids_.size();
+    std::vector<regional_market_t> ret(num_regions);
+    if (num_regions == 0)
+        return ret;
+    
+    task_scheduler_t& scheduler = task_scheduler_t::instance();
+    unsigned num_threads = scheduler.num_workers(task_scheduler_t::pool_t::IO);
+    if (this->debug_mode_.verbose())
+        std::cout << "Fetching market orders from " << num_regions << " regions using " << num_threads << " worker threads.\n";
+    
+    // Workers only bump counters.  The status line is drawn by its own
+    // thread, and only if stdout is a terminal.
+    progress_reporter_t progress("Fetching market orders", "pages", 0, this->debug_mode_.verbose());
+    this->progress_ = &progress;
+    
+    // Create a JSON decoder for each I/O worker
+    Json::CharReaderBuilder builder;
+    this->readers_.clear();
+    for (unsigned ix = 0; ix < num_threads; ix++)
+        this->readers_.emplace_back(builder.newCharReader());
+    
+    // Every fetch, decode and aggregation of every region belongs to this
+    // group, so waiting on it waits for all of them.
+    task_scheduler_t::task_group_t group;
+    this->group_ = &group;
+    this->output_ = &ret;
+    
+    // Reset bookkeeping and probe page 1 of every region
+    this->regions_.clear();
+    this->regions_.resize(num_regions);
+    this->tasks_.clear();
+    this->queue_lock_.lock();
+    for (unsigned ix = 0; ix < num_regions; ix++)
+    {
+        region_state_t& cur_region = this->regions_[ix];
+        cur_region.region_id = this->region_ids_[ix];
+        cur_region.num_pages = 1;
+        cur_region.num_pages_known = false;
+        cur_region.last_page_seen = false;
+        cur_region.per_type = false;
+        cur_region.failed = false;
+        cur_region.decode_failed = false;
+        cur_region.num_outstanding = 0;
+        cur_region.num_orders_fetched = 0;
+        cur_region.raw_regional_market.debug_mode(this->debug_mode_);
+        cur_region.raw_regional_market.ingest_filter(this->ingest_filter_);
+        cur_region.raw_regional_market.region_id(cur_region.region_id);
+        this->push_task(ix, 1);
+    }
+    this->queue_lock_.unlock();
+    group.wait();
+    
+    progress.stop();
+    this->progress_ = nullptr;
+    this->group_ = nullptr;
+    this->output_ = nullptr;
+    this->readers_.clear();
+    this->regions_.clear();
+    
+    return ret;
+    
+}
@@ -0,0 +1,266 @@
+/// @file fetch_scheduler.h
+/// @brief Declaration of @ref fetch_scheduler_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_FETCH_SCHEDULER
+#define HEADER_GUARD_FETCH_SCHEDULER
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "debug_mode.h"
+#include "error.h"
+#include "fetch_planner.h"
+#include "ingest_filter.h"
+#include "json.h"
+#include "progress_reporter.h"
+#include "raw_order.h"
+#include "raw_regional_market.h"
+#include "regional_market.h"
+#include "station_attributes.h"
+#include "task_scheduler.h"
+
+/// @brief Fetches the market orders of several regions at once on the I/O
+/// pool of @ref task_scheduler_t.
+///
+/// Every page is its own I/O task.  Page 1 of every region is requested
+/// first.  Its X-Pages header tells us how large each region is, so the
+/// remaining pages are queued largest region first and small regions fill the
+/// slots left idle by the tail of the large ones.  Regions whose size is not
+/// reported fall back to fetching one page at a time until an empty page is
+/// seen.  If the @ref fetch_planner finds it cheaper, a large region is
+/// instead fetched with one query per relevant item type, which share the
+/// queue with every other page.
+///
+/// Each fetched page is decoded by its own task on the CPU pool, and once the
+/// last page of a region is in, the region is aggregated by a CPU task which
+/// depends on all of its decodes.  CPU work therefore overlaps with the
+/// remaining network traffic without holding up an I/O worker.
+class fetch_scheduler_t
+{
+        
+    public:
+        
+        /// @brief Default constructor
+        inline fetch_scheduler_t()
+          : group_(nullptr),
+            output_(nullptr),
+            progress_(nullptr)
+        {
+            // All work done in initializer list
+        }
+        
+        // Add member initialization constructors here
+        // Try to use initializer lists when possible.
+        
+        // Add operators here if desired.
+        
+        // Add member read and write functions
+        
+        inline const std::vector<uint64_t>& region_ids() const
+        {
+            return this->region_ids_;
+        }
+        
+        inline const debug_mode_t& debug_mode() const
+        {
+            return this->debug_mode_;
+        }
+        
+        inline void debug_mode(const debug_mode_t& new_debug_mode)
+        {
+            this->debug_mode_ = new_debug_mode;
+        }
+        
+        /// @brief Applied to every region as it is decoded and aggregated.
+        inline const ingest_filter_t& ingest_filter() const
+        {
+            return this->ingest_filter_;
+        }
+        
+        inline void ingest_filter(const ingest_filter_t& new_ingest_filter)
+        {
+            this->ingest_filter_ = new_ingest_filter;
+        }
+        
+        /// @brief Consulted after page 1 of each region to choose between
+        /// paging through the region and querying each item type.
+        inline const fetch_planner_t& fetch_planner() const
+        {
+            return this->fetch_planner_;
+        }
+        
+        inline void fetch_planner(const fetch_planner_t& new_fetch_planner)
+        {
+            this->fetch_planner_ = new_fetch_planner;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Forget all requested regions.
+        inline void clear()
+        {
+            this->region_ids_.clear();
+        }
+        
+        /// @brief Request a region.  Duplicates are ignored.
+        void add_region(uint64_t region_id);
+        
+        /// @brief Request the region of every station.  Regions containing
+        /// several stations are only fetched once.
+        void add_regions(const station_attributes_t& station_attributes);
+        
+        /// @brief Fetch, decode and aggregate every requested region.  At most
+        /// one HTTPS request is in flight per I/O worker, across all regions.
+        ///
+        /// @return One market for each requested region, in the same order
+        /// as @ref region_ids.
+        std::vector<regional_market_t> fetch();
+        
+    protected:
+        
+        /// @brief One fetched page waiting to be decoded.
+        struct page_t
+        {
+            /// @brief Parsed page.  Released once decoded.
+            Json::Value payload;
+            /// @brief Orders kept by @ref ingest_filter.
+            std::vector<raw_order_t> orders;
+        };
+        
+        /// @brief Bookkeeping for one region while @ref fetch is running.
+        struct region_state_t
+        {
+            /// @brief See @ref regional_market_t::region_id.
+            uint64_t region_id;
+            /// @brief Number of pages reported by the server, or the number
+            /// of pages requested so far if the server didn't say.
+            unsigned num_pages;
+            /// @brief True if the server reported @ref num_pages.
+            bool num_pages_known;
+            /// @brief True once an empty page was seen, for regions whose
+            /// size is not known.
+            bool last_page_seen;
+            /// @brief True if the region is fetched one item type at a time
+            /// instead of page by page.
+            bool per_type;
+            /// @brief True if a request failed.  Remaining pages are skipped
+            /// and whatever was fetched is still aggregated.
+            bool failed;
+            /// @brief True if a page could not be decoded, in which case the
+            /// region is left empty.
+            bool decode_failed;
+            /// @brief Pages which are queued or being fetched.
+            unsigned num_outstanding;
+            /// @brief Orders on the fetched pages before filtering.
+            unsigned num_orders_fetched;
+            /// @brief Fetched pages, indexed by page number - 1.  Pages of
+            /// per type queries are appended in the order they arrive.
+            /// Entries are null for pages which were not fetched.  Pointers
+            /// so that decode tasks are unaffected when this is resized.
+            std::vector< std::unique_ptr<page_t> > pages;
+            /// @brief One decode task per entry of @ref pages.
+            std::vector<task_scheduler_t::task_handle_t> decodes;
+            /// @brief Carries the region, filter and debug mode used to
+            /// decode each page, and finally the decoded orders.
+            raw_regional_market_t raw_regional_market;
+        };
+        
+        /// @brief One page of one region.
+        struct task_t
+        {
+            /// @brief Index into @ref regions_.
+            unsigned region_ix;
+            /// @brief Page number starting at 1.
+            unsigned page;
+            /// @brief Index into @ref fetch_planner_t::item_ids of the type
+            /// queried, or @ref whole_region_ for a page of the whole region.
+            unsigned type_ix;
+        };
+        
+        /// @brief See @ref task_t::type_ix.
+        static constexpr unsigned whole_region_ = ~0u;
+        
+        /// @brief Body of each I/O task.  Fetches the best queued page and
+        /// queues whatever work it leads to.
+        void fetch_next_page();
+        
+        /// @brief Queue a page and submit an I/O task to fetch it.
+        /// @ref queue_lock_ must be held.
+        void push_task(unsigned region_ix, unsigned page, unsigned type_ix = whole_region_);
+        
+        /// @brief True if the queued task a should be fetched after b.
+        /// Probes come first, then larger regions, then lower pages.
+        bool task_after(const task_t& a, const task_t& b) const;
+        
+        /// @brief Store a fetched page at pages[page_ix] of a region and
+        /// submit a CPU task to decode it.  @ref queue_lock_ must be held.
+        void push_page(unsigned region_ix, unsigned page_ix, Json::Value& json_payload);
+        
+        /// @brief Called with @ref queue_lock_ held after a task of a region
+        /// finishes.  Returns true if the region has no more work, in which
+        /// case the caller must aggregate it.
+        bool region_finished(const region_state_t& region) const;
+        
+        /// @brief Decode one page.  Runs as a task on the CPU pool.
+        void decode_page(unsigned region_ix, page_t* page);
+        
+        /// @brief Aggregate the decoded pages of a finished region into
+        /// @ref output_.  Runs as a task on the CPU pool once every decode of
+        /// the region has finished.
+        void finish_region(unsigned region_ix);
+        
+        /// @brief URL of the market orders of a region, without a "&page=x"
+        /// suffix.
+        static std::string base_url(uint64_t region_id);
+        
+        /// @brief URL of the market orders of one item type in a region,
+        /// without a "&page=x" suffix.
+        static std::string type_url(uint64_t region_id, uint64_t item_id);
+        
+        /// @brief Requested regions, in the order they were added.
+        std::vector<uint64_t> region_ids_;
+        
+        /// @brief Controls verbose printing, statistics and tracing.
+        debug_mode_t debug_mode_;
+        
+        /// @brief See @ref ingest_filter.
+        ingest_filter_t ingest_filter_;
+        
+        /// @brief See @ref fetch_planner.
+        fetch_planner_t fetch_planner_;
+        
+        /// @brief One entry per element of @ref region_ids_.  Only valid
+        /// during @ref fetch.
+        std::vector<region_state_t> regions_;
+        
+        /// @brief Binary heap of pages waiting for a worker, ordered by
+        /// @ref task_after.
+        std::vector<task_t> tasks_;
+        
+        /// @brief Guards @ref regions_ and @ref tasks_.
+        std::mutex queue_lock_;
+        
+        /// @brief Group of every task of the current fetch, null otherwise.
+        task_scheduler_t::task_group_t* group_;
+        
+        /// @brief Return value of the current fetch, null otherwise.
+        std::vector<regional_market_t>* output_;
+        
+        /// @brief One JSON decoder per I/O worker, indexed by
+        /// @ref task_scheduler_t::current_worker.
+        std::vector< std::unique_ptr<Json::CharReader> > readers_;
+        
+        /// @brief Counts pages while @ref fetch is running, null otherwise.
+        progress_reporter_t* progress_;
+        
+};
+
+#endif // Header Guard
+
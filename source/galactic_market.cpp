@@ -12,7 +12,53 @@
 #include "error.h"
 #include "json.h"
 #include "galactic_market.h"
+#include "item_market.h"
+#include "price_delta.h"
 #include "regional_market.h"
+#include "station_market.h"
+
+void galactic_market_t::apply_delta(const price_delta_t& delta)
+{
+    
+    for (const price_delta_t::region_delta_t& cur_region_delta : delta.regions())
+    {
+        
+        regional_market_t& cur_region = this->find_or_allocate(cur_region_delta.region_id);
+        cur_region.region_id(cur_region_delta.region_id);
+        
+        for (const price_delta_t::station_delta_t& cur_station_delta : cur_region_delta.stations)
+        {
+            
+            station_market_t& cur_station = cur_region.find_or_allocate(cur_station_delta.station_id);
+            cur_station.station_id(cur_station_delta.station_id);
+            
+            // Replace the orders of changed items with their new best prices
+            for (const price_delta_t::item_change_t& cur_change : cur_station_delta.changed_items)
+            {
+                item_market_t& cur_item = cur_station.find_or_allocate(cur_change.item_id);
+                cur_item.item_id(cur_change.item_id);
+                cur_item.clear_buy_orders();
+                cur_item.clear_sell_orders();
+                if (cur_change.has_buy_order)
+                    cur_item.new_buy_order(cur_change.max_buy_order);
+                if (cur_change.has_sell_order)
+                    cur_item.new_sell_order(cur_change.min_sell_order);
+            }
+            
+            for (uint64_t cur_item_id : cur_station_delta.removed_items)
+                cur_station.erase_item_market(cur_item_id);
+            
+            if (cur_station.items().empty())
+                cur_region.erase_station_market(cur_station_delta.station_id);
+                
+        }
+        
+        if (cur_region.stations().empty())
+            this->regions_.erase(cur_region_delta.region_id);
+            
+    }
+    
+}
 
 void galactic_market_t::read_from_json_file(std::istream& file)
 {
@@ -108,7 +154,7 @@ void galactic_market_t::write_to_json_buffer(std::string& buffer, unsigned inden
         buffer += indent_2;
         unsigned num_regions_processed = 0;
         unsigned last_region_to_process = num_regions - 1;
-        for (const std::pair<uint64_t, regional_market_t>& cur_pair : this->regions_)
+        for (const std::pair<const uint64_t, regional_market_t>& cur_pair : this->regions_)
         {
             
             const regional_market_t& cur_regional_market = cur_pair.second;
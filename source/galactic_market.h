@@ -17,6 +17,8 @@
 #include "regional_market.h"
 #include "json.h"
 
+class price_delta_t;
+
 /// @brief Contains all of the buy and sell orders at a particular region.
 class galactic_market_t
 {
@@ -76,6 +78,12 @@ class galactic_market_t
             this->regions_.emplace(new_regional_market.region_id(), new_regional_market);
         }
         
+        inline void add_new_regional_market(regional_market_t&& new_regional_market)
+        {
+            uint64_t region_id = new_regional_market.region_id();
+            this->regions_.emplace(region_id, std::move(new_regional_market));
+        }
+        
         /// @brief Search for an region with a given ID.  If that region market
         /// already existed, return a reference to that region.  If the region didn't
         /// exist, allocate a new empty market for that region and return a reference
@@ -103,6 +111,13 @@ class galactic_market_t
                 cur_region_node.second.cull_unavailable_orders();
         }
         
+        /// @brief Bring this market up to date with a delta generated by
+        /// @ref price_delta_t::initialize_from_markets.
+        ///
+        /// Changed items are left with only their best buy and sell order.
+        /// Stations and regions with no items left are removed.
+        void apply_delta(const price_delta_t& delta);
+        
         /// @brief Open a file conforming to data/json/schema.json and use it to initialize
         /// this object, clearing previous content.
         ///
@@ -9,32 +9,100 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
+#include "build_tree.h"
 #include "error.h"
 #include "galactic_market.h"
 #include "galactic_profits.h"
+#include "industry_profile.h"
+#include "industry_profiles.h"
 #include "json.h"
+#include "profit_matrix.h"
+#include "station_market.h"
+#include "task_scheduler.h"
 
 void galactic_profits_t::caclulate_station_profits
 (
     const blueprints_t& blueprints,
     const galactic_market_t& galactic_market,
-    blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy
+    blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy,
+    const best_price_index_t* best_prices,
+    const build_tree_t* build_tree,
+    unsigned runs_per_job,
+    const industry_profiles_t* profiles
 ){
     
     // Clear previous content
     this->station_profits_.clear();
     
-    // Iterate through each station with a market hub
-    for (const std::pair<uint64_t, regional_market_t>& cur_regional_market : galactic_market.regions())
+    // Fold each profile's bonuses into a few multipliers once, rather than
+    // once per blueprint and station
+    std::vector<industry_profile_t::modifiers_t> modifiers_table;
+    if (profiles != nullptr)
+        modifiers_table = profiles->modifiers_table();
+    else
+        modifiers_table.push_back(industry_profile_t::no_modifiers);
+    
+    unsigned num_profiles = modifiers_table.size();
+    
+    // Every station with a market hub, in output order
+    std::vector<const station_market_t*> station_markets;
+    for (const std::pair<const uint64_t, regional_market_t>& cur_regional_market : galactic_market.regions())
+    {
+        for (const std::pair<const uint64_t, station_market_t>& cur_station_market : cur_regional_market.second.stations())
+            station_markets.push_back(&cur_station_market.second);
+    }
+    unsigned num_stations = station_markets.size();
+    
+    // Without a build tree, the cost of every blueprint is linear in the
+    // prices at a station and is compiled once for all stations
+    std::vector<profit_matrix_t> profit_matrices;
+    if (build_tree == nullptr)
     {
-        for (const std::pair<uint64_t, station_market_t>& cur_station_market : cur_regional_market.second.stations())
+        profit_matrices.resize(num_profiles);
+        for (unsigned profile_ix = 0; profile_ix < num_profiles; profile_ix++)
+            profit_matrices[profile_ix].initialize_from_blueprints(blueprints, runs_per_job, modifiers_table[profile_ix]);
+    }
+    
+    // Reused between stations to avoid rehashing
+    task_scheduler_t& scheduler = task_scheduler_t::instance();
+    std::vector<build_tree_t::item_costs_t> item_costs(scheduler.num_workers(task_scheduler_t::pool_t::CPU));
+    
+    // One task per profile and station
+    this->station_profits_.resize(num_profiles * num_stations);
+    scheduler.parallel_for
+    (
+        num_profiles * num_stations,
+        1,
+        [&](unsigned ix)
         {
-            station_profits_t new_station_profits;
-            new_station_profits.calculate_blueprint_profits(blueprints, cur_station_market.second, decryptor_optimization_strategy);
-            this->station_profits_.emplace_back(std::move(new_station_profits));
+            
+            unsigned profile_ix = ix / num_stations;
+            const industry_profile_t::modifiers_t& modifiers = modifiers_table[profile_ix];
+            const station_market_t& station_market = *station_markets[ix % num_stations];
+            
+            // Cost every intermediate once for this station, so each
+            // blueprint using it only needs a lookup
+            const build_tree_t::item_costs_t* build_costs = nullptr;
+            if (build_tree != nullptr)
+            {
+                build_tree_t::item_costs_t& worker_item_costs = item_costs[task_scheduler_t::current_worker()];
+                build_tree->resolve(blueprints, station_market, best_prices, worker_item_costs, runs_per_job, modifiers);
+                build_costs = &worker_item_costs;
+            }
+            
+            station_profits_t& new_station_profits = this->station_profits_[ix];
+            new_station_profits.debug_mode(this->debug_mode_);
+            if (profiles != nullptr)
+                new_station_profits.profile(profiles->profiles()[profile_ix].name());
+            if (build_tree == nullptr)
+                new_station_profits.calculate_blueprint_profits(profit_matrices[profile_ix], blueprints, station_market, decryptor_optimization_strategy, best_prices);
+            else
+                new_station_profits.calculate_blueprint_profits(blueprints, station_market, decryptor_optimization_strategy, best_prices, build_costs, runs_per_job, modifiers);
+            
         }
-    }
+    );
     
 }
 
@@ -136,11 +204,25 @@ void galactic_profits_t::write_to_json_buffer
     // enable chaining.
     buffer += "[\n";
     
-    // Encode each station's profit report.
+    // Encode each station's profit report on its own, since sorting and
+    // formatting the blueprints dominates.  The reports are joined in order.
+    std::vector<std::string> station_buffers(num_stations);
+    task_scheduler_t::instance().parallel_for
+    (
+        num_stations,
+        1,
+        [&](unsigned ix)
+        {
+            this->station_profits_[ix].write_to_json_buffer(station_buffers[ix], output_order, blueprint_names, indent_start + spaces_per_tab, spaces_per_tab);
+        }
+    );
+    
     buffer += indent_1;
     for (unsigned ix = 0, last_ix = num_stations - 1; ix <= last_ix; ix++)
     {
-        this->station_profits_[ix].write_to_json_buffer(buffer, output_order, blueprint_names, indent_start + spaces_per_tab, spaces_per_tab);
+        buffer += station_buffers[ix];
+        station_buffers[ix].clear();
+        station_buffers[ix].shrink_to_fit();
         if (ix == last_ix)
             buffer += '\n';
         else
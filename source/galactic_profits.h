@@ -12,12 +12,15 @@
 #include <string_view>
 #include <vector>
 
+#include "build_tree.h"
+#include "debug_mode.h"
 #include "error.h"
 #include "json.h"
 #include "station_profits.h"
 
 class blueprints_t;
 class galactic_market_t;
+class industry_profiles_t;
 
 /// @brief Reports on all blueprint profitabilities across all stations.
 class galactic_profits_t
@@ -32,7 +35,7 @@ class galactic_profits_t
         // Try to use initializer lists when possible.
         
         // Add operators here if desired.
-
+        
         // Add member read and write functions
         
         const std::vector<station_profits_t>& station_profits() const
@@ -40,6 +43,16 @@ class galactic_profits_t
             return this->station_profits_;
         }
         
+        inline const debug_mode_t& debug_mode() const
+        {
+            return this->debug_mode_;
+        }
+        
+        inline void debug_mode(const debug_mode_t& new_debug_mode)
+        {
+            this->debug_mode_ = new_debug_mode;
+        }
+        
         // Add special-purpose functions here
         
         /// @brief Initialize this object by calculating profit margins for
@@ -48,7 +61,19 @@ class galactic_profits_t
         (
             const blueprints_t& blueprints,
             const galactic_market_t& galactic_market,
-            blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy
+            blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy,
+            /// If not null, materials and products at each station are
+            /// sourced from the best station in the galaxy.
+            const best_price_index_t* best_prices = nullptr,
+            /// If not null, intermediates are built instead of bought whenever
+            /// that is cheaper.  The tree is resolved once per station.
+            const build_tree_t* build_tree = nullptr,
+            /// Number of runs in each manufacturing job, see
+            /// @ref blueprint_profit_t::initialize_from_market
+            unsigned runs_per_job = 1,
+            /// If not null, every station is evaluated once per profile and
+            /// each @ref station_profits_t is labelled with the profile name.
+            const industry_profiles_t* profiles = nullptr
         );
         
         // Add encoders/decoders here
@@ -132,6 +157,9 @@ class galactic_profits_t
         /// @brief Blueprint profitability for each station.
         std::vector<station_profits_t> station_profits_;
         
+        /// @brief Controls verbose printing and statistics collection
+        debug_mode_t debug_mode_;
+        
 };
 
 /// @brief Convenience alias to allow printing directly via cout or similar.
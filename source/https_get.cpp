@@ -34,8 +34,10 @@
 #include <curl/curl.h>
 #include <iostream>
 #include <string>
+#include <strings.h>
 
 #include "error.h"
+#include "https_get.h"
 
 /// \brief Recieve a burst of data from the network and append it to a more
 /// permanent buffer.
@@ -46,7 +48,44 @@ static size_t recieve_burst(void* buffer, size_t size, size_t nmemb, void* str)
     return size_t(num_chars);
 }
 
+/// \brief Called by curl once for each response header line.  Looks for
+/// "X-Pages: N", ignoring case, and stores N.
+static size_t recieve_header(char* buffer, size_t size, size_t nitems, void* num_pages)
+{
+    
+    size_t num_chars = nitems * size;
+    
+    static const char prefix[] = "x-pages:";
+    const size_t prefix_length = sizeof(prefix) - 1;
+    if (num_chars > prefix_length && strncasecmp(buffer, prefix, prefix_length) == 0)
+    {
+        unsigned value = 0;
+        for (size_t ix = prefix_length; ix < num_chars; ix++)
+        {
+            char cur_char = buffer[ix];
+            if (cur_char >= '0' && cur_char <= '9')
+                value = value * 10 + unsigned(cur_char - '0');
+            else if (cur_char != ' ' && cur_char != '\t')
+                break;
+        }
+        *((unsigned*)(num_pages)) = value;
+    }
+    
+    return num_chars;
+    
+}
+
 std::string https_get(const std::string& url)
+{
+    return https_get(url, nullptr, nullptr);
+}
+
+std::string https_get(const std::string& url, https_get_timing_t* timing)
+{
+    return https_get(url, timing, nullptr);
+}
+
+std::string https_get(const std::string& url, https_get_timing_t* timing, unsigned* num_pages)
 {
     
     // This buffer will accumulate all the text recieved from the FTP GET
@@ -74,6 +113,14 @@ std::string https_get(const std::string& url)
     // Set a pointer to our struct to pass to the callback
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ret);
     
+    // Only inspect headers if somebody asked for the page count
+    if (num_pages != nullptr)
+    {
+        *num_pages = 0;
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, recieve_header);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, num_pages);
+    }
+    
     // We activate SSL and we require it for both control and data
     curl_easy_setopt(curl, CURLOPT_USE_SSL, CURLUSESSL_ALL);
     
@@ -99,6 +146,29 @@ std::string https_get(const std::string& url)
         
     }
     
+    // Report where the time went before the handle is destroyed.  Phases
+    // which did not happen report zero, so clamp them to the previous phase
+    // to keep the timeline monotonic.
+    if (timing != nullptr)
+    {
+        curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME, &timing->name_lookup);
+        curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME, &timing->connect);
+        curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME, &timing->tls_handshake);
+        curl_easy_getinfo(curl, CURLINFO_PRETRANSFER_TIME, &timing->pre_transfer);
+        curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME, &timing->start_transfer);
+        curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &timing->total);
+        if (timing->connect < timing->name_lookup)
+            timing->connect = timing->name_lookup;
+        if (timing->tls_handshake < timing->connect)
+            timing->tls_handshake = timing->connect;
+        if (timing->pre_transfer < timing->tls_handshake)
+            timing->pre_transfer = timing->tls_handshake;
+        if (timing->start_transfer < timing->pre_transfer)
+            timing->start_transfer = timing->pre_transfer;
+        if (timing->total < timing->start_transfer)
+            timing->total = timing->start_transfer;
+    }
+    
     // always cleanup
     curl_easy_cleanup(curl);
     curl_global_cleanup();
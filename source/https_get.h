@@ -8,7 +8,7 @@
 /// Target OS:                      Ubuntu Linux 16.04 \n
 /// Target architecture:            x86 64-bit \n
 /// See documentation/html_out/index.html for documentation.
- 
+
 //***************************************************************************
 // *                                  _   _ ____  _
 // *  Project                     ___| | | |  _ \| |
@@ -36,9 +36,39 @@
 
 #include <string>
 
+/// \brief Breakdown of where time went during one request.  Each field is
+/// the number of seconds between the start of the request and the end of a
+/// phase, as reported by curl_easy_getinfo.  Phases which were skipped, such
+/// as the TLS handshake on a reused connection, have the same value as the
+/// phase before them.
+struct https_get_timing_t
+{
+    /// \brief CURLINFO_NAMELOOKUP_TIME, when DNS resolution finished.
+    double name_lookup;
+    /// \brief CURLINFO_CONNECT_TIME, when the TCP connection was established.
+    double connect;
+    /// \brief CURLINFO_APPCONNECT_TIME, when the TLS handshake finished.
+    double tls_handshake;
+    /// \brief CURLINFO_PRETRANSFER_TIME, when the request was about to be sent.
+    double pre_transfer;
+    /// \brief CURLINFO_STARTTRANSFER_TIME, when the first byte was received.
+    double start_transfer;
+    /// \brief CURLINFO_TOTAL_TIME, when the transfer completed.
+    double total;
+};
+
 /// \brief Fetches the raw webpage or file at the given URL and packages the
 /// results in the returned string.
 std::string https_get(const std::string& url);
 
+/// \brief Same as above, but if timing is not null, it is filled out with the
+/// duration of each phase of a successful request.
+std::string https_get(const std::string& url, https_get_timing_t* timing);
+
+/// \brief Same as above, but if num_pages is not null, it is set to the value
+/// of the X-Pages response header which the EvE API uses to report how many
+/// pages a paginated resource has, or 0 if the header was absent.
+std::string https_get(const std::string& url, https_get_timing_t* timing, unsigned* num_pages);
+
 #endif // header guard
 
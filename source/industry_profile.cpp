@@ -0,0 +1,266 @@
+/// @file industry_profile.cpp
+/// @brief Implementation of @ref industry_profile_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "error.h"
+#include "industry_profile.h"
+#include "json.h"
+#include "util.h"
+
+/// @brief Decode an optional skill level, which defaults to 0.
+///
+/// @exception error_message_t
+static unsigned decode_skill_level(const Json::Value& json_root, const char* key)
+{
+    const Json::Value& json_level = json_root[key];
+    if (json_level.isNull())
+        return 0;
+    if (!json_level.isUInt() || json_level.asUInt() > 5)
+    {
+        std::string message("Error.  <industry_profile>/");
+        message += key;
+        message += " was not an integer between 0 and 5.\n";
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, message);
+    }
+    return json_level.asUInt();
+}
+
+/// @brief Decode an optional bonus, tax or fee, which defaults to 0.
+///
+/// @exception error_message_t
+static float decode_percent(const Json::Value& json_root, const char* key)
+{
+    const Json::Value& json_percent = json_root[key];
+    if (json_percent.isNull())
+        return 0.0f;
+    if (!json_percent.isNumeric() || !(json_percent.asFloat() >= 0.0f && json_percent.asFloat() < 100.0f))
+    {
+        std::string message("Error.  <industry_profile>/");
+        message += key;
+        message += " was not a number in [0, 100).\n";
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, message);
+    }
+    return json_percent.asFloat();
+}
+
+/// @brief Decode an optional fraction, such as a cost index, which defaults
+/// to 0.
+///
+/// @exception error_message_t
+static float decode_fraction(const Json::Value& json_root, const char* key)
+{
+    const Json::Value& json_fraction = json_root[key];
+    if (json_fraction.isNull())
+        return 0.0f;
+    if (!json_fraction.isNumeric() || !(json_fraction.asFloat() >= 0.0f && json_fraction.asFloat() < 1.0f))
+    {
+        std::string message("Error.  <industry_profile>/");
+        message += key;
+        message += " was not a number in [0, 1).\n";
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, message);
+    }
+    return json_fraction.asFloat();
+}
+
+industry_profile_t::modifiers_t industry_profile_t::modifiers() const
+{
+    
+    float structure_time = (1.0f - this->structure_time_bonus_percent_ / 100.0f) * (1.0f - this->rig_time_bonus_percent_ / 100.0f);
+    float advanced_industry = 1.0f - 0.03f * float(this->advanced_industry_level_);
+    
+    modifiers_t ret;
+    ret.material_multiplier
+      = (1.0f - this->structure_material_bonus_percent_ / 100.0f)
+      * (1.0f - this->rig_material_bonus_percent_ / 100.0f);
+    ret.manufacturing_time_multiplier
+      = (1.0f - 0.04f * float(this->industry_level_))
+      * advanced_industry
+      * (1.0f - this->implant_time_bonus_percent_ / 100.0f)
+      * structure_time;
+    ret.science_time_multiplier
+      = (1.0f - 0.05f * float(this->science_level_))
+      * advanced_industry
+      * structure_time;
+    ret.job_fee_fraction = this->system_cost_index_ + this->facility_tax_percent_ / 100.0f;
+    ret.sell_fraction = 1.0f - (this->sales_tax_percent_ + this->broker_fee_percent_) / 100.0f;
+    return ret;
+    
+}
+
+void industry_profile_t::read_from_json_file(std::istream& file)
+{
+    
+    // Get the number of characters in the input file.
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_SIZE_FAILED, "Error.  Failed to determine file size when decoding industry_profile_t object.\n");
+    file.seekg(0, std::ios_base::end);
+    unsigned file_size = file.tellg();
+    file.seekg(0, std::ios_base::beg);
+    
+    // Read the entire file into RAM at once
+    std::string buffer(file_size, '\0');
+    file.read(buffer.data(), file_size);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_READ_FAILED, "Error.  Failed to read file when decoding industry_profile_t object.\n");
+    this->read_from_json_buffer(std::string_view(buffer));
+    
+}
+
+void industry_profile_t::read_from_json_buffer(std::string_view buffer)
+{
+    
+    Json::CharReaderBuilder builder;
+    Json::CharReader* reader = builder.newCharReader();
+    
+    Json::Value json_root;
+    std::string error_message;
+    bool success = reader->parse(buffer.begin(), buffer.end(), &json_root, &error_message);
+    delete reader;
+    if (!success)
+        Json::throwRuntimeError(error_message);
+    
+    // Now that the JSON syntax is parsed, extract the stat_list specific
+    // data.
+    this->read_from_json_json(json_root);
+    
+}
+
+void industry_profile_t::read_from_json_json(const Json::Value& json_root)
+{
+    
+    // Parse root
+    if (!json_root.isObject())
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  Root of industry_profile_t is not of type \"object\".\n");
+    
+    // Decode name
+    const Json::Value& json_name = json_root["name"];
+    if (!json_name.isString())
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <industry_profile>/name was not found or not of type \"string\".\n");
+    this->name_ = json_name.asString();
+    
+    // Decode optional character_id
+    const Json::Value& json_character_id = json_root["character_id"];
+    if (json_character_id.isNull())
+    {
+        this->character_id_ = 0;
+    } else if (json_character_id.isUInt64()) {
+        this->character_id_ = json_character_id.asUInt64();
+    } else {
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <industry_profile>/character_id was not of type \"unsigned integer\".\n");
+    }
+    
+    // Everything else is optional and defaults to no bonus
+    this->industry_level_ = decode_skill_level(json_root, "industry_level");
+    this->advanced_industry_level_ = decode_skill_level(json_root, "advanced_industry_level");
+    this->science_level_ = decode_skill_level(json_root, "science_level");
+    this->implant_time_bonus_percent_ = decode_percent(json_root, "implant_time_bonus_percent");
+    this->structure_material_bonus_percent_ = decode_percent(json_root, "structure_material_bonus_percent");
+    this->structure_time_bonus_percent_ = decode_percent(json_root, "structure_time_bonus_percent");
+    this->rig_material_bonus_percent_ = decode_percent(json_root, "rig_material_bonus_percent");
+    this->rig_time_bonus_percent_ = decode_percent(json_root, "rig_time_bonus_percent");
+    this->system_cost_index_ = decode_fraction(json_root, "system_cost_index");
+    this->facility_tax_percent_ = decode_percent(json_root, "facility_tax_percent");
+    this->sales_tax_percent_ = decode_percent(json_root, "sales_tax_percent");
+    this->broker_fee_percent_ = decode_percent(json_root, "broker_fee_percent");
+    
+}
+
+void industry_profile_t::write_to_json_file(std::ostream& file, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    file << this->write_to_json_buffer(indent_start, spaces_per_tab);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when encoding industry_profile_t object.");
+}
+
+void industry_profile_t::write_to_json_buffer(std::string& buffer, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    
+    std::string indent_1(indent_start + 1 * spaces_per_tab, ' ');
+    std::string_view indent_0(indent_1.data(), indent_start);
+    
+    // It is recommended not to start a new line before the opening brace, to
+    // enable chaining.
+    buffer += "{\n";
+    
+    // Encode name
+    buffer += indent_1;
+    buffer += "\"name\": \"";
+    buffer += escape_quotes(this->name_);
+    buffer += "\",\n";
+    
+    // Encode character_id
+    buffer += indent_1;
+    buffer += "\"character_id\": ";
+    buffer += std::to_string(this->character_id_);
+    buffer += ",\n";
+    
+    // Encode skills
+    const std::pair<const char*, unsigned> skill_levels[] =
+    {
+        {"industry_level", this->industry_level_},
+        {"advanced_industry_level", this->advanced_industry_level_},
+        {"science_level", this->science_level_}
+    };
+    for (const std::pair<const char*, unsigned>& cur_skill_level : skill_levels)
+    {
+        buffer += indent_1;
+        buffer += '\"';
+        buffer += cur_skill_level.first;
+        buffer += "\": ";
+        buffer += std::to_string(cur_skill_level.second);
+        buffer += ",\n";
+    }
+    
+    // Encode bonuses, taxes and fees
+    const std::pair<const char*, float> percents[] =
+    {
+        {"implant_time_bonus_percent", this->implant_time_bonus_percent_},
+        {"structure_material_bonus_percent", this->structure_material_bonus_percent_},
+        {"structure_time_bonus_percent", this->structure_time_bonus_percent_},
+        {"rig_material_bonus_percent", this->rig_material_bonus_percent_},
+        {"rig_time_bonus_percent", this->rig_time_bonus_percent_},
+        {"system_cost_index", this->system_cost_index_},
+        {"facility_tax_percent", this->facility_tax_percent_},
+        {"sales_tax_percent", this->sales_tax_percent_},
+        {"broker_fee_percent", this->broker_fee_percent_}
+    };
+    unsigned num_percents = sizeof(percents) / sizeof(percents[0]);
+    for (unsigned ix = 0; ix < num_percents; ix++)
+    {
+        buffer += indent_1;
+        buffer += '\"';
+        buffer += percents[ix].first;
+        buffer += "\": ";
+        buffer += std::to_string(percents[ix].second);
+        buffer += ix + 1 == num_percents ? "\n" : ",\n";
+    }
+    
+    // It is recommended to not put a newline on the last brace to allow
+    // comma chaining when this object is an element of an array.
+    buffer += indent_0;
+    buffer += '}';
+    
+}
+
+std::istream& operator>>(std::istream& stream, industry_profile_t& destination)
+{
+    try
+    {
+        destination.read_from_json_file(stream);
+    } catch (error_message_t error) {
+        stream.setstate(std::ios::failbit);
+        throw error;
+    } catch (Json::Exception error) {
+        stream.setstate(std::ios::failbit);
+        throw error;
+    }
+    return stream;
+}
+
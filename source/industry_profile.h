@@ -0,0 +1,229 @@
+/// @file industry_profile.h
+/// @brief Declaration of @ref industry_profile_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_INDUSTRY_PROFILE
+#define HEADER_GUARD_INDUSTRY_PROFILE
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "error.h"
+#include "json.h"
+
+/// @brief The skills of one character and the structure they build in, which
+/// together change how much every job costs and how long it takes.
+///
+/// Profit calculations don't read the individual bonuses.  They use the
+/// handful of multipliers in @ref modifiers_t, which @ref modifiers folds
+/// every bonus into once per profile.
+class industry_profile_t
+{
+        
+    public:
+        
+        /// @brief Every bonus of a profile reduced to what the profit
+        /// calculation needs.  The default value changes nothing.
+        struct modifiers_t
+        {
+            /// @brief Scales input materials of manufacturing jobs, applied
+            /// on top of blueprint material efficiency.
+            float material_multiplier;
+            /// @brief Scales the time of manufacturing jobs.
+            float manufacturing_time_multiplier;
+            /// @brief Scales the time of copy and invention jobs.
+            float science_time_multiplier;
+            /// @brief Installation fee of a manufacturing job as a fraction
+            /// of the value of its input materials.
+            float job_fee_fraction;
+            /// @brief Fraction of the sale price kept after sales tax and
+            /// broker fees.
+            float sell_fraction;
+        };
+        
+        /// @brief Modifiers of a character with no skills, bonuses or taxes.
+        static constexpr modifiers_t no_modifiers = {1.0f, 1.0f, 1.0f, 0.0f, 1.0f};
+        
+        /// @brief Default constructor
+        inline industry_profile_t() = default;
+        
+        // Add member read and write functions
+        
+        /// @brief Used to label results, for example the character's name.
+        inline const std::string& name() const
+        {
+            return this->name_;
+        }
+        
+        inline void name(std::string_view new_name)
+        {
+            this->name_ = new_name;
+        }
+        
+        /// @brief ID of the character from data/character_ids.csv, or 0 if
+        /// not given.
+        inline uint64_t character_id() const
+        {
+            return this->character_id_;
+        }
+        
+        inline void character_id(uint64_t new_character_id)
+        {
+            this->character_id_ = new_character_id;
+        }
+        
+        /// @brief Sales tax on products, in percent.
+        inline float sales_tax_percent() const
+        {
+            return this->sales_tax_percent_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Fold every skill, implant, structure, rig and tax into the
+        /// multipliers used by @ref blueprint_profit_t.
+        ///
+        /// * Industry: -4% manufacturing time per level
+        /// * Advanced Industry: -3% time of all jobs per level
+        /// * Science: -5% copy and invention time per level
+        /// * Implants: reduce manufacturing time only
+        /// * Structure and rig bonuses: multiply together
+        /// * Job fee: system cost index plus facility tax
+        modifiers_t modifiers() const;
+        
+        // Add encoders/decoders here
+        
+        /// @brief Open a file conforming to data/json/schema.json and use it to initialize
+        /// this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        /// @exception Json::Exception
+        void read_from_json_file(std::istream& file);
+        
+        /// @brief Decode serialized content conforming to data/json/schema.json and use it
+        /// to initialize this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        /// @exception Json::Exception
+        void read_from_json_buffer(std::string_view buffer);
+        
+        /// @brief Extract required data fields from a pre-parsed JSON tree
+        /// and use them to initialize this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        void read_from_json_json(const Json::Value& json_root);
+        
+        /// @brief Serialize the content of this file into a file that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_file
+        (
+            /// [out] Stream to append serialized object content to.
+            std::ostream& file,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Serialize the content of this file into a string that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_buffer
+        (
+            /// [out] This string is overwritten with serialzed JSON content.
+            std::string& buffer,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Convinence method for pretty initialize-on-construction
+        /// syntax.
+        inline std::string write_to_json_buffer
+        (
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const {
+            std::string buffer;
+            this->write_to_json_buffer(buffer, indent_start, spaces_per_tab);
+            return buffer;
+        }
+        
+    protected:
+        
+        /// @brief See @ref name.
+        std::string name_;
+        
+        /// @brief See @ref character_id.
+        uint64_t character_id_;
+        
+        /// @brief Level of the Industry skill, 0 to 5.
+        unsigned industry_level_;
+        
+        /// @brief Level of the Advanced Industry skill, 0 to 5.
+        unsigned advanced_industry_level_;
+        
+        /// @brief Level of the Science skill, 0 to 5.
+        unsigned science_level_;
+        
+        /// @brief Manufacturing time reduction of implants, in percent.
+        float implant_time_bonus_percent_;
+        
+        /// @brief Material reduction of the structure, in percent.
+        float structure_material_bonus_percent_;
+        
+        /// @brief Job time reduction of the structure, in percent.
+        float structure_time_bonus_percent_;
+        
+        /// @brief Material reduction of the rigs fitted to the structure, in
+        /// percent.
+        float rig_material_bonus_percent_;
+        
+        /// @brief Job time reduction of the rigs fitted to the structure, in
+        /// percent.
+        float rig_time_bonus_percent_;
+        
+        /// @brief Cost index of the solar system the structure is in, for
+        /// example 0.05 for 5%.
+        float system_cost_index_;
+        
+        /// @brief Tax charged by the structure owner on job fees, in percent
+        /// of the value of the job.
+        float facility_tax_percent_;
+        
+        /// @brief Sales tax on products, in percent.
+        float sales_tax_percent_;
+        
+        /// @brief Broker fee for listing products, in percent.
+        float broker_fee_percent_;
+        
+};
+
+/// @brief Convenience alias to allow printing directly via cout or similar.
+inline std::ostream& operator<<(std::ostream& stream, const industry_profile_t& source)
+{
+    source.write_to_json_file(stream);
+    return stream;
+}
+
+/// @brief Extraction operator for decoding.
+std::istream& operator>>(std::istream& stream, industry_profile_t& destination);
+
+#endif // Header Guard
+
@@ -0,0 +1,137 @@
+/// @file industry_profiles.cpp
+/// @brief Implementation of @ref industry_profiles_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "error.h"
+#include "industry_profile.h"
+#include "industry_profiles.h"
+#include "json.h"
+
+std::vector<industry_profile_t::modifiers_t> industry_profiles_t::modifiers_table() const
+{
+    std::vector<industry_profile_t::modifiers_t> ret;
+    ret.reserve(this->profiles_.size());
+    for (const industry_profile_t& cur_profile : this->profiles_)
+        ret.push_back(cur_profile.modifiers());
+    return ret;
+}
+
+void industry_profiles_t::read_from_json_file(std::istream& file)
+{
+    
+    // Get the number of characters in the input file.
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_SIZE_FAILED, "Error.  Failed to determine file size when decoding industry_profiles_t object.\n");
+    file.seekg(0, std::ios_base::end);
+    unsigned file_size = file.tellg();
+    file.seekg(0, std::ios_base::beg);
+    
+    // Read the entire file into RAM at once
+    std::string buffer(file_size, '\0');
+    file.read(buffer.data(), file_size);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_READ_FAILED, "Error.  Failed to read file when decoding industry_profiles_t object.\n");
+    this->read_from_json_buffer(std::string_view(buffer));
+    
+}
+
+void industry_profiles_t::read_from_json_buffer(std::string_view buffer)
+{
+    
+    Json::CharReaderBuilder builder;
+    Json::CharReader* reader = builder.newCharReader();
+    
+    Json::Value json_root;
+    std::string error_message;
+    bool success = reader->parse(buffer.begin(), buffer.end(), &json_root, &error_message);
+    delete reader;
+    if (!success)
+        Json::throwRuntimeError(error_message);
+    
+    // Now that the JSON syntax is parsed, extract the stat_list specific
+    // data.
+    this->read_from_json_json(json_root);
+    
+}
+
+void industry_profiles_t::read_from_json_json(const Json::Value& json_root)
+{
+    
+    // Parse root
+    if (!json_root.isArray())
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  Root of industry_profiles is not of type \"array\".\n");
+    
+    // Clear previous content
+    this->profiles_.clear();
+    this->profiles_.reserve(json_root.size());
+    
+    // Decode and store each element in the array.
+    for (const Json::Value& cur_element : json_root)
+    {
+        industry_profile_t new_profile;
+        new_profile.read_from_json_json(cur_element);
+        this->profiles_.emplace_back(new_profile);
+    }
+    
+}
+
+void industry_profiles_t::write_to_json_file(std::ostream& file, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    file << this->write_to_json_buffer(indent_start, spaces_per_tab);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when encoding industry_profiles_t object.");
+}
+
+void industry_profiles_t::write_to_json_buffer(std::string& buffer, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    
+    std::string indent_1(indent_start + 1 * spaces_per_tab, ' ');
+    std::string_view indent_0(indent_1.data(), indent_start);
+    
+    // It is recommended not to start a new line before the opening brace, to
+    // enable chaining.
+    buffer += "[\n";
+    buffer += indent_1;
+    
+    // Encode member variables.
+    for (signed ix = 0, last_ix = this->profiles_.size() - 1; ix <= last_ix; ix++)
+    {
+        
+        buffer += this->profiles_[ix].write_to_json_buffer(indent_start + spaces_per_tab, spaces_per_tab);
+        
+        if (ix != last_ix)
+            buffer += ", ";
+            
+    }
+    
+    // It is recommended to not put a newline on the last brace to allow
+    // comma chaining when this object is an element of an array.
+    buffer += '\n';
+    buffer += indent_0;
+    buffer += "]";
+    
+}
+
+std::istream& operator>>(std::istream& stream, industry_profiles_t& destination)
+{
+    try
+    {
+        destination.read_from_json_file(stream);
+    } catch (error_message_t error) {
+        stream.setstate(std::ios::failbit);
+        throw error;
+    } catch (Json::Exception error) {
+        stream.setstate(std::ios::failbit);
+        throw error;
+    }
+    return stream;
+}
+
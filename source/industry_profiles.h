@@ -0,0 +1,133 @@
+/// @file industry_profiles.h
+/// @brief Declaration of @ref industry_profiles_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_INDUSTRY_PROFILES
+#define HEADER_GUARD_INDUSTRY_PROFILES
+
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "error.h"
+#include "industry_profile.h"
+#include "json.h"
+
+/// @brief Every character and structure combination to evaluate blueprint
+/// profits for.
+class industry_profiles_t
+{
+        
+    public:
+        
+        /// @brief Default constructor
+        inline industry_profiles_t() = default;
+        
+        // Add member read and write functions
+        
+        inline const std::vector<industry_profile_t>& profiles() const
+        {
+            return this->profiles_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief The modifiers of every profile, in the same order as
+        /// @ref profiles.
+        ///
+        /// The profit kernel indexes this small table instead of recomputing
+        /// the modifiers of a profile for every blueprint and station.
+        std::vector<industry_profile_t::modifiers_t> modifiers_table() const;
+        
+        // Add encoders/decoders here
+        
+        /// @brief Open a file conforming to data/json/schema.json and use it to initialize
+        /// this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        /// @exception Json::Exception
+        void read_from_json_file(std::istream& file);
+        
+        /// @brief Decode serialized content conforming to data/json/schema.json and use it
+        /// to initialize this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        /// @exception Json::Exception
+        void read_from_json_buffer(std::string_view buffer);
+        
+        /// @brief Extract required data fields from a pre-parsed JSON tree
+        /// and use them to initialize this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        void read_from_json_json(const Json::Value& json_root);
+        
+        /// @brief Serialize the content of this file into a file that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_file
+        (
+            /// [out] Stream to append serialized object content to.
+            std::ostream& file,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Serialize the content of this file into a string that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_buffer
+        (
+            /// [out] This string is overwritten with serialzed JSON content.
+            std::string& buffer,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Convinence method for pretty initialize-on-construction
+        /// syntax.
+        inline std::string write_to_json_buffer
+        (
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const {
+            std::string buffer;
+            this->write_to_json_buffer(buffer, indent_start, spaces_per_tab);
+            return buffer;
+        }
+        
+    protected:
+        
+        /// @brief See @ref profiles.
+        std::vector<industry_profile_t> profiles_;
+        
+};
+
+/// @brief Convenience alias to allow printing directly via cout or similar.
+inline std::ostream& operator<<(std::ostream& stream, const industry_profiles_t& source)
+{
+    source.write_to_json_file(stream);
+    return stream;
+}
+
+/// @brief Extraction operator for decoding.
+std::istream& operator>>(std::istream& stream, industry_profiles_t& destination);
+
+#endif // Header Guard
+
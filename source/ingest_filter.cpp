@@ -0,0 +1,103 @@
+/// @file ingest_filter.cpp
+/// @brief Implementation of @ref ingest_filter_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <utility>
+#include <vector>
+
+#include "blueprint.h"
+#include "blueprints.h"
+#include "decryptor.h"
+#include "ingest_filter.h"
+#include "item_quantities.h"
+#include "item_quantity.h"
+#include "raw_order.h"
+#include "station_attribute.h"
+#include "station_attributes.h"
+#include "universe_topology.h"
+
+void ingest_filter_t::add_stations(const station_attributes_t& station_attributes)
+{
+    const std::vector<station_attribute_t>& stations = station_attributes.stations();
+    this->stations_to_keep_.reserve(this->stations_to_keep_.size() + stations.size());
+    for (const station_attribute_t& cur_station : stations)
+        this->stations_to_keep_.emplace(cur_station.station_id());
+}
+
+void ingest_filter_t::order_ranges(const universe_topology_t* topology, const station_attributes_t& station_attributes)
+{
+    this->topology_ = topology;
+    this->range_targets_.clear();
+    if (topology == nullptr)
+        return;
+    for (const station_attribute_t& cur_station : station_attributes.stations())
+        this->range_targets_.push_back({cur_station.station_id(), cur_station.system_id(), cur_station.region_id()});
+}
+
+bool ingest_filter_t::reaches(const range_target_t& target, uint64_t region_id, uint64_t system_id, uint8_t range) const
+{
+    if (range == raw_order_t::station_range || target.region_id != region_id)
+        return false;
+    if (range == raw_order_t::region_range)
+        return true;
+    return this->topology_->distance(target.system_id, system_id) <= range;
+}
+
+bool ingest_filter_t::reaches_range_target(uint64_t region_id, uint64_t system_id, uint8_t range) const
+{
+    for (const range_target_t& cur_target : this->range_targets_)
+    {
+        if (this->reaches(cur_target, region_id, system_id, range))
+            return true;
+    }
+    return false;
+}
+
+void ingest_filter_t::add_items(const blueprints_t& blueprints)
+{
+    
+    auto add_materials = [this](const item_quantities_t& materials)
+    {
+        for (const item_quantity_t& cur_material : materials.materials_list())
+            this->add_item(cur_material.item_id());
+    };
+    
+    for (const std::pair<const uint64_t, blueprint_t>& cur_blueprint : blueprints.storage())
+    {
+        
+        const blueprint_t::manufacture_t& manufacture = cur_blueprint.second.manufacture();
+        add_materials(manufacture.input_materials());
+        add_materials(manufacture.output_materials());
+        
+        // Copy and invent accessors throw if the blueprint can't do either
+        if (cur_blueprint.second.copy().valid())
+            add_materials(cur_blueprint.second.copy().input_materials());
+        if (cur_blueprint.second.invent().valid())
+            add_materials(cur_blueprint.second.invent().input_materials());
+            
+    }
+    
+    for
+    (
+        decryptor_t::type_t cur_decryptor = decryptor_t::type_t(unsigned(decryptor_t::type_t::NO_DECRYPTOR) + 1);
+        cur_decryptor != decryptor_t::type_t::NUM_ENUMS;
+        cur_decryptor = decryptor_t::type_t(unsigned(cur_decryptor) + 1)
+    ){
+        this->add_item(decryptor_t(cur_decryptor).item_id());
+    }
+    
+}
+
+std::vector<uint64_t> ingest_filter_t::item_ids() const
+{
+    std::vector<uint64_t> ret;
+    for (uint64_t word_ix = 0, num_words = this->items_to_keep_.size(); word_ix < num_words; word_ix++)
+    {
+        for (uint64_t word = this->items_to_keep_[word_ix]; word != 0; word &= word - 1)
+            ret.push_back(word_ix * 64 + __builtin_ctzll(word));
+    }
+    return ret;
+}
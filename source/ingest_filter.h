@@ -0,0 +1,213 @@
+/// @file ingest_filter.h
+/// @brief Declaration of @ref ingest_filter_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_INGEST_FILTER
+#define HEADER_GUARD_INGEST_FILTER
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+class blueprints_t;
+class station_attributes_t;
+class universe_topology_t;
+
+/// @brief Decides which market orders are kept while a region is being
+/// decoded and aggregated, so that unwanted orders are never stored.
+///
+/// This replaces culling a fully built @ref galactic_market_t after the
+/// fact.  The default filter keeps everything.
+///
+/// When order ranges are honoured, a buy order placed at another station
+/// is also kept if one of the @ref range_targets is within its range, so
+/// that it can be counted as a buy order at that station.
+class ingest_filter_t
+{
+        
+    public:
+        
+        /// @brief A station which buy orders placed elsewhere can be filled
+        /// at.
+        struct range_target_t
+        {
+            uint64_t station_id;
+            uint64_t system_id;
+            uint64_t region_id;
+        };
+        
+        /// @brief Default constructor.  Keeps every order.
+        inline ingest_filter_t()
+          : cull_stations_(false),
+            cull_orders_(false),
+            cull_items_(false),
+            topology_(nullptr)
+        {
+            // All work done in initializer list
+        }
+        
+        // Add member read and write functions
+        
+        /// @brief True if orders at stations not in @ref stations_to_keep
+        /// are dropped.
+        inline bool cull_stations() const
+        {
+            return this->cull_stations_;
+        }
+        
+        inline void cull_stations(bool new_cull_stations)
+        {
+            this->cull_stations_ = new_cull_stations;
+        }
+        
+        /// @brief True if only the maximum buy order and minimum sell order
+        /// of each item at each station are kept.
+        inline bool cull_orders() const
+        {
+            return this->cull_orders_;
+        }
+        
+        inline void cull_orders(bool new_cull_orders)
+        {
+            this->cull_orders_ = new_cull_orders;
+        }
+        
+        /// @brief True if orders for items not in @ref items_to_keep are
+        /// dropped.
+        inline bool cull_items() const
+        {
+            return this->cull_items_;
+        }
+        
+        inline void cull_items(bool new_cull_items)
+        {
+            this->cull_items_ = new_cull_items;
+        }
+        
+        inline const std::unordered_set<uint64_t>& stations_to_keep() const
+        {
+            return this->stations_to_keep_;
+        }
+        
+        /// @brief Whitelist of item IDs as a bitset, where bit (id % 64) of
+        /// word (id / 64) is set if the item is kept.  Item IDs are small
+        /// and dense enough that this is only tens of kilobytes.
+        inline const std::vector<uint64_t>& items_to_keep() const
+        {
+            return this->items_to_keep_;
+        }
+        
+        /// @brief Null if order ranges are ignored.
+        inline const universe_topology_t* topology() const
+        {
+            return this->topology_;
+        }
+        
+        inline const std::vector<range_target_t>& range_targets() const
+        {
+            return this->range_targets_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Reset to default-constructed state.
+        inline void clear()
+        {
+            this->cull_stations_ = false;
+            this->cull_orders_ = false;
+            this->cull_items_ = false;
+            this->stations_to_keep_.clear();
+            this->items_to_keep_.clear();
+            this->topology_ = nullptr;
+            this->range_targets_.clear();
+        }
+        
+        inline void add_station(uint64_t station_id)
+        {
+            this->stations_to_keep_.emplace(station_id);
+        }
+        
+        /// @brief Whitelist every station in station_attributes.
+        void add_stations(const station_attributes_t& station_attributes);
+        
+        /// @brief Count buy orders placed elsewhere at every station in
+        /// station_attributes within their range.  The distances of topology
+        /// must already have been computed or mapped.  A null topology ignores
+        /// ranges.
+        void order_ranges(const universe_topology_t* topology, const station_attributes_t& station_attributes);
+        
+        /// @brief True if a buy order placed in system_id of region_id, with
+        /// a @ref raw_order_t::range "range", can be filled at target.
+        ///
+        /// @exception error_message_t
+        bool reaches(const range_target_t& target, uint64_t region_id, uint64_t system_id, uint8_t range) const;
+        
+        /// @brief True if a buy order can be filled at any of the
+        /// @ref range_targets.
+        ///
+        /// @exception error_message_t
+        bool reaches_range_target(uint64_t region_id, uint64_t system_id, uint8_t range) const;
+        
+        /// @brief True if orders at this station should be stored.
+        inline bool keep_station(uint64_t station_id) const
+        {
+            return !this->cull_stations_ || this->stations_to_keep_.count(station_id) != 0;
+        }
+        
+        inline void add_item(uint64_t item_id)
+        {
+            uint64_t word_ix = item_id >> 6;
+            if (word_ix >= this->items_to_keep_.size())
+                this->items_to_keep_.resize(word_ix + 1, 0);
+            this->items_to_keep_[word_ix] |= uint64_t(1) << (item_id & 63);
+        }
+        
+        /// @brief Whitelist the inputs and outputs of every manufacturing
+        /// job, the inputs of every copy and invention job, and every
+        /// decryptor.
+        void add_items(const blueprints_t& blueprints);
+        
+        /// @brief Every whitelisted item ID, sorted.
+        std::vector<uint64_t> item_ids() const;
+        
+        /// @brief True if orders for this item should be stored.
+        inline bool keep_item(uint64_t item_id) const
+        {
+            if (!this->cull_items_)
+                return true;
+            uint64_t word_ix = item_id >> 6;
+            return word_ix < this->items_to_keep_.size() && ((this->items_to_keep_[word_ix] >> (item_id & 63)) & 1) != 0;
+        }
+        
+    protected:
+        
+        /// @brief See @ref cull_stations.
+        bool cull_stations_;
+        
+        /// @brief See @ref cull_orders.
+        bool cull_orders_;
+        
+        /// @brief See @ref cull_items.
+        bool cull_items_;
+        
+        /// @brief Whitelist of station IDs.  Only used if
+        /// @ref cull_stations_ is set.
+        std::unordered_set<uint64_t> stations_to_keep_;
+        
+        /// @brief See @ref items_to_keep.  Only used if @ref cull_items_ is
+        /// set.
+        std::vector<uint64_t> items_to_keep_;
+        
+        /// @brief See @ref topology.
+        const universe_topology_t* topology_;
+        
+        /// @brief See @ref range_targets.
+        std::vector<range_target_t> range_targets_;
+        
+};
+
+#endif // Header Guard
+
@@ -0,0 +1,341 @@
+/// @file invention_risk.cpp
+/// @brief Implementation of @ref invention_risk_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "blueprints.h"
+#include "counter_rng.h"
+#include "decryptor.h"
+#include "error.h"
+#include "galactic_market.h"
+#include "invention_risk.h"
+#include "profit_matrix.h"
+#include "regional_market.h"
+#include "station_market.h"
+#include "task_scheduler.h"
+
+void invention_risk_t::simulate(float probability, std::vector<unsigned>& histogram) const
+{
+    
+    // Each probability gets its own stream, so results don't depend on the
+    // order of blueprints
+    uint32_t probability_bits;
+    std::memcpy(&probability_bits, &probability, sizeof(probability_bits));
+    counter_rng_t rng(this->seed_ ^ counter_rng_t::mix(probability_bits));
+    
+    unsigned num_trials = this->num_trials_;
+    unsigned num_bins = this->invention_attempts_ + 1;
+    unsigned num_blocks = (num_trials + trials_per_block - 1) / trials_per_block;
+    histogram.assign(num_bins, 0);
+    
+    // Each worker counts into its own histogram, which are summed once every
+    // block is done
+    task_scheduler_t& scheduler = task_scheduler_t::instance();
+    std::vector< std::vector<unsigned> > worker_histograms(scheduler.num_workers(task_scheduler_t::pool_t::CPU), std::vector<unsigned>(num_bins, 0));
+    scheduler.parallel_for
+    (
+        num_blocks,
+        16,
+        [&](unsigned block_ix)
+        {
+            std::vector<unsigned>& local_histogram = worker_histograms[task_scheduler_t::current_worker()];
+            unsigned successes[trials_per_block];
+            uint64_t first_trial = uint64_t(block_ix) * trials_per_block;
+            unsigned block_trials = std::min(trials_per_block, unsigned(num_trials - first_trial));
+            rng.count_successes(probability, this->invention_attempts_, first_trial, block_trials, successes);
+            for (unsigned ix = 0; ix < block_trials; ix++)
+                local_histogram[successes[ix]]++;
+        }
+    );
+    
+    for (const std::vector<unsigned>& cur_histogram : worker_histograms)
+    {
+        for (unsigned ix = 0; ix < num_bins; ix++)
+            histogram[ix] += cur_histogram[ix];
+    }
+    
+}
+
+void invention_risk_t::summarize
+(
+    const std::vector<unsigned>& histogram,
+    double gain,
+    double loss,
+    outcome_t& outcome
+) const {
+    
+    double num_trials = this->num_trials_;
+    unsigned max_successes = this->invention_attempts_;
+    
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    double losing_trials = 0.0;
+    for (unsigned successes = 0; successes <= max_successes; successes++)
+    {
+        double profit = gain * double(successes) - loss;
+        sum += double(histogram[successes]) * profit;
+        sum_squares += double(histogram[successes]) * profit * profit;
+        if (profit < 0.0)
+            losing_trials += histogram[successes];
+    }
+    double mean = sum / num_trials;
+    outcome.mean = mean;
+    outcome.standard_deviation = std::sqrt(std::max(0.0, sum_squares / num_trials - mean * mean));
+    outcome.probability_of_loss = losing_trials / num_trials;
+    
+    // Nearest-rank percentiles.  Profit falls with successes if each invented
+    // copy loses money.
+    auto percentile = [&](double fraction) -> float
+    {
+        uint64_t rank = std::max(uint64_t(1), uint64_t(std::ceil(fraction * num_trials)));
+        uint64_t cumulative = 0;
+        for (unsigned ix = 0; ix <= max_successes; ix++)
+        {
+            unsigned successes = gain >= 0.0 ? ix : max_successes - ix;
+            cumulative += histogram[successes];
+            if (cumulative >= rank)
+                return gain * double(successes) - loss;
+        }
+        return gain * double(gain >= 0.0 ? max_successes : 0) - loss;
+    };
+    outcome.percentile_5 = percentile(0.05);
+    outcome.percentile_50 = percentile(0.50);
+    outcome.percentile_95 = percentile(0.95);
+    
+}
+
+void invention_risk_t::initialize_from_market
+(
+    const blueprints_t& blueprints,
+    const galactic_market_t& galactic_market,
+    unsigned num_trials,
+    unsigned invention_attempts,
+    uint64_t seed,
+    const best_price_index_t* best_prices,
+    unsigned runs_per_job,
+    const industry_profile_t::modifiers_t& modifiers
+){
+    
+    if (num_trials == 0 || invention_attempts == 0)
+        throw error_message_t(error_code_t::RISK_LIMIT_INVALID, "Error.  At least one trial of at least one invention attempt is required to simulate invention risk.\n");
+    
+    this->stations_.clear();
+    this->num_trials_ = num_trials;
+    this->invention_attempts_ = invention_attempts;
+    this->seed_ = seed;
+    
+    profit_matrix_t profit_matrix;
+    profit_matrix.initialize_from_blueprints(blueprints, runs_per_job, modifiers);
+    
+    // Simulate each distinct invention probability once
+    std::unordered_map<float, std::vector<unsigned> > histograms;
+    for (const profit_matrix_t::row_t& cur_row : profit_matrix.rows())
+    {
+        if (!cur_row.compiled || cur_row.job.effective_num_t1_copies == 0.0f)
+            continue;
+        std::pair<std::unordered_map<float, std::vector<unsigned> >::iterator, bool> found = histograms.try_emplace(cur_row.job.invention_probability);
+        if (found.second)
+            this->simulate(cur_row.job.invention_probability, found.first->second);
+    }
+    
+    std::vector<float> input_prices;
+    std::vector<float> output_prices;
+    const std::vector<unsigned>& blueprint_offsets = profit_matrix.blueprint_offsets();
+    for (const std::pair<const uint64_t, regional_market_t>& cur_regional_market : galactic_market.regions())
+    {
+        for (const std::pair<const uint64_t, station_market_t>& cur_station_market : cur_regional_market.second.stations())
+        {
+            
+            station_t new_station;
+            new_station.station_id = cur_station_market.first;
+            profit_matrix.gather_prices(cur_station_market.second, best_prices, input_prices, output_prices);
+            
+            for (unsigned blueprint_ix = 0, num_blueprints = blueprint_offsets.size() - 1; blueprint_ix < num_blueprints; blueprint_ix++)
+            {
+                
+                unsigned first_outcome = new_station.outcomes.size();
+                for (unsigned row_ix = blueprint_offsets[blueprint_ix], last_row = blueprint_offsets[blueprint_ix + 1]; row_ix < last_row; row_ix++)
+                {
+                    
+                    const profit_matrix_t::row_t& row = profit_matrix.rows()[row_ix];
+                    if (!row.compiled || row.job.effective_num_t1_copies == 0.0f)
+                        continue;
+                    
+                    float attempt_cost;
+                    float manufacture_cost;
+                    float output_value;
+                    profit_matrix.evaluate_invention_row(row_ix, input_prices, output_prices, attempt_cost, manufacture_cost, output_value);
+                    if (!std::isfinite(attempt_cost) || !std::isfinite(manufacture_cost) || !std::isfinite(output_value))
+                        continue;
+                    
+                    // Each success is manufactured in jobs of row.job.runs runs
+                    double gain = double(row.job.invented_runs) / double(row.job.runs) * (double(output_value) - double(manufacture_cost));
+                    double loss = double(invention_attempts) * double(attempt_cost);
+                    
+                    outcome_t outcome;
+                    outcome.blueprint_id = row.blueprint_id;
+                    outcome.decryptor = row.decryptor;
+                    outcome.best = false;
+                    this->summarize(histograms[row.job.invention_probability], gain, loss, outcome);
+                    new_station.outcomes.push_back(outcome);
+                    
+                }
+                
+                // Choose the decryptor least likely to go badly
+                if (first_outcome == new_station.outcomes.size())
+                    continue;
+                std::vector<outcome_t>::iterator best = std::max_element
+                (
+                    new_station.outcomes.begin() + first_outcome,
+                    new_station.outcomes.end(),
+                    [](const outcome_t& lhs, const outcome_t& rhs)
+                    {
+                        if (lhs.percentile_5 != rhs.percentile_5)
+                            return lhs.percentile_5 < rhs.percentile_5;
+                        return lhs.mean < rhs.mean;
+                    }
+                );
+                best->best = true;
+                
+            }
+            
+            this->stations_.emplace_back(std::move(new_station));
+            
+        }
+    }
+    
+}
+
+void invention_risk_t::write_to_json_file
+(
+    std::ostream& file,
+    const std::unordered_map<uint64_t, std::string_view>& blueprint_names,
+    unsigned indent_start,
+    unsigned spaces_per_tab
+) const {
+    std::string buffer;
+    this->write_to_json_buffer(buffer, blueprint_names, indent_start, spaces_per_tab);
+    file << buffer;
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when encoding invention_risk_t object.\n");
+}
+
+void invention_risk_t::write_to_json_buffer
+(
+    std::string& buffer,
+    const std::unordered_map<uint64_t, std::string_view>& blueprint_names,
+    unsigned indent_start,
+    unsigned spaces_per_tab
+) const {
+    
+    std::string indent_4(indent_start + 4 * spaces_per_tab, ' ');
+    std::string_view indent_3(indent_4.data(), indent_start + 3 * spaces_per_tab);
+    std::string_view indent_2(indent_4.data(), indent_start + 2 * spaces_per_tab);
+    std::string_view indent_1(indent_4.data(), indent_start + spaces_per_tab);
+    std::string_view indent_0(indent_4.data(), indent_start);
+    
+    // It is recommended not to start a new line before the opening brace, to
+    // enable chaining.
+    buffer += "{\n";
+    
+    buffer += indent_1;
+    buffer += "\"num_trials\": ";
+    buffer += std::to_string(this->num_trials_);
+    buffer += ",\n";
+    buffer += indent_1;
+    buffer += "\"invention_attempts\": ";
+    buffer += std::to_string(this->invention_attempts_);
+    buffer += ",\n";
+    buffer += indent_1;
+    buffer += "\"seed\": ";
+    buffer += std::to_string(this->seed_);
+    buffer += ",\n";
+    
+    // One object per station, with one line per blueprint and decryptor
+    buffer += indent_1;
+    buffer += "\"stations\": [";
+    for (unsigned station_ix = 0, num_stations = this->stations_.size(); station_ix < num_stations; station_ix++)
+    {
+        
+        const station_t& cur_station = this->stations_[station_ix];
+        buffer += station_ix == 0 ? "\n" : ",\n";
+        buffer += indent_2;
+        buffer += "{\n";
+        buffer += indent_3;
+        buffer += "\"station_id\": ";
+        buffer += std::to_string(cur_station.station_id);
+        buffer += ",\n";
+        buffer += indent_3;
+        buffer += "\"outcomes\": [";
+        
+        for (unsigned outcome_ix = 0, num_outcomes = cur_station.outcomes.size(); outcome_ix < num_outcomes; outcome_ix++)
+        {
+            
+            const outcome_t& cur_outcome = cur_station.outcomes[outcome_ix];
+            buffer += outcome_ix == 0 ? "\n" : ",\n";
+            buffer += indent_4;
+            buffer += "{\"blueprint_id\": ";
+            buffer += std::to_string(cur_outcome.blueprint_id);
+            std::unordered_map<uint64_t, std::string_view>::const_iterator name_match = blueprint_names.find(cur_outcome.blueprint_id);
+            if (name_match != blueprint_names.end())
+            {
+                buffer += ", \"blueprint_name\": \"";
+                buffer += name_match->second;
+                buffer += '\"';
+            }
+            buffer += ", \"decryptor\": ";
+            decryptor_t(cur_outcome.decryptor).write_to_json_buffer(buffer);
+            buffer += ", \"best\": ";
+            buffer += cur_outcome.best ? "true" : "false";
+            buffer += ", \"mean\": ";
+            buffer += std::to_string(cur_outcome.mean);
+            buffer += ", \"standard_deviation\": ";
+            buffer += std::to_string(cur_outcome.standard_deviation);
+            buffer += ", \"percentile_5\": ";
+            buffer += std::to_string(cur_outcome.percentile_5);
+            buffer += ", \"percentile_50\": ";
+            buffer += std::to_string(cur_outcome.percentile_50);
+            buffer += ", \"percentile_95\": ";
+            buffer += std::to_string(cur_outcome.percentile_95);
+            buffer += ", \"probability_of_loss\": ";
+            buffer += std::to_string(cur_outcome.probability_of_loss);
+            buffer += '}';
+            
+        }
+        
+        buffer += cur_station.outcomes.empty() ? "]\n" : "\n";
+        if (!cur_station.outcomes.empty())
+        {
+            buffer += indent_3;
+            buffer += "]\n";
+        }
+        buffer += indent_2;
+        buffer += '}';
+        
+    }
+    buffer += this->stations_.empty() ? "]\n" : "\n";
+    if (!this->stations_.empty())
+    {
+        buffer += indent_1;
+        buffer += "]\n";
+    }
+    
+    // It is recommended to not put a newline on the last brace to allow
+    // comma chaining when this object is an element of an array.
+    buffer += indent_0;
+    buffer += '}';
+    
+}
@@ -0,0 +1,202 @@
+/// @file invention_risk.h
+/// @brief Declaration of @ref invention_risk_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_INVENTION_RISK
+#define HEADER_GUARD_INVENTION_RISK
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "best_price_index.h"
+#include "decryptor.h"
+#include "error.h"
+#include "industry_profile.h"
+#include "profit_matrix.h"
+
+class blueprints_t;
+class galactic_market_t;
+
+/// @brief Monte Carlo simulation of how much a batch of invention jobs
+/// really makes, for every T2 blueprint and decryptor at every station.
+///
+/// @ref blueprint_profit_t prices invention at its expectation, which hides
+/// how often a small batch of jobs loses money.  Here each trial makes a
+/// fixed number of invention attempts, and every invented copy is
+/// manufactured and sold in full.  The profit of a trial is then
+///
+///     successes * (invented runs / runs per job) * (output value - manufacturing cost)
+///   - attempts * (copy + invention + decryptor cost)
+///
+/// The number of successes only depends on the invention probability, so
+/// trials are simulated once per distinct probability, in parallel, and
+/// their histogram is reused for every blueprint and station.
+class invention_risk_t
+{
+        
+    public:
+        
+        /// @brief Distribution of the profit of one blueprint and decryptor
+        /// at one station.
+        struct outcome_t
+        {
+            uint64_t blueprint_id;
+            decryptor_t::type_t decryptor;
+            /// @brief True for the decryptor with the best 5th percentile of
+            /// each blueprint, breaking ties with the mean.
+            bool best;
+            float mean;
+            float standard_deviation;
+            float percentile_5;
+            float percentile_50;
+            float percentile_95;
+            /// @brief Fraction of trials whose profit was negative.
+            float probability_of_loss;
+        };
+        
+        /// @brief Every T2 blueprint which could be priced at one station.
+        struct station_t
+        {
+            uint64_t station_id;
+            std::vector<outcome_t> outcomes;
+        };
+        
+        /// @brief Default constructor
+        inline invention_risk_t()
+          : num_trials_(0),
+            invention_attempts_(0),
+            seed_(0)
+        {
+            // All work done in initializer list
+        }
+        
+        // Add member read and write functions
+        
+        inline unsigned num_trials() const
+        {
+            return this->num_trials_;
+        }
+        
+        /// @brief Invention jobs started by each trial.
+        inline unsigned invention_attempts() const
+        {
+            return this->invention_attempts_;
+        }
+        
+        inline uint64_t seed() const
+        {
+            return this->seed_;
+        }
+        
+        inline const std::vector<station_t>& stations() const
+        {
+            return this->stations_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Simulate every T2 blueprint and decryptor at every station,
+        /// clearing previous content.
+        ///
+        /// @exception error_message_t
+        void initialize_from_market
+        (
+            const blueprints_t& blueprints,
+            const galactic_market_t& galactic_market,
+            unsigned num_trials,
+            unsigned invention_attempts,
+            /// [in] The same seed gives the same results on any number of
+            /// threads.
+            uint64_t seed,
+            /// [in] See @ref blueprint_profit_t::initialize_from_market
+            const best_price_index_t* best_prices = nullptr,
+            /// [in] See @ref blueprint_profit_t::initialize_from_market
+            unsigned runs_per_job = 1,
+            /// [in] See @ref blueprint_profit_t::initialize_from_market
+            const industry_profile_t::modifiers_t& modifiers = industry_profile_t::no_modifiers
+        );
+        
+        // Add encoders/decoders here
+        
+        /// @brief Serialize the content of this file into a file that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_file
+        (
+            /// [out] Stream to append serialized object content to.
+            std::ostream& file,
+            /// [in] Allows human readable names to be displayed with each
+            /// blueprint.
+            const std::unordered_map<uint64_t, std::string_view>& blueprint_names,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Serialize the content of this file into a string that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_buffer
+        (
+            /// [out] This string is overwritten with serialzed JSON content.
+            std::string& buffer,
+            /// [in] Allows human readable names to be displayed with each
+            /// blueprint.
+            const std::unordered_map<uint64_t, std::string_view>& blueprint_names,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+    protected:
+        
+        /// @brief Trials simulated together by one thread.
+        static constexpr unsigned trials_per_block = 1024;
+        
+        /// @brief Simulate every trial with one invention probability.
+        void simulate
+        (
+            float probability,
+            /// [out] Number of trials with each number of successes, from 0
+            /// to @ref invention_attempts.
+            std::vector<unsigned>& histogram
+        ) const;
+        
+        /// @brief Fill in the statistics of an outcome whose profit is
+        /// gain * successes - loss.
+        void summarize
+        (
+            const std::vector<unsigned>& histogram,
+            double gain,
+            double loss,
+            outcome_t& outcome
+        ) const;
+        
+        /// @brief See @ref num_trials.
+        unsigned num_trials_;
+        
+        /// @brief See @ref invention_attempts.
+        unsigned invention_attempts_;
+        
+        /// @brief See @ref seed.
+        uint64_t seed_;
+        
+        /// @brief See @ref stations.
+        std::vector<station_t> stations_;
+        
+};
+
+#endif // Header Guard
@@ -8,7 +8,6 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
-#include <omp.h>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -17,6 +16,10 @@
 #include "item_ids.h"
 #include "error.h"
 #include "json.h"
+#include "progress_reporter.h"
+#include "stats.h"
+#include "task_scheduler.h"
+#include "trace.h"
 
 void item_attributes_t::fetch(const item_ids_t& item_ids)
 {
@@ -25,70 +28,60 @@ void item_attributes_t::fetch(const item_ids_t& item_ids)
     
     unsigned num_item_ids = item_ids.ids().size();
     
-    // Pre-allocate all storage so re-allocation won't happen while multiple omp
-    // threads are writing to it.
+    // Pre-allocate all storage so re-allocation won't happen while multiple
+    // tasks are writing to it.
     this->items_.resize(num_item_ids);
     
-    // This JSON library is kindof weird.  Allocate a json parser outside the
-    // loop to avoid constructing a new one each iteration.
+    // This JSON library is kindof weird.  Allocate one json parser per I/O
+    // worker rather than constructing a new one for each item.
     // The smart pointer allows proper de-allocation if an exception is thrown.
     Json::CharReaderBuilder builder;
     
-    unsigned num_threads = omp_get_max_threads();
+    task_scheduler_t& scheduler = task_scheduler_t::instance();
+    unsigned num_workers = scheduler.num_workers(task_scheduler_t::pool_t::IO);
     if (this->debug_mode_.verbose())
-        std::cout << "Fetching item attributes using " << num_threads << " threads.\n";
+        std::cout << "Fetching item attributes using " << num_workers << " threads.\n";
     
     std::vector< std::unique_ptr<Json::CharReader> > readers;
-    for (unsigned ix = 0; ix < num_threads; ix++)
+    for (unsigned ix = 0; ix < num_workers; ix++)
         readers.emplace_back(builder.newCharReader());
     
-    std::string progress_message;
+    // Null if statistics or tracing are disabled
+    stats_t* stats = this->debug_mode_.stats();
+    trace_t* trace = this->debug_mode_.trace();
     
-    // Fetch each requested item ID
-    unsigned percent = num_item_ids / 100;
-    unsigned progress_threshold = percent;
-    unsigned num_items_processed = 0;
-    #pragma omp parallel for
+    // Workers only bump counters.  The status line is drawn by its own
+    // thread, and only if stdout is a terminal.
+    progress_reporter_t progress("Fetching item attributes", "items", num_item_ids, this->debug_mode_.verbose());
+    
+    // Fetch each requested item ID.  A failure cancels the items which
+    // haven't started yet and is rethrown by wait.
+    task_scheduler_t::task_group_t group;
     for (unsigned ix = 0; ix < num_item_ids; ix++)
     {
-        
-        unsigned thread_ix = omp_get_thread_num();
-        
-        // Fetch this item's attributes from EvE API (connect to network).
-        this->items_[ix].fetch(item_ids.ids()[ix], readers[thread_ix].get());
-        
-        #pragma omp atomic
-        num_items_processed++;
-        
-        // Print progress bar
-        if (this->debug_mode_.verbose() && num_items_processed == progress_threshold)
-        {
-            
-            // Clear previous message
-            for (unsigned iy = 0, bound = progress_message.length(); iy < bound; iy++)
-                std::cout << '\b';
-            
-            // Generate and print progress message
-            progress_message = "Fetched ";
-            progress_message += std::to_string(num_items_processed);
-            progress_message += " / ";
-            progress_message += std::to_string(num_item_ids);
-            progress_message += ' ';
-            progress_message += std::to_string(100 * num_items_processed / num_item_ids);
-            progress_message += '%';
-            
-            #pragma omp critical
-            std::cout << progress_message << std::flush;
-            
-            // Set next milestone for printing.
-            progress_threshold += percent;
-            
-        }
-        
+        scheduler.submit
+        (
+            group,
+            task_scheduler_t::pool_t::IO,
+            [this, &item_ids, &readers, &progress, stats, trace, ix]
+            {
+                
+                // Fetch this item's attributes from EvE API (connect to network).
+                {
+                    stats_t::scoped_timer_t timer(stats, stats_t::stage_t::FETCH);
+                    trace_t::scoped_span_t span(trace, "fetch_item_attribute", "fetch", item_ids.ids()[ix]);
+                    this->items_[ix].fetch(item_ids.ids()[ix], readers[task_scheduler_t::current_worker()].get());
+                }
+                if (stats != nullptr)
+                    stats->increment(stats_t::counter_t::PAGES_FETCHED);
+                progress.increment();
+                
+            }
+        );
     }
+    group.wait();
     
-    if (this->debug_mode_.verbose())
-        std::cout << '\n';
+    progress.stop();
     
 }
 
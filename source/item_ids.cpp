@@ -6,7 +6,6 @@
 /// * Documentation is generated by doxygen, see documentation/html_out/index.html
 
 #include <fstream>
-#include <iostream>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -16,6 +15,9 @@
 #include "item_ids.h"
 #include "error.h"
 #include "json.h"
+#include "progress_reporter.h"
+#include "stats.h"
+#include "trace.h"
 
 void item_ids_t::fetch()
 {
@@ -27,36 +29,54 @@ void item_ids_t::fetch()
     Json::CharReaderBuilder builder;
     std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
     
-    std::string progress_message;
+    // Null if statistics or tracing are disabled
+    stats_t* stats = this->debug_mode_.stats();
+    trace_t* trace = this->debug_mode_.trace();
     
     // There are multiple pages of item IDs.  The last page is signified with
     // and empty array.
     std::string_view query_prefix("https://esi.tech.ccp.is/latest/universe/types/?datasource=tranquility&page=");
     unsigned page = 1;
+    progress_reporter_t progress("Fetching item IDs", "pages", 0, this->debug_mode_.verbose());
     while (true)
     {
         
-        // Print progress message, erasing previous one if it existed
-        if (this->debug_mode_.verbose())
-        {
-            for (unsigned ix = 0, bound = progress_message.length(); ix < bound; ix++)
-                std::cout << '\b';
-            progress_message = "Page ";
-            progress_message += std::to_string(page);
-            std::cout << progress_message << std::flush;
-        }
         // Prepare a request URL
         std::string query(query_prefix);
         query += std::to_string(page);
         page++;
         
         // Attempt to pull data from the EVE API
-        std::string payload = https_get(query);
+        std::string payload;
+        {
+            stats_t::scoped_timer_t timer(stats, stats_t::stage_t::FETCH);
+            if (trace != nullptr)
+            {
+                https_get_timing_t timing;
+                uint64_t start_ns = trace->now_ns();
+                payload = https_get(query, &timing);
+                trace->record_https_get(start_ns, timing, page - 1);
+            } else {
+                payload = https_get(query);
+            }
+        }
+        progress.increment(1, payload.size());
+        if (stats != nullptr)
+        {
+            stats->increment(stats_t::counter_t::PAGES_FETCHED);
+            stats->increment(stats_t::counter_t::BYTES_RECEIVED, payload.size());
+        }
         
         // Attempt to decode received data
         Json::Value json_item_ids;
         std::string error_message;
-        if (!reader->parse(payload.data(), payload.data() + payload.size(), &json_item_ids, &error_message))
+        bool parse_successful;
+        {
+            stats_t::scoped_timer_t timer(stats, stats_t::stage_t::PARSE);
+            trace_t::scoped_span_t span(trace, "parse", "parse", page - 1);
+            parse_successful = reader->parse(payload.data(), payload.data() + payload.size(), &json_item_ids, &error_message);
+        }
+        if (!parse_successful)
         {
             std::string message("Error.  Tried to decode JSON data from\"");
             message += query;
@@ -95,8 +115,7 @@ void item_ids_t::fetch()
         
         if (json_item_ids.empty())
         {
-            if (this->debug_mode_.verbose())
-                std::cout << '\n';
+            progress.stop();
             return;
         }
         
@@ -5,6 +5,7 @@
 /// * Date Created = Tuesday November 7 2017
 /// * Documentation is generated by doxygen, see html/index.html
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <string_view>
@@ -26,13 +27,12 @@ float item_market_t::min_buy_order() const
         throw error_message_t(error_code_t::NO_ORDERS, message);
     }
     
-    float min_bid = this->buy_orders_.front();
+    // Branch-free so that the reduction vectorizes
+    const float* orders = this->buy_orders_.data();
+    float min_bid = orders[0];
+    #pragma omp simd reduction(min:min_bid)
     for (unsigned ix = 1; ix < num_orders; ix++)
-    {
-        float cur_bid = this->buy_orders_[ix];
-        if (min_bid > cur_bid)
-            min_bid = cur_bid;
-    }
+        min_bid = std::min(min_bid, orders[ix]);
     
     return min_bid;
     
@@ -50,13 +50,11 @@ float item_market_t::max_buy_order() const
         throw error_message_t(error_code_t::NO_ORDERS, message);
     }
     
-    float max_bid = this->buy_orders_.front();
+    const float* orders = this->buy_orders_.data();
+    float max_bid = orders[0];
+    #pragma omp simd reduction(max:max_bid)
     for (unsigned ix = 1; ix < num_orders; ix++)
-    {
-        float cur_bid = this->buy_orders_[ix];
-        if (max_bid < cur_bid)
-            max_bid = cur_bid;
-    }
+        max_bid = std::max(max_bid, orders[ix]);
     
     return max_bid;
     
@@ -74,13 +72,11 @@ float item_market_t::min_sell_order() const
         throw error_message_t(error_code_t::NO_ORDERS, message);
     }
     
-    float min_bid = this->sell_orders_.front();
+    const float* orders = this->sell_orders_.data();
+    float min_bid = orders[0];
+    #pragma omp simd reduction(min:min_bid)
     for (unsigned ix = 1; ix < num_orders; ix++)
-    {
-        float cur_bid = this->sell_orders_[ix];
-        if (min_bid > cur_bid)
-            min_bid = cur_bid;
-    }
+        min_bid = std::min(min_bid, orders[ix]);
     
     return min_bid;
     
@@ -98,13 +94,11 @@ float item_market_t::max_sell_order() const
         throw error_message_t(error_code_t::NO_ORDERS, message);
     }
     
-    float max_bid = this->sell_orders_.front();
+    const float* orders = this->sell_orders_.data();
+    float max_bid = orders[0];
+    #pragma omp simd reduction(max:max_bid)
     for (unsigned ix = 1; ix < num_orders; ix++)
-    {
-        float cur_bid = this->sell_orders_[ix];
-        if (max_bid < cur_bid)
-            max_bid = cur_bid;
-    }
+        max_bid = std::max(max_bid, orders[ix]);
     
     return max_bid;
     
@@ -12,6 +12,7 @@
 #include <string_view>
 #include <vector>
 
+#include "arena.h"
 #include "error.h"
 #include "json.h"
 
@@ -22,12 +23,24 @@ class item_market_t
         
     public:
         
+        /// @brief Buy and sell prices, allocated from the @ref arena_t of the
+        /// owning @ref regional_market_t when there is one.
+        typedef std::vector< float, arena_allocator_t<float> > price_list_t;
+        
         /// @brief Default constructor
         inline item_market_t() = default;
         
         // Add member initialization constructors here
         // Try to use initializer lists when possible.
         
+        /// @brief Allocate prices from an arena.  A null arena uses the heap.
+        inline item_market_t(arena_t* arena)
+          : buy_orders_(arena_allocator_t<float>(arena)),
+            sell_orders_(arena_allocator_t<float>(arena))
+        {
+            // All work done in initializer list
+        }
+        
         // Add operators here if desired.
         
         // Add member read and write functions
@@ -44,12 +57,12 @@ class item_market_t
             this->item_id_ = new_item_id;
         } 
         
-        const std::vector<float>& buy_orders() const
+        const price_list_t& buy_orders() const
         {
             return this->buy_orders_;
         }
         
-        const std::vector<float>& sell_orders() const
+        const price_list_t& sell_orders() const
         {
             return this->sell_orders_;
         }
@@ -78,6 +91,24 @@ class item_market_t
             this->sell_orders_.emplace_back(sell_price);
         }
         
+        inline void clear_buy_orders()
+        {
+            this->buy_orders_.clear();
+        }
+        
+        inline void clear_sell_orders()
+        {
+            this->sell_orders_.clear();
+        }
+        
+        /// @brief Pre-size order storage so that adding this many orders
+        /// doesn't reallocate.
+        inline void reserve(unsigned num_buy_orders, unsigned num_sell_orders)
+        {
+            this->buy_orders_.reserve(num_buy_orders);
+            this->sell_orders_.reserve(num_sell_orders);
+        }
+        
         /// @brief Remove all orders that are not the minimum sell order.
         void cull_unavailable_orders();
         
@@ -171,10 +202,10 @@ class item_market_t
         uint64_t item_id_;
         
         /// The prices for all active buy bids for this item.
-        std::vector<float> buy_orders_;
+        price_list_t buy_orders_;
         
         /// The prices for all active sell bids for this item.
-        std::vector<float> sell_orders_;
+        price_list_t sell_orders_;
         
 };
 
@@ -5,6 +5,7 @@
 /// * Date Created = Friday November 24 2017
 /// * Documentation is generated by doxygen, see html/index.html
 
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include <string_view>
@@ -14,17 +15,16 @@
 #include "json.h"
 #include "station_market.h"
 
-float item_quantities_t::total_sell_value(const station_market_t& station_market, unsigned material_efficiency) const
+float item_quantities_t::total_sell_value(const station_market_t& station_market, unsigned material_efficiency, unsigned runs, float material_multiplier) const
 {
     
     float accumulator = 0.0f;
-    unsigned scale_material_efficiency = 100 - material_efficiency;
-    std::unordered_map<uint64_t, item_market_t>::const_iterator not_found = station_market.end();
+    station_market_t::item_map_t::const_iterator not_found = station_market.end();
     
     for (const item_quantity_t& cur_item_quantity : this->materials_list_)
     {
         
-        std::unordered_map<uint64_t, item_market_t>::const_iterator cur_item_market = station_market.items().find(cur_item_quantity.item_id());
+        station_market_t::item_map_t::const_iterator cur_item_market = station_market.items().find(cur_item_quantity.item_id());
         if (cur_item_market == not_found)
         {
             std::string message("Error.  Could not find sell order for item with id ");
@@ -33,11 +33,10 @@ float item_quantities_t::total_sell_value(const station_market_t& station_market
             throw error_message_t(error_code_t::NO_ORDERS, message);
         }
         
-        // Round up to the nearest integer
-        unsigned rounded_modified_materials = (cur_item_quantity.quantity() * scale_material_efficiency + 99) / 100;
-        
-        // This integer rounding error (during divide) is intentional
-        // to match EvE's rounding rules.
+        // Round up to the nearest integer once per job.  This integer
+        // rounding error (during divide) is intentional to match EvE's
+        // rounding rules.
+        uint64_t rounded_modified_materials = batch_quantity(cur_item_quantity.quantity(), material_efficiency, runs, material_multiplier);
         accumulator += float(rounded_modified_materials) * cur_item_market->second.min_sell_order();
     }
     
@@ -8,6 +8,8 @@
 #ifndef HEADER_GUARD_ITEM_QUANTITIES
 #define HEADER_GUARD_ITEM_QUANTITIES
 
+#include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <string_view>
 #include <vector>
@@ -48,6 +50,19 @@ class item_quantities_t
         
         // Add special-purpose functions here
         
+        // Number of units of one material consumed by a job of several runs.
+        // EvE rounds up once per job rather than once per run, but never
+        // uses less than one unit per run.  Structure and rig bonuses scale
+        // the amount before it is rounded.
+        static inline uint64_t batch_quantity(unsigned base_quantity, unsigned material_efficiency, unsigned runs, float material_multiplier = 1.0f)
+        {
+            uint64_t hundredths = uint64_t(base_quantity) * runs * (100 - material_efficiency);
+            if (material_multiplier != 1.0f)
+                hundredths = uint64_t(std::llround(double(hundredths) * material_multiplier));
+            uint64_t rounded = (hundredths + 99) / 100;
+            return rounded > runs ? rounded : runs;
+        }
+        
         // Calculate the combined ISK value of all items in this structure
         // based on the lowest sell order
         //
@@ -57,7 +72,11 @@ class item_quantities_t
             // Prices for items at a specific station
             const station_market_t& station_market,
             // Ranges from [0 to 10].
-            unsigned material_efficiency
+            unsigned material_efficiency,
+            // Number of runs in one manufacturing job
+            unsigned runs = 1,
+            // See batch_quantity
+            float material_multiplier = 1.0f
         ) const;
         
         // Add encoders/decoders here
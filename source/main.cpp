@@ -8,16 +8,152 @@
 #include <fstream>
 #include <iostream>
 #include <unordered_set>
+#include <vector>
 
+#include "arbitrage_scan.h"
 #include "args_eve_industry.h"
+#include "best_price_index.h"
 #include "blueprints.h"
+#include "build_tree.h"
 #include "error.h"
+#include "fetch_planner.h"
+#include "fetch_scheduler.h"
 #include "galactic_market.h"
+#include "ingest_filter.h"
 #include "item_attributes.h"
 #include "item_ids.h"
 #include "galactic_profits.h"
+#include "industry_profiles.h"
+#include "invention_risk.h"
+#include "market_history.h"
+#include "price_delta.h"
+#include "price_scenarios.h"
+#include "price_sensitivity.h"
+#include "production_schedule.h"
+#include "reprocess_values.h"
+#include "reprocessing.h"
 #include "station_attributes.h"
-#include "raw_regional_market.h"
+#include "stats.h"
+#include "trace.h"
+#include "universe_topology.h"
+
+/// @brief Add the size of a freshly written output file to the statistics.
+static void count_output_bytes(const debug_mode_t& debug_mode, std::ofstream& file)
+{
+    if (debug_mode.stats() != nullptr)
+        debug_mode.stats()->increment(stats_t::counter_t::OUTPUT_BYTES, uint64_t(file.tellp()));
+}
+
+/// @brief Files shared by the modes which price items from a galactic market.
+/// Optional members are left empty if their argument wasn't passed.
+struct profit_inputs_t
+{
+    galactic_market_t galactic_market;
+    blueprints_t blueprints;
+    /// @brief Only kept as read when there are no blueprints, else it has
+    /// already been applied to @ref galactic_market.
+    market_history_t market_history;
+    item_attributes_t item_attributes;
+    /// @brief Names from @ref item_attributes.
+    std::unordered_map<uint64_t, std::string_view> item_names;
+    industry_profiles_t profiles;
+};
+
+/// @brief Read --prices-in, --blueprints-in if the mode takes it,
+/// --history-in, --item-attributes-in and --profiles-in.
+///
+/// If blueprints were read, top-of-book prices are replaced with recent
+/// averages from the history.  The blueprints are needed first to tell
+/// products from inputs.
+///
+/// Returns false after printing a message if a file can't be opened.
+static bool load_profit_inputs(const args::eve_industry_t& args, const debug_mode_t& debug_mode, profit_inputs_t& inputs)
+{
+    
+    // Open prices file for reading
+    if (debug_mode.verbose())
+        std::cout << "Parsing prices-in file \"" << args.prices_in() << "\".\n";
+    std::ifstream prices_in_file(args.prices_in());
+    if (!prices_in_file.good())
+    {
+        std::cerr << "Error.  Failed to open \"" << args.prices_in() << "\" for reading.\n";
+        return false;
+    }
+    {
+        stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+        inputs.galactic_market.read_from_json_file(prices_in_file);
+    }
+    
+    // Open blueprints file for reading
+    if (!args.blueprints_in().empty())
+    {
+        if (debug_mode.verbose())
+            std::cout << "Parsing blueprints-in file \"" << args.blueprints_in() << "\".\n";
+        std::ifstream blueprints_in_file(args.blueprints_in());
+        if (!blueprints_in_file.good())
+        {
+            std::cerr << "Error.  Failed to open \"" << args.blueprints_in() << "\" for reading.\n";
+            return false;
+        }
+        stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+        inputs.blueprints.read_from_json_file(blueprints_in_file);
+    }
+    
+    // Open optional history file for reading
+    if (!args.history_in().empty())
+    {
+        if (debug_mode.verbose())
+            std::cout << "Parsing history-in file \"" << args.history_in() << "\".\n";
+        std::ifstream history_in_file(args.history_in(), std::ios::binary);
+        if (!history_in_file.good())
+        {
+            std::cerr << "Error.  Failed to open \"" << args.history_in() << "\" for reading.\n";
+            return false;
+        }
+        inputs.market_history.debug_mode(debug_mode);
+        {
+            stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+            inputs.market_history.read_from_file(history_in_file);
+        }
+        if (!args.blueprints_in().empty())
+            inputs.market_history.apply_averages(inputs.galactic_market, inputs.blueprints, args.history_days(), args.history_min_volume());
+    }
+    
+    // Open optional item_attributes_in file for reading
+    if (!args.item_attributes_in().empty())
+    {
+        if (debug_mode.verbose())
+            std::cout << "Parsing item-attributes-in file \"" << args.item_attributes_in() << "\".\n";
+        std::ifstream item_attributes_in_file(args.item_attributes_in());
+        if (!item_attributes_in_file.good())
+        {
+            std::cerr << "Error.  Failed to open \"" << args.item_attributes_in() << "\" for reading.\n";
+            return false;
+        }
+        stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+        inputs.item_attributes.read_from_json_file(item_attributes_in_file);
+        for (const item_attribute_t& cur_item : inputs.item_attributes.items())
+            inputs.item_names.emplace(cur_item.id(), std::string_view(cur_item.name()));
+    }
+    
+    // Open optional profiles_in file for reading
+    if (!args.profiles_in().empty())
+    {
+        if (debug_mode.verbose())
+            std::cout << "Parsing profiles-in file \"" << args.profiles_in() << "\".\n";
+        std::ifstream profiles_in_file(args.profiles_in());
+        if (!profiles_in_file.good())
+        {
+            std::cerr << "Error.  Failed to open \"" << args.profiles_in() << "\" for reading.\n";
+            return false;
+        }
+        stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+        inputs.profiles.read_from_json_file(profiles_in_file);
+    }
+    
+    return true;
+    
+}
 
 /// @brief Code execution starts here
 int main(int argc, char** argv)
@@ -29,6 +165,36 @@ int main(int argc, char** argv)
         args::eve_industry_t args;
         args.parse(argc, argv);
         
+        // Statistics are only collected if --stats-out was passed.  Open the
+        // file now so that we can find out if it fails before doing any work.
+        stats_t stats;
+        debug_mode_t debug_mode = args.debug_mode();
+        std::ofstream stats_out_file;
+        if (!args.stats_out().empty())
+        {
+            stats_out_file.open(args.stats_out());
+            if (!stats_out_file.good())
+            {
+                std::cerr << "Error.  Failed to open \"" << args.stats_out() << "\" for writing.\n";
+                return -1;
+            }
+            debug_mode.stats(&stats);
+        }
+        
+        // Likewise, only record a timeline if --trace-out was passed.
+        trace_t trace;
+        std::ofstream trace_out_file;
+        if (!args.trace_out().empty())
+        {
+            trace_out_file.open(args.trace_out());
+            if (!trace_out_file.good())
+            {
+                std::cerr << "Error.  Failed to open \"" << args.trace_out() << "\" for writing.\n";
+                return -1;
+            }
+            debug_mode.trace(&trace);
+        }
+        
         switch (args.mode())
         {
             
@@ -44,21 +210,25 @@ int main(int argc, char** argv)
                     return -1;
                 }
                 
-                if (args.debug_mode().verbose())
+                if (debug_mode.verbose())
                     std::cout << "Fetching item ids\n";
                 item_ids_t item_ids;
-                item_ids.debug_mode(args.debug_mode());
+                item_ids.debug_mode(debug_mode);
                 item_ids.fetch();
                 
-                if (args.debug_mode().verbose())
+                if (debug_mode.verbose())
                     std::cout << "Fetching item attributes\n";
                 item_attributes_t item_attributes;
-                item_attributes.debug_mode(args.debug_mode());
+                item_attributes.debug_mode(debug_mode);
                 item_attributes.fetch(item_ids);
-                    
-                if (args.debug_mode().verbose())
+                
+                if (debug_mode.verbose())
                     std::cout << "Writing item attributes to file.\n";
-                item_attributes.write_to_json_file(item_attributes_out_file);
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::WRITE);
+                    item_attributes.write_to_json_file(item_attributes_out_file);
+                }
+                count_output_bytes(debug_mode, item_attributes_out_file);
                 item_attributes_out_file.close();
                 
                 break;
@@ -69,7 +239,7 @@ int main(int argc, char** argv)
             {
                 
                 // Open item attributes from file
-                if (args.debug_mode().verbose())
+                if (debug_mode.verbose())
                     std::cout << "Parsing item-attributes-in file \"" << args.item_attributes_in() << "\".\n";
                 std::ifstream item_attributes_in_file(args.item_attributes_in());
                 if (!item_attributes_in_file.good())
@@ -78,11 +248,14 @@ int main(int argc, char** argv)
                     return -1;
                 }
                 item_attributes_t item_attributes_in;
-                item_attributes_in.read_from_json_file(item_attributes_in_file);
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    item_attributes_in.read_from_json_file(item_attributes_in_file);
+                }
                 item_attributes_in_file.close();
                 
                 // Open station attributes from file
-                if (args.debug_mode().verbose())
+                if (debug_mode.verbose())
                     std::cout << "Parsing station-attributes-in file\"" << args.station_attributes_in() << "\".\n";
                 std::ifstream station_attributes_in_file(args.station_attributes_in());
                 if (!station_attributes_in_file.good())
@@ -91,7 +264,10 @@ int main(int argc, char** argv)
                     return -1;
                 }
                 station_attributes_t station_attributes_in;
-                station_attributes_in.read_from_json_file(station_attributes_in_file);
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    station_attributes_in.read_from_json_file(station_attributes_in_file);
+                }
                 station_attributes_in_file.close();
                 
                 // Open file to output market data to
@@ -102,79 +278,241 @@ int main(int argc, char** argv)
                     return -1;
                 }
                 
-                // Fetch market data for the regions of all requested stations.
-                galactic_market_t galactic_market;
-                for (const station_attribute_t& cur_station : station_attributes_in.stations())
-                {
-                    
-                    if (args.debug_mode().verbose())
-                        std::cout << "Fetching market data for station \"" << cur_station.name() << "\".\n";
-                    
-                    // Do not re-fetch data for the same region if we've already fetched it.
-                    if (galactic_market.regions().count(cur_station.station_id()))
-                        continue;
-                    
-                    uint64_t cur_region_id = cur_station.region_id();
-                    if (args.debug_mode().verbose())
-                        std::cout << "Fetching all market orders from region " << cur_region_id << '\n';
-                    raw_regional_market_t raw_regional_market;
-                    raw_regional_market.fetch(cur_region_id);
-                    
-                    // Post-process market data
-                    if (args.debug_mode().verbose())
-                        std::cout << "Post-processing regional market for region " << cur_region_id << '\n';
-                    regional_market_t regional_market;
-                    regional_market.initialize_from_raw_regional_market(raw_regional_market);
-                    
-                    // Augmenting galactic market
-                    if (args.debug_mode().verbose())
-                        std::cout << "Augmenting galactic market data.\n";
-                    galactic_market.add_new_regional_market(std::move(regional_market));
-                    
-                }
-                
-                // Remove market data for stations we aren't interested in
+                // Orders at stations we aren't interested in, and all except
+                // the best orders if requested, are dropped while each region
+                // is decoded so that they are never stored.
+                ingest_filter_t ingest_filter;
                 if (args.cull_stations())
                 {
-                    
-                    if (args.debug_mode().verbose())
+                    if (debug_mode.verbose())
                         std::cout << "Culling orders from non-requested stations.\n";
-                    
-                    // Build list of stations to keep
-                    std::unordered_set<uint64_t> stations_to_keep;
-                    const std::vector<station_attribute_t>& stations = station_attributes_in.stations();
-                    unsigned num_stations = stations.size();
-                    stations_to_keep.reserve(num_stations);
-                    for (unsigned ix = 0; ix < num_stations; ix++)
-                        stations_to_keep.emplace(stations[ix].station_id());
-                    
-                    // Strip away orders for stations that we didn't ask for
-                    galactic_market.cull_by_station(stations_to_keep);
-                    
+                    ingest_filter.cull_stations(true);
+                    ingest_filter.add_stations(station_attributes_in);
                 }
-                
                 if (args.cull_orders())
                 {
-                    if (args.debug_mode().verbose())
+                    if (debug_mode.verbose())
                         std::cout << "Culling all except minimum sell and maximum buy orders.\n";
-                    galactic_market.cull_unavailable_orders();
+                    ingest_filter.cull_orders(true);
+                }
+                if (!args.blueprints_in().empty())
+                {
+                    if (debug_mode.verbose())
+                        std::cout << "Culling orders for items not used by any blueprint in \"" << args.blueprints_in() << "\".\n";
+                    std::ifstream blueprints_in_file(args.blueprints_in());
+                    if (!blueprints_in_file.good())
+                    {
+                        std::cerr << "Error.  Failed to open \"" << args.blueprints_in() << "\" for reading.\n";
+                        return -1;
+                    }
+                    blueprints_t blueprints_in;
+                    {
+                        stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                        blueprints_in.read_from_json_file(blueprints_in_file);
+                    }
+                    ingest_filter.cull_items(true);
+                    ingest_filter.add_items(blueprints_in);
                 }
                 
+                // Buy orders at other stations count at each requested station
+                // within their range.  A cached topology is mapped rather than
+                // searching the stargates again.
+                universe_topology_t topology;
+                if (!args.topology_in().empty())
+                {
+                    if (debug_mode.verbose())
+                        std::cout << "Mapping topology-in file \"" << args.topology_in() << "\".\n";
+                    {
+                        stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                        topology.map_binary_file(args.topology_in());
+                    }
+                    ingest_filter.order_ranges(&topology, station_attributes_in);
+                } else if (!args.stargates_in().empty()) {
+                    if (debug_mode.verbose())
+                        std::cout << "Parsing stargates-in file \"" << args.stargates_in() << "\".\n";
+                    std::ifstream stargates_in_file(args.stargates_in());
+                    if (!stargates_in_file.good())
+                    {
+                        std::cerr << "Error.  Failed to open \"" << args.stargates_in() << "\" for reading.\n";
+                        return -1;
+                    }
+                    {
+                        stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                        topology.read_from_json_file(stargates_in_file);
+                    }
+                    ingest_filter.order_ranges(&topology, station_attributes_in);
+                }
+                
+                // Regions with many pages but few relevant items are cheaper
+                // to fetch one item type at a time
+                fetch_planner_t fetch_planner;
+                if (ingest_filter.cull_items())
+                    fetch_planner.item_ids(ingest_filter.item_ids());
+                
+                // Fetch market data for the regions of all requested stations.
+                // Each region is only fetched once no matter how many stations
+                // it contains, and all regions share one pool of workers.
+                fetch_scheduler_t fetch_scheduler;
+                fetch_scheduler.debug_mode(debug_mode);
+                fetch_scheduler.ingest_filter(ingest_filter);
+                fetch_scheduler.fetch_planner(fetch_planner);
+                fetch_scheduler.add_regions(station_attributes_in);
+                std::vector<regional_market_t> regional_markets = fetch_scheduler.fetch();
+                
+                // Augmenting galactic market
+                if (debug_mode.verbose())
+                    std::cout << "Augmenting galactic market data.\n";
+                galactic_market_t galactic_market;
+                for (regional_market_t& cur_regional_market : regional_markets)
+                    galactic_market.add_new_regional_market(std::move(cur_regional_market));
+                regional_markets.clear();
+                
                 // Write market data to file
-                if (args.debug_mode().verbose())
+                if (debug_mode.verbose())
                     std::cout << "Writing galactic market data to file \"" << args.prices_out() << "\".\n";
-                galactic_market.write_to_json_file(prices_out_file);
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::WRITE);
+                    galactic_market.write_to_json_file(prices_out_file);
+                }
+                count_output_bytes(debug_mode, prices_out_file);
                 prices_out_file.close();
                 
                 break;
                 
             }
             
-            case args::eve_industry_t::mode_t::CALCULATE_BLUEPRINT_PROFITS:
+            case args::eve_industry_t::mode_t::UPDATE_HISTORY:
             {
                 
                 // Open prices file for reading
-                if (args.debug_mode().verbose())
+                if (debug_mode.verbose())
+                    std::cout << "Parsing prices-in file \"" << args.prices_in() << "\".\n";
+                std::ifstream prices_in_file(args.prices_in());
+                if (!prices_in_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.prices_in() << "\" for reading.\n";
+                    return -1;
+                }
+                galactic_market_t galactic_market;
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    galactic_market.read_from_json_file(prices_in_file);
+                }
+                
+                // Load the existing history, if any, so that only new days are
+                // appended
+                market_history_t market_history;
+                market_history.debug_mode(debug_mode);
+                {
+                    std::ifstream history_in_file(args.history_out(), std::ios::binary);
+                    if (history_in_file.good())
+                    {
+                        if (debug_mode.verbose())
+                            std::cout << "Parsing existing history file \"" << args.history_out() << "\".\n";
+                        stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                        market_history.read_from_file(history_in_file);
+                    }
+                }
+                
+                // Every item traded in every region gets today's snapshot and
+                // whatever the API has published since the last update
+                std::vector<market_history_t::series_key_t> keys;
+                for (const std::pair<const uint64_t, regional_market_t>& cur_region : galactic_market)
+                {
+                    std::unordered_set<uint64_t> items;
+                    for (const std::pair<const uint64_t, station_market_t>& cur_station : cur_region.second)
+                        for (const std::pair<const uint64_t, item_market_t>& cur_item : cur_station.second)
+                            if (items.insert(cur_item.first).second)
+                                keys.emplace_back(cur_region.first, cur_item.first);
+                }
+                market_history.append_snapshot(galactic_market, market_history_t::today());
+                if (debug_mode.verbose())
+                    std::cout << "Fetching history of " << keys.size() << " items.\n";
+                market_history.fetch(keys);
+                
+                // Append new days to the history file
+                if (debug_mode.verbose())
+                    std::cout << "Writing history-out file \"" << args.history_out() << "\".\n";
+                std::ofstream history_out_file(args.history_out(), std::ios::binary | std::ios::app);
+                if (!history_out_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.history_out() << "\" for writing.\n";
+                    return -1;
+                }
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::WRITE);
+                    market_history.append_to_file(history_out_file);
+                }
+                count_output_bytes(debug_mode, history_out_file);
+                history_out_file.close();
+                
+                break;
+                
+            }
+            
+            case args::eve_industry_t::mode_t::DIFF_PRICES:
+            {
+                
+                // Open both prices files for reading
+                if (debug_mode.verbose())
+                    std::cout << "Parsing prices-in file \"" << args.prices_in() << "\".\n";
+                std::ifstream prices_in_file(args.prices_in());
+                if (!prices_in_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.prices_in() << "\" for reading.\n";
+                    return -1;
+                }
+                galactic_market_t old_galactic_market;
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    old_galactic_market.read_from_json_file(prices_in_file);
+                }
+                
+                if (debug_mode.verbose())
+                    std::cout << "Parsing new-prices-in file \"" << args.new_prices_in() << "\".\n";
+                std::ifstream new_prices_in_file(args.new_prices_in());
+                if (!new_prices_in_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.new_prices_in() << "\" for reading.\n";
+                    return -1;
+                }
+                galactic_market_t new_galactic_market;
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    new_galactic_market.read_from_json_file(new_prices_in_file);
+                }
+                
+                // Compare best prices
+                price_delta_t price_delta;
+                price_delta.initialize_from_markets(old_galactic_market, new_galactic_market);
+                if (debug_mode.verbose())
+                    std::cout << price_delta.num_changed_items() << " items changed and " << price_delta.num_removed_items() << " items were removed.\n";
+                
+                // Write delta to file
+                if (debug_mode.verbose())
+                    std::cout << "Writing delta-out file \"" << args.delta_out() << "\".\n";
+                std::ofstream delta_out_file(args.delta_out());
+                if (!delta_out_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.delta_out() << "\" for writing.\n";
+                    return -1;
+                }
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::WRITE);
+                    price_delta.write_to_json_file(delta_out_file);
+                }
+                count_output_bytes(debug_mode, delta_out_file);
+                delta_out_file.close();
+                
+                break;
+                
+            }
+            
+            case args::eve_industry_t::mode_t::APPLY_PRICE_DELTA:
+            {
+                
+                // Open prices and delta files for reading
+                if (debug_mode.verbose())
                     std::cout << "Parsing prices-in file \"" << args.prices_in() << "\".\n";
                 std::ifstream prices_in_file(args.prices_in());
                 if (!prices_in_file.good())
@@ -183,10 +521,118 @@ int main(int argc, char** argv)
                     return -1;
                 }
                 galactic_market_t galactic_market;
-                galactic_market.read_from_json_file(prices_in_file);
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    galactic_market.read_from_json_file(prices_in_file);
+                }
+                
+                if (debug_mode.verbose())
+                    std::cout << "Parsing delta-in file \"" << args.delta_in() << "\".\n";
+                std::ifstream delta_in_file(args.delta_in());
+                if (!delta_in_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.delta_in() << "\" for reading.\n";
+                    return -1;
+                }
+                price_delta_t price_delta;
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    price_delta.read_from_json_file(delta_in_file);
+                }
+                
+                galactic_market.apply_delta(price_delta);
+                
+                // Write updated prices to file
+                if (debug_mode.verbose())
+                    std::cout << "Writing prices-out file \"" << args.prices_out() << "\".\n";
+                std::ofstream prices_out_file(args.prices_out());
+                if (!prices_out_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.prices_out() << "\" for writing.\n";
+                    return -1;
+                }
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::WRITE);
+                    galactic_market.write_to_json_file(prices_out_file);
+                }
+                count_output_bytes(debug_mode, prices_out_file);
+                prices_out_file.close();
+                
+                break;
+                
+            }
+            
+            case args::eve_industry_t::mode_t::CALCULATE_BLUEPRINT_PROFITS:
+            {
+                
+                profit_inputs_t inputs;
+                if (!load_profit_inputs(args, debug_mode, inputs))
+                    return -1;
                 
-                // Open blueprints file for reading
-                if (args.debug_mode().verbose())
+                // Calculate blueprint profit at each station
+                if (debug_mode.verbose())
+                    std::cout << "Calculating blueprint profitability.\n";
+                galactic_profits_t galactic_profits_out;
+                galactic_profits_out.debug_mode(debug_mode);
+                best_price_index_t best_prices;
+                if (args.cross_station())
+                {
+                    best_prices.hauling_cost(float(args.hauling_cost_percent() / 100.0));
+                    best_prices.initialize_from_market(inputs.galactic_market);
+                }
+                build_tree_t build_tree;
+                if (args.build_intermediates())
+                    build_tree.initialize_from_blueprints(inputs.blueprints);
+                galactic_profits_out.caclulate_station_profits
+                (
+                    inputs.blueprints,
+                    inputs.galactic_market,
+                    args.decryptor_optimization_strategy(),
+                    args.cross_station() ? &best_prices : nullptr,
+                    args.build_intermediates() ? &build_tree : nullptr,
+                    args.runs_per_job(),
+                    args.profiles_in().empty() ? nullptr : &inputs.profiles
+                );
+                
+                // Write profits report to file.
+                if (debug_mode.verbose())
+                    std::cout << "Writing profits-out file \"" << args.profits_out() << "\".\n";
+                std::ofstream profits_out_file(args.profits_out());
+                if (!profits_out_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.profits_out() << "\" for reading.\n";
+                    return -1;
+                }
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::WRITE);
+                    galactic_profits_out.write_to_json_file(profits_out_file, args.output_order(), inputs.item_names);
+                }
+                count_output_bytes(debug_mode, profits_out_file);
+                profits_out_file.close();
+                
+                break;
+                
+            }
+            
+            case args::eve_industry_t::mode_t::SCHEDULE_PRODUCTION:
+            {
+                
+                // Open profits and blueprints files for reading
+                if (debug_mode.verbose())
+                    std::cout << "Parsing profits-in file \"" << args.profits_in() << "\".\n";
+                std::ifstream profits_in_file(args.profits_in());
+                if (!profits_in_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.profits_in() << "\" for reading.\n";
+                    return -1;
+                }
+                galactic_profits_t galactic_profits_in;
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    galactic_profits_in.read_from_json_file(profits_in_file);
+                }
+                
+                if (debug_mode.verbose())
                     std::cout << "Parsing blueprints-in file \"" << args.blueprints_in() << "\".\n";
                 std::ifstream blueprints_in_file(args.blueprints_in());
                 if (!blueprints_in_file.good())
@@ -195,16 +641,355 @@ int main(int argc, char** argv)
                     return -1;
                 }
                 blueprints_t blueprints_in;
-                blueprints_in.read_from_json_file(blueprints_in_file);
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    blueprints_in.read_from_json_file(blueprints_in_file);
+                }
+                
+                // Optional trade volumes to cap each blueprint
+                market_history_t market_history;
+                market_history.debug_mode(debug_mode);
+                if (!args.history_in().empty())
+                {
+                    if (debug_mode.verbose())
+                        std::cout << "Parsing history-in file \"" << args.history_in() << "\".\n";
+                    std::ifstream history_in_file(args.history_in(), std::ios::binary);
+                    if (!history_in_file.good())
+                    {
+                        std::cerr << "Error.  Failed to open \"" << args.history_in() << "\" for reading.\n";
+                        return -1;
+                    }
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    market_history.read_from_file(history_in_file);
+                }
+                
+                if (debug_mode.verbose())
+                    std::cout << "Scheduling production.\n";
+                production_schedule_t production_schedule;
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::PROFIT);
+                    production_schedule.num_characters(args.num_characters());
+                    production_schedule.manufacturing_slots(args.manufacturing_slots());
+                    production_schedule.science_slots(args.science_slots());
+                    production_schedule.capital(args.capital());
+                    production_schedule.horizon_hours(args.schedule_hours());
+                    production_schedule.initialize_from_profits
+                    (
+                        galactic_profits_in,
+                        blueprints_in,
+                        args.history_in().empty() ? nullptr : &market_history,
+                        args.history_days()
+                    );
+                    production_schedule.solve();
+                }
+                
+                // Write schedule to file
+                if (debug_mode.verbose())
+                    std::cout << "Writing schedule-out file \"" << args.schedule_out() << "\".\n";
+                std::ofstream schedule_out_file(args.schedule_out());
+                if (!schedule_out_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.schedule_out() << "\" for writing.\n";
+                    return -1;
+                }
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::WRITE);
+                    production_schedule.write_to_json_file(schedule_out_file);
+                    schedule_out_file << '\n';
+                }
+                count_output_bytes(debug_mode, schedule_out_file);
+                schedule_out_file.close();
+                
+                break;
+                
+            }
+            
+            case args::eve_industry_t::mode_t::PRICE_SENSITIVITY:
+            {
+                
+                profit_inputs_t inputs;
+                if (!load_profit_inputs(args, debug_mode, inputs))
+                    return -1;
+                
+                // Only the first profile is used
+                industry_profile_t::modifiers_t modifiers = industry_profile_t::no_modifiers;
+                if (!inputs.profiles.profiles().empty())
+                    modifiers = inputs.profiles.profiles().front().modifiers();
+                
+                // Open optional scenarios_in file for reading
+                price_scenarios_t scenarios_in;
+                if (!args.scenarios_in().empty())
+                {
+                    if (debug_mode.verbose())
+                        std::cout << "Parsing scenarios-in file \"" << args.scenarios_in() << "\".\n";
+                    std::ifstream scenarios_in_file(args.scenarios_in());
+                    if (!scenarios_in_file.good())
+                    {
+                        std::cerr << "Error.  Failed to open \"" << args.scenarios_in() << "\" for reading.\n";
+                        return -1;
+                    }
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    scenarios_in.read_from_json_file(scenarios_in_file);
+                }
+                
+                if (debug_mode.verbose())
+                    std::cout << "Calculating price sensitivity.\n";
+                price_sensitivity_t price_sensitivity;
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::PROFIT);
+                    best_price_index_t best_prices;
+                    if (args.cross_station())
+                    {
+                        best_prices.hauling_cost(float(args.hauling_cost_percent() / 100.0));
+                        best_prices.initialize_from_market(inputs.galactic_market);
+                    }
+                    price_sensitivity.initialize_from_market
+                    (
+                        inputs.blueprints,
+                        inputs.galactic_market,
+                        args.decryptor_optimization_strategy(),
+                        args.cross_station() ? &best_prices : nullptr,
+                        args.runs_per_job(),
+                        modifiers
+                    );
+                    price_sensitivity.evaluate_scenarios(scenarios_in);
+                }
+                
+                // Write report to file
+                if (debug_mode.verbose())
+                    std::cout << "Writing sensitivity-out file \"" << args.sensitivity_out() << "\".\n";
+                std::ofstream sensitivity_out_file(args.sensitivity_out());
+                if (!sensitivity_out_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.sensitivity_out() << "\" for writing.\n";
+                    return -1;
+                }
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::WRITE);
+                    price_sensitivity.write_to_json_file(sensitivity_out_file, inputs.item_names);
+                    sensitivity_out_file << '\n';
+                }
+                count_output_bytes(debug_mode, sensitivity_out_file);
+                sensitivity_out_file.close();
+                
+                break;
+                
+            }
+            
+            case args::eve_industry_t::mode_t::INVENTION_RISK:
+            {
+                
+                profit_inputs_t inputs;
+                if (!load_profit_inputs(args, debug_mode, inputs))
+                    return -1;
+                
+                // Only the first profile is used
+                industry_profile_t::modifiers_t modifiers = industry_profile_t::no_modifiers;
+                if (!inputs.profiles.profiles().empty())
+                    modifiers = inputs.profiles.profiles().front().modifiers();
+                
+                if (debug_mode.verbose())
+                    std::cout << "Simulating " << args.num_trials() << " trials of " << args.invention_attempts() << " invention attempts.\n";
+                invention_risk_t invention_risk;
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::PROFIT);
+                    best_price_index_t best_prices;
+                    if (args.cross_station())
+                    {
+                        best_prices.hauling_cost(float(args.hauling_cost_percent() / 100.0));
+                        best_prices.initialize_from_market(inputs.galactic_market);
+                    }
+                    invention_risk.initialize_from_market
+                    (
+                        inputs.blueprints,
+                        inputs.galactic_market,
+                        args.num_trials(),
+                        args.invention_attempts(),
+                        args.seed(),
+                        args.cross_station() ? &best_prices : nullptr,
+                        args.runs_per_job(),
+                        modifiers
+                    );
+                }
+                
+                // Write report to file
+                if (debug_mode.verbose())
+                    std::cout << "Writing risk-out file \"" << args.risk_out() << "\".\n";
+                std::ofstream risk_out_file(args.risk_out());
+                if (!risk_out_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.risk_out() << "\" for writing.\n";
+                    return -1;
+                }
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::WRITE);
+                    invention_risk.write_to_json_file(risk_out_file, inputs.item_names);
+                    risk_out_file << '\n';
+                }
+                count_output_bytes(debug_mode, risk_out_file);
+                risk_out_file.close();
+                
+                break;
+                
+            }
+            
+            case args::eve_industry_t::mode_t::BUILD_TOPOLOGY:
+            {
+                
+                // Read stargates and search every system
+                if (debug_mode.verbose())
+                    std::cout << "Parsing stargates-in file \"" << args.stargates_in() << "\".\n";
+                std::ifstream stargates_in_file(args.stargates_in());
+                if (!stargates_in_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.stargates_in() << "\" for reading.\n";
+                    return -1;
+                }
+                universe_topology_t topology;
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    topology.read_from_json_file(stargates_in_file);
+                }
+                stargates_in_file.close();
+                
+                // Write cache to file
+                if (debug_mode.verbose())
+                    std::cout << "Writing topology-out file \"" << args.topology_out() << "\" with " << topology.num_systems() << " systems.\n";
+                std::ofstream topology_out_file(args.topology_out(), std::ios::binary);
+                if (!topology_out_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.topology_out() << "\" for writing.\n";
+                    return -1;
+                }
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::WRITE);
+                    topology.write_to_binary_file(topology_out_file);
+                }
+                count_output_bytes(debug_mode, topology_out_file);
+                topology_out_file.close();
+                
+                break;
+                
+            }
+            
+            case args::eve_industry_t::mode_t::SCAN_ARBITRAGE:
+            {
+                
+                // Optional history weights each pair by the volume traded at
+                // its destination.  Top-of-book prices are kept since those
+                // are the orders actually traded against.
+                profit_inputs_t inputs;
+                if (!load_profit_inputs(args, debug_mode, inputs))
+                    return -1;
+                
+                // Optional topology weights each pair by the jumps between its
+                // stations
+                universe_topology_t topology;
+                station_attributes_t station_attributes_in;
+                if (!args.topology_in().empty())
+                {
+                    if (debug_mode.verbose())
+                        std::cout << "Mapping topology-in file \"" << args.topology_in() << "\".\n";
+                    {
+                        stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                        topology.map_binary_file(args.topology_in());
+                    }
+                    if (debug_mode.verbose())
+                        std::cout << "Parsing station-attributes-in file \"" << args.station_attributes_in() << "\".\n";
+                    std::ifstream station_attributes_in_file(args.station_attributes_in());
+                    if (!station_attributes_in_file.good())
+                    {
+                        std::cerr << "Error.  Failed to open \"" << args.station_attributes_in() << "\" for reading.\n";
+                        return -1;
+                    }
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    station_attributes_in.read_from_json_file(station_attributes_in_file);
+                }
+                
+                // Only the sales tax of the first profile is used
+                float sell_fraction = 1.0f;
+                if (!inputs.profiles.profiles().empty())
+                    sell_fraction = 1.0f - inputs.profiles.profiles().front().sales_tax_percent() / 100.0f;
+                
+                if (debug_mode.verbose())
+                    std::cout << "Searching for the best " << args.num_opportunities() << " arbitrage opportunities.\n";
+                arbitrage_scan_t arbitrage_scan;
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::PROFIT);
+                    arbitrage_scan.initialize_from_market
+                    (
+                        inputs.galactic_market,
+                        args.num_opportunities(),
+                        sell_fraction,
+                        float(args.hauling_cost_percent() / 100.0),
+                        args.topology_in().empty() ? nullptr : &topology,
+                        args.topology_in().empty() ? nullptr : &station_attributes_in,
+                        args.history_in().empty() ? nullptr : &inputs.market_history,
+                        args.history_days(),
+                        args.history_min_volume()
+                    );
+                }
+                
+                // Write report to file
+                if (debug_mode.verbose())
+                    std::cout << "Writing arbitrage-out file \"" << args.arbitrage_out() << "\".\n";
+                std::ofstream arbitrage_out_file(args.arbitrage_out());
+                if (!arbitrage_out_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.arbitrage_out() << "\" for writing.\n";
+                    return -1;
+                }
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::WRITE);
+                    arbitrage_scan.write_to_json_file(arbitrage_out_file, inputs.item_names);
+                    arbitrage_out_file << '\n';
+                }
+                count_output_bytes(debug_mode, arbitrage_out_file);
+                arbitrage_out_file.close();
+                
+                break;
+                
+            }
+            
+            case args::eve_industry_t::mode_t::EVALUATE_REPROCESSING:
+            {
+                
+                // Open prices file for reading
+                if (debug_mode.verbose())
+                    std::cout << "Parsing prices-in file \"" << args.prices_in() << "\".\n";
+                std::ifstream prices_in_file(args.prices_in());
+                if (!prices_in_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.prices_in() << "\" for reading.\n";
+                    return -1;
+                }
+                galactic_market_t galactic_market;
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    galactic_market.read_from_json_file(prices_in_file);
+                }
+                
+                // Open reprocessing file for reading
+                if (debug_mode.verbose())
+                    std::cout << "Parsing reprocessing-in file \"" << args.reprocessing_in() << "\".\n";
+                std::ifstream reprocessing_in_file(args.reprocessing_in());
+                if (!reprocessing_in_file.good())
+                {
+                    std::cerr << "Error.  Failed to open \"" << args.reprocessing_in() << "\" for reading.\n";
+                    return -1;
+                }
+                reprocessing_t reprocessing_in;
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
+                    reprocessing_in.read_from_json_file(reprocessing_in_file);
+                }
                 
                 // Open optional item_attributes_in file for reading
-                std::unordered_map<uint64_t, std::string_view> blueprint_names; // <-- Empty and valid if argument not passed
+                std::unordered_map<uint64_t, std::string_view> item_names; // <-- Empty and valid if argument not passed
                 item_attributes_t item_attributes_in;
                 if (!args.item_attributes_in().empty())
                 {
-                    
-                    // Open file
-                    if (args.debug_mode().verbose())
+                    if (debug_mode.verbose())
                         std::cout << "Parsing item-attributes-in file \"" << args.item_attributes_in() << "\".\n";
                     std::ifstream item_attributes_in_file(args.item_attributes_in());
                     if (!item_attributes_in_file.good())
@@ -212,33 +997,36 @@ int main(int argc, char** argv)
                         std::cerr << "Error.  Failed to open \"" << args.item_attributes_in() << "\" for reading.\n";
                         return -1;
                     }
-                    
-                    // Parse JSON
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::READ);
                     item_attributes_in.read_from_json_file(item_attributes_in_file);
-                    
-                    // Generate ID -> Name mapping
                     for (const item_attribute_t& cur_item : item_attributes_in.items())
-                        blueprint_names.emplace(cur_item.id(), std::string_view(cur_item.name()));
-                    
+                        item_names.emplace(cur_item.id(), std::string_view(cur_item.name()));
                 }
                 
-                // Calculate blueprint profit at each station
-                if (args.debug_mode().verbose())
-                    std::cout << "Calculating blueprint profitability.\n";
-                galactic_profits_t galactic_profits_out;
-                galactic_profits_out.caclulate_station_profits(blueprints_in, galactic_market, args.decryptor_optimization_strategy());
+                if (debug_mode.verbose())
+                    std::cout << "Valuing " << reprocessing_in.types().size() << " reprocessable types at " << args.reprocess_yield_percent() << "% yield.\n";
+                reprocess_values_t reprocess_values;
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::PROFIT);
+                    reprocess_values.initialize_from_market(reprocessing_in, galactic_market, args.reprocess_yield_percent() / 100.0);
+                }
                 
-                // Write profits report to file.
-                if (args.debug_mode().verbose())
-                    std::cout << "Writing profits-out file \"" << args.profits_out() << "\".\n";
-                std::ofstream profits_out_file(args.profits_out());
-                if (!profits_out_file.good())
+                // Write report to file
+                if (debug_mode.verbose())
+                    std::cout << "Writing reprocess-out file \"" << args.reprocess_out() << "\".\n";
+                std::ofstream reprocess_out_file(args.reprocess_out());
+                if (!reprocess_out_file.good())
                 {
-                    std::cerr << "Error.  Failed to open \"" << args.profits_out() << "\" for reading.\n";
+                    std::cerr << "Error.  Failed to open \"" << args.reprocess_out() << "\" for writing.\n";
                     return -1;
                 }
-                galactic_profits_out.write_to_json_file(profits_out_file, args.output_order(), blueprint_names);
-                profits_out_file.close();
+                {
+                    stats_t::scoped_timer_t timer(debug_mode.stats(), stats_t::stage_t::WRITE);
+                    reprocess_values.write_to_json_file(reprocess_out_file, item_names);
+                    reprocess_out_file << '\n';
+                }
+                count_output_bytes(debug_mode, reprocess_out_file);
+                reprocess_out_file.close();
                 
                 break;
                 
@@ -251,6 +1039,28 @@ int main(int argc, char** argv)
             }
             
         }
+        
+        // Dump statistics collected during this run
+        if (debug_mode.stats() != nullptr)
+        {
+            if (debug_mode.verbose())
+                std::cout << "Writing stats-out file \"" << args.stats_out() << "\".\n";
+            stats.write_to_json_file(stats_out_file);
+            stats_out_file << '\n';
+            stats_out_file.close();
+        }
+        
+        // Dump the timeline recorded during this run.  All worker threads
+        // have been joined by now.
+        if (debug_mode.trace() != nullptr)
+        {
+            if (debug_mode.verbose())
+                std::cout << "Writing trace-out file \"" << args.trace_out() << "\".\n";
+            trace.write_to_json_file(trace_out_file);
+            trace_out_file << '\n';
+            trace_out_file.close();
+        }
+        
     } catch (Json::Exception error) {
         std::cerr << error.what() << "  Fatal.  Could not decode JSON input file.\n";
         return -1;
@@ -0,0 +1,616 @@
+/// @file market_history.cpp
+/// @brief Implementation of @ref market_history_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "blueprint.h"
+#include "blueprints.h"
+#include "error.h"
+#include "galactic_market.h"
+#include "https_get.h"
+#include "item_market.h"
+#include "item_quantity.h"
+#include "json.h"
+#include "market_history.h"
+#include "progress_reporter.h"
+#include "regional_market.h"
+#include "station_market.h"
+#include "stats.h"
+#include "task_scheduler.h"
+#include "trace.h"
+
+/// @brief Size of the fixed part of each block in a history file.
+static constexpr size_t block_header_size = 32;
+
+/// @brief Size of all columns of one day in a history file.
+static constexpr size_t block_bytes_per_day = 4 + 4 + 4 + 4 + 8;
+
+const market_history_t::series_t* market_history_t::find(uint64_t region_id, uint64_t item_id) const
+{
+    series_map_t::const_iterator found = this->series_.find(series_key_t(region_id, item_id));
+    if (found == this->series_.end())
+        return nullptr;
+    return &found->second;
+}
+
+void market_history_t::merge(series_t& series, const series_t& new_days, series_t& added)
+{
+    
+    unsigned num_new_days = new_days.size();
+    if (num_new_days == 0)
+        return;
+    
+    // Fast path.  Updates normally only contain days after the last known one.
+    if (series.size() == 0 || series.days.back() < new_days.days.front())
+    {
+        for (unsigned ix = 0; ix < num_new_days; ix++)
+        {
+            series.push_back(new_days.days[ix], new_days.sources[ix], new_days.average[ix], new_days.highest[ix], new_days.lowest[ix], new_days.volume[ix]);
+            added.push_back(new_days.days[ix], new_days.sources[ix], new_days.average[ix], new_days.highest[ix], new_days.lowest[ix], new_days.volume[ix]);
+        }
+        return;
+    }
+    
+    // General case.  Merge both sorted series.  A new day replaces a known day
+    // if it comes from a better source, or from the same source with
+    // different numbers, such as the still-changing statistics of today.
+    series_t merged;
+    unsigned num_old_days = series.size();
+    unsigned old_ix = 0;
+    unsigned new_ix = 0;
+    while (old_ix < num_old_days || new_ix < num_new_days)
+    {
+        
+        bool take_old;
+        bool take_new;
+        if (new_ix == num_new_days)
+        {
+            take_old = true;
+            take_new = false;
+        } else if (old_ix == num_old_days || new_days.days[new_ix] < series.days[old_ix]) {
+            take_old = false;
+            take_new = true;
+        } else if (series.days[old_ix] < new_days.days[new_ix]) {
+            take_old = true;
+            take_new = false;
+        } else {
+            
+            // Same day
+            source_t old_source = series.sources[old_ix];
+            source_t new_source = new_days.sources[new_ix];
+            bool differs =
+                series.average[old_ix] != new_days.average[new_ix]
+             || series.highest[old_ix] != new_days.highest[new_ix]
+             || series.lowest[old_ix] != new_days.lowest[new_ix]
+             || series.volume[old_ix] != new_days.volume[new_ix];
+            take_new = old_source < new_source || (old_source == new_source && differs);
+            take_old = !take_new;
+            if (take_new)
+                old_ix++;
+            else
+                new_ix++;
+                
+        }
+        
+        if (take_old)
+        {
+            merged.push_back(series.days[old_ix], series.sources[old_ix], series.average[old_ix], series.highest[old_ix], series.lowest[old_ix], series.volume[old_ix]);
+            old_ix++;
+        } else if (take_new) {
+            merged.push_back(new_days.days[new_ix], new_days.sources[new_ix], new_days.average[new_ix], new_days.highest[new_ix], new_days.lowest[new_ix], new_days.volume[new_ix]);
+            added.push_back(new_days.days[new_ix], new_days.sources[new_ix], new_days.average[new_ix], new_days.highest[new_ix], new_days.lowest[new_ix], new_days.volume[new_ix]);
+            new_ix++;
+        }
+        
+    }
+    
+    series = std::move(merged);
+    
+}
+
+void market_history_t::append(uint64_t region_id, uint64_t item_id, const series_t& new_days)
+{
+    
+    series_t added;
+    series_key_t key(region_id, item_id);
+    market_history_t::merge(this->series_[key], new_days, added);
+    
+    // Blocks have a single source, so split the added days wherever the
+    // source changes.
+    unsigned num_added = added.size();
+    unsigned begin = 0;
+    while (begin < num_added)
+    {
+        unsigned end = begin + 1;
+        while (end < num_added && added.sources[end] == added.sources[begin])
+            end++;
+        pending_block_t block;
+        block.key = key;
+        block.source = added.sources[begin];
+        for (unsigned ix = begin; ix < end; ix++)
+            block.days.push_back(added.days[ix], added.sources[ix], added.average[ix], added.highest[ix], added.lowest[ix], added.volume[ix]);
+        this->pending_.emplace_back(std::move(block));
+        begin = end;
+    }
+    
+}
+
+void market_history_t::append_snapshot(const galactic_market_t& galactic_market, uint32_t day)
+{
+    
+    for (const std::pair<const uint64_t, regional_market_t>& cur_region : galactic_market.regions())
+    {
+        
+        // The history is regional, so take the best price at any station
+        std::unordered_map<uint64_t, float> min_sell_prices;
+        for (const std::pair<const uint64_t, station_market_t>& cur_station : cur_region.second.stations())
+        {
+            for (const std::pair<const uint64_t, item_market_t>& cur_item : cur_station.second.items())
+            {
+                if (cur_item.second.sell_orders().empty())
+                    continue;
+                float price = cur_item.second.min_sell_order();
+                std::pair<std::unordered_map<uint64_t, float>::iterator, bool> found = min_sell_prices.try_emplace(cur_item.first, price);
+                if (!found.second && price < found.first->second)
+                    found.first->second = price;
+            }
+        }
+        
+        for (const std::pair<const uint64_t, float>& cur_price : min_sell_prices)
+        {
+            series_t snapshot;
+            snapshot.push_back(day, source_t::SNAPSHOT, cur_price.second, cur_price.second, cur_price.second, 0);
+            this->append(cur_region.first, cur_price.first, snapshot);
+        }
+        
+    }
+    
+}
+
+void market_history_t::decode_api_history(const Json::Value& json_root, series_t& series)
+{
+    
+    if (!json_root.isArray())
+        throw error_message_t(error_code_t::EVE_SUCKS, "Error.  Market history fetched from eve API was not of type \"array\".\n");
+    
+    // Decode each day into a temporary list first since the API doesn't
+    // promise any particular order.
+    std::vector< std::pair<uint32_t, unsigned> > order;
+    series_t unsorted;
+    for (const Json::Value& json_cur_day : json_root)
+    {
+        
+        if (!json_cur_day.isObject())
+            throw error_message_t(error_code_t::EVE_SUCKS, "Error.  Element of market history fetched from eve API was not of type \"object\".\n");
+        
+        const Json::Value& json_date = json_cur_day["date"];
+        if (!json_date.isString())
+            throw error_message_t(error_code_t::EVE_SUCKS, "Error.  date of market history fetched from eve API was not of type \"string\".\n");
+        
+        const Json::Value& json_average = json_cur_day["average"];
+        const Json::Value& json_highest = json_cur_day["highest"];
+        const Json::Value& json_lowest = json_cur_day["lowest"];
+        if (!json_average.isNumeric() || !json_highest.isNumeric() || !json_lowest.isNumeric())
+            throw error_message_t(error_code_t::EVE_SUCKS, "Error.  average, highest or lowest of market history fetched from eve API was not of type \"float\".\n");
+        
+        const Json::Value& json_volume = json_cur_day["volume"];
+        if (!json_volume.isUInt64())
+            throw error_message_t(error_code_t::EVE_SUCKS, "Error.  volume of market history fetched from eve API was not of type \"unsigned integer\".\n");
+        
+        uint32_t day = market_history_t::parse_day(json_date.asString());
+        order.emplace_back(day, unsorted.size());
+        unsorted.push_back(day, source_t::API, json_average.asFloat(), json_highest.asFloat(), json_lowest.asFloat(), json_volume.asUInt64());
+        
+    }
+    
+    // Sort by day, dropping duplicates
+    std::sort(order.begin(), order.end());
+    for (const std::pair<uint32_t, unsigned>& cur_day : order)
+    {
+        if (series.size() != 0 && series.days.back() == cur_day.first)
+            continue;
+        unsigned ix = cur_day.second;
+        series.push_back(unsorted.days[ix], source_t::API, unsorted.average[ix], unsorted.highest[ix], unsorted.lowest[ix], unsorted.volume[ix]);
+    }
+    
+}
+
+void market_history_t::fetch(const std::vector<series_key_t>& keys)
+{
+    
+    unsigned num_keys = keys.size();
+    
+    // Pre-allocate all storage so re-allocation won't happen while multiple
+    // tasks are writing to it.
+    std::vector<std::string> payloads(num_keys);
+    std::vector<series_t> fetched(num_keys);
+    std::vector<std::string> failures(num_keys);
+    
+    // Parsing happens on the CPU pool, so one reader per CPU worker
+    task_scheduler_t& scheduler = task_scheduler_t::instance();
+    Json::CharReaderBuilder builder;
+    std::vector< std::unique_ptr<Json::CharReader> > readers;
+    for (unsigned ix = 0, num_workers = scheduler.num_workers(task_scheduler_t::pool_t::CPU); ix < num_workers; ix++)
+        readers.emplace_back(builder.newCharReader());
+    if (this->debug_mode_.verbose())
+        std::cout << "Fetching market history of " << num_keys << " items using " << scheduler.num_workers(task_scheduler_t::pool_t::IO) << " threads.\n";
+    
+    // Null if statistics or tracing are disabled
+    stats_t* stats = this->debug_mode_.stats();
+    trace_t* trace = this->debug_mode_.trace();
+    
+    progress_reporter_t progress("Fetching market history", "items", num_keys, this->debug_mode_.verbose());
+    
+    // Each item is fetched on the I/O pool and then decoded on the CPU pool,
+    // so decoding overlaps with the remaining requests.
+    task_scheduler_t::task_group_t group;
+    for (unsigned ix = 0; ix < num_keys; ix++)
+    {
+        
+        task_scheduler_t::task_handle_t fetch_task = scheduler.submit
+        (
+            group,
+            task_scheduler_t::pool_t::IO,
+            [&keys, &payloads, &failures, &progress, stats, trace, ix]
+            {
+                
+                std::string url("https://esi.tech.ccp.is/latest/markets/");
+                url += std::to_string(keys[ix].first);
+                url += "/history/?datasource=tranquility&type_id=";
+                url += std::to_string(keys[ix].second);
+                
+                try
+                {
+                    stats_t::scoped_timer_t timer(stats, stats_t::stage_t::FETCH);
+                    trace_t::scoped_span_t span(trace, "fetch_history", "fetch", keys[ix].second);
+                    payloads[ix] = https_get(url);
+                } catch (const error_message_t& error) {
+                    failures[ix] = error.message();
+                    if (stats != nullptr)
+                        stats->increment(stats_t::counter_t::FETCH_FAILURES);
+                    progress.increment();
+                }
+                
+            }
+        );
+        
+        scheduler.submit
+        (
+            group,
+            task_scheduler_t::pool_t::CPU,
+            [&payloads, &fetched, &failures, &readers, &progress, stats, ix]
+            {
+                
+                if (!failures[ix].empty())
+                    return;
+                
+                std::string payload(std::move(payloads[ix]));
+                try
+                {
+                    
+                    Json::Value json_root;
+                    std::string error_message;
+                    {
+                        stats_t::scoped_timer_t timer(stats, stats_t::stage_t::PARSE);
+                        if (!readers[task_scheduler_t::current_worker()]->parse(payload.data(), payload.data() + payload.size(), &json_root, &error_message))
+                            throw error_message_t(error_code_t::EVE_SUCKS, "Error.  Could not parse market history fetched from eve API.  " + error_message + '\n');
+                    }
+                    
+                    {
+                        stats_t::scoped_timer_t timer(stats, stats_t::stage_t::DECODE);
+                        market_history_t::decode_api_history(json_root, fetched[ix]);
+                    }
+                    
+                    if (stats != nullptr)
+                    {
+                        stats->increment(stats_t::counter_t::PAGES_FETCHED);
+                        stats->increment(stats_t::counter_t::BYTES_RECEIVED, payload.size());
+                    }
+                    progress.increment(1, payload.size());
+                    
+                } catch (const error_message_t& error) {
+                    failures[ix] = error.message();
+                    if (stats != nullptr)
+                        stats->increment(stats_t::counter_t::FETCH_FAILURES);
+                    progress.increment();
+                }
+                
+            },
+            {fetch_task}
+        );
+        
+    }
+    group.wait();
+    
+    progress.stop();
+    
+    // Merge serially so that pending blocks are written in a stable order
+    for (unsigned ix = 0; ix < num_keys; ix++)
+    {
+        if (!failures[ix].empty())
+        {
+            std::string message("Warning.  Failed to fetch market history of item ");
+            message += std::to_string(keys[ix].second);
+            message += " in region ";
+            message += std::to_string(keys[ix].first);
+            message += ".  ";
+            message += failures[ix];
+            std::cout << message << std::flush;
+            continue;
+        }
+        this->append(keys[ix].first, keys[ix].second, fetched[ix]);
+    }
+    
+}
+
+bool market_history_t::summarize(uint64_t region_id, uint64_t item_id, uint32_t first_day, uint32_t last_day, summary_t& summary) const
+{
+    
+    const series_t* series = this->find(region_id, item_id);
+    if (series == nullptr)
+        return false;
+    
+    unsigned begin = std::lower_bound(series->days.begin(), series->days.end(), first_day) - series->days.begin();
+    unsigned end = std::upper_bound(series->days.begin(), series->days.end(), last_day) - series->days.begin();
+    if (begin >= end)
+        return false;
+    
+    // Only the needed columns are touched, and each is contiguous.
+    const float* average = series->average.data();
+    const float* highest = series->highest.data();
+    const float* lowest = series->lowest.data();
+    const uint64_t* volume = series->volume.data();
+    double weighted_sum = 0.0;
+    double plain_sum = 0.0;
+    uint64_t total_volume = 0;
+    float max_highest = highest[begin];
+    float min_lowest = lowest[begin];
+    #pragma omp simd reduction(+:weighted_sum, plain_sum, total_volume) reduction(max:max_highest) reduction(min:min_lowest)
+    for (unsigned ix = begin; ix < end; ix++)
+    {
+        weighted_sum += double(average[ix]) * double(volume[ix]);
+        plain_sum += double(average[ix]);
+        total_volume += volume[ix];
+        max_highest = std::max(max_highest, highest[ix]);
+        min_lowest = std::min(min_lowest, lowest[ix]);
+    }
+    
+    summary.num_days = end - begin;
+    if (total_volume != 0)
+        summary.average = float(weighted_sum / double(total_volume));
+    else
+        summary.average = float(plain_sum / double(end - begin));
+    summary.highest = max_highest;
+    summary.lowest = min_lowest;
+    summary.volume = total_volume;
+    return true;
+    
+}
+
+bool market_history_t::summarize_recent(uint64_t region_id, uint64_t item_id, unsigned num_days, summary_t& summary) const
+{
+    const series_t* series = this->find(region_id, item_id);
+    if (series == nullptr || series->size() == 0 || num_days == 0)
+        return false;
+    uint32_t last_day = market_history_t::today();
+    uint32_t first_day = last_day + 1 > num_days ? last_day + 1 - num_days : 0;
+    return this->summarize(region_id, item_id, first_day, last_day, summary);
+}
+
+void market_history_t::apply_averages
+(
+    galactic_market_t& galactic_market,
+    const blueprints_t& blueprints,
+    unsigned num_days,
+    uint64_t min_daily_volume
+) const {
+    
+    // Only products need to sell through, so only they are capped
+    std::unordered_set<uint64_t> products;
+    if (min_daily_volume != 0)
+    {
+        for (const std::pair<const uint64_t, blueprint_t>& cur_blueprint : blueprints.storage())
+        {
+            for (const item_quantity_t& cur_product : cur_blueprint.second.manufacture().output_materials().materials_list())
+                products.insert(cur_product.item_id());
+        }
+    }
+    
+    for (std::pair<const uint64_t, regional_market_t>& cur_region : galactic_market)
+    {
+        uint64_t region_id = cur_region.second.region_id();
+        for (std::pair<const uint64_t, station_market_t>& cur_station : cur_region.second)
+        {
+            for (std::pair<const uint64_t, item_market_t>& cur_item : cur_station.second)
+            {
+                
+                summary_t summary;
+                if (!this->summarize_recent(region_id, cur_item.first, num_days, summary))
+                    continue;
+                
+                // Snapshots carry no volume, so only judge items with some
+                // API history.  Days without trades are missing from the API
+                // history, so the volume is spread over the whole window.
+                item_market_t& item_market = cur_item.second;
+                item_market.clear_sell_orders();
+                if
+                (
+                    summary.volume != 0
+                 && summary.volume < min_daily_volume * uint64_t(num_days)
+                 && products.count(cur_item.first) != 0
+                ){
+                    continue;
+                }
+                item_market.new_sell_order(summary.average);
+                
+            }
+        }
+    }
+    
+}
+
+void market_history_t::read_from_file(std::istream& file)
+{
+    
+    // Get the number of bytes in the input file.
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_SIZE_FAILED, "Error.  Failed to determine file size when decoding market_history_t object.\n");
+    file.seekg(0, std::ios_base::end);
+    size_t file_size = file.tellg();
+    file.seekg(0, std::ios_base::beg);
+    
+    // Read the entire file into RAM at once
+    std::string buffer(file_size, '\0');
+    file.read(buffer.data(), file_size);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_READ_FAILED, "Error.  Failed to read file when decoding market_history object.\n");
+    this->read_from_buffer(std::string_view(buffer));
+    
+}
+
+void market_history_t::read_from_buffer(std::string_view buffer)
+{
+    
+    stats_t::scoped_timer_t timer(this->debug_mode_.stats(), stats_t::stage_t::READ);
+    
+    this->clear();
+    
+    size_t offset = 0;
+    size_t buffer_size = buffer.size();
+    const char* data = buffer.data();
+    while (offset < buffer_size)
+    {
+        
+        // Decode header
+        if (buffer_size - offset < block_header_size || std::memcmp(data + offset, "EIH1", 4) != 0)
+        {
+            std::string message("Error.  Market history block at byte ");
+            message += std::to_string(offset);
+            message += " is truncated or has the wrong magic number.\n";
+            throw error_message_t(error_code_t::HISTORY_FILE_CORRUPT, message);
+        }
+        uint32_t source;
+        uint32_t num_days;
+        uint64_t region_id;
+        uint64_t item_id;
+        std::memcpy(&source, data + offset + 4, 4);
+        std::memcpy(&num_days, data + offset + 8, 4);
+        std::memcpy(&region_id, data + offset + 16, 8);
+        std::memcpy(&item_id, data + offset + 24, 8);
+        if (source >= uint32_t(source_t::NUM_ENUMS) || buffer_size - offset - block_header_size < block_bytes_per_day * num_days)
+        {
+            std::string message("Error.  Market history block at byte ");
+            message += std::to_string(offset);
+            message += " has an unknown source or is truncated.\n";
+            throw error_message_t(error_code_t::HISTORY_FILE_CORRUPT, message);
+        }
+        
+        // Decode columns
+        const char* columns = data + offset + block_header_size;
+        series_t block;
+        block.days.resize(num_days);
+        block.sources.assign(num_days, source_t(source));
+        block.average.resize(num_days);
+        block.highest.resize(num_days);
+        block.lowest.resize(num_days);
+        block.volume.resize(num_days);
+        std::memcpy(block.days.data(), columns, 4 * num_days);
+        std::memcpy(block.average.data(), columns + 4 * num_days, 4 * num_days);
+        std::memcpy(block.highest.data(), columns + 8 * num_days, 4 * num_days);
+        std::memcpy(block.lowest.data(), columns + 12 * num_days, 4 * num_days);
+        std::memcpy(block.volume.data(), columns + 16 * num_days, 8 * num_days);
+        offset += block_header_size + block_bytes_per_day * num_days;
+        
+        // Later blocks take precedence
+        series_t added;
+        market_history_t::merge(this->series_[series_key_t(region_id, item_id)], block, added);
+        
+    }
+    
+}
+
+void market_history_t::append_to_file(std::ostream& file)
+{
+    
+    stats_t::scoped_timer_t timer(this->debug_mode_.stats(), stats_t::stage_t::WRITE);
+    
+    for (const pending_block_t& cur_block : this->pending_)
+    {
+        
+        char header[block_header_size] = {'E', 'I', 'H', '1'};
+        uint32_t source = uint32_t(cur_block.source);
+        uint32_t num_days = cur_block.days.size();
+        std::memcpy(header + 4, &source, 4);
+        std::memcpy(header + 8, &num_days, 4);
+        std::memcpy(header + 16, &cur_block.key.first, 8);
+        std::memcpy(header + 24, &cur_block.key.second, 8);
+        
+        file.write(header, block_header_size);
+        file.write(reinterpret_cast<const char*>(cur_block.days.days.data()), 4 * num_days);
+        file.write(reinterpret_cast<const char*>(cur_block.days.average.data()), 4 * num_days);
+        file.write(reinterpret_cast<const char*>(cur_block.days.highest.data()), 4 * num_days);
+        file.write(reinterpret_cast<const char*>(cur_block.days.lowest.data()), 4 * num_days);
+        file.write(reinterpret_cast<const char*>(cur_block.days.volume.data()), 8 * num_days);
+        
+    }
+    
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when appending market_history_t object.\n");
+    this->pending_.clear();
+    
+}
+
+uint32_t market_history_t::parse_day(std::string_view date)
+{
+    
+    // Expect exactly YYYY-MM-DD
+    bool valid = date.size() == 10 && date[4] == '-' && date[7] == '-';
+    for (unsigned ix : {0, 1, 2, 3, 5, 6, 8, 9})
+        valid = valid && date[ix] >= '0' && date[ix] <= '9';
+    int year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    if (valid)
+    {
+        year = (date[0] - '0') * 1000 + (date[1] - '0') * 100 + (date[2] - '0') * 10 + (date[3] - '0');
+        month = (date[5] - '0') * 10 + (date[6] - '0');
+        day = (date[8] - '0') * 10 + (date[9] - '0');
+        valid = year >= 1970 && month >= 1 && month <= 12 && day >= 1 && day <= 31;
+    }
+    if (!valid)
+    {
+        std::string message("Error.  Could not decode date \"");
+        message += date;
+        message += "\".  Expected YYYY-MM-DD.\n";
+        throw error_message_t(error_code_t::EVE_SUCKS, message);
+    }
+    
+    // Days from the civil calendar, counting March as the first month so
+    // that leap days fall at the end of the year.
+    year -= month <= 2 ? 1 : 0;
+    int era = year / 400;
+    unsigned year_of_era = year - era * 400;
+    unsigned day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+    
+}
+
+uint32_t market_history_t::today()
+{
+    return uint32_t(std::time(nullptr) / 86400);
+}
+
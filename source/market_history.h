@@ -0,0 +1,255 @@
+/// @file market_history.h
+/// @brief Declaration of @ref market_history_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_MARKET_HISTORY
+#define HEADER_GUARD_MARKET_HISTORY
+
+#include <cstdint>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "debug_mode.h"
+#include "error.h"
+#include "json.h"
+
+class blueprints_t;
+class galactic_market_t;
+
+/// @brief Daily price and volume statistics of items in regions, kept as an
+/// append-only time series.
+///
+/// Days come from two sources.  The EvE API reports the average, highest and
+/// lowest trade price and the volume traded for each past day.  Snapshots of
+/// our own --prices-out files record the top-of-book sell price for days the
+/// API hasn't published yet.  When both cover the same day, the API wins.
+///
+/// The file format is a sequence of self-describing blocks, one per series
+/// per update, so new days are appended without rewriting anything.  Each
+/// block is a fixed 32 byte header followed by one column per field:
+///
+/// | Bytes         | Field                                      |
+/// | ------------- | ------------------------------------------ |
+/// | 4             | Magic "EIH1"                               |
+/// | 4             | @ref source_t of every day in this block   |
+/// | 4             | Number of days n                           |
+/// | 4             | Reserved, zero                             |
+/// | 8             | Region ID                                  |
+/// | 8             | Item ID                                    |
+/// | 4n            | Day, counted from 1970-01-01               |
+/// | 4n, 4n, 4n    | Average, highest and lowest price          |
+/// | 8n            | Volume                                     |
+///
+/// All integers and floats are in host byte order.
+class market_history_t
+{
+        
+    public:
+        
+        /// @brief Where a day of history came from.
+        enum class source_t : uint32_t
+        {
+            /// Snapshot of the order book from a --prices-out file
+            SNAPSHOT,
+            /// Trade statistics published by the EvE API
+            API,
+            /// This must be last
+            NUM_ENUMS
+        };
+        
+        /// @brief All days of one item in one region, sorted by day.  Each
+        /// field is stored contiguously so that range queries scan only the
+        /// columns they need.
+        struct series_t
+        {
+            std::vector<uint32_t> days;
+            std::vector<source_t> sources;
+            std::vector<float> average;
+            std::vector<float> highest;
+            std::vector<float> lowest;
+            std::vector<uint64_t> volume;
+            inline unsigned size() const
+            {
+                return this->days.size();
+            }
+            /// @brief Append one day.  Days must be added in increasing order.
+            inline void push_back(uint32_t day, source_t source, float average, float highest, float lowest, uint64_t volume)
+            {
+                this->days.push_back(day);
+                this->sources.push_back(source);
+                this->average.push_back(average);
+                this->highest.push_back(highest);
+                this->lowest.push_back(lowest);
+                this->volume.push_back(volume);
+            }
+        };
+        
+        /// @brief Statistics over a range of days, returned by
+        /// @ref summarize.
+        struct summary_t
+        {
+            /// @brief Number of days with data in the range.
+            unsigned num_days;
+            /// @brief Volume-weighted average price, or the plain mean of the
+            /// daily averages if no volume was recorded.
+            float average;
+            float highest;
+            float lowest;
+            /// @brief Total volume traded over the range.
+            uint64_t volume;
+        };
+        
+        /// @brief Identifies a series.  First is the region ID and second is
+        /// the item ID.
+        typedef std::pair<uint64_t, uint64_t> series_key_t;
+        
+        struct series_key_hash_t
+        {
+            inline size_t operator()(const series_key_t& key) const
+            {
+                return std::hash<uint64_t>()(key.first * 0x9e3779b97f4a7c15ull ^ key.second);
+            }
+        };
+        
+        typedef std::unordered_map<series_key_t, series_t, series_key_hash_t> series_map_t;
+        
+        /// @brief Default constructor
+        inline market_history_t() = default;
+        
+        // Add member read and write functions
+        
+        inline const series_map_t& series() const
+        {
+            return this->series_;
+        }
+        
+        inline const debug_mode_t& debug_mode() const
+        {
+            return this->debug_mode_;
+        }
+        
+        inline void debug_mode(const debug_mode_t& new_debug_mode)
+        {
+            this->debug_mode_ = new_debug_mode;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Forget all history, including days not yet written.
+        inline void clear()
+        {
+            this->series_.clear();
+            this->pending_.clear();
+        }
+        
+        /// @return The series of an item in a region, or null if there is no
+        /// history for it.
+        const series_t* find(uint64_t region_id, uint64_t item_id) const;
+        
+        /// @brief Merge new days into a series.  Days which are already known
+        /// from an equal or better @ref source_t are ignored.  The days that
+        /// were actually added are queued for @ref append_to_file.
+        void append(uint64_t region_id, uint64_t item_id, const series_t& new_days);
+        
+        /// @brief Record the minimum sell price of every item in every region
+        /// of galactic_market as a snapshot for the given day.
+        void append_snapshot(const galactic_market_t& galactic_market, uint32_t day);
+        
+        /// @brief Download the daily history of each (region, item) pair from
+        /// the EvE API and @ref append it.  Pairs which fail to download are
+        /// reported and skipped.
+        void fetch(const std::vector<series_key_t>& keys);
+        
+        /// @brief Summarize a range of days.
+        ///
+        /// @return false if the series has no days in [first_day, last_day].
+        bool summarize(uint64_t region_id, uint64_t item_id, uint32_t first_day, uint32_t last_day, summary_t& summary) const;
+        
+        /// @brief Summarize the last num_days days of a series, ending
+        /// @ref today, so a series which stopped trading long ago has no
+        /// recent history.
+        ///
+        /// @return false if there is no history for this item in that
+        /// window.
+        bool summarize_recent(uint64_t region_id, uint64_t item_id, unsigned num_days, summary_t& summary) const;
+        
+        /// @brief Replace the sell orders of every item in galactic_market
+        /// with its average price over the last num_days days of history.
+        ///
+        /// Products of blueprints whose average daily volume is below
+        /// min_daily_volume lose their sell orders, since they couldn't be
+        /// sold at that price, so those blueprints are reported as lacking
+        /// market data.  Inputs keep their average however rarely they
+        /// trade.  Items without history keep their top-of-book prices.
+        void apply_averages
+        (
+            galactic_market_t& galactic_market,
+            /// [in] Source of the products the volume cap applies to.
+            const blueprints_t& blueprints,
+            unsigned num_days,
+            uint64_t min_daily_volume
+        ) const;
+        
+        /// @brief Load every block of a history file, clearing previous
+        /// content.
+        ///
+        /// @exception error_message_t
+        void read_from_file(std::istream& file);
+        
+        /// @brief Decode blocks from an in-memory copy of a history file.
+        ///
+        /// @exception error_message_t
+        void read_from_buffer(std::string_view buffer);
+        
+        /// @brief Write one block for each series that gained days since it
+        /// was loaded.  The stream should be opened in binary append mode.
+        ///
+        /// @exception error_message_t
+        void append_to_file(std::ostream& file);
+        
+        /// @brief Convert "YYYY-MM-DD" to days since 1970-01-01.
+        ///
+        /// @exception error_message_t
+        static uint32_t parse_day(std::string_view date);
+        
+        /// @brief The current UTC day, counted from 1970-01-01.
+        static uint32_t today();
+        
+    protected:
+        
+        /// @brief Days waiting to be written by @ref append_to_file.
+        struct pending_block_t
+        {
+            series_key_t key;
+            source_t source;
+            series_t days;
+        };
+        
+        /// @brief Merge new_days into series, keeping only days from the best
+        /// source.  Days that were added are appended to added.
+        static void merge(series_t& series, const series_t& new_days, series_t& added);
+        
+        /// @brief Decode the daily history of one item from the EvE API.
+        ///
+        /// @exception error_message_t
+        static void decode_api_history(const Json::Value& json_root, series_t& series);
+        
+        /// @brief Every series that has been loaded, fetched or snapshotted.
+        series_map_t series_;
+        
+        /// @brief See @ref pending_block_t.
+        std::vector<pending_block_t> pending_;
+        
+        /// @brief Controls verbose printing, statistics and tracing.
+        debug_mode_t debug_mode_;
+        
+};
+
+#endif // Header Guard
+
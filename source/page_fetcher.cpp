@@ -5,154 +5,82 @@
 /// * Date Created = Thursday November 9 2017
 /// * Documentation is generated by doxygen, see html/index.html
 
-#include <atomic>
 #include <fstream>
-#include <iostream>
-#include <mutex>
 #include <string>
 #include <string_view>
-#include <thread>
 #include <vector>
 
 #include "page_fetcher.h"
 #include "error.h"
 #include "https_get.h"
 #include "json.h"
+#include "stats.h"
+#include "trace.h"
 
-void page_fetcher_t::erase_terminal()
-{
-    
-    unsigned num_characters = this->last_print_length_;
-    
-    // Move cursor as far left as possible
-    for (unsigned ix = 0; ix < num_characters; ix++)
-        std::cout << '\b';
-    
-    // Overwrite characters with spaces
-    for (unsigned ix = 0; ix < num_characters; ix++)
-        std::cout << ' ';
-    
-    // Move cursor as far left as possible
-    for (unsigned ix = 0; ix < num_characters; ix++)
-        std::cout << '\b';
-    
-}
-
-void page_fetcher_t::worker_function(std::vector<Json::Value>* output)
-{
-    
-    // Create a JSON decoder
-    Json::CharReaderBuilder builder;
-    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
-    
-    // Hoisted to reduce re-allocations
-    std::string query;
-    std::string json_error_message;
-    std::string progress_string;
+uint64_t page_fetcher_t::fetch_page
+(
+    std::string_view base_url,
+    unsigned page,
+    Json::CharReader* reader,
+    const debug_mode_t& debug_mode,
+    Json::Value& json_payload,
+    unsigned* num_pages
+){
+    
+    // Null if statistics or tracing are disabled
+    stats_t* stats = debug_mode.stats();
+    trace_t* trace = debug_mode.trace();
+    
+    // Fetch market data from network
+    std::string query(base_url);
+    query += "&page=";
+    query += std::to_string(page);
     std::string raw_payload;
-    
-    /// Keep fetching until a worker identifies the last page
-    while (!this->kill_switch_)
+    try
     {
         
-        unsigned page = this->next_page_++;
-        
-        if (this->debug_mode_.verbose())
+        stats_t::scoped_timer_t timer(stats, stats_t::stage_t::FETCH);
+        if (trace != nullptr)
         {
-            
-            this->print_lock_.lock();
-            
-            this->erase_terminal();
-            
-            // Write new progress message
-            progress_string = "Fetching market orders page ";
-            progress_string += std::to_string(page);
-            std::cout << progress_string << std::flush;
-            this->last_print_length_ = progress_string.length();
-            
-            this->print_lock_.unlock();
-            
+            https_get_timing_t timing;
+            uint64_t start_ns = trace->now_ns();
+            raw_payload = https_get(query, &timing, num_pages);
+            trace->record_https_get(start_ns, timing, page);
+        } else {
+            raw_payload = https_get(query, nullptr, num_pages);
         }
         
-        // Fetch market data from network
-        query = this->base_url_;
-        query += "&page=";
-        query += std::to_string(page);
-        try
-        {
-            
-            raw_payload = https_get(query);
-            
-        } catch (const error_message_t& error) {
-            
-            this->print_lock_.lock();
-            this->erase_terminal();
-            std::cout << "\nWarning.  Failed to fetch page " << page << error;
-            this->print_lock_.unlock();
-            
-            this->kill_switch_ = true;
-            return;
-            
-        }
-        
-        // Parse Json syntax of received string
-        Json::Value json_payload;
-        if (!reader->parse(raw_payload.data(), raw_payload.data() + raw_payload.size(), &json_payload, &json_error_message))
-        {
-            std::string message("Error.  Tried to decode JSON data from\"");
-            message += query;
-            message += "\" but it failed with message \"";
-            message += json_error_message;
-            message += "\".\n";
-            throw error_message_t(error_code_t::EVE_SUCKS, message);
-        }
-        
-        /// The last market page is indicated by an empty page.
-        /// Exit this thread and signal other threads to quit.
-        if (json_payload.empty())
-        {
-            this->kill_switch_ = true;
-            return;
-        }
-        
-        // Store parsed Json data to output vector
-        this->output_lock_.lock();
-        output->emplace_back(std::move(json_payload));
-        this->output_lock_.unlock();
-        
-        // Decode JSON syntax of received data
-        
-        
+    } catch (const error_message_t& error) {
+        if (stats != nullptr)
+            stats->increment(stats_t::counter_t::FETCH_FAILURES);
+        throw error;
     }
     
-}
-
-std::vector<Json::Value> page_fetcher_t::parallel_fetch(unsigned num_threads)
-{
-    
-    // Reset thread control
-    this->kill_switch_ = false;
-    this->next_page_ = 1;
-    this->output_lock_.unlock();
-    this->print_lock_.unlock();
-    
-    std::vector<Json::Value> ret;
-    
-    // Spawn multiple threads to fetch pages of market data. 
-    if (this->debug_mode_.verbose())
-        std::cout << "Spawning " << num_threads << " worker threads for market page fetching.\n";
-    std::vector<std::thread> workers;
-    for (unsigned ix = 0; ix < num_threads; ix++)
-        workers.emplace_back(&page_fetcher_t::worker_function, this, &ret);
-    
-    // Wait for all worker threads to finish.
-    for (unsigned ix = 0; ix < num_threads; ix++)
-        workers[ix].join();
+    if (stats != nullptr)
+    {
+        stats->increment(stats_t::counter_t::PAGES_FETCHED);
+        stats->increment(stats_t::counter_t::BYTES_RECEIVED, raw_payload.size());
+    }
     
-    if (this->debug_mode_.verbose())
-        std::cout << '\n';
+    // Parse Json syntax of received string
+    std::string json_error_message;
+    bool parse_successful;
+    {
+        stats_t::scoped_timer_t timer(stats, stats_t::stage_t::PARSE);
+        trace_t::scoped_span_t span(trace, "parse", "parse", page);
+        parse_successful = reader->parse(raw_payload.data(), raw_payload.data() + raw_payload.size(), &json_payload, &json_error_message);
+    }
+    if (!parse_successful)
+    {
+        std::string message("Error.  Tried to decode JSON data from\"");
+        message += query;
+        message += "\" but it failed with message \"";
+        message += json_error_message;
+        message += "\".\n";
+        throw error_message_t(error_code_t::EVE_SUCKS, message);
+    }
     
-    return ret;
+    return raw_payload.size();
     
 }
 
@@ -207,13 +135,6 @@ void page_fetcher_t::read_from_json_json(const Json::Value& json_root)
         throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error <page_fetcher>/base_url was not found or not of type \"string\".\n");
     this->base_url_ = json_base_url.asString();
     
-    // Non-encodable members
-    this->next_page_ = 1;
-    this->kill_switch_ = false;
-    this->output_lock_.unlock();
-    this->last_print_length_ = 0;
-    this->print_lock_.unlock();
-    
 }
 
 void page_fetcher_t::write_to_json_file(std::ostream& file, unsigned indent_start, unsigned spaces_per_tab) const
@@ -8,9 +8,8 @@
 #ifndef HEADER_GUARD_PAGE_FETCHER
 #define HEADER_GUARD_PAGE_FETCHER
 
-#include <atomic>
+#include <cstdint>
 #include <fstream>
-#include <mutex>
 #include <string_view>
 #include <vector>
 
@@ -18,20 +17,15 @@
 #include "error.h"
 #include "json.h"
 
-/// @brief Spawns multiple worker threads to speculativly fetch
-/// multi-page data from the EvE API.
+/// @brief Fetches single pages of multi-page data from the EvE API.  The
+/// pages themselves are scheduled by @ref fetch_scheduler_t.
 class page_fetcher_t
 {
         
     public:
         
         /// @brief Default constructor
-        inline page_fetcher_t()
-        {
-            this->next_page_ = 1;
-            this->kill_switch_ = false;
-            this->last_print_length_ = 0;
-        }
+        inline page_fetcher_t() = default;
         
         // Add member initialization constructors here
         // Try to use initializer lists when possible.
@@ -64,11 +58,29 @@ class page_fetcher_t
         
         // Add special-purpose functions here
         
-        /// @brief Pull all of the pages from @ref base_url_, fetching
-        /// multiple pages in parallel.
+        /// @brief Download and parse a single page, recording statistics and
+        /// trace spans if they are enabled.  Safe to call from any thread as
+        /// long as each thread uses its own reader.
+        ///
+        /// @return The number of payload bytes received.
         ///
-        /// @return The data fetched from each page
-        std::vector<Json::Value> parallel_fetch(unsigned num_threads);
+        /// @exception error_message_t
+        static uint64_t fetch_page
+        (
+            /// [in] URL to fetch data from, without a "&page=x" suffix.
+            std::string_view base_url,
+            /// [in] Page number to fetch, starting at 1.
+            unsigned page,
+            /// [in] JSON parser owned by the calling thread.
+            Json::CharReader* reader,
+            /// [in] Source of the statistics and trace pointers.
+            const debug_mode_t& debug_mode,
+            /// [out] Overwritten with the parsed page.
+            Json::Value& json_payload,
+            /// [out] If not null, set to the number of pages reported by the
+            /// server or 0 if unknown.  See @ref https_get.
+            unsigned* num_pages = nullptr
+        );
         
         /// @brief Open a file conforming to data/json/schema.json and use it to initialize
         /// this object, clearing previous content.
@@ -158,38 +170,9 @@ class page_fetcher_t
         /// @brief URL to fetch data from, without a "&page=x" suffix.
         std::string base_url_;
         
-        /// @brief Starts at 1.  Each worker thread pulls a page number
-        /// from this variable and then atomically increments it.
-        std::atomic<unsigned> next_page_;
-        
-        /// @brief If a worker thread fails or detects the last page
-        /// this is set to true to indicate that other workers should
-        /// terminate.
-        /// 
-        /// *   False means keep going.
-        /// *   True means keep fetching
-        volatile bool kill_switch_;
-        
-        /// @brief Used to serialize allocations to return value of
-        /// @ref parallel_fetch(unsigned num_threads).
-        std::mutex output_lock_;
-        
         /// @brief Enables printing of extra diagnostic messages.
         debug_mode_t debug_mode_;
         
-        /// @brief Tracks how many characters need to be erased
-        /// when diagnostics are printed
-        volatile unsigned last_print_length_;
-        
-        /// @brief Guards std::cout and similar.
-        std::mutex print_lock_;
-        
-        /// @brief Output @ref last_print_length_ backspace characters to stdout.
-        void erase_terminal();
-        
-        /// @brief Thread-safe function for grabbing market data.
-        void worker_function(std::vector<Json::Value>* output);
-        
 };
 
 /// @brief Convenience alias to allow printing directly via cout or similar.
@@ -0,0 +1,491 @@
+/// @file price_delta.cpp
+/// @brief Implementation of @ref price_delta_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "error.h"
+#include "galactic_market.h"
+#include "item_market.h"
+#include "json.h"
+#include "price_delta.h"
+#include "regional_market.h"
+#include "station_market.h"
+
+/// @brief Copy the (ID, node) pairs of a market container into a vector
+/// sorted by ID, so that two snapshots can be merged without hashing.
+template <typename map_t>
+static void sorted_entries(const map_t& map, std::vector< std::pair<uint64_t, const typename map_t::mapped_type*> >& entries)
+{
+    entries.clear();
+    entries.reserve(map.size());
+    for (const typename map_t::value_type& cur_node : map)
+        entries.emplace_back(cur_node.first, &cur_node.second);
+    std::sort
+    (
+        entries.begin(),
+        entries.end(),
+        [](const std::pair<uint64_t, const typename map_t::mapped_type*>& lhs, const std::pair<uint64_t, const typename map_t::mapped_type*>& rhs)
+        {
+            return lhs.first < rhs.first;
+        }
+    );
+}
+
+/// @brief The best buy and sell price of an item.
+static price_delta_t::item_change_t best_prices(uint64_t item_id, const item_market_t& item_market)
+{
+    price_delta_t::item_change_t change;
+    change.item_id = item_id;
+    change.has_buy_order = !item_market.buy_orders().empty();
+    change.max_buy_order = change.has_buy_order ? item_market.max_buy_order() : 0.0f;
+    change.has_sell_order = !item_market.sell_orders().empty();
+    change.min_sell_order = change.has_sell_order ? item_market.min_sell_order() : 0.0f;
+    return change;
+}
+
+/// @brief Decode an array of unsigned integers, such as a list of IDs.
+static void decode_ids(const Json::Value& json_ids, std::string_view name, std::vector<uint64_t>& ids)
+{
+    if (!json_ids.isArray())
+    {
+        std::string message("Error.  <price_delta>/");
+        message += name;
+        message += " was not found or not of type \"array\".\n";
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, message);
+    }
+    ids.clear();
+    ids.reserve(json_ids.size());
+    for (const Json::Value& json_cur_id : json_ids)
+    {
+        if (!json_cur_id.isUInt64())
+        {
+            std::string message("Error.  <price_delta>/");
+            message += name;
+            message += " contained an element not of type \"unsigned integer\".\n";
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, message);
+        }
+        ids.push_back(json_cur_id.asUInt64());
+    }
+}
+
+unsigned price_delta_t::num_changed_items() const
+{
+    unsigned num_changed_items = 0;
+    for (const region_delta_t& cur_region : this->regions_)
+        for (const station_delta_t& cur_station : cur_region.stations)
+            num_changed_items += cur_station.changed_items.size();
+    return num_changed_items;
+}
+
+unsigned price_delta_t::num_removed_items() const
+{
+    unsigned num_removed_items = 0;
+    for (const region_delta_t& cur_region : this->regions_)
+        for (const station_delta_t& cur_station : cur_region.stations)
+            num_removed_items += cur_station.removed_items.size();
+    return num_removed_items;
+}
+
+void price_delta_t::initialize_from_markets(const galactic_market_t& old_market, const galactic_market_t& new_market)
+{
+    
+    this->clear();
+    
+    std::vector< std::pair<uint64_t, const regional_market_t*> > old_regions;
+    std::vector< std::pair<uint64_t, const regional_market_t*> > new_regions;
+    sorted_entries(old_market.regions(), old_regions);
+    sorted_entries(new_market.regions(), new_regions);
+    
+    // Reused for every region to avoid reallocating
+    std::vector< std::pair<uint64_t, const station_market_t*> > old_stations;
+    std::vector< std::pair<uint64_t, const station_market_t*> > new_stations;
+    
+    unsigned num_old_regions = old_regions.size();
+    unsigned num_new_regions = new_regions.size();
+    unsigned old_region_ix = 0;
+    unsigned new_region_ix = 0;
+    while (old_region_ix < num_old_regions || new_region_ix < num_new_regions)
+    {
+        
+        // A region missing from one side is compared against an empty one
+        region_delta_t region_delta;
+        old_stations.clear();
+        new_stations.clear();
+        if (new_region_ix == num_new_regions || (old_region_ix < num_old_regions && old_regions[old_region_ix].first < new_regions[new_region_ix].first))
+        {
+            region_delta.region_id = old_regions[old_region_ix].first;
+            sorted_entries(old_regions[old_region_ix].second->stations(), old_stations);
+            old_region_ix++;
+        } else if (old_region_ix == num_old_regions || new_regions[new_region_ix].first < old_regions[old_region_ix].first) {
+            region_delta.region_id = new_regions[new_region_ix].first;
+            sorted_entries(new_regions[new_region_ix].second->stations(), new_stations);
+            new_region_ix++;
+        } else {
+            region_delta.region_id = new_regions[new_region_ix].first;
+            sorted_entries(old_regions[old_region_ix].second->stations(), old_stations);
+            sorted_entries(new_regions[new_region_ix].second->stations(), new_stations);
+            old_region_ix++;
+            new_region_ix++;
+        }
+        
+        // Same merge again over the stations of this region
+        unsigned num_old_stations = old_stations.size();
+        unsigned num_new_stations = new_stations.size();
+        unsigned old_station_ix = 0;
+        unsigned new_station_ix = 0;
+        while (old_station_ix < num_old_stations || new_station_ix < num_new_stations)
+        {
+            
+            station_delta_t station_delta;
+            if (new_station_ix == num_new_stations || (old_station_ix < num_old_stations && old_stations[old_station_ix].first < new_stations[new_station_ix].first))
+            {
+                station_delta.station_id = old_stations[old_station_ix].first;
+                price_delta_t::diff_station(old_stations[old_station_ix].second, nullptr, station_delta);
+                old_station_ix++;
+            } else if (old_station_ix == num_old_stations || new_stations[new_station_ix].first < old_stations[old_station_ix].first) {
+                station_delta.station_id = new_stations[new_station_ix].first;
+                price_delta_t::diff_station(nullptr, new_stations[new_station_ix].second, station_delta);
+                new_station_ix++;
+            } else {
+                station_delta.station_id = new_stations[new_station_ix].first;
+                price_delta_t::diff_station(old_stations[old_station_ix].second, new_stations[new_station_ix].second, station_delta);
+                old_station_ix++;
+                new_station_ix++;
+            }
+            
+            if (!station_delta.changed_items.empty() || !station_delta.removed_items.empty())
+                region_delta.stations.emplace_back(std::move(station_delta));
+                
+        }
+        
+        if (!region_delta.stations.empty())
+            this->regions_.emplace_back(std::move(region_delta));
+            
+    }
+    
+}
+
+void price_delta_t::diff_station(const station_market_t* old_station, const station_market_t* new_station, station_delta_t& delta)
+{
+    
+    std::vector< std::pair<uint64_t, const item_market_t*> > old_items;
+    std::vector< std::pair<uint64_t, const item_market_t*> > new_items;
+    if (old_station != nullptr)
+        sorted_entries(old_station->items(), old_items);
+    if (new_station != nullptr)
+        sorted_entries(new_station->items(), new_items);
+    
+    unsigned num_old_items = old_items.size();
+    unsigned num_new_items = new_items.size();
+    unsigned old_ix = 0;
+    unsigned new_ix = 0;
+    while (old_ix < num_old_items || new_ix < num_new_items)
+    {
+        
+        if (new_ix == num_new_items || (old_ix < num_old_items && old_items[old_ix].first < new_items[new_ix].first))
+        {
+            
+            // Item no longer listed
+            delta.removed_items.push_back(old_items[old_ix].first);
+            old_ix++;
+            
+        } else if (old_ix == num_old_items || new_items[new_ix].first < old_items[old_ix].first) {
+            
+            // Newly listed item
+            delta.changed_items.push_back(best_prices(new_items[new_ix].first, *new_items[new_ix].second));
+            new_ix++;
+            
+        } else {
+            
+            // Listed in both, so only report it if the top of the book moved
+            item_change_t old_prices = best_prices(old_items[old_ix].first, *old_items[old_ix].second);
+            item_change_t new_prices = best_prices(new_items[new_ix].first, *new_items[new_ix].second);
+            bool buy_changed = old_prices.has_buy_order != new_prices.has_buy_order || old_prices.max_buy_order != new_prices.max_buy_order;
+            bool sell_changed = old_prices.has_sell_order != new_prices.has_sell_order || old_prices.min_sell_order != new_prices.min_sell_order;
+            if (buy_changed || sell_changed)
+                delta.changed_items.push_back(new_prices);
+            old_ix++;
+            new_ix++;
+            
+        }
+        
+    }
+    
+}
+
+void price_delta_t::read_from_json_file(std::istream& file)
+{
+    
+    // Get the number of characters in the input file.
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_SIZE_FAILED, "Error.  Failed to determine file size when decoding price_delta_t object.\n");
+    file.seekg(0, std::ios_base::end);
+    unsigned file_size = file.tellg();
+    file.seekg(0, std::ios_base::beg);
+    
+    // Read the entire file into RAM at once
+    std::string buffer(file_size, '\0');
+    file.read(buffer.data(), file_size);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_READ_FAILED, "Error.  Failed to read file when decoding price_delta_t object.\n");
+    this->read_from_json_buffer(std::string_view(buffer));
+    
+}
+
+void price_delta_t::read_from_json_buffer(std::string_view buffer)
+{
+    
+    Json::CharReaderBuilder builder;
+    Json::CharReader* reader = builder.newCharReader();
+    
+    Json::Value json_root;
+    std::string error_message;
+    bool success = reader->parse(buffer.begin(), buffer.end(), &json_root, &error_message);
+    delete reader;
+    if (!success)
+        Json::throwRuntimeError(error_message);
+    
+    // Now that the JSON syntax is parsed, extract the price_delta specific
+    // data.
+    this->read_from_json_json(json_root);
+    
+}
+
+void price_delta_t::read_from_json_json(const Json::Value& json_root)
+{
+    
+    this->clear();
+    
+    // Parse root
+    if (!json_root.isObject())
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  Root of price_delta is not of type \"object\".\n");
+    
+    // Decode regions array
+    const Json::Value& json_regions = json_root["regions"];
+    if (!json_regions.isArray())
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_delta>/regions was not found or not of type \"array\".\n");
+    this->regions_.reserve(json_regions.size());
+    for (const Json::Value& json_cur_region : json_regions)
+    {
+        
+        region_delta_t region_delta;
+        
+        // Decode region_id
+        const Json::Value& json_region_id = json_cur_region["region_id"];
+        if (!json_region_id.isUInt64())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_delta>/regions/region_id was not found or not of type \"unsigned integer\".\n");
+        region_delta.region_id = json_region_id.asUInt64();
+        
+        // Decode stations array
+        const Json::Value& json_stations = json_cur_region["stations"];
+        if (!json_stations.isArray())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_delta>/regions/stations was not found or not of type \"array\".\n");
+        region_delta.stations.reserve(json_stations.size());
+        for (const Json::Value& json_cur_station : json_stations)
+        {
+            
+            station_delta_t station_delta;
+            
+            // Decode station_id
+            const Json::Value& json_station_id = json_cur_station["station_id"];
+            if (!json_station_id.isUInt64())
+                throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_delta>/regions/stations/station_id was not found or not of type \"unsigned integer\".\n");
+            station_delta.station_id = json_station_id.asUInt64();
+            
+            // Decode changed_items array
+            const Json::Value& json_changed_items = json_cur_station["changed_items"];
+            if (!json_changed_items.isArray())
+                throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_delta>/regions/stations/changed_items was not found or not of type \"array\".\n");
+            station_delta.changed_items.reserve(json_changed_items.size());
+            for (const Json::Value& json_cur_item : json_changed_items)
+            {
+                
+                item_change_t change;
+                
+                const Json::Value& json_item_id = json_cur_item["item_id"];
+                if (!json_item_id.isUInt64())
+                    throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_delta>/regions/stations/changed_items/item_id was not found or not of type \"unsigned integer\".\n");
+                change.item_id = json_item_id.asUInt64();
+                
+                // A missing price means the item has no orders of that kind
+                const Json::Value& json_max_buy_order = json_cur_item["max_buy_order"];
+                change.has_buy_order = !json_max_buy_order.isNull();
+                if (change.has_buy_order && !json_max_buy_order.isNumeric())
+                    throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_delta>/regions/stations/changed_items/max_buy_order was not of type \"float\".\n");
+                change.max_buy_order = change.has_buy_order ? json_max_buy_order.asFloat() : 0.0f;
+                
+                const Json::Value& json_min_sell_order = json_cur_item["min_sell_order"];
+                change.has_sell_order = !json_min_sell_order.isNull();
+                if (change.has_sell_order && !json_min_sell_order.isNumeric())
+                    throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_delta>/regions/stations/changed_items/min_sell_order was not of type \"float\".\n");
+                change.min_sell_order = change.has_sell_order ? json_min_sell_order.asFloat() : 0.0f;
+                
+                station_delta.changed_items.push_back(change);
+                
+            }
+            
+            // Decode removed_items array
+            decode_ids(json_cur_station["removed_items"], "regions/stations/removed_items", station_delta.removed_items);
+            
+            region_delta.stations.emplace_back(std::move(station_delta));
+            
+        }
+        
+        this->regions_.emplace_back(std::move(region_delta));
+        
+    }
+    
+}
+
+void price_delta_t::write_to_json_file(std::ostream& file, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    file << this->write_to_json_buffer(indent_start, spaces_per_tab);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when encoding price_delta_t object.");
+}
+
+void price_delta_t::write_to_json_buffer(std::string& buffer, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    
+    std::string indent_5(indent_start + 5 * spaces_per_tab, ' ');
+    std::string_view indent_4(indent_5.data(), indent_start + 4 * spaces_per_tab);
+    std::string_view indent_3(indent_5.data(), indent_start + 3 * spaces_per_tab);
+    std::string_view indent_2(indent_5.data(), indent_start + 2 * spaces_per_tab);
+    std::string_view indent_1(indent_5.data(), indent_start + spaces_per_tab);
+    std::string_view indent_0(indent_5.data(), indent_start);
+    
+    // It is recommended not to start a new line before the opening brace, to
+    // enable chaining.
+    buffer += "{\n";
+    
+    // Encode each region.  Stations and items follow in nested arrays, with
+    // one changed item per line to keep the delta compact.
+    buffer += indent_1;
+    buffer += "\"regions\": [";
+    unsigned num_regions = this->regions_.size();
+    for (unsigned region_ix = 0; region_ix < num_regions; region_ix++)
+    {
+        
+        const region_delta_t& cur_region = this->regions_[region_ix];
+        
+        buffer += region_ix == 0 ? "\n" : ",\n";
+        buffer += indent_2;
+        buffer += "{\n";
+        buffer += indent_3;
+        buffer += "\"region_id\": ";
+        buffer += std::to_string(cur_region.region_id);
+        buffer += ",\n";
+        buffer += indent_3;
+        buffer += "\"stations\": [";
+        
+        unsigned num_stations = cur_region.stations.size();
+        for (unsigned station_ix = 0; station_ix < num_stations; station_ix++)
+        {
+            
+            const station_delta_t& cur_station = cur_region.stations[station_ix];
+            
+            buffer += station_ix == 0 ? "\n" : ",\n";
+            buffer += indent_4;
+            buffer += "{\n";
+            buffer += indent_5;
+            buffer += "\"station_id\": ";
+            buffer += std::to_string(cur_station.station_id);
+            buffer += ",\n";
+            
+            // Encode changed_items
+            buffer += indent_5;
+            buffer += "\"changed_items\": [";
+            unsigned num_changed_items = cur_station.changed_items.size();
+            for (unsigned item_ix = 0; item_ix < num_changed_items; item_ix++)
+            {
+                const item_change_t& cur_item = cur_station.changed_items[item_ix];
+                buffer += item_ix == 0 ? "\n" : ",\n";
+                buffer += indent_5;
+                buffer += indent_1;
+                buffer += "{\"item_id\": ";
+                buffer += std::to_string(cur_item.item_id);
+                if (cur_item.has_buy_order)
+                {
+                    buffer += ", \"max_buy_order\": ";
+                    buffer += std::to_string(cur_item.max_buy_order);
+                }
+                if (cur_item.has_sell_order)
+                {
+                    buffer += ", \"min_sell_order\": ";
+                    buffer += std::to_string(cur_item.min_sell_order);
+                }
+                buffer += '}';
+            }
+            if (num_changed_items != 0)
+            {
+                buffer += '\n';
+                buffer += indent_5;
+            }
+            buffer += "],\n";
+            
+            // Encode removed_items
+            buffer += indent_5;
+            buffer += "\"removed_items\": [";
+            unsigned num_removed_items = cur_station.removed_items.size();
+            for (unsigned item_ix = 0; item_ix < num_removed_items; item_ix++)
+            {
+                if (item_ix != 0)
+                    buffer += ", ";
+                buffer += std::to_string(cur_station.removed_items[item_ix]);
+            }
+            buffer += "]\n";
+            
+            buffer += indent_4;
+            buffer += '}';
+            
+        }
+        
+        if (num_stations != 0)
+        {
+            buffer += '\n';
+            buffer += indent_3;
+        }
+        buffer += "]\n";
+        buffer += indent_2;
+        buffer += '}';
+        
+    }
+    if (num_regions != 0)
+    {
+        buffer += '\n';
+        buffer += indent_1;
+    }
+    buffer += "]\n";
+    
+    // It is recommended to not put a newline on the last brace to allow
+    // comma chaining when this object is an element of an array.
+    buffer += indent_0;
+    buffer += '}';
+    
+}
+
+std::istream& operator>>(std::istream& stream, price_delta_t& destination)
+{
+    try
+    {
+        destination.read_from_json_file(stream);
+    } catch (error_message_t error) {
+        stream.setstate(std::ios::failbit);
+        throw error;
+    } catch (Json::Exception error) {
+        stream.setstate(std::ios::failbit);
+        throw error;
+    }
+    return stream;
+}
+
@@ -0,0 +1,182 @@
+/// @file price_delta.h
+/// @brief Declaration of @ref price_delta_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_PRICE_DELTA
+#define HEADER_GUARD_PRICE_DELTA
+
+#include <cstdint>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+#include "error.h"
+#include "json.h"
+
+class galactic_market_t;
+class station_market_t;
+
+/// @brief The difference in best prices between two snapshots of a
+/// @ref galactic_market_t.
+///
+/// Only the top of the book is compared, so an item whose highest buy order
+/// and lowest sell order didn't move is left out even if orders behind them
+/// changed.  Applying a delta to the old snapshot therefore reproduces the
+/// new one exactly when both were fetched with order culling, which is the
+/// default.
+class price_delta_t
+{
+        
+    public:
+        
+        /// @brief New best prices of an item which was added or changed.
+        struct item_change_t
+        {
+            uint64_t item_id;
+            /// @brief False if the item no longer has any buy orders.
+            bool has_buy_order;
+            float max_buy_order;
+            /// @brief False if the item no longer has any sell orders.
+            bool has_sell_order;
+            float min_sell_order;
+        };
+        
+        /// @brief Changes at one station, each sorted by item ID.
+        struct station_delta_t
+        {
+            uint64_t station_id;
+            std::vector<item_change_t> changed_items;
+            std::vector<uint64_t> removed_items;
+        };
+        
+        /// @brief Changes in one region, sorted by station ID.
+        struct region_delta_t
+        {
+            uint64_t region_id;
+            std::vector<station_delta_t> stations;
+        };
+        
+        /// @brief Default constructor
+        inline price_delta_t() = default;
+        
+        // Add member read and write functions
+        
+        /// @brief Every region with at least one change, sorted by region ID.
+        inline const std::vector<region_delta_t>& regions() const
+        {
+            return this->regions_;
+        }
+        
+        // Add special-purpose functions here
+        
+        inline void clear()
+        {
+            this->regions_.clear();
+        }
+        
+        /// @brief Total number of added or changed items at all stations.
+        unsigned num_changed_items() const;
+        
+        /// @brief Total number of removed items at all stations.
+        unsigned num_removed_items() const;
+        
+        /// @brief Compare two snapshots, clearing previous content.
+        ///
+        /// Regions, stations and items are each walked as a sorted merge over
+        /// their IDs, so the work is linear in the size of the snapshots after
+        /// sorting and no hash lookups are done into the other snapshot.
+        void initialize_from_markets(const galactic_market_t& old_market, const galactic_market_t& new_market);
+        
+        /// @brief Open a file conforming to data/json/schema.json and use it to initialize
+        /// this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        /// @exception Json::Exception
+        void read_from_json_file(std::istream& file);
+        
+        /// @brief Decode serialized content conforming to data/json/schema.json and use it
+        /// to initialize this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        /// @exception Json::Exception
+        void read_from_json_buffer(std::string_view buffer);
+        
+        /// @brief Extract required data fields from a pre-parsed JSON tree
+        /// and use them to initialize this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        void read_from_json_json(const Json::Value& json_root);
+        
+        /// @brief Serialize the content of this file into a file that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_file
+        (
+            /// [out] Stream to append serialized object content to.
+            std::ostream& file,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Serialize the content of this file into a string that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_buffer
+        (
+            /// [out] This string is overwritten with serialzed JSON content.
+            std::string& buffer,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Convinence method for pretty initialize-on-construction
+        /// syntax.
+        inline std::string write_to_json_buffer
+        (
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const {
+            std::string buffer;
+            this->write_to_json_buffer(buffer, indent_start, spaces_per_tab);
+            return buffer;
+        }
+        
+    protected:
+        
+        /// @brief Compare the items of one station.  Either station may be
+        /// null if it only exists in one snapshot.
+        static void diff_station(const station_market_t* old_station, const station_market_t* new_station, station_delta_t& delta);
+        
+        /// @brief See @ref regions.
+        std::vector<region_delta_t> regions_;
+        
+};
+
+/// @brief Convenience alias to allow printing directly via cout or similar.
+inline std::ostream& operator<<(std::ostream& stream, const price_delta_t& source)
+{
+    source.write_to_json_file(stream);
+    return stream;
+}
+
+/// @brief Extraction operator for decoding.
+std::istream& operator>>(std::istream& stream, price_delta_t& destination);
+
+#endif // Header Guard
+
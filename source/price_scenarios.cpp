@@ -0,0 +1,132 @@
+/// @file price_scenarios.cpp
+/// @brief Implementation of @ref price_scenarios_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "error.h"
+#include "json.h"
+#include "price_scenarios.h"
+
+void price_scenarios_t::read_from_json_file(std::istream& file)
+{
+    
+    // Get the number of characters in the input file.
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_SIZE_FAILED, "Error.  Failed to determine file size when decoding price_scenarios_t object.\n");
+    file.seekg(0, std::ios_base::end);
+    unsigned file_size = file.tellg();
+    file.seekg(0, std::ios_base::beg);
+    
+    // Read the entire file into RAM at once
+    std::string buffer(file_size, '\0');
+    file.read(buffer.data(), file_size);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_READ_FAILED, "Error.  Failed to read file when decoding price_scenarios_t object.\n");
+    this->read_from_json_buffer(std::string_view(buffer));
+    
+}
+
+void price_scenarios_t::read_from_json_buffer(std::string_view buffer)
+{
+    
+    Json::CharReaderBuilder builder;
+    Json::CharReader* reader = builder.newCharReader();
+    
+    Json::Value json_root;
+    std::string error_message;
+    bool success = reader->parse(buffer.begin(), buffer.end(), &json_root, &error_message);
+    delete reader;
+    if (!success)
+        Json::throwRuntimeError(error_message);
+    
+    // Now that the JSON syntax is parsed, extract the stat_list specific
+    // data.
+    this->read_from_json_json(json_root);
+    
+}
+
+void price_scenarios_t::read_from_json_json(const Json::Value& json_root)
+{
+    
+    // Parse root
+    if (!json_root.isArray())
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  Root of price_scenarios is not of type \"array\".\n");
+    
+    // Clear previous content
+    this->scenarios_.clear();
+    this->scenarios_.reserve(json_root.size());
+    
+    for (const Json::Value& json_cur_scenario : json_root)
+    {
+        
+        if (!json_cur_scenario.isObject())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_scenarios>/<scenario> is not of type \"object\".\n");
+        scenario_t new_scenario;
+        
+        // Decode name
+        const Json::Value& json_name = json_cur_scenario["name"];
+        if (!json_name.isString())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_scenarios>/<scenario>/name was not found or not of type \"string\".\n");
+        new_scenario.name = json_name.asString();
+        
+        // Decode overrides
+        const Json::Value& json_overrides = json_cur_scenario["overrides"];
+        if (!json_overrides.isArray())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_scenarios>/<scenario>/overrides was not found or not of type \"array\".\n");
+        new_scenario.overrides.reserve(json_overrides.size());
+        for (const Json::Value& json_cur_override : json_overrides)
+        {
+            
+            if (!json_cur_override.isObject())
+                throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_scenarios>/<scenario>/overrides/<override> is not of type \"object\".\n");
+            override_t new_override;
+            
+            const Json::Value& json_item_id = json_cur_override["item_id"];
+            if (!json_item_id.isUInt64())
+                throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_scenarios>/<scenario>/overrides/<override>/item_id was not found or not of type \"unsigned integer\".\n");
+            new_override.item_id = json_item_id.asUInt64();
+            
+            // Exactly one of price and multiplier
+            const Json::Value& json_price = json_cur_override["price"];
+            const Json::Value& json_multiplier = json_cur_override["multiplier"];
+            if (json_price.isNull() == json_multiplier.isNull())
+                throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_scenarios>/<scenario>/overrides/<override> must have exactly one of price and multiplier.\n");
+            const Json::Value& json_value = json_price.isNull() ? json_multiplier : json_price;
+            if (!json_value.isNumeric() || !(json_value.asFloat() >= 0.0f))
+                throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <price_scenarios>/<scenario>/overrides/<override>/price or multiplier was not a non-negative number.\n");
+            new_override.absolute = !json_price.isNull();
+            new_override.price = new_override.absolute ? json_value.asFloat() : 0.0f;
+            new_override.multiplier = new_override.absolute ? 1.0f : json_value.asFloat();
+            
+            new_scenario.overrides.push_back(new_override);
+            
+        }
+        
+        this->scenarios_.emplace_back(std::move(new_scenario));
+        
+    }
+    
+}
+
+std::istream& operator>>(std::istream& stream, price_scenarios_t& destination)
+{
+    try
+    {
+        destination.read_from_json_file(stream);
+    } catch (error_message_t error) {
+        stream.setstate(std::ios::failbit);
+        throw error;
+    } catch (Json::Exception error) {
+        stream.setstate(std::ios::failbit);
+        throw error;
+    }
+    return stream;
+}
+
@@ -0,0 +1,93 @@
+/// @file price_scenarios.h
+/// @brief Declaration of @ref price_scenarios_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_PRICE_SCENARIOS
+#define HEADER_GUARD_PRICE_SCENARIOS
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "error.h"
+#include "json.h"
+
+/// @brief What-if questions about prices, such as "Tritanium rises 10%",
+/// each of which overrides the price of a few items at every station.
+class price_scenarios_t
+{
+        
+    public:
+        
+        /// @brief New price of one item.
+        struct override_t
+        {
+            uint64_t item_id;
+            /// @brief If true, the item costs @ref price everywhere.  Else
+            /// the price at each station is scaled by @ref multiplier.
+            bool absolute;
+            float price;
+            float multiplier;
+        };
+        
+        /// @brief One set of overrides, applied together.
+        struct scenario_t
+        {
+            std::string name;
+            std::vector<override_t> overrides;
+        };
+        
+        /// @brief Default constructor
+        inline price_scenarios_t() = default;
+        
+        // Add member read and write functions
+        
+        inline const std::vector<scenario_t>& scenarios() const
+        {
+            return this->scenarios_;
+        }
+        
+        inline std::vector<scenario_t>& scenarios()
+        {
+            return this->scenarios_;
+        }
+        
+        // Add encoders/decoders here
+        
+        /// @brief Open a file conforming to data/json/schema.json and use it to initialize
+        /// this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        /// @exception Json::Exception
+        void read_from_json_file(std::istream& file);
+        
+        /// @brief Decode serialized content conforming to data/json/schema.json and use it
+        /// to initialize this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        /// @exception Json::Exception
+        void read_from_json_buffer(std::string_view buffer);
+        
+        /// @brief Extract required data fields from a pre-parsed JSON tree
+        /// and use them to initialize this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        void read_from_json_json(const Json::Value& json_root);
+        
+    protected:
+        
+        /// @brief See @ref scenarios.
+        std::vector<scenario_t> scenarios_;
+        
+};
+
+/// @brief Extraction operator for decoding.
+std::istream& operator>>(std::istream& stream, price_scenarios_t& destination);
+
+#endif // Header Guard
+
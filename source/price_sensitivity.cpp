@@ -0,0 +1,400 @@
+/// @file price_sensitivity.cpp
+/// @brief Implementation of @ref price_sensitivity_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "blueprint_profit.h"
+#include "blueprints.h"
+#include "decryptor.h"
+#include "error.h"
+#include "galactic_market.h"
+#include "price_scenarios.h"
+#include "price_sensitivity.h"
+#include "profit_matrix.h"
+#include "regional_market.h"
+#include "station_market.h"
+#include "task_scheduler.h"
+#include "util.h"
+
+unsigned price_sensitivity_t::best_row
+(
+    unsigned blueprint_ix,
+    const std::vector<float>& total_costs,
+    const std::vector<float>& output_values
+) const {
+    
+    // Same choice as station_profits_t, skipping rows without prices
+    unsigned ret = no_row;
+    float best_profit = -1 * std::numeric_limits<float>::infinity();
+    blueprint_profit_t candidate;
+    const std::vector<unsigned>& blueprint_offsets = this->profit_matrix_.blueprint_offsets();
+    for (unsigned row_ix = blueprint_offsets[blueprint_ix], last_row = blueprint_offsets[blueprint_ix + 1]; row_ix < last_row; row_ix++)
+    {
+        if (!std::isfinite(total_costs[row_ix]) || !std::isfinite(output_values[row_ix]))
+            continue;
+        const profit_matrix_t::row_t& row = this->profit_matrix_.rows()[row_ix];
+        candidate.initialize_from_totals(row.blueprint_id, row.decryptor, row.job, total_costs[row_ix], output_values[row_ix]);
+        float profit = candidate.profit(this->decryptor_optimization_strategy_);
+        if (ret == no_row || profit >= best_profit)
+        {
+            ret = row_ix;
+            best_profit = profit;
+        }
+    }
+    return ret;
+    
+}
+
+void price_sensitivity_t::initialize_from_market
+(
+    const blueprints_t& blueprints,
+    const galactic_market_t& galactic_market,
+    blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy,
+    const best_price_index_t* best_prices,
+    unsigned runs_per_job,
+    const industry_profile_t::modifiers_t& modifiers
+){
+    
+    this->stations_.clear();
+    this->scenario_results_.clear();
+    this->decryptor_optimization_strategy_ = decryptor_optimization_strategy;
+    this->profit_matrix_.initialize_from_blueprints(blueprints, runs_per_job, modifiers);
+    
+    unsigned num_blueprints = this->profit_matrix_.blueprint_offsets().size() - 1;
+    for (const std::pair<const uint64_t, regional_market_t>& cur_regional_market : galactic_market.regions())
+    {
+        for (const std::pair<const uint64_t, station_market_t>& cur_station_market : cur_regional_market.second.stations())
+        {
+            
+            station_t new_station;
+            new_station.station_id = cur_station_market.first;
+            this->profit_matrix_.gather_prices(cur_station_market.second, best_prices, new_station.input_prices, new_station.output_prices);
+            this->profit_matrix_.evaluate(new_station.input_prices, new_station.output_prices, new_station.total_costs, new_station.output_values);
+            
+            new_station.best_rows.resize(num_blueprints);
+            for (unsigned blueprint_ix = 0; blueprint_ix < num_blueprints; blueprint_ix++)
+                new_station.best_rows[blueprint_ix] = this->best_row(blueprint_ix, new_station.total_costs, new_station.output_values);
+            
+            this->stations_.emplace_back(std::move(new_station));
+            
+        }
+    }
+    
+}
+
+void price_sensitivity_t::evaluate_scenarios(const price_scenarios_t& scenarios)
+{
+    
+    unsigned num_scenarios = scenarios.scenarios().size();
+    this->scenario_results_.clear();
+    this->scenario_results_.resize(num_scenarios);
+    
+    const std::vector<unsigned>& blueprint_offsets = this->profit_matrix_.blueprint_offsets();
+    unsigned num_rows = this->profit_matrix_.rows().size();
+    
+    // Reused between scenarios by whichever worker evaluates them
+    struct scratch_t
+    {
+        std::vector<uint64_t> item_ids;
+        std::vector<unsigned> rows;
+        std::vector<unsigned> blueprint_ixs;
+        std::vector<bool> affected;
+        std::vector<float> total_costs;
+        std::vector<float> output_values;
+        std::vector<float> input_prices;
+        std::vector<float> output_prices;
+    };
+    task_scheduler_t& scheduler = task_scheduler_t::instance();
+    std::vector<scratch_t> worker_scratch(scheduler.num_workers(task_scheduler_t::pool_t::CPU));
+    for (scratch_t& cur_scratch : worker_scratch)
+    {
+        cur_scratch.affected.assign(num_rows, false);
+        cur_scratch.total_costs.resize(num_rows);
+        cur_scratch.output_values.resize(num_rows);
+    }
+    
+    scheduler.parallel_for
+    (
+        num_scenarios,
+        1,
+        [&](unsigned scenario_ix)
+        {
+            
+            scratch_t& scratch = worker_scratch[task_scheduler_t::current_worker()];
+            std::vector<uint64_t>& item_ids = scratch.item_ids;
+            std::vector<unsigned>& rows = scratch.rows;
+            std::vector<unsigned>& blueprint_ixs = scratch.blueprint_ixs;
+            std::vector<bool>& affected = scratch.affected;
+            std::vector<float>& total_costs = scratch.total_costs;
+            std::vector<float>& output_values = scratch.output_values;
+            std::vector<float>& input_prices = scratch.input_prices;
+            std::vector<float>& output_prices = scratch.output_prices;
+            
+            const price_scenarios_t::scenario_t& scenario = scenarios.scenarios()[scenario_ix];
+            scenario_result_t& result = this->scenario_results_[scenario_ix];
+            result.name = scenario.name;
+            
+            // Only rows using an overridden item change, at every station
+            item_ids.clear();
+            for (const price_scenarios_t::override_t& cur_override : scenario.overrides)
+                item_ids.push_back(cur_override.item_id);
+            this->profit_matrix_.affected_rows(item_ids, rows);
+            blueprint_ixs.clear();
+            for (unsigned cur_row : rows)
+            {
+                affected[cur_row] = true;
+                unsigned blueprint_ix = this->profit_matrix_.blueprint_of_row(cur_row);
+                if (blueprint_ixs.empty() || blueprint_ixs.back() != blueprint_ix)
+                    blueprint_ixs.push_back(blueprint_ix);
+            }
+            
+            for (const station_t& cur_station : this->stations_)
+            {
+                
+                // Override prices
+                input_prices.assign(cur_station.input_prices.begin(), cur_station.input_prices.end());
+                output_prices.assign(cur_station.output_prices.begin(), cur_station.output_prices.end());
+                for (const price_scenarios_t::override_t& cur_override : scenario.overrides)
+                {
+                    unsigned column = this->profit_matrix_.input_column(cur_override.item_id);
+                    if (column != profit_matrix_t::no_column)
+                        input_prices[column] = cur_override.absolute ? cur_override.price : input_prices[column] * cur_override.multiplier;
+                    column = this->profit_matrix_.output_column(cur_override.item_id);
+                    if (column != profit_matrix_t::no_column)
+                        output_prices[column] = cur_override.absolute ? cur_override.price : output_prices[column] * cur_override.multiplier;
+                }
+                
+                // Choose the best decryptor again for each affected blueprint
+                for (unsigned blueprint_ix : blueprint_ixs)
+                {
+                    
+                    for (unsigned row_ix = blueprint_offsets[blueprint_ix], last_row = blueprint_offsets[blueprint_ix + 1]; row_ix < last_row; row_ix++)
+                    {
+                        if (affected[row_ix])
+                        {
+                            this->profit_matrix_.evaluate_row(row_ix, input_prices, output_prices, total_costs[row_ix], output_values[row_ix]);
+                        } else {
+                            total_costs[row_ix] = cur_station.total_costs[row_ix];
+                            output_values[row_ix] = cur_station.output_values[row_ix];
+                        }
+                    }
+                    
+                    unsigned base_row = cur_station.best_rows[blueprint_ix];
+                    unsigned new_row = this->best_row(blueprint_ix, total_costs, output_values);
+                    float nan = std::numeric_limits<float>::quiet_NaN();
+                    float base_profit_amount = base_row == no_row ? nan : cur_station.output_values[base_row] - cur_station.total_costs[base_row];
+                    float profit_amount = new_row == no_row ? nan : output_values[new_row] - total_costs[new_row];
+                    if (base_row == new_row && base_profit_amount == profit_amount)
+                        continue;
+                    if (base_row == no_row && new_row == no_row)
+                        continue;
+                    
+                    change_t change;
+                    change.station_id = cur_station.station_id;
+                    change.blueprint_id = this->profit_matrix_.rows()[blueprint_offsets[blueprint_ix]].blueprint_id;
+                    change.decryptor = new_row == no_row ? decryptor_t::type_t::NO_DECRYPTOR : this->profit_matrix_.rows()[new_row].decryptor;
+                    change.base_profit_amount = base_profit_amount;
+                    change.profit_amount = profit_amount;
+                    result.changes.push_back(change);
+                    
+                }
+                
+            }
+            
+            for (unsigned cur_row : rows)
+                affected[cur_row] = false;
+                
+        }
+    );
+    
+}
+
+/// @brief Append a float, or null if it isn't finite.
+static void append_number(std::string& buffer, float number)
+{
+    if (std::isfinite(number))
+        buffer += std::to_string(number);
+    else
+        buffer += "null";
+}
+
+void price_sensitivity_t::write_to_json_file
+(
+    std::ostream& file,
+    const std::unordered_map<uint64_t, std::string_view>& blueprint_names,
+    unsigned indent_start,
+    unsigned spaces_per_tab
+) const {
+    std::string buffer;
+    this->write_to_json_buffer(buffer, blueprint_names, indent_start, spaces_per_tab);
+    file << buffer;
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when encoding price_sensitivity_t object.\n");
+}
+
+void price_sensitivity_t::write_to_json_buffer
+(
+    std::string& buffer,
+    const std::unordered_map<uint64_t, std::string_view>& blueprint_names,
+    unsigned indent_start,
+    unsigned spaces_per_tab
+) const {
+    
+    std::string indent_4(indent_start + 4 * spaces_per_tab, ' ');
+    std::string_view indent_3(indent_4.data(), indent_start + 3 * spaces_per_tab);
+    std::string_view indent_2(indent_4.data(), indent_start + 2 * spaces_per_tab);
+    std::string_view indent_1(indent_4.data(), indent_start + spaces_per_tab);
+    std::string_view indent_0(indent_4.data(), indent_start);
+    
+    // It is recommended not to start a new line before the opening brace, to
+    // enable chaining.
+    buffer += "{\n";
+    
+    // One object per station, with one line per blueprint
+    buffer += indent_1;
+    buffer += "\"stations\": [";
+    std::vector< std::pair<uint64_t, float> > gradient;
+    for (unsigned station_ix = 0, num_stations = this->stations_.size(); station_ix < num_stations; station_ix++)
+    {
+        
+        const station_t& cur_station = this->stations_[station_ix];
+        buffer += station_ix == 0 ? "\n" : ",\n";
+        buffer += indent_2;
+        buffer += "{\n";
+        buffer += indent_3;
+        buffer += "\"station_id\": ";
+        buffer += std::to_string(cur_station.station_id);
+        buffer += ",\n";
+        buffer += indent_3;
+        buffer += "\"blueprints\": [";
+        
+        bool first = true;
+        for (unsigned best_row : cur_station.best_rows)
+        {
+            
+            if (best_row == no_row)
+                continue;
+            const profit_matrix_t::row_t& row = this->profit_matrix_.rows()[best_row];
+            
+            buffer += first ? "\n" : ",\n";
+            first = false;
+            buffer += indent_4;
+            buffer += "{\"blueprint_id\": ";
+            buffer += std::to_string(row.blueprint_id);
+            std::unordered_map<uint64_t, std::string_view>::const_iterator name_match = blueprint_names.find(row.blueprint_id);
+            if (name_match != blueprint_names.end())
+            {
+                buffer += ", \"blueprint_name\": \"";
+                buffer += name_match->second;
+                buffer += '\"';
+            }
+            buffer += ", \"decryptor\": ";
+            decryptor_t(row.decryptor).write_to_json_buffer(buffer);
+            buffer += ", \"profit_amount\": ";
+            buffer += std::to_string(cur_station.output_values[best_row] - cur_station.total_costs[best_row]);
+            
+            // Change in profit per ISK change in the price of each item
+            buffer += ", \"gradient\": [";
+            this->profit_matrix_.gradient(best_row, gradient);
+            for (unsigned ix = 0, num_items = gradient.size(); ix < num_items; ix++)
+            {
+                if (ix != 0)
+                    buffer += ", ";
+                buffer += "{\"item_id\": ";
+                buffer += std::to_string(gradient[ix].first);
+                buffer += ", \"derivative\": ";
+                buffer += std::to_string(gradient[ix].second);
+                buffer += '}';
+            }
+            buffer += "]}";
+            
+        }
+        
+        buffer += first ? "]\n" : "\n";
+        if (!first)
+        {
+            buffer += indent_3;
+            buffer += "]\n";
+        }
+        buffer += indent_2;
+        buffer += '}';
+        
+    }
+    buffer += this->stations_.empty() ? "],\n" : "\n";
+    if (!this->stations_.empty())
+    {
+        buffer += indent_1;
+        buffer += "],\n";
+    }
+    
+    // One object per scenario, with one line per change
+    buffer += indent_1;
+    buffer += "\"scenarios\": [";
+    for (unsigned scenario_ix = 0, num_scenarios = this->scenario_results_.size(); scenario_ix < num_scenarios; scenario_ix++)
+    {
+        
+        const scenario_result_t& cur_result = this->scenario_results_[scenario_ix];
+        buffer += scenario_ix == 0 ? "\n" : ",\n";
+        buffer += indent_2;
+        buffer += "{\n";
+        buffer += indent_3;
+        buffer += "\"name\": \"";
+        buffer += escape_quotes(cur_result.name);
+        buffer += "\",\n";
+        buffer += indent_3;
+        buffer += "\"changes\": [";
+        
+        for (unsigned change_ix = 0, num_changes = cur_result.changes.size(); change_ix < num_changes; change_ix++)
+        {
+            const change_t& cur_change = cur_result.changes[change_ix];
+            buffer += change_ix == 0 ? "\n" : ",\n";
+            buffer += indent_4;
+            buffer += "{\"station_id\": ";
+            buffer += std::to_string(cur_change.station_id);
+            buffer += ", \"blueprint_id\": ";
+            buffer += std::to_string(cur_change.blueprint_id);
+            buffer += ", \"decryptor\": ";
+            decryptor_t(cur_change.decryptor).write_to_json_buffer(buffer);
+            buffer += ", \"base_profit_amount\": ";
+            append_number(buffer, cur_change.base_profit_amount);
+            buffer += ", \"profit_amount\": ";
+            append_number(buffer, cur_change.profit_amount);
+            buffer += '}';
+        }
+        
+        buffer += cur_result.changes.empty() ? "]\n" : "\n";
+        if (!cur_result.changes.empty())
+        {
+            buffer += indent_3;
+            buffer += "]\n";
+        }
+        buffer += indent_2;
+        buffer += '}';
+        
+    }
+    buffer += this->scenario_results_.empty() ? "]\n" : "\n";
+    if (!this->scenario_results_.empty())
+    {
+        buffer += indent_1;
+        buffer += "]\n";
+    }
+    
+    // It is recommended to not put a newline on the last brace to allow
+    // comma chaining when this object is an element of an array.
+    buffer += indent_0;
+    buffer += '}';
+    
+}
+
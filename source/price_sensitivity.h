@@ -0,0 +1,191 @@
+/// @file price_sensitivity.h
+/// @brief Declaration of @ref price_sensitivity_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_PRICE_SENSITIVITY
+#define HEADER_GUARD_PRICE_SENSITIVITY
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "best_price_index.h"
+#include "blueprint_profit.h"
+#include "decryptor.h"
+#include "error.h"
+#include "industry_profile.h"
+#include "price_scenarios.h"
+#include "profit_matrix.h"
+
+class blueprints_t;
+class galactic_market_t;
+
+/// @brief How the profit of the best decryptor of each blueprint at each
+/// station responds to prices.
+///
+/// Profit is linear in prices once a decryptor is chosen, so its partial
+/// derivative with respect to each price is read straight from a
+/// @ref profit_matrix_t.  Scenarios override a few prices and only
+/// re-evaluate the rows of the matrix which use those items, choosing the
+/// best decryptor again for the blueprints they belong to.
+///
+/// With --cross-station the derivative is with respect to the best price
+/// reachable from the station, including hauling.
+class price_sensitivity_t
+{
+        
+    public:
+        
+        /// @brief The blueprint profit at one station that a scenario
+        /// changed.
+        struct change_t
+        {
+            uint64_t station_id;
+            uint64_t blueprint_id;
+            /// @brief Best decryptor with the scenario's prices.
+            decryptor_t::type_t decryptor;
+            /// @brief Not finite if the blueprint couldn't be built before.
+            float base_profit_amount;
+            /// @brief Not finite if the blueprint can't be built anymore.
+            float profit_amount;
+        };
+        
+        /// @brief Every change caused by one scenario.
+        struct scenario_result_t
+        {
+            std::string name;
+            std::vector<change_t> changes;
+        };
+        
+        /// @brief Default constructor
+        inline price_sensitivity_t()
+          : decryptor_optimization_strategy_(blueprint_profit_t::sort_strategy_t::PROFIT_PER_SECOND)
+        {
+            // All work done in initializer list
+        }
+        
+        // Add member read and write functions
+        
+        /// @brief Only valid after @ref evaluate_scenarios.
+        inline const std::vector<scenario_result_t>& scenario_results() const
+        {
+            return this->scenario_results_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Price every blueprint at every station and choose the best
+        /// decryptor of each, clearing previous content.
+        ///
+        /// @exception error_message_t
+        void initialize_from_market
+        (
+            const blueprints_t& blueprints,
+            const galactic_market_t& galactic_market,
+            blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy,
+            /// [in] See @ref blueprint_profit_t::initialize_from_market
+            const best_price_index_t* best_prices = nullptr,
+            /// [in] See @ref blueprint_profit_t::initialize_from_market
+            unsigned runs_per_job = 1,
+            /// [in] See @ref blueprint_profit_t::initialize_from_market
+            const industry_profile_t::modifiers_t& modifiers = industry_profile_t::no_modifiers
+        );
+        
+        /// @brief Apply each scenario on its own to the prices of
+        /// @ref initialize_from_market, replacing previous results.
+        /// Scenarios are evaluated in parallel.
+        ///
+        /// @exception error_message_t
+        void evaluate_scenarios(const price_scenarios_t& scenarios);
+        
+        // Add encoders/decoders here
+        
+        /// @brief Serialize the content of this file into a file that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_file
+        (
+            /// [out] Stream to append serialized object content to.
+            std::ostream& file,
+            /// [in] Allows human readable names to be displayed with each
+            /// blueprint.
+            const std::unordered_map<uint64_t, std::string_view>& blueprint_names,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Serialize the content of this file into a string that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_buffer
+        (
+            /// [out] This string is overwritten with serialzed JSON content.
+            std::string& buffer,
+            /// [in] Allows human readable names to be displayed with each
+            /// blueprint.
+            const std::unordered_map<uint64_t, std::string_view>& blueprint_names,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+    protected:
+        
+        /// @brief Prices and results of one station without any scenario.
+        struct station_t
+        {
+            uint64_t station_id;
+            std::vector<float> input_prices;
+            std::vector<float> output_prices;
+            std::vector<float> total_costs;
+            std::vector<float> output_values;
+            /// @brief Best row of @ref profit_matrix_ of each blueprint, or
+            /// @ref no_row if none can be built.
+            std::vector<unsigned> best_rows;
+        };
+        
+        /// @brief See @ref station_t::best_rows.
+        static constexpr unsigned no_row = ~0u;
+        
+        /// @brief Choose the best of the rows of one blueprint.
+        ///
+        /// @return The best row, or @ref no_row if no row has a finite
+        /// total cost and output value.
+        ///
+        /// @exception error_message_t
+        unsigned best_row
+        (
+            unsigned blueprint_ix,
+            const std::vector<float>& total_costs,
+            const std::vector<float>& output_values
+        ) const;
+        
+        /// @brief Every blueprint and decryptor compiled once.
+        profit_matrix_t profit_matrix_;
+        
+        /// @brief Used to choose between decryptors.
+        blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy_;
+        
+        /// @brief Every station of the market.
+        std::vector<station_t> stations_;
+        
+        /// @brief See @ref scenario_results.
+        std::vector<scenario_result_t> scenario_results_;
+        
+};
+
+#endif // Header Guard
+
@@ -0,0 +1,367 @@
+/// @file production_schedule.cpp
+/// @brief Implementation of @ref production_schedule_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "blueprint.h"
+#include "blueprint_profit.h"
+#include "blueprints.h"
+#include "error.h"
+#include "galactic_profits.h"
+#include "item_quantity.h"
+#include "market_history.h"
+#include "production_schedule.h"
+#include "station_profits.h"
+
+void production_schedule_t::initialize_from_profits
+(
+    const galactic_profits_t& profits,
+    const blueprints_t& blueprints,
+    const market_history_t* history,
+    unsigned history_days
+){
+    
+    this->clear();
+    
+    // Keep the station with the best profit per second for each blueprint,
+    // since a blueprint can only be run in one place at a time.
+    std::unordered_map<uint64_t, unsigned> candidate_ixs;
+    std::vector<float> best_profit_per_second;
+    for (const station_profits_t& cur_station : profits.station_profits())
+    {
+        for (const blueprint_profit_t& cur_profit : cur_station.blueprint_profits())
+        {
+            
+            if (!cur_profit.manufacturability().is_ok() || !(cur_profit.profit_amount() > 0.0f) || cur_profit.time() == 0)
+                continue;
+            
+            std::unordered_map<uint64_t, blueprint_t>::const_iterator blueprint = blueprints.storage().find(cur_profit.blueprint_id());
+            if (blueprint == blueprints.storage().end())
+                continue;
+            
+            std::pair<std::unordered_map<uint64_t, unsigned>::iterator, bool> found = candidate_ixs.try_emplace(cur_profit.blueprint_id(), this->candidates_.size());
+            if (found.second)
+            {
+                this->candidates_.emplace_back();
+                best_profit_per_second.push_back(-std::numeric_limits<float>::infinity());
+            }
+            unsigned candidate_ix = found.first->second;
+            if (!(cur_profit.profit_per_second() > best_profit_per_second[candidate_ix]))
+                continue;
+            best_profit_per_second[candidate_ix] = cur_profit.profit_per_second();
+            
+            candidate_t& candidate = this->candidates_[candidate_ix];
+            candidate.blueprint_id = cur_profit.blueprint_id();
+            candidate.station_id = cur_station.station_id();
+            candidate.runs = cur_profit.runs();
+            candidate.manufacturing_time = cur_profit.manufacturing_time();
+            candidate.science_time = cur_profit.science_time();
+            candidate.cost = cur_profit.total_cost();
+            candidate.profit = cur_profit.profit_amount();
+            candidate.max_jobs = std::numeric_limits<unsigned>::max();
+            
+        }
+    }
+    
+    if (history == nullptr || history_days == 0)
+        return;
+    
+    // Average daily volume of every product, summed over all regions
+    std::unordered_map<uint64_t, double> daily_volumes;
+    for (const candidate_t& cur_candidate : this->candidates_)
+    {
+        const blueprint_t& blueprint = blueprints.storage().at(cur_candidate.blueprint_id);
+        for (const item_quantity_t& cur_output : blueprint.manufacture().output_materials().materials_list())
+            daily_volumes.emplace(cur_output.item_id(), 0.0);
+    }
+    for (const std::pair<const market_history_t::series_key_t, market_history_t::series_t>& cur_series : history->series())
+    {
+        std::unordered_map<uint64_t, double>::iterator daily_volume = daily_volumes.find(cur_series.first.second);
+        if (daily_volume == daily_volumes.end())
+            continue;
+        market_history_t::summary_t summary;
+        if (history->summarize_recent(cur_series.first.first, cur_series.first.second, history_days, summary))
+            daily_volume->second += double(summary.volume) / double(history_days);
+    }
+    
+    // Cap each blueprint by the product the market absorbs least of
+    double horizon_days = this->horizon_hours_ / 24.0;
+    for (candidate_t& cur_candidate : this->candidates_)
+    {
+        const blueprint_t& blueprint = blueprints.storage().at(cur_candidate.blueprint_id);
+        double max_jobs = double(std::numeric_limits<unsigned>::max());
+        for (const item_quantity_t& cur_output : blueprint.manufacture().output_materials().materials_list())
+        {
+            double units_per_job = double(cur_output.quantity()) * double(cur_candidate.runs);
+            if (units_per_job > 0.0)
+                max_jobs = std::min(max_jobs, std::floor(daily_volumes[cur_output.item_id()] * horizon_days / units_per_job));
+        }
+        cur_candidate.max_jobs = unsigned(max_jobs);
+    }
+    
+}
+
+double production_schedule_t::fill
+(
+    const std::vector<unsigned>& ranking,
+    unsigned skip,
+    std::vector<unsigned>& jobs,
+    double& free_manufacturing,
+    double& free_science,
+    double& free_capital
+) const {
+    
+    double added_profit = 0.0;
+    for (unsigned cur_ix : ranking)
+    {
+        
+        if (cur_ix == skip)
+            continue;
+        const candidate_t& candidate = this->candidates_[cur_ix];
+        if (jobs[cur_ix] >= candidate.max_jobs)
+            continue;
+        
+        // Number of jobs limited by each resource
+        double num_jobs = double(candidate.max_jobs - jobs[cur_ix]);
+        num_jobs = std::min(num_jobs, std::floor(free_manufacturing / candidate.manufacturing_time));
+        if (candidate.science_time > 0.0f)
+            num_jobs = std::min(num_jobs, std::floor(free_science / candidate.science_time));
+        if (candidate.cost > 0.0f)
+            num_jobs = std::min(num_jobs, std::floor(free_capital / candidate.cost));
+        if (!(num_jobs >= 1.0))
+            continue;
+        
+        jobs[cur_ix] += unsigned(num_jobs);
+        free_manufacturing -= num_jobs * candidate.manufacturing_time;
+        free_science -= num_jobs * candidate.science_time;
+        free_capital -= num_jobs * candidate.cost;
+        added_profit += num_jobs * candidate.profit;
+        
+    }
+    
+    return added_profit;
+    
+}
+
+void production_schedule_t::solve()
+{
+    
+    this->allocations_.clear();
+    this->total_profit_ = 0.0;
+    this->manufacturing_used_ = 0.0;
+    this->science_used_ = 0.0;
+    this->capital_used_ = 0.0;
+    
+    double horizon_seconds = this->horizon_hours_ * 3600.0;
+    double manufacturing_capacity = double(this->num_characters_) * double(this->manufacturing_slots_) * horizon_seconds;
+    double science_capacity = double(this->num_characters_) * double(this->science_slots_) * horizon_seconds;
+    double capital_capacity = this->capital_ > 0.0 ? this->capital_ : std::numeric_limits<double>::infinity();
+    if (!(manufacturing_capacity > 0.0))
+        return;
+    
+    // Rank candidates by profit per share of all three resources.  Capital
+    // only counts when it is limited.
+    unsigned num_candidates = this->candidates_.size();
+    std::vector<double> scores(num_candidates, 0.0);
+    std::vector<unsigned> ranking;
+    ranking.reserve(num_candidates);
+    for (unsigned ix = 0; ix < num_candidates; ix++)
+    {
+        
+        const candidate_t& candidate = this->candidates_[ix];
+        if (!(candidate.profit > 0.0f) || candidate.max_jobs == 0)
+            continue;
+        if (!(candidate.manufacturing_time > 0.0f) || candidate.manufacturing_time > horizon_seconds)
+            continue;
+        if (candidate.science_time > 0.0f && !(science_capacity > 0.0))
+            continue;
+        
+        double share = candidate.manufacturing_time / manufacturing_capacity + candidate.cost / capital_capacity;
+        if (candidate.science_time > 0.0f)
+            share += candidate.science_time / science_capacity;
+        scores[ix] = candidate.profit / share;
+        ranking.push_back(ix);
+        
+    }
+    std::sort
+    (
+        ranking.begin(),
+        ranking.end(),
+        [&](unsigned lhs, unsigned rhs) -> bool
+        {
+            if (scores[lhs] != scores[rhs])
+                return scores[lhs] > scores[rhs];
+            return this->candidates_[lhs].blueprint_id < this->candidates_[rhs].blueprint_id;
+        }
+    );
+    
+    // Greedy start
+    std::vector<unsigned> jobs(num_candidates, 0);
+    double free_manufacturing = manufacturing_capacity;
+    double free_science = science_capacity;
+    double free_capital = capital_capacity;
+    double profit = this->fill(ranking, num_candidates, jobs, free_manufacturing, free_science, free_capital);
+    
+    // Local search.  Greedy by ratio leaves capacity stranded when a good
+    // candidate is too big for what is left, so try giving back one job of
+    // each scheduled candidate, worst first, and refilling with the others.
+    std::vector<unsigned> trial_jobs;
+    const unsigned max_passes = 8;
+    for (unsigned pass = 0; pass < max_passes; pass++)
+    {
+        
+        bool improved = false;
+        for (std::vector<unsigned>::const_reverse_iterator cur_ix = ranking.rbegin(); cur_ix != ranking.rend(); ++cur_ix)
+        {
+            
+            if (jobs[*cur_ix] == 0)
+                continue;
+            const candidate_t& candidate = this->candidates_[*cur_ix];
+            
+            trial_jobs = jobs;
+            trial_jobs[*cur_ix]--;
+            double trial_manufacturing = free_manufacturing + candidate.manufacturing_time;
+            double trial_science = free_science + candidate.science_time;
+            double trial_capital = free_capital + candidate.cost;
+            double trial_profit = profit - candidate.profit + this->fill(ranking, *cur_ix, trial_jobs, trial_manufacturing, trial_science, trial_capital);
+            
+            // Ignore changes lost in rounding
+            if (trial_profit > profit + 1e-6 * std::fabs(profit))
+            {
+                jobs.swap(trial_jobs);
+                free_manufacturing = trial_manufacturing;
+                free_science = trial_science;
+                free_capital = trial_capital;
+                profit = trial_profit;
+                improved = true;
+            }
+            
+        }
+        if (!improved)
+            break;
+            
+    }
+    
+    // Report what was scheduled, best candidates first
+    for (unsigned cur_ix : ranking)
+    {
+        if (jobs[cur_ix] != 0)
+            this->allocations_.push_back(allocation_t{this->candidates_[cur_ix], jobs[cur_ix]});
+    }
+    this->total_profit_ = profit;
+    this->manufacturing_used_ = manufacturing_capacity - free_manufacturing;
+    this->science_used_ = science_capacity - free_science;
+    this->capital_used_ = this->capital_ > 0.0 ? capital_capacity - free_capital : 0.0;
+    if (!(this->capital_ > 0.0))
+    {
+        for (const allocation_t& cur_allocation : this->allocations_)
+            this->capital_used_ += double(cur_allocation.jobs) * cur_allocation.candidate.cost;
+    }
+    
+}
+
+void production_schedule_t::write_to_json_file(std::ostream& file, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    file << this->write_to_json_buffer(indent_start, spaces_per_tab);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when encoding production_schedule_t object.");
+}
+
+void production_schedule_t::write_to_json_buffer(std::string& buffer, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    
+    std::string indent_2(indent_start + 2 * spaces_per_tab, ' ');
+    std::string_view indent_1(indent_2.data(), indent_start + spaces_per_tab);
+    std::string_view indent_0(indent_2.data(), indent_start);
+    
+    double horizon_seconds = this->horizon_hours_ * 3600.0;
+    double manufacturing_capacity = double(this->num_characters_) * double(this->manufacturing_slots_) * horizon_seconds;
+    double science_capacity = double(this->num_characters_) * double(this->science_slots_) * horizon_seconds;
+    
+    // It is recommended not to start a new line before the opening brace, to
+    // enable chaining.
+    buffer += "{\n";
+    
+    buffer += indent_1;
+    buffer += "\"horizon_hours\": ";
+    buffer += std::to_string(this->horizon_hours_);
+    buffer += ",\n";
+    
+    buffer += indent_1;
+    buffer += "\"total_profit\": ";
+    buffer += std::to_string(this->total_profit_);
+    buffer += ",\n";
+    
+    buffer += indent_1;
+    buffer += "\"profit_per_hour\": ";
+    buffer += std::to_string(this->horizon_hours_ > 0.0 ? this->total_profit_ / this->horizon_hours_ : 0.0);
+    buffer += ",\n";
+    
+    buffer += indent_1;
+    buffer += "\"capital_used\": ";
+    buffer += std::to_string(this->capital_used_);
+    buffer += ",\n";
+    
+    buffer += indent_1;
+    buffer += "\"manufacturing_utilization\": ";
+    buffer += std::to_string(manufacturing_capacity > 0.0 ? this->manufacturing_used_ / manufacturing_capacity : 0.0);
+    buffer += ",\n";
+    
+    buffer += indent_1;
+    buffer += "\"science_utilization\": ";
+    buffer += std::to_string(science_capacity > 0.0 ? this->science_used_ / science_capacity : 0.0);
+    buffer += ",\n";
+    
+    // One allocation per line
+    buffer += indent_1;
+    buffer += "\"allocations\": [";
+    unsigned num_allocations = this->allocations_.size();
+    for (unsigned ix = 0; ix < num_allocations; ix++)
+    {
+        const allocation_t& cur_allocation = this->allocations_[ix];
+        buffer += ix == 0 ? "\n" : ",\n";
+        buffer += indent_2;
+        buffer += "{\"blueprint_id\": ";
+        buffer += std::to_string(cur_allocation.candidate.blueprint_id);
+        buffer += ", \"station_id\": ";
+        buffer += std::to_string(cur_allocation.candidate.station_id);
+        buffer += ", \"runs\": ";
+        buffer += std::to_string(cur_allocation.candidate.runs);
+        buffer += ", \"jobs\": ";
+        buffer += std::to_string(cur_allocation.jobs);
+        buffer += ", \"manufacturing_time\": ";
+        buffer += std::to_string(cur_allocation.candidate.manufacturing_time);
+        buffer += ", \"science_time\": ";
+        buffer += std::to_string(cur_allocation.candidate.science_time);
+        buffer += ", \"cost\": ";
+        buffer += std::to_string(cur_allocation.candidate.cost);
+        buffer += ", \"profit\": ";
+        buffer += std::to_string(cur_allocation.candidate.profit);
+        buffer += '}';
+    }
+    if (num_allocations != 0)
+    {
+        buffer += '\n';
+        buffer += indent_1;
+    }
+    buffer += "]\n";
+    
+    // It is recommended to not put a newline on the last brace to allow
+    // chaining.
+    buffer += indent_0;
+    buffer += '}';
+    
+}
+
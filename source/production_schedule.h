@@ -0,0 +1,299 @@
+/// @file production_schedule.h
+/// @brief Declaration of @ref production_schedule_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_PRODUCTION_SCHEDULE
+#define HEADER_GUARD_PRODUCTION_SCHEDULE
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "error.h"
+
+class blueprints_t;
+class galactic_profits_t;
+class market_history_t;
+
+/// @brief Chooses which blueprints to run, and how many jobs of each, to make
+/// the most ISK with a limited number of job slots and a limited amount of
+/// capital.
+///
+/// The slots of every character are pooled into one budget of
+/// manufacturing slot-seconds and one of science slot-seconds over the
+/// planning horizon, and a job is only considered if it finishes within the
+/// horizon.  This relaxes the underlying bin packing problem, which is
+/// accurate as long as jobs are short compared to the horizon.
+///
+/// What remains is a bounded knapsack with three resources.  It is solved
+/// greedily by profit per share of the resources a job uses, then improved
+/// by a local search that takes single jobs back out and refills the freed
+/// capacity, keeping any change that makes more profit.
+class production_schedule_t
+{
+        
+    public:
+        
+        /// @brief One blueprint that could be run, and what one job of it
+        /// costs and makes.
+        struct candidate_t
+        {
+            uint64_t blueprint_id;
+            /// @brief Station with the best profit per second for this
+            /// blueprint.
+            uint64_t station_id;
+            unsigned runs;
+            /// @brief Seconds of manufacturing slot time per job.
+            float manufacturing_time;
+            /// @brief Seconds of science slot time per job spent copying and
+            /// inventing, weighted by the invention probability.
+            float science_time;
+            float cost;
+            float profit;
+            /// @brief Most jobs the market can absorb over the horizon.
+            unsigned max_jobs;
+        };
+        
+        /// @brief A candidate and how many jobs of it were scheduled.
+        struct allocation_t
+        {
+            candidate_t candidate;
+            unsigned jobs;
+        };
+        
+        /// @brief Default constructor
+        inline production_schedule_t()
+          : num_characters_(1),
+            manufacturing_slots_(11),
+            science_slots_(11),
+            capital_(0.0),
+            horizon_hours_(24.0),
+            total_profit_(0.0),
+            manufacturing_used_(0.0),
+            science_used_(0.0),
+            capital_used_(0.0)
+        {
+            // All work done in initializer list
+        }
+        
+        // Add member read and write functions
+        
+        inline unsigned num_characters() const
+        {
+            return this->num_characters_;
+        }
+        
+        inline void num_characters(unsigned new_num_characters)
+        {
+            this->num_characters_ = new_num_characters;
+        }
+        
+        /// @brief Manufacturing slots of each character.
+        inline unsigned manufacturing_slots() const
+        {
+            return this->manufacturing_slots_;
+        }
+        
+        inline void manufacturing_slots(unsigned new_manufacturing_slots)
+        {
+            this->manufacturing_slots_ = new_manufacturing_slots;
+        }
+        
+        /// @brief Science slots of each character, used for copying and
+        /// invention.
+        inline unsigned science_slots() const
+        {
+            return this->science_slots_;
+        }
+        
+        inline void science_slots(unsigned new_science_slots)
+        {
+            this->science_slots_ = new_science_slots;
+        }
+        
+        /// @brief ISK available to buy materials, or 0 for no limit.
+        inline double capital() const
+        {
+            return this->capital_;
+        }
+        
+        inline void capital(double new_capital)
+        {
+            this->capital_ = new_capital;
+        }
+        
+        /// @brief Length of the schedule.  Every scheduled job finishes
+        /// within it.
+        inline double horizon_hours() const
+        {
+            return this->horizon_hours_;
+        }
+        
+        inline void horizon_hours(double new_horizon_hours)
+        {
+            this->horizon_hours_ = new_horizon_hours;
+        }
+        
+        inline const std::vector<candidate_t>& candidates() const
+        {
+            return this->candidates_;
+        }
+        
+        /// @brief Every candidate with at least one job, best first.  Only
+        /// valid after @ref solve.
+        inline const std::vector<allocation_t>& allocations() const
+        {
+            return this->allocations_;
+        }
+        
+        inline double total_profit() const
+        {
+            return this->total_profit_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Remove all candidates and allocations.  Limits are kept.
+        inline void clear()
+        {
+            this->candidates_.clear();
+            this->allocations_.clear();
+            this->total_profit_ = 0.0;
+            this->manufacturing_used_ = 0.0;
+            this->science_used_ = 0.0;
+            this->capital_used_ = 0.0;
+        }
+        
+        /// @brief Make one candidate per profitable blueprint from a
+        /// calculate-blueprint-profits report, clearing previous content.
+        ///
+        /// If history is not null, the number of jobs of each blueprint is
+        /// capped so that its products don't exceed the average daily volume
+        /// traded over the last history_days days, summed over all regions,
+        /// for the length of @ref horizon_hours.
+        void initialize_from_profits
+        (
+            const galactic_profits_t& profits,
+            const blueprints_t& blueprints,
+            const market_history_t* history,
+            unsigned history_days
+        );
+        
+        /// @brief Allocate jobs to candidates, replacing previous
+        /// allocations.
+        void solve();
+        
+        // Add encoders/decoders here
+        
+        /// @brief Serialize the content of this file into a file that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_file
+        (
+            /// [out] Stream to append serialized object content to.
+            std::ostream& file,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Serialize the content of this file into a string that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_buffer
+        (
+            /// [out] This string is overwritten with serialzed JSON content.
+            std::string& buffer,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Convinence method for pretty initialize-on-construction
+        /// syntax.
+        inline std::string write_to_json_buffer
+        (
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const {
+            std::string buffer;
+            this->write_to_json_buffer(buffer, indent_start, spaces_per_tab);
+            return buffer;
+        }
+        
+    protected:
+        
+        /// @brief Add as many jobs as fit to each candidate in ranking, in
+        /// order, skipping the candidate with index skip.  The free
+        /// capacities are reduced by what was added.
+        ///
+        /// @return Profit of the added jobs.
+        double fill
+        (
+            const std::vector<unsigned>& ranking,
+            unsigned skip,
+            std::vector<unsigned>& jobs,
+            double& free_manufacturing,
+            double& free_science,
+            double& free_capital
+        ) const;
+        
+        /// @brief See @ref num_characters.
+        unsigned num_characters_;
+        
+        /// @brief See @ref manufacturing_slots.
+        unsigned manufacturing_slots_;
+        
+        /// @brief See @ref science_slots.
+        unsigned science_slots_;
+        
+        /// @brief See @ref capital.
+        double capital_;
+        
+        /// @brief See @ref horizon_hours.
+        double horizon_hours_;
+        
+        /// @brief See @ref candidates.
+        std::vector<candidate_t> candidates_;
+        
+        /// @brief See @ref allocations.
+        std::vector<allocation_t> allocations_;
+        
+        /// @brief See @ref total_profit.
+        double total_profit_;
+        
+        /// @brief Manufacturing slot-seconds used by @ref allocations.
+        double manufacturing_used_;
+        
+        /// @brief Science slot-seconds used by @ref allocations.
+        double science_used_;
+        
+        /// @brief ISK spent on materials by @ref allocations.
+        double capital_used_;
+        
+};
+
+/// @brief Convenience alias to allow printing directly via cout or similar.
+inline std::ostream& operator<<(std::ostream& stream, const production_schedule_t& source)
+{
+    source.write_to_json_file(stream);
+    return stream;
+}
+
+#endif // Header Guard
+
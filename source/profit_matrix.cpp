@@ -0,0 +1,370 @@
+/// @file profit_matrix.cpp
+/// @brief Implementation of @ref profit_matrix_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "best_price_index.h"
+#include "blueprint.h"
+#include "blueprint_profit.h"
+#include "blueprints.h"
+#include "decryptor.h"
+#include "error.h"
+#include "item_quantities.h"
+#include "item_quantity.h"
+#include "profit_matrix.h"
+#include "station_market.h"
+
+unsigned profit_matrix_t::column
+(
+    uint64_t item_id,
+    std::vector<uint64_t>& column_items,
+    std::unordered_map<uint64_t, unsigned>& columns
+){
+    std::pair<std::unordered_map<uint64_t, unsigned>::iterator, bool> found = columns.try_emplace(item_id, column_items.size());
+    if (found.second)
+        column_items.push_back(item_id);
+    return found.first->second;
+}
+
+void profit_matrix_t::initialize_from_blueprints
+(
+    const blueprints_t& blueprints,
+    unsigned runs_per_job,
+    const industry_profile_t::modifiers_t& modifiers
+){
+    
+    this->rows_.clear();
+    this->blueprint_offsets_.clear();
+    this->input_matrix_.clear();
+    this->input_items_.clear();
+    this->output_matrix_.clear();
+    this->output_items_.clear();
+    this->input_columns_.clear();
+    this->output_columns_.clear();
+    this->input_row_owners_.clear();
+    this->runs_per_job_ = runs_per_job;
+    this->modifiers_ = modifiers;
+    
+    // Append one list of materials as a row of the input matrix
+    auto append_inputs = [&](const item_quantities_t& materials, unsigned material_efficiency, unsigned runs, float material_multiplier)
+    {
+        for (const item_quantity_t& cur_item_quantity : materials.materials_list())
+        {
+            uint64_t quantity = item_quantities_t::batch_quantity(cur_item_quantity.quantity(), material_efficiency, runs, material_multiplier);
+            this->input_matrix_.append(profit_matrix_t::column(cur_item_quantity.item_id(), this->input_items_, this->input_columns_), float(quantity));
+        }
+        this->input_matrix_.finish_row();
+        this->input_row_owners_.push_back(this->rows_.size());
+    };
+    
+    // Products are sold without material efficiency or structure bonuses
+    auto append_outputs = [&](const item_quantities_t& materials, unsigned runs)
+    {
+        for (const item_quantity_t& cur_item_quantity : materials.materials_list())
+        {
+            uint64_t quantity = item_quantities_t::batch_quantity(cur_item_quantity.quantity(), 0, runs);
+            this->output_matrix_.append(profit_matrix_t::column(cur_item_quantity.item_id(), this->output_items_, this->output_columns_), float(quantity));
+        }
+        this->output_matrix_.finish_row();
+    };
+    
+    // Rows follow the same formulas as blueprint_profit_t::calculate_total_cost
+    for (const std::pair<const uint64_t, blueprint_t>& cur_blueprint : blueprints.storage())
+    {
+        
+        this->blueprint_offsets_.push_back(this->rows_.size());
+        
+        const blueprint_t::manufacture_t& manufacture = cur_blueprint.second.manufacture();
+        const blueprint_t::invent_t& invent = cur_blueprint.second.invent();
+        if (!invent.valid())
+        {
+            
+            row_t row;
+            row.blueprint_id = cur_blueprint.first;
+            row.decryptor = decryptor_t::type_t::NO_DECRYPTOR;
+            row.compiled = true;
+            row.job = blueprint_profit_t::job(cur_blueprint.second, nullptr, row.decryptor, runs_per_job, modifiers);
+            row.first_input_row = this->input_matrix_.num_rows();
+            append_inputs(manufacture.input_materials(), manufacture.material_efficiency(), runs_per_job, modifiers.material_multiplier);
+            append_outputs(manufacture.output_materials(), runs_per_job);
+            this->rows_.push_back(row);
+            continue;
+            
+        }
+        
+        // T2 blueprints whose T1 blueprint can't be copied are left to
+        // blueprint_profit_t, which reports why
+        std::unordered_map<uint64_t, blueprint_t>::const_iterator t1_iterator = blueprints.storage().find(invent.invented_from_blueprint_id());
+        bool compiled = t1_iterator != blueprints.storage().end() && t1_iterator->second.copy().valid();
+        
+        for
+        (
+            decryptor_t::type_t cur_decryptor_type = decryptor_t::type_t(0);
+            cur_decryptor_type != decryptor_t::type_t::NUM_ENUMS;
+            cur_decryptor_type = decryptor_t::type_t(unsigned(cur_decryptor_type) + 1)
+        ){
+            
+            row_t row;
+            row.blueprint_id = cur_blueprint.first;
+            row.decryptor = cur_decryptor_type;
+            row.compiled = compiled;
+            row.first_input_row = this->input_matrix_.num_rows();
+            if (!compiled)
+            {
+                row.job = blueprint_profit_t::job_t();
+                this->output_matrix_.finish_row();
+                this->rows_.push_back(row);
+                continue;
+            }
+            
+            decryptor_t decryptor(cur_decryptor_type);
+            const blueprint_t::copy_t copy = t1_iterator->second.copy();
+            row.job = blueprint_profit_t::job(cur_blueprint.second, &t1_iterator->second, decryptor, runs_per_job, modifiers);
+            
+            append_inputs(copy.input_materials(), 0, 1, 1.0f);
+            append_inputs(invent.input_materials(), 0, 1, 1.0f);
+            if (cur_decryptor_type != decryptor_t::type_t::NO_DECRYPTOR)
+                this->input_matrix_.append(profit_matrix_t::column(decryptor.item_id(), this->input_items_, this->input_columns_), 1.0f);
+            this->input_matrix_.finish_row();
+            this->input_row_owners_.push_back(this->rows_.size());
+            append_inputs(manufacture.input_materials(), decryptor.modify_material_efficiency(invent.material_efficiency()), row.job.runs, modifiers.material_multiplier);
+            append_outputs(manufacture.output_materials(), row.job.runs);
+            this->rows_.push_back(row);
+            
+        }
+        
+    }
+    this->blueprint_offsets_.push_back(this->rows_.size());
+    
+    // Find every row using an item, for what-if questions about its price
+    this->input_transpose_ = this->input_matrix_.transpose();
+    this->output_transpose_ = this->output_matrix_.transpose();
+    
+}
+
+void profit_matrix_t::gather_column_prices
+(
+    const std::vector<uint64_t>& column_items,
+    const station_market_t& station_market,
+    const best_price_index_t* best_prices,
+    best_price_index_t::side_t side,
+    std::vector<float>& prices
+){
+    
+    float infinity = std::numeric_limits<float>::infinity();
+    prices.resize(column_items.size());
+    for (unsigned column = 0, num_columns = column_items.size(); column < num_columns; column++)
+    {
+        
+        uint64_t item_id = column_items[column];
+        if (best_prices != nullptr)
+        {
+            try
+            {
+                prices[column] = best_prices->price(item_id, station_market, side);
+            } catch (const error_message_t& error) {
+                if (error != error_code_t::NO_ORDERS)
+                    throw error;
+                prices[column] = infinity;
+            }
+            continue;
+        }
+        
+        station_market_t::item_map_t::const_iterator local = station_market.items().find(item_id);
+        if (local == station_market.items().end() || local->second.sell_orders().empty())
+            prices[column] = infinity;
+        else
+            prices[column] = local->second.min_sell_order();
+            
+    }
+    
+}
+
+void profit_matrix_t::gather_prices
+(
+    const station_market_t& station_market,
+    const best_price_index_t* best_prices,
+    std::vector<float>& input_prices,
+    std::vector<float>& output_prices
+) const {
+    profit_matrix_t::gather_column_prices(this->input_items_, station_market, best_prices, best_price_index_t::side_t::BUY, input_prices);
+    profit_matrix_t::gather_column_prices(this->output_items_, station_market, best_prices, best_price_index_t::side_t::SELL, output_prices);
+}
+
+float profit_matrix_t::total_cost(const row_t& row, const float* input_costs) const
+{
+    
+    // The job fee is charged on manufacturing inputs only
+    float job_fee_fraction = this->modifiers_.job_fee_fraction;
+    if (!row.compiled)
+        return std::numeric_limits<float>::quiet_NaN();
+    if (row.job.effective_num_t1_copies == 0.0f)
+        return input_costs[0] + job_fee_fraction * input_costs[0];
+    return row.job.effective_num_t1_copies * (input_costs[0] + input_costs[1] + input_costs[2])
+      + input_costs[3]
+      + job_fee_fraction * input_costs[3];
+      
+}
+
+void profit_matrix_t::evaluate
+(
+    const station_market_t& station_market,
+    const best_price_index_t* best_prices,
+    std::vector<float>& total_costs,
+    std::vector<float>& output_values
+) const {
+    std::vector<float> input_prices;
+    std::vector<float> output_prices;
+    this->gather_prices(station_market, best_prices, input_prices, output_prices);
+    this->evaluate(input_prices, output_prices, total_costs, output_values);
+}
+
+void profit_matrix_t::evaluate
+(
+    const std::vector<float>& input_prices,
+    const std::vector<float>& output_prices,
+    std::vector<float>& total_costs,
+    std::vector<float>& output_values
+) const {
+    
+    std::vector<float> input_costs;
+    this->input_matrix_.multiply(input_prices, input_costs);
+    this->output_matrix_.multiply(output_prices, output_values);
+    
+    // Combine the lists of materials of each row
+    unsigned num_rows = this->rows_.size();
+    total_costs.resize(num_rows);
+    for (unsigned ix = 0; ix < num_rows; ix++)
+    {
+        const row_t& row = this->rows_[ix];
+        total_costs[ix] = this->total_cost(row, input_costs.data() + row.first_input_row);
+        output_values[ix] = this->modifiers_.sell_fraction * output_values[ix];
+    }
+    
+}
+
+void profit_matrix_t::evaluate_row
+(
+    unsigned row_ix,
+    const std::vector<float>& input_prices,
+    const std::vector<float>& output_prices,
+    float& total_cost,
+    float& output_value
+) const {
+    
+    const row_t& row = this->rows_[row_ix];
+    float input_costs[4];
+    unsigned num_input_rows = row.job.effective_num_t1_copies == 0.0f ? 1 : 4;
+    if (row.compiled)
+    {
+        for (unsigned ix = 0; ix < num_input_rows; ix++)
+            input_costs[ix] = this->input_matrix_.multiply_row(row.first_input_row + ix, input_prices);
+    }
+    total_cost = this->total_cost(row, input_costs);
+    output_value = this->modifiers_.sell_fraction * this->output_matrix_.multiply_row(row_ix, output_prices);
+    
+}
+
+void profit_matrix_t::evaluate_invention_row
+(
+    unsigned row_ix,
+    const std::vector<float>& input_prices,
+    const std::vector<float>& output_prices,
+    float& attempt_cost,
+    float& manufacture_cost,
+    float& output_value
+) const {
+    
+    const row_t& row = this->rows_[row_ix];
+    if (!row.compiled || row.job.effective_num_t1_copies == 0.0f)
+        throw error_message_t(error_code_t::INVENTION_ROW_INVALID, "Error.  Attempted to split the invention cost of a row which has no invention.\n");
+    
+    float input_costs[4];
+    for (unsigned ix = 0; ix < 4; ix++)
+        input_costs[ix] = this->input_matrix_.multiply_row(row.first_input_row + ix, input_prices);
+    attempt_cost = input_costs[0] + input_costs[1] + input_costs[2];
+    manufacture_cost = input_costs[3] + this->modifiers_.job_fee_fraction * input_costs[3];
+    output_value = this->modifiers_.sell_fraction * this->output_matrix_.multiply_row(row_ix, output_prices);
+    
+}
+
+unsigned profit_matrix_t::blueprint_of_row(unsigned row_ix) const
+{
+    return std::upper_bound(this->blueprint_offsets_.begin(), this->blueprint_offsets_.end(), row_ix) - this->blueprint_offsets_.begin() - 1;
+}
+
+unsigned profit_matrix_t::input_column(uint64_t item_id) const
+{
+    std::unordered_map<uint64_t, unsigned>::const_iterator found = this->input_columns_.find(item_id);
+    return found == this->input_columns_.end() ? no_column : found->second;
+}
+
+unsigned profit_matrix_t::output_column(uint64_t item_id) const
+{
+    std::unordered_map<uint64_t, unsigned>::const_iterator found = this->output_columns_.find(item_id);
+    return found == this->output_columns_.end() ? no_column : found->second;
+}
+
+void profit_matrix_t::affected_rows(const std::vector<uint64_t>& item_ids, std::vector<unsigned>& rows) const
+{
+    
+    rows.clear();
+    for (uint64_t cur_item_id : item_ids)
+    {
+        
+        // Columns of the transposes are rows of the matrices
+        unsigned column = this->input_column(cur_item_id);
+        if (column != no_column)
+        {
+            for (unsigned ix = this->input_transpose_.row_offsets()[column], end = this->input_transpose_.row_offsets()[column + 1]; ix < end; ix++)
+                rows.push_back(this->input_row_owners_[this->input_transpose_.columns()[ix]]);
+        }
+        
+        column = this->output_column(cur_item_id);
+        if (column != no_column)
+        {
+            for (unsigned ix = this->output_transpose_.row_offsets()[column], end = this->output_transpose_.row_offsets()[column + 1]; ix < end; ix++)
+                rows.push_back(this->output_transpose_.columns()[ix]);
+        }
+        
+    }
+    
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    
+}
+
+void profit_matrix_t::gradient(unsigned row_ix, std::vector< std::pair<uint64_t, float> >& derivatives) const
+{
+    
+    derivatives.clear();
+    const row_t& row = this->rows_[row_ix];
+    if (!row.compiled)
+        return;
+    
+    // Each list of inputs is weighted the way total_cost combines them
+    std::map<uint64_t, float> accumulator;
+    float manufacture_weight = 1.0f + this->modifiers_.job_fee_fraction;
+    unsigned num_input_rows = row.job.effective_num_t1_copies == 0.0f ? 1 : 4;
+    for (unsigned input_row = 0; input_row < num_input_rows; input_row++)
+    {
+        float weight = input_row + 1 == num_input_rows ? manufacture_weight : row.job.effective_num_t1_copies;
+        unsigned matrix_row = row.first_input_row + input_row;
+        for (unsigned ix = this->input_matrix_.row_offsets()[matrix_row], end = this->input_matrix_.row_offsets()[matrix_row + 1]; ix < end; ix++)
+            accumulator[this->input_items_[this->input_matrix_.columns()[ix]]] -= weight * this->input_matrix_.values()[ix];
+    }
+    for (unsigned ix = this->output_matrix_.row_offsets()[row_ix], end = this->output_matrix_.row_offsets()[row_ix + 1]; ix < end; ix++)
+        accumulator[this->output_items_[this->output_matrix_.columns()[ix]]] += this->modifiers_.sell_fraction * this->output_matrix_.values()[ix];
+    
+    derivatives.assign(accumulator.begin(), accumulator.end());
+    
+}
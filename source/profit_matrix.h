@@ -0,0 +1,288 @@
+/// @file profit_matrix.h
+/// @brief Declaration of @ref profit_matrix_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_PROFIT_MATRIX
+#define HEADER_GUARD_PROFIT_MATRIX
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "best_price_index.h"
+#include "blueprint_profit.h"
+#include "decryptor.h"
+#include "industry_profile.h"
+#include "sparse_matrix.h"
+
+class blueprints_t;
+class station_market_t;
+
+/// @brief Every blueprint and decryptor combination compiled into sparse
+/// matrices, so the cost and value of all of them at a station is two
+/// sparse matrix-vector products over that station's prices.
+///
+/// Once the runs per job and the industry profile are fixed, material
+/// efficiency rounding, invention probability and the number of copies per
+/// job only depend on the blueprint.  What is left is linear in the price of
+/// each item.  Each row of the cost matrix is one list of input materials,
+/// summed in the same order as @ref blueprint_profit_t so the results are
+/// identical.
+///
+/// Rows the matrix can't describe, and rows missing a price at a station,
+/// are flagged by @ref evaluate and left to @ref blueprint_profit_t, which
+/// also explains what went wrong.  Build trees are not linear in prices and
+/// aren't supported.
+class profit_matrix_t
+{
+        
+    public:
+        
+        /// @brief One blueprint with one decryptor.
+        struct row_t
+        {
+            uint64_t blueprint_id;
+            decryptor_t::type_t decryptor;
+            /// @brief False if the blueprint needs a T1 blueprint which is
+            /// missing or can't be copied.
+            bool compiled;
+            /// @brief Runs, time and invention weighting.  All zero if not
+            /// @ref compiled.
+            blueprint_profit_t::job_t job;
+            /// @brief First row of @ref input_matrix_ used by this row.  T1
+            /// blueprints use one row for manufacturing inputs.  T2
+            /// blueprints use four, for copy, invention, decryptor and
+            /// manufacturing inputs.
+            unsigned first_input_row;
+        };
+        
+        /// @brief Default constructor
+        inline profit_matrix_t()
+          : runs_per_job_(1),
+            modifiers_(industry_profile_t::no_modifiers)
+        {
+            // All work done in initializer list
+        }
+        
+        // Add member read and write functions
+        
+        /// @brief Rows in the order of blueprints_t::storage, and decryptors
+        /// in enum order within each T2 blueprint.
+        inline const std::vector<row_t>& rows() const
+        {
+            return this->rows_;
+        }
+        
+        /// @brief Index into @ref rows of the first row of each blueprint,
+        /// followed by the number of rows.
+        inline const std::vector<unsigned>& blueprint_offsets() const
+        {
+            return this->blueprint_offsets_;
+        }
+        
+        inline unsigned runs_per_job() const
+        {
+            return this->runs_per_job_;
+        }
+        
+        inline const industry_profile_t::modifiers_t& modifiers() const
+        {
+            return this->modifiers_;
+        }
+        
+        /// @brief Item bought in each column of the input matrix.
+        inline const std::vector<uint64_t>& input_items() const
+        {
+            return this->input_items_;
+        }
+        
+        /// @brief Item sold in each column of the output matrix.
+        inline const std::vector<uint64_t>& output_items() const
+        {
+            return this->output_items_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Compile every blueprint, clearing previous content.
+        void initialize_from_blueprints
+        (
+            const blueprints_t& blueprints,
+            /// [in] See @ref blueprint_profit_t::initialize_from_market
+            unsigned runs_per_job = 1,
+            /// [in] See @ref blueprint_profit_t::initialize_from_market
+            const industry_profile_t::modifiers_t& modifiers = industry_profile_t::no_modifiers
+        );
+        
+        /// @brief Price of each column of the input and output matrices at a
+        /// station.  Items without orders cost infinity.
+        ///
+        /// @exception error_message_t
+        void gather_prices
+        (
+            /// [in] See @ref blueprint_profit_t::initialize_from_market
+            const station_market_t& station_market,
+            /// [in] See @ref blueprint_profit_t::initialize_from_market
+            const best_price_index_t* best_prices,
+            /// [out] Price of each item in @ref input_items.
+            std::vector<float>& input_prices,
+            /// [out] Price of each item in @ref output_items.
+            std::vector<float>& output_prices
+        ) const;
+        
+        /// @brief Calculate the total cost and output value of every row with
+        /// a station's prices.
+        ///
+        /// Rows which aren't compiled, or which use an item without a price,
+        /// get a total cost or output value which is not finite.
+        ///
+        /// @exception error_message_t
+        void evaluate
+        (
+            /// [in] See @ref blueprint_profit_t::initialize_from_market
+            const station_market_t& station_market,
+            /// [in] See @ref blueprint_profit_t::initialize_from_market
+            const best_price_index_t* best_prices,
+            /// [out] Resized to the number of rows.
+            std::vector<float>& total_costs,
+            /// [out] Resized to the number of rows.
+            std::vector<float>& output_values
+        ) const;
+        
+        /// @brief Same as above, with prices from @ref gather_prices.
+        void evaluate
+        (
+            const std::vector<float>& input_prices,
+            const std::vector<float>& output_prices,
+            std::vector<float>& total_costs,
+            std::vector<float>& output_values
+        ) const;
+        
+        /// @brief Same as @ref evaluate, but for one row.
+        void evaluate_row
+        (
+            unsigned row_ix,
+            const std::vector<float>& input_prices,
+            const std::vector<float>& output_prices,
+            float& total_cost,
+            float& output_value
+        ) const;
+        
+        /// @brief Split the total cost of a compiled T2 row into what one
+        /// invention attempt costs and what manufacturing one job costs,
+        /// including the job fee.
+        ///
+        /// A total cost is the invention cost times
+        /// @ref row_t::effective_num_t1_copies plus the manufacturing cost.
+        void evaluate_invention_row
+        (
+            unsigned row_ix,
+            const std::vector<float>& input_prices,
+            const std::vector<float>& output_prices,
+            /// [out] Copy, invention and decryptor inputs of one attempt.
+            float& attempt_cost,
+            float& manufacture_cost,
+            float& output_value
+        ) const;
+        
+        /// @brief Index into @ref blueprint_offsets of the blueprint a row
+        /// belongs to.
+        unsigned blueprint_of_row(unsigned row_ix) const;
+        
+        /// @brief Returned by @ref input_column and @ref output_column for
+        /// items no row uses.
+        static constexpr unsigned no_column = ~0u;
+        
+        /// @brief Index into @ref input_items of an item, or @ref no_column.
+        unsigned input_column(uint64_t item_id) const;
+        
+        /// @brief Index into @ref output_items of an item, or @ref no_column.
+        unsigned output_column(uint64_t item_id) const;
+        
+        /// @brief Every row whose total cost or output value depends on the
+        /// price of any of item_ids, sorted.
+        void affected_rows(const std::vector<uint64_t>& item_ids, std::vector<unsigned>& rows) const;
+        
+        /// @brief Partial derivative of the profit of a row with respect to
+        /// the price of each item it buys or sells, sorted by item ID.  Empty
+        /// for rows which aren't compiled.
+        void gradient(unsigned row_ix, std::vector< std::pair<uint64_t, float> >& derivatives) const;
+        
+    protected:
+        
+        /// @brief Add a column for item_id to one of the matrices if it
+        /// doesn't have one yet.
+        ///
+        /// @return The column.
+        static unsigned column
+        (
+            uint64_t item_id,
+            std::vector<uint64_t>& column_items,
+            std::unordered_map<uint64_t, unsigned>& columns
+        );
+        
+        /// @brief Price of each item in column_items at a station.
+        ///
+        /// @exception error_message_t
+        static void gather_column_prices
+        (
+            const std::vector<uint64_t>& column_items,
+            const station_market_t& station_market,
+            const best_price_index_t* best_prices,
+            best_price_index_t::side_t side,
+            std::vector<float>& prices
+        );
+        
+        /// @brief Combine the cost of each list of inputs of a row, starting
+        /// at input_costs.
+        float total_cost(const row_t& row, const float* input_costs) const;
+        
+        /// @brief See @ref rows.
+        std::vector<row_t> rows_;
+        
+        /// @brief See @ref blueprint_offsets.
+        std::vector<unsigned> blueprint_offsets_;
+        
+        /// @brief See @ref runs_per_job.
+        unsigned runs_per_job_;
+        
+        /// @brief See @ref modifiers.
+        industry_profile_t::modifiers_t modifiers_;
+        
+        /// @brief Quantity of each input material per job.  See
+        /// @ref row_t::first_input_row.
+        sparse_matrix_t input_matrix_;
+        
+        /// @brief See @ref input_items.
+        std::vector<uint64_t> input_items_;
+        
+        /// @brief Inverse of @ref input_items_.
+        std::unordered_map<uint64_t, unsigned> input_columns_;
+        
+        /// @brief Row of @ref rows_ each row of @ref input_matrix_ belongs
+        /// to.
+        std::vector<unsigned> input_row_owners_;
+        
+        /// @brief Rows of @ref input_matrix_ using each item.
+        sparse_matrix_t input_transpose_;
+        
+        /// @brief Quantity of each product per job, one row per row.
+        sparse_matrix_t output_matrix_;
+        
+        /// @brief See @ref output_items.
+        std::vector<uint64_t> output_items_;
+        
+        /// @brief Inverse of @ref output_items_.
+        std::unordered_map<uint64_t, unsigned> output_columns_;
+        
+        /// @brief Rows of @ref output_matrix_ selling each item.
+        sparse_matrix_t output_transpose_;
+        
+};
+
+#endif // Header Guard
+
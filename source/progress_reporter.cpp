@@ -0,0 +1,138 @@
+/// @file progress_reporter.cpp
+/// @brief Implementation of @ref progress_reporter_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+
+#include "progress_reporter.h"
+
+/// @brief Print a floating point number with one digit after the decimal.
+static std::string one_decimal_string(double value)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.1f", value);
+    return std::string(buffer);
+}
+
+progress_reporter_t::progress_reporter_t
+(
+    std::string_view label,
+    std::string_view unit,
+    uint64_t total,
+    bool enabled,
+    std::chrono::milliseconds interval
+) : label_(label),
+    unit_(unit),
+    done_(0),
+    bytes_(0),
+    total_(total),
+    interval_(interval),
+    start_(std::chrono::steady_clock::now()),
+    enabled_(enabled && progress_reporter_t::stdout_is_terminal()),
+    last_print_length_(0),
+    stopping_(false)
+{
+    if (this->enabled_)
+        this->thread_ = std::thread(&progress_reporter_t::reporter_function, this);
+}
+
+progress_reporter_t::~progress_reporter_t()
+{
+    this->stop();
+}
+
+bool progress_reporter_t::stdout_is_terminal()
+{
+    return isatty(STDOUT_FILENO) != 0;
+}
+
+void progress_reporter_t::stop()
+{
+    
+    if (!this->thread_.joinable())
+        return;
+    
+    this->stop_lock_.lock();
+    this->stopping_ = true;
+    this->stop_lock_.unlock();
+    this->stop_condition_.notify_one();
+    this->thread_.join();
+    
+    // Leave the final counts on screen.
+    this->render();
+    std::cout << '\n' << std::flush;
+    
+}
+
+void progress_reporter_t::reporter_function()
+{
+    std::unique_lock<std::mutex> lock(this->stop_lock_);
+    while (!this->stop_condition_.wait_for(lock, this->interval_, [this]{ return this->stopping_; }))
+        this->render();
+}
+
+void progress_reporter_t::render()
+{
+    
+    uint64_t done = this->done();
+    uint64_t bytes = this->bytes();
+    uint64_t total = this->total();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->start_).count();
+    double rate = seconds > 0.0 ? double(done) / seconds : 0.0;
+    
+    std::string line(this->label_);
+    line += ": ";
+    line += std::to_string(done);
+    if (total != 0)
+    {
+        line += '/';
+        line += std::to_string(total);
+    }
+    line += ' ';
+    line += this->unit_;
+    if (total != 0)
+    {
+        line += " (";
+        line += std::to_string(done < total ? done * 100 / total : 100);
+        line += "%)";
+    }
+    line += ", ";
+    line += one_decimal_string(rate);
+    line += ' ';
+    line += this->unit_;
+    line += "/s";
+    if (bytes != 0)
+    {
+        line += ", ";
+        line += one_decimal_string(double(bytes) / (1024.0 * 1024.0));
+        line += " MiB";
+    }
+    if (total != 0 && done < total && rate > 0.0)
+    {
+        line += ", ETA ";
+        line += std::to_string(unsigned(double(total - done) / rate + 0.5));
+        line += 's';
+    }
+    
+    // Pad with spaces to cover any leftovers from a longer previous line.
+    unsigned print_length = line.length();
+    if (print_length < this->last_print_length_)
+        line.append(this->last_print_length_ - print_length, ' ');
+    this->last_print_length_ = print_length;
+    
+    std::cout << '\r' << line << std::flush;
+    
+}
+
@@ -0,0 +1,158 @@
+/// @file progress_reporter.h
+/// @brief Declaration of @ref progress_reporter_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_PROGRESS_REPORTER
+#define HEADER_GUARD_PROGRESS_REPORTER
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+/// @brief Prints a single self-overwriting status line such as
+/// "Fetching market orders: 120/300 pages (40%), 25.1 pages/s, 12.3 MiB, ETA 7s"
+/// from a dedicated thread.
+///
+/// Worker threads only bump relaxed atomic counters via @ref increment, so
+/// they never contend on the terminal.  The status line is redrawn once per
+/// tick with a carriage return.  Nothing at all is printed unless enabled and
+/// stdout is a terminal, so redirected output and log files stay clean.
+class progress_reporter_t
+{
+        
+    public:
+        
+        /// @brief Start the reporter thread, if printing is enabled.
+        progress_reporter_t
+        (
+            /// [in] Printed at the start of the status line.
+            std::string_view label,
+            /// [in] Noun printed after the counts, such as "pages".
+            std::string_view unit,
+            /// [in] Expected final value of @ref done, or 0 if unknown in
+            /// which case percentages and ETAs are not printed.
+            uint64_t total,
+            /// [in] If false, no thread is started and nothing is printed.
+            /// Usually @ref debug_mode_t::verbose.
+            bool enabled,
+            /// [in] Time between redraws.
+            std::chrono::milliseconds interval = std::chrono::milliseconds(200)
+        );
+        
+        /// @brief Calls @ref stop.
+        ~progress_reporter_t();
+        
+        progress_reporter_t(const progress_reporter_t&) = delete;
+        progress_reporter_t& operator=(const progress_reporter_t&) = delete;
+        
+        // Add member read and write functions
+        
+        inline uint64_t done() const
+        {
+            return this->done_.load(std::memory_order_relaxed);
+        }
+        
+        inline uint64_t bytes() const
+        {
+            return this->bytes_.load(std::memory_order_relaxed);
+        }
+        
+        inline uint64_t total() const
+        {
+            return this->total_.load(std::memory_order_relaxed);
+        }
+        
+        /// @brief Change the expected final value once it becomes known.
+        inline void total(uint64_t new_total)
+        {
+            this->total_.store(new_total, std::memory_order_relaxed);
+        }
+        
+        /// @brief True if a reporter thread is running.
+        inline bool enabled() const
+        {
+            return this->enabled_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Record that units of work have finished.  Safe and cheap to
+        /// call from any thread.
+        inline void increment(uint64_t num_done = 1, uint64_t num_bytes = 0)
+        {
+            this->done_.fetch_add(num_done, std::memory_order_relaxed);
+            if (num_bytes != 0)
+                this->bytes_.fetch_add(num_bytes, std::memory_order_relaxed);
+        }
+        
+        /// @brief Draw the final status line, end it with a newline and join
+        /// the reporter thread.  Calling this more than once has no effect.
+        void stop();
+        
+        /// @brief True if stdout is attached to a terminal rather than a pipe
+        /// or file.
+        static bool stdout_is_terminal();
+        
+    protected:
+        
+        /// @brief Body of @ref thread_.  Redraws every @ref interval_ until
+        /// @ref stop is called.
+        void reporter_function();
+        
+        /// @brief Overwrite the status line with the current counter values.
+        void render();
+        
+        /// @brief See constructor.
+        std::string label_;
+        
+        /// @brief See constructor.
+        std::string unit_;
+        
+        /// @brief Units of work finished so far.
+        std::atomic<uint64_t> done_;
+        
+        /// @brief Payload bytes received so far, or 0 if not applicable.
+        std::atomic<uint64_t> bytes_;
+        
+        /// @brief See constructor.
+        std::atomic<uint64_t> total_;
+        
+        /// @brief See constructor.
+        std::chrono::milliseconds interval_;
+        
+        /// @brief Time at construction, used to compute rates.
+        std::chrono::steady_clock::time_point start_;
+        
+        /// @brief False if printing was disabled or stdout is not a terminal.
+        bool enabled_;
+        
+        /// @brief Length of the previously drawn line, so that a shorter line
+        /// can be padded to fully overwrite it.  Only touched by the reporter
+        /// thread and by @ref stop after joining it.
+        unsigned last_print_length_;
+        
+        /// @brief Set by @ref stop to wake and terminate @ref thread_.
+        bool stopping_;
+        
+        /// @brief Guards @ref stopping_.
+        std::mutex stop_lock_;
+        
+        /// @brief Signalled by @ref stop so that the reporter does not sleep
+        /// out the rest of its tick.
+        std::condition_variable stop_condition_;
+        
+        /// @brief Redraws the status line.  Not joinable when disabled.
+        std::thread thread_;
+        
+};
+
+#endif // Header Guard
+
@@ -5,6 +5,7 @@
 /// * Date Created = Tuesday October 31 2017
 /// * Documentation is generated by doxygen, see documentation/html_out/index.html
 
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include <string_view>
@@ -13,6 +14,54 @@
 #include "error.h"
 #include "json.h"
 
+bool raw_order_t::range_from_string(std::string_view range_string, uint8_t& range)
+{
+    
+    if (range_string == "station")
+    {
+        range = station_range;
+        return true;
+    }
+    if (range_string == "solarsystem")
+    {
+        range = 0;
+        return true;
+    }
+    if (range_string == "region")
+    {
+        range = region_range;
+        return true;
+    }
+    
+    // Otherwise a number of jumps
+    if (range_string.empty() || range_string.size() > 2)
+        return false;
+    unsigned jumps = 0;
+    for (char cur_char : range_string)
+    {
+        if (cur_char < '0' || cur_char > '9')
+            return false;
+        jumps = 10 * jumps + unsigned(cur_char - '0');
+    }
+    if (jumps == 0 || jumps >= station_range)
+        return false;
+    range = jumps;
+    return true;
+    
+}
+
+void raw_order_t::range_to_string(uint8_t range, std::string& buffer)
+{
+    if (range == station_range)
+        buffer += "station";
+    else if (range == region_range)
+        buffer += "region";
+    else if (range == 0)
+        buffer += "solarsystem";
+    else
+        buffer += std::to_string(range);
+}
+
 void raw_order_t::read_from_json_file(std::istream& file)
 {
     
@@ -110,6 +159,27 @@ void raw_order_t::read_from_json_json(const Json::Value& json_root)
         throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, message);
     }
     
+    // Parse root/system_id
+    // This is optional and left at 0 if missing.
+    const Json::Value& json_system_id = json_root["system_id"];
+    this->system_id_ = 0;
+    if (!json_system_id.isNull())
+    {
+        if (!json_system_id.isUInt64())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <order>/system_id was not of type \"unsigned int\".\n");
+        this->system_id_ = json_system_id.asUInt64();
+    }
+    
+    // Parse root/range
+    // This is optional and left at "station" if missing.
+    const Json::Value& json_range = json_root["range"];
+    this->range_ = station_range;
+    if (!json_range.isNull())
+    {
+        if (!json_range.isString() || !raw_order_t::range_from_string(json_range.asString(), this->range_))
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <order>/range was not a valid order range.\n");
+    }
+    
 }
 
 void raw_order_t::write_to_json_file(std::ostream& file, unsigned indent_start, unsigned spaces_per_tab) const
@@ -151,12 +221,24 @@ void raw_order_t::write_to_json_buffer(std::string& buffer, unsigned indent_star
     buffer += indent_1;
     buffer += "\"raw_order_type\": \"";
     if (this->order_type_ == order_type_t::BUY)
-        buffer += "buy\"\n";
+        buffer += "buy\",\n";
     else if (this->order_type_ == order_type_t::SELL)
-        buffer += "sell\"\n";
+        buffer += "sell\",\n";
     else
         throw error_message_t(error_code_t::UNKNOWN_ORDER_TYPE, "Error.  Could not encode order with unknown order_type.\n");
     
+    // Encode system_id
+    buffer += indent_1;
+    buffer += "\"system_id\": ";
+    buffer += std::to_string(this->system_id_);
+    buffer += ",\n";
+    
+    // Encode range
+    buffer += indent_1;
+    buffer += "\"range\": \"";
+    raw_order_t::range_to_string(this->range_, buffer);
+    buffer += "\"\n";
+    
     // It is recommended to not put a newline on the last brace to allow
     // comma chaining when this object is an element of an array.
     buffer += indent_0;
@@ -8,7 +8,9 @@
 #ifndef HEADER_GUARD_ORDER
 #define HEADER_GUARD_ORDER
 
+#include <cstdint>
 #include <fstream>
+#include <string>
 #include <string_view>
 
 #include "error.h"
@@ -32,17 +34,40 @@ class raw_order_t
         
     public:
         
+        /// @brief @ref range of orders which can only be filled at their own
+        /// station.  Sell orders always have this range.
+        static constexpr uint8_t station_range = 254;
+        
+        /// @brief @ref range of orders which can be filled anywhere in their
+        /// region.
+        static constexpr uint8_t region_range = 255;
+        
         /// @brief Default constructor
-        inline raw_order_t() = default;
+        inline raw_order_t()
+          : system_id_(0),
+            range_(station_range)
+        {
+            // All work done in initializer list
+        }
         
         // Add member initialization constructors here
         
         // Try to use initializer lists when possible.
-        inline raw_order_t(float price, uint64_t item_id, uint64_t station_id, order_type_t order_type)
+        inline raw_order_t
+        (
+            float price,
+            uint64_t item_id,
+            uint64_t station_id,
+            order_type_t order_type,
+            uint64_t system_id = 0,
+            uint8_t range = station_range
+        )
           : price_(price),
             item_id_(item_id),
             station_id_(station_id),
-            order_type_(order_type)
+            order_type_(order_type),
+            system_id_(system_id),
+            range_(range)
         {
             // All work done in initializer list
         }
@@ -58,7 +83,9 @@ class raw_order_t
                 this->price_ == source.price_
              && this->item_id_ == source.item_id_
              && this->station_id_ == source.station_id_
-             && this->order_type_ == source.order_type_;
+             && this->order_type_ == source.order_type_
+             && this->system_id_ == source.system_id_
+             && this->range_ == source.range_;
         }
         
         /// @brief 1:1 inverse of @ref operator==(const raw_order_t& source) const "operator==".
@@ -111,6 +138,39 @@ class raw_order_t
             this->order_type_ = new_order_type;
         }
         
+        /// @brief Solar system of @ref station_id, or 0 if unknown.
+        inline uint64_t system_id() const
+        {
+            return this->system_id_;
+        }
+        
+        inline void system_id(uint64_t new_system_id)
+        {
+            this->system_id_ = new_system_id;
+        }
+        
+        /// @brief Stations a buy order can be filled at, as the most jumps
+        /// from @ref system_id, where 0 is the same system.  Otherwise
+        /// @ref station_range or @ref region_range.
+        inline uint8_t range() const
+        {
+            return this->range_;
+        }
+        
+        inline void range(uint8_t new_range)
+        {
+            this->range_ = new_range;
+        }
+        
+        /// @brief Decode a range as written by the EvE Swagger API, such as
+        /// "station", "solarsystem", "5" or "region".
+        ///
+        /// @return False if the string is not a valid range.
+        static bool range_from_string(std::string_view range_string, uint8_t& range);
+        
+        /// @brief Inverse of @ref range_from_string.
+        static void range_to_string(uint8_t range, std::string& buffer);
+        
         /// @brief Open a file conforming to data/json/schema.json and use it to initialize
         /// this object, clearing previous content.
         ///
@@ -210,6 +270,12 @@ class raw_order_t
         /// @brief Indicates if this order is a buy or sell order.
         order_type_t order_type_;
         
+        /// @brief See @ref system_id.
+        uint64_t system_id_;
+        
+        /// @brief See @ref range.
+        uint8_t range_;
+        
 };
 
 /// @brief Convenience alias to allow printing directly via cout or similar.
@@ -5,98 +5,221 @@
 /// * Date Created = Friday November 3 2017
 /// * Documentation is generated by doxygen, see html/index.html
 
+#include <algorithm>
+#include <cstdint>
 #include <fstream>
-#include <iostream>
 #include <memory>
 #include <string>
 #include <string_view>
-#include <thread>
 #include <vector>
 
 #include "debug_mode.h"
 #include "error.h"
-#include "https_get.h"
 #include "json.h"
-#include "page_fetcher.h"
 #include "raw_order.h"
 #include "raw_regional_market.h"
+#include "stats.h"
+#include "trace.h"
 
-void raw_regional_market_t::fetch(uint64_t region_id)
+void raw_regional_market_t::decode_page(const Json::Value& json_payload, std::vector<raw_order_t>& page_orders) const
 {
     
-    this->region_id_ = region_id;
+    stats_t::scoped_timer_t timer(this->debug_mode_.stats(), stats_t::stage_t::DECODE);
+    trace_t::scoped_span_t span(this->debug_mode_.trace(), "decode", "decode", this->region_id_);
     
-    page_fetcher_t page_fetcher;
-    page_fetcher.debug_mode(this->debug_mode());
+    page_orders.clear();
     
-    std::string query_prefix("https://esi.tech.ccp.is/latest/markets/");
-    query_prefix += std::to_string(region_id);
-    query_prefix += "/orders/?datasource=tranquility&order_type=all";
-    page_fetcher.base_url(query_prefix);
+    if (!json_payload.isArray())
+        throw error_message_t(error_code_t::EVE_SUCKS, "Error.  Could not decode non-array market payload.\n");
     
-    std::vector<Json::Value> payloads = page_fetcher.parallel_fetch(std::thread::hardware_concurrency());
+    // When most stations or orders are culled, reserving for every order
+    // would waste more than it saves.
+    if (!this->ingest_filter_.cull_stations() && !this->ingest_filter_.cull_items())
+        page_orders.reserve(json_payload.size());
     
-    this->decode_from_payloads(payloads);
+    // Step through each order and decode it
+    for (const Json::Value& json_cur_order : json_payload)
+    {
+        
+        // Accumulate fields for each order in this structure
+        raw_order_t new_order;
+        
+        if (!json_cur_order.isObject())
+            throw error_message_t(error_code_t::EVE_SUCKS, "Element fetched from eve API was not of type \"object\".\n");
+        
+        const Json::Value& json_cur_price = json_cur_order["price"];
+        if (!json_cur_price.isNumeric())
+            throw error_message_t(error_code_t::EVE_SUCKS, "price fetched from eve API was not of type \"float\".\n");
+        new_order.price(json_cur_price.asFloat());
+        
+        const Json::Value& json_cur_item_id = json_cur_order["type_id"];
+        if (!json_cur_item_id.isUInt64())
+            throw error_message_t(error_code_t::EVE_SUCKS, "type_id fetched from eve API was not of type \"unsigned integer\".\n");
+        uint64_t item_id = json_cur_item_id.asUInt64();
+        if (!this->ingest_filter_.keep_item(item_id))
+            continue;
+        new_order.item_id(item_id);
+        
+        const Json::Value& json_cur_station_id = json_cur_order["location_id"];
+        if (!json_cur_station_id.isUInt64())
+            throw error_message_t(error_code_t::EVE_SUCKS, "location_id fetched from eve API was not of type \"unsigned integer\".\n");
+        uint64_t station_id = json_cur_station_id.asUInt64();
+        new_order.station_id(station_id);
+        
+        const Json::Value& json_cur_order_type = json_cur_order["is_buy_order"];
+        if (!json_cur_order_type.isBool())
+            throw error_message_t(error_code_t::EVE_SUCKS, "is_buy_order fetched from eve API was not of type \"bool\".\n");
+        if (json_cur_order_type.asBool())
+            new_order.order_type(order_type_t::BUY);
+        else
+            new_order.order_type(order_type_t::SELL);
+        
+        // Only buy orders can be filled away from their own station
+        if (this->ingest_filter_.topology() != nullptr && new_order.order_type() == order_type_t::BUY)
+        {
+            
+            const Json::Value& json_cur_system_id = json_cur_order["system_id"];
+            if (!json_cur_system_id.isUInt64())
+                throw error_message_t(error_code_t::EVE_SUCKS, "system_id fetched from eve API was not of type \"unsigned integer\".\n");
+            new_order.system_id(json_cur_system_id.asUInt64());
+            
+            const Json::Value& json_cur_range = json_cur_order["range"];
+            uint8_t range;
+            if (!json_cur_range.isString() || !raw_order_t::range_from_string(json_cur_range.asString(), range))
+                throw error_message_t(error_code_t::EVE_SUCKS, "range fetched from eve API was not a valid order range.\n");
+            new_order.range(range);
+            
+        }
+        
+        // Keep buy orders elsewhere which can be filled at a station we
+        // are interested in
+        if
+        (
+            !this->ingest_filter_.keep_station(station_id)
+         && (
+                new_order.range() == raw_order_t::station_range
+             || !this->ingest_filter_.reaches_range_target(this->region_id_, new_order.system_id(), new_order.range())
+            )
+        ){
+            continue;
+        }
+        
+        page_orders.emplace_back(std::move(new_order));
+        
+    }
+    
+    if (this->debug_mode_.stats() != nullptr)
+        this->debug_mode_.stats()->increment(stats_t::counter_t::ORDERS_DECODED, page_orders.size());
     
 }
 
-void raw_regional_market_t::decode_from_payloads(const std::vector<Json::Value>& payloads)
+void raw_regional_market_t::initialize_from_pages(const std::vector< std::vector<raw_order_t> >& pages, unsigned num_orders_fetched)
 {
     
     this->clear();
     
-    // Calcuate the total number of market orders across all fetched payoads
-    unsigned num_orders;
-    for (const Json::Value& json_cur_payload : payloads)
+    if (!this->ingest_filter_.cull_orders())
     {
-        if (!json_cur_payload.isArray())
-            throw error_message_t(error_code_t::EVE_SUCKS, "Error.  Could not decode non-array market payload.\n");
-        num_orders += json_cur_payload.size();
+        
+        unsigned num_orders = 0;
+        for (const std::vector<raw_order_t>& cur_page : pages)
+            num_orders += cur_page.size();
+        this->orders_.reserve(num_orders);
+        for (const std::vector<raw_order_t>& cur_page : pages)
+            this->orders_.insert(this->orders_.end(), cur_page.begin(), cur_page.end());
+        
+    } else {
+        
+        stats_t::scoped_timer_t timer(this->debug_mode_.stats(), stats_t::stage_t::CULL);
+        
+        // Fold each page into reduced in page order
+        std::vector<packed_order_t> reduced;
+        std::vector<float> reduced_prices;
+        for (const std::vector<raw_order_t>& cur_page : pages)
+            raw_regional_market_t::reduce_page(cur_page, reduced, reduced_prices);
+        
+        // Unpack the best order of each key
+        this->orders_.reserve(reduced.size());
+        for (const packed_order_t& cur_record : reduced)
+        {
+            bool buy = (cur_record.type_range & 1) != 0;
+            this->orders_.emplace_back
+            (
+                buy ? -cur_record.price : cur_record.price,
+                cur_record.item_id,
+                cur_record.station_id,
+                buy ? order_type_t::BUY : order_type_t::SELL,
+                cur_record.system_id,
+                uint8_t(cur_record.type_range >> 1)
+            );
+        }
+        
     }
-    this->orders_.reserve(num_orders);
     
-    // Step through each payload and select it for decoding
-    for (const Json::Value& json_cur_payload : payloads)
+    if (this->debug_mode_.stats() != nullptr)
+        this->debug_mode_.stats()->increment(stats_t::counter_t::ORDERS_CULLED, num_orders_fetched - this->orders_.size());
+    
+}
+
+void raw_regional_market_t::reduce_page
+(
+    const std::vector<raw_order_t>& page_orders,
+    std::vector<packed_order_t>& reduced,
+    std::vector<float>& prices
+){
+    
+    auto key_less = [](const packed_order_t& lhs, const packed_order_t& rhs) -> bool
+    {
+        return lhs.key_less(rhs);
+    };
+    
+    // Pack and sort the page, then merge it with the records of earlier
+    // pages, which are already sorted.
+    unsigned num_reduced = reduced.size();
+    for (const raw_order_t& cur_order : page_orders)
+    {
+        bool buy = cur_order.order_type() == order_type_t::BUY;
+        packed_order_t record;
+        record.station_id = cur_order.station_id();
+        record.item_id = cur_order.item_id();
+        record.system_id = cur_order.system_id();
+        record.type_range = (uint32_t(cur_order.range()) << 1) | (buy ? 1 : 0);
+        record.price = buy ? -cur_order.price() : cur_order.price();
+        reduced.push_back(record);
+    }
+    std::sort(reduced.begin() + num_reduced, reduced.end(), key_less);
+    std::inplace_merge(reduced.begin(), reduced.begin() + num_reduced, reduced.end(), key_less);
+    
+    // Copy prices out contiguously so that each run reduces with SIMD
+    // instructions.
+    unsigned num_records = reduced.size();
+    prices.resize(num_records);
+    for (unsigned ix = 0; ix < num_records; ix++)
+        prices[ix] = reduced[ix].price;
+    const float* price_data = prices.data();
+    
+    // Compact each run of equal keys into its first record
+    unsigned num_kept = 0;
+    unsigned run_begin = 0;
+    while (run_begin < num_records)
     {
         
-        // Step through each order and decode it
-        for (const Json::Value& json_cur_order : json_cur_payload)
-        {
-            
-            // Accumulate fields for each order in this structure
-            raw_order_t new_order;
-            
-            if (!json_cur_order.isObject())
-                throw error_message_t(error_code_t::EVE_SUCKS, "Element fetched from eve API was not of type \"object\".\n");
-            
-            const Json::Value& json_cur_price = json_cur_order["price"];
-            if (!json_cur_price.isNumeric())
-                throw error_message_t(error_code_t::EVE_SUCKS, "price fetched from eve API was not of type \"float\".\n");
-            new_order.price(json_cur_price.asFloat());
-            
-            const Json::Value& json_cur_item_id = json_cur_order["type_id"];
-            if (!json_cur_item_id.isUInt64())
-                throw error_message_t(error_code_t::EVE_SUCKS, "type_id fetched from eve API was not of type \"unsigned integer\".\n");
-            new_order.item_id(json_cur_item_id.asUInt64());
-            
-            const Json::Value& json_cur_station_id = json_cur_order["location_id"];
-            if (!json_cur_station_id.isUInt64())
-                throw error_message_t(error_code_t::EVE_SUCKS, "location_id fetched from eve API was not of type \"unsigned integer\".\n");
-            new_order.station_id(json_cur_station_id.asUInt64());
-            
-            const Json::Value& json_cur_order_type = json_cur_order["is_buy_order"];
-            if (!json_cur_order_type.isBool())
-                throw error_message_t(error_code_t::EVE_SUCKS, "is_buy_order fetched from eve API was not of type \"bool\".\n");
-            if (json_cur_order_type.asBool())
-                new_order.order_type(order_type_t::BUY);
-            else
-                new_order.order_type(order_type_t::SELL);
-            
-            this->orders_.emplace_back(std::move(new_order));
-            
-        }
+        unsigned run_end = run_begin + 1;
+        while (run_end < num_records && reduced[run_end].same_key(reduced[run_begin]))
+            run_end++;
+        
+        float best_price = price_data[run_begin];
+        #pragma omp simd reduction(min:best_price)
+        for (unsigned ix = run_begin + 1; ix < run_end; ix++)
+            best_price = std::min(best_price, price_data[ix]);
+        
+        reduced[num_kept] = reduced[run_begin];
+        reduced[num_kept].price = best_price;
+        num_kept++;
+        run_begin = run_end;
         
     }
+    reduced.resize(num_kept);
     
 }
 
@@ -213,7 +336,7 @@ void raw_regional_market_t::write_to_json_buffer(std::string& buffer, unsigned i
                 buffer += '\n';
             else
                 buffer += ", ";
-            
+                
         }
         
         buffer += indent_1;
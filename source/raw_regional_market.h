@@ -16,6 +16,7 @@
 
 #include "debug_mode.h"
 #include "error.h"
+#include "ingest_filter.h"
 #include "json.h"
 #include "raw_order.h"
 
@@ -56,12 +57,25 @@ class raw_regional_market_t
         {
             return this->debug_mode_;
         }
-         
+        
         inline void debug_mode(const debug_mode_t& new_debug_mode)
         {
             this->debug_mode_ = new_debug_mode;
         }
         
+        /// @brief Orders rejected by this filter are dropped by
+        /// @ref decode_page.  The filter is also consulted when
+        /// this market is aggregated into a @ref regional_market_t.
+        inline const ingest_filter_t& ingest_filter() const
+        {
+            return this->ingest_filter_;
+        }
+        
+        inline void ingest_filter(const ingest_filter_t& new_ingest_filter)
+        {
+            this->ingest_filter_ = new_ingest_filter;
+        }
+        
         // Add special-purpose member functions here
         
         /// @brief Reset to default-constructed state with zero orders.
@@ -70,9 +84,26 @@ class raw_regional_market_t
             this->orders_.clear();
         }
         
-        /// @brief Pull all of the market orders from all NPC stations in a
-        /// region in EvE.
-        void fetch(uint64_t region_id);
+        /// @brief Parse one page of orders fetched from the EvE API for the
+        /// region set by @ref region_id into page_orders.  Orders at stations
+        /// or for items rejected by @ref ingest_filter are skipped.  Doesn't
+        /// modify this object, so several pages may be decoded at once.
+        ///
+        /// If the filter honours order ranges, buy orders keep their system
+        /// and range, and buy orders at other stations are kept if they can
+        /// be filled at one of the filter's range targets.
+        ///
+        /// @exception error_message_t
+        void decode_page(const Json::Value& json_payload, std::vector<raw_order_t>& page_orders) const;
+        
+        /// @brief Re-initialize this object's market orders from pages
+        /// returned by @ref decode_page, in page order.
+        ///
+        /// If the filter culls orders, the pages are folded together keeping
+        /// only the maximum buy and minimum sell order of each item at each
+        /// station.  num_orders_fetched is the number of orders on the pages
+        /// before filtering, and is only used for statistics.
+        void initialize_from_pages(const std::vector< std::vector<raw_order_t> >& pages, unsigned num_orders_fetched);
         
         /// @brief Open a file conforming to data/json/schema.json and use it to initialize
         /// this object, clearing previous content.
@@ -157,6 +188,48 @@ class raw_regional_market_t
         
     protected:
         
+        /// @brief Fixed-size record of the single order kept for each item,
+        /// station, order type and range when culling orders.  Records are
+        /// kept sorted by key so that duplicates sit next to each other and
+        /// each run of them reduces to one record with a SIMD minimum.
+        struct packed_order_t
+        {
+            uint64_t station_id;
+            uint64_t item_id;
+            /// @brief Not part of the key.  Every order at a station is in
+            /// the same system.
+            uint64_t system_id;
+            /// @brief range << 1, plus 1 for buy orders.
+            uint32_t type_range;
+            /// @brief Negated for buy orders, so that the best price of every
+            /// key is the minimum.
+            float price;
+            inline bool key_less(const packed_order_t& other) const
+            {
+                if (this->station_id != other.station_id)
+                    return this->station_id < other.station_id;
+                if (this->item_id != other.item_id)
+                    return this->item_id < other.item_id;
+                return this->type_range < other.type_range;
+            }
+            inline bool same_key(const packed_order_t& other) const
+            {
+                return this->station_id == other.station_id
+                    && this->item_id == other.item_id
+                    && this->type_range == other.type_range;
+            }
+        };
+        
+        /// @brief Fold one decoded page into reduced, which is sorted by key
+        /// and holds one record per key before and after the call.
+        static void reduce_page
+        (
+            const std::vector<raw_order_t>& page_orders,
+            std::vector<packed_order_t>& reduced,
+            /// [in] Scratch space reused between pages.
+            std::vector<float>& prices
+        );
+        
         /// @brief Integral uniquifier used by the EvE Swagger interface for
         /// this region.  For example, 10000002 for "The Forge" or
         /// 10000043 for "Domain".
@@ -168,9 +241,8 @@ class raw_regional_market_t
         /// @brief Controls verbose printing and progress messages
         debug_mode_t debug_mode_;
         
-        /// @brief Parse data fetched from the EvE API and use it to
-        /// re-initialize this object's market orders.
-        void decode_from_payloads(const std::vector<Json::Value>& payloads);
+        /// @brief See @ref ingest_filter.
+        ingest_filter_t ingest_filter_;
         
 };
 
@@ -5,54 +5,316 @@
 /// * Date Created = Tuesday November 7 2017
 /// * Documentation is generated by doxygen, see html/index.html
 
+#include <algorithm>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include "arena.h"
 #include "error.h"
+#include "ingest_filter.h"
 #include "json.h"
+#include "raw_order.h"
 #include "raw_regional_market.h"
 #include "regional_market.h"
 #include "station_market.h"
+#include "stats.h"
+#include "trace.h"
+
+void regional_market_t::reset_arena(size_t initial_capacity)
+{
+    
+    // Stations must be destroyed before the arena they live in.
+    this->stations_ = station_map_t();
+    this->arena_.reset();
+    
+    if (initial_capacity != 0)
+    {
+        this->arena_ = std::make_unique<arena_t>(initial_capacity);
+        this->stations_ = station_map_t(station_map_t::allocator_type(this->arena_.get()));
+    }
+    
+}
+
+void regional_market_t::add_ranged_buy_orders
+(
+    const ingest_filter_t& ingest_filter,
+    uint64_t region_id,
+    std::vector<raw_order_t>& orders
+){
+    
+    std::vector<ingest_filter_t::range_target_t> targets;
+    for (const ingest_filter_t::range_target_t& cur_target : ingest_filter.range_targets())
+    {
+        if (cur_target.region_id == region_id)
+            targets.push_back(cur_target);
+    }
+    if (targets.empty())
+        return;
+    
+    // Buy orders which can be filled elsewhere, grouped by item with the
+    // best price first
+    std::vector<unsigned> ranged_ixs;
+    for (unsigned ix = 0, num_orders = orders.size(); ix < num_orders; ix++)
+    {
+        if (orders[ix].order_type() == order_type_t::BUY && orders[ix].range() != raw_order_t::station_range)
+            ranged_ixs.push_back(ix);
+    }
+    std::stable_sort
+    (
+        ranged_ixs.begin(),
+        ranged_ixs.end(),
+        [&orders](unsigned a, unsigned b)
+        {
+            if (orders[a].item_id() != orders[b].item_id())
+                return orders[a].item_id() < orders[b].item_id();
+            return orders[b].price() < orders[a].price();
+        }
+    );
+    
+    // The targets a system and range reach are the same for every item, so
+    // they are only found once
+    std::unordered_map< uint64_t, std::vector<unsigned> > reached_targets;
+    auto find_reached_targets = [&](uint64_t system_id, uint8_t range) -> const std::vector<unsigned>&
+    {
+        std::pair<std::unordered_map< uint64_t, std::vector<unsigned> >::iterator, bool> found
+            = reached_targets.try_emplace((system_id << 8) | range);
+        if (found.second)
+        {
+            for (unsigned target_ix = 0, num_targets = targets.size(); target_ix < num_targets; target_ix++)
+            {
+                if (ingest_filter.reaches(targets[target_ix], region_id, system_id, range))
+                    found.first->second.push_back(target_ix);
+            }
+        }
+        return found.first->second;
+    };
+    
+    // Sweep each item's orders from the best price down.  When culling, a
+    // target is done once the best order reaching it is found.
+    bool cull_orders = ingest_filter.cull_orders();
+    std::vector<bool> filled(targets.size());
+    unsigned group_begin = 0;
+    unsigned num_ranged = ranged_ixs.size();
+    while (group_begin < num_ranged)
+    {
+        
+        uint64_t item_id = orders[ranged_ixs[group_begin]].item_id();
+        unsigned group_end = group_begin;
+        while (group_end < num_ranged && orders[ranged_ixs[group_end]].item_id() == item_id)
+            group_end++;
+        
+        filled.assign(targets.size(), false);
+        unsigned num_unfilled = targets.size();
+        for (unsigned ix = group_begin; ix < group_end && num_unfilled != 0; ix++)
+        {
+            
+            // Copy first since appending may reallocate
+            raw_order_t cur_order = orders[ranged_ixs[ix]];
+            for (unsigned target_ix : find_reached_targets(cur_order.system_id(), cur_order.range()))
+            {
+                const ingest_filter_t::range_target_t& target = targets[target_ix];
+                if (target.station_id == cur_order.station_id())
+                    continue;
+                if (cull_orders)
+                {
+                    if (filled[target_ix])
+                        continue;
+                    filled[target_ix] = true;
+                    num_unfilled--;
+                }
+                orders.emplace_back(cur_order.price(), item_id, target.station_id, order_type_t::BUY, target.system_id);
+            }
+            
+        }
+        
+        group_begin = group_end;
+        
+    }
+    
+}
 
 void regional_market_t::initialize_from_raw_regional_market
 (
     const raw_regional_market_t& raw_regional_market
 ){
     
-    this->stations_.clear();
+    stats_t* stats = raw_regional_market.debug_mode().stats();
+    stats_t::scoped_timer_t timer(stats, stats_t::stage_t::AGGREGATE);
+    trace_t::scoped_span_t span(raw_regional_market.debug_mode().trace(), "aggregate", "aggregate", raw_regional_market.region_id());
     
     this->region_id_ = raw_regional_market.region_id();
+    const ingest_filter_t& ingest_filter = raw_regional_market.ingest_filter();
+    bool cull_orders = ingest_filter.cull_orders();
     
-    // Iterate through each order in the raw market data
-    for (const raw_order_t& cur_raw_order : raw_regional_market.orders())
+    // Sort a copy of the orders so that each station, and each item within a
+    // station, is one contiguous run.  The sort is stable so that prices keep
+    // the order they were fetched in.
+    std::vector<raw_order_t> orders(raw_regional_market.orders());
+    if (ingest_filter.topology() != nullptr)
+        regional_market_t::add_ranged_buy_orders(ingest_filter, this->region_id_, orders);
+    std::stable_sort
+    (
+        orders.begin(),
+        orders.end(),
+        [](const raw_order_t& a, const raw_order_t& b)
+        {
+            if (a.station_id() != b.station_id())
+                return a.station_id() < b.station_id();
+            return a.item_id() < b.item_id();
+        }
+    );
+    
+    // Counting pass.  Reject bad orders before anything is allocated.
+    unsigned num_stations = 0;
+    unsigned num_items = 0;
+    unsigned num_orders = orders.size();
+    for (unsigned ix = 0; ix < num_orders; ix++)
+    {
+        const raw_order_t& cur_order = orders[ix];
+        if (cur_order.order_type() != order_type_t::BUY && cur_order.order_type() != order_type_t::SELL)
+            throw error_message_t(error_code_t::UNKNOWN_ORDER_TYPE, "Error.  Could not encode order with unknown order_type.\n");
+        bool new_station = ix == 0 || cur_order.station_id() != orders[ix - 1].station_id();
+        if (new_station)
+            num_stations++;
+        if (new_station || cur_order.item_id() != orders[ix - 1].item_id())
+            num_items++;
+    }
+    
+    // Estimate the size of every hash node, bucket array and price list so
+    // that they usually fit in one allocation.  Node and bucket overheads
+    // depend on the standard library, so they are guessed with a little
+    // slack, and the arena grows by another chunk if the guess falls short.
+    // When culling orders, each item keeps at most one buy and one sell
+    // price.
+    size_t num_prices = cull_orders ? std::min(num_orders, 2 * num_items) : num_orders;
+    size_t station_bytes = sizeof(std::pair<const uint64_t, station_market_t>) + 2 * sizeof(void*);
+    size_t item_bytes = sizeof(std::pair<const uint64_t, item_market_t>) + 2 * sizeof(void*);
+    size_t bucket_bytes = 3 * sizeof(void*);
+    size_t arena_bytes =
+        num_stations * (station_bytes + bucket_bytes)
+      + num_items * (item_bytes + bucket_bytes + 2 * sizeof(void*))
+      + num_prices * sizeof(float)
+      + 64 * sizeof(void*);
+    this->reset_arena(arena_bytes);
+    this->stations_.reserve(num_stations);
+    
+    // Build each station and item exactly once, with pre-sized storage
+    unsigned num_items_kept = 0;
+    unsigned station_begin = 0;
+    while (station_begin < num_orders)
     {
         
-        // Select order's station and item, making new spaces if they didn't exist before
-        station_market_t& cur_station = this->find_or_allocate(cur_raw_order.station_id());
-        item_market_t& cur_item = cur_station.find_or_allocate(cur_raw_order.item_id());
+        uint64_t station_id = orders[station_begin].station_id();
+        unsigned station_end = station_begin;
+        unsigned num_station_items = 0;
+        while (station_end < num_orders && orders[station_end].station_id() == station_id)
+        {
+            if (station_end == station_begin || orders[station_end].item_id() != orders[station_end - 1].item_id())
+                num_station_items++;
+            station_end++;
+        }
         
-        // Copy this order from raw data to sorted market structure
-        cur_station.station_id(cur_raw_order.station_id());
-        cur_item.item_id(cur_raw_order.item_id());
+        // Orders which were not filtered during decode, such as those read
+        // from a file, are filtered here instead.
+        if (!ingest_filter.keep_station(station_id))
+        {
+            station_begin = station_end;
+            continue;
+        }
         
-        switch (cur_raw_order.order_type())
+        station_market_t cur_station(this->arena_.get());
+        cur_station.station_id(station_id);
+        cur_station.reserve(num_station_items);
+        
+        unsigned item_begin = station_begin;
+        while (item_begin < station_end)
         {
-            case order_type_t::BUY:
-                cur_item.new_buy_order(cur_raw_order.price());
-                break;
-            case order_type_t::SELL:
-                cur_item.new_sell_order(cur_raw_order.price());
-                break;
-            default:
-                throw error_message_t(error_code_t::UNKNOWN_ORDER_TYPE, "Error.  Could not encode order with unknown order_type.\n");
-                break;
+            
+            uint64_t item_id = orders[item_begin].item_id();
+            unsigned item_end = item_begin;
+            unsigned num_buy_orders = 0;
+            while (item_end < station_end && orders[item_end].item_id() == item_id)
+            {
+                if (orders[item_end].order_type() == order_type_t::BUY)
+                    num_buy_orders++;
+                item_end++;
+            }
+            
+            // Same for items no blueprint uses
+            if (!ingest_filter.keep_item(item_id))
+            {
+                item_begin = item_end;
+                continue;
+            }
+            
+            unsigned num_sell_orders = item_end - item_begin - num_buy_orders;
+            
+            item_market_t cur_item(this->arena_.get());
+            cur_item.item_id(item_id);
+            if (cull_orders)
+            {
+                
+                // Keep a running maximum buy and minimum sell price instead of
+                // storing orders which would be culled anyway.
+                float max_buy = 0.0f;
+                float min_sell = 0.0f;
+                bool buy_seen = false;
+                bool sell_seen = false;
+                for (unsigned ix = item_begin; ix < item_end; ix++)
+                {
+                    float price = orders[ix].price();
+                    if (orders[ix].order_type() == order_type_t::BUY)
+                    {
+                        if (!buy_seen || max_buy < price)
+                            max_buy = price;
+                        buy_seen = true;
+                    } else {
+                        if (!sell_seen || price < min_sell)
+                            min_sell = price;
+                        sell_seen = true;
+                    }
+                }
+                
+                cur_item.reserve(buy_seen ? 1 : 0, sell_seen ? 1 : 0);
+                if (buy_seen)
+                    cur_item.new_buy_order(max_buy);
+                if (sell_seen)
+                    cur_item.new_sell_order(min_sell);
+                    
+            } else {
+                cur_item.reserve(num_buy_orders, num_sell_orders);
+                for (unsigned ix = item_begin; ix < item_end; ix++)
+                {
+                    if (orders[ix].order_type() == order_type_t::BUY)
+                        cur_item.new_buy_order(orders[ix].price());
+                    else
+                        cur_item.new_sell_order(orders[ix].price());
+                }
+            }
+            cur_station.add_new_item_market(std::move(cur_item));
+            num_items_kept++;
+            
+            item_begin = item_end;
+            
         }
         
+        this->stations_.emplace(station_id, std::move(cur_station));
+        station_begin = station_end;
         
     }
     
+    if (stats != nullptr)
+    {
+        stats->increment(stats_t::counter_t::STATIONS_AGGREGATED, this->stations_.size());
+        stats->increment(stats_t::counter_t::ITEMS_AGGREGATED, num_items_kept);
+        stats->increment(stats_t::counter_t::ARENA_BYTES, this->arena_->bytes_reserved());
+    }
+    
 }
 
 void regional_market_t::cull_by_station(const std::unordered_set<uint64_t>& stations_to_keep)
@@ -60,7 +322,7 @@ void regional_market_t::cull_by_station(const std::unordered_set<uint64_t>& stat
     
     // Build a list of stations to remove from this market
     std::unordered_set<uint64_t> stations_to_cull;
-    for (std::pair<uint64_t, station_market_t> cur_node : this->stations_)
+    for (const std::pair<const uint64_t, station_market_t>& cur_node : this->stations_)
     {
         uint64_t cur_station_id = cur_node.first;
         if (stations_to_keep.count(cur_station_id) == 0)
@@ -70,7 +332,7 @@ void regional_market_t::cull_by_station(const std::unordered_set<uint64_t>& stat
     // Remove all unwanted stations from the market
     for (uint64_t cur_station_to_kill : stations_to_cull)
         this->stations_.erase(cur_station_to_kill);
-    
+        
 }
 
 
@@ -130,14 +392,16 @@ void regional_market_t::read_from_json_json(const Json::Value& json_root)
     if (!json_stations.isArray())
         throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <regional_market>/stations was not found or not of type \"array\".\n");
     
-    // Decode each station market in the stations array
-    this->stations_.clear();
+    // Decode each station market in the stations array.  The size of the
+    // arena is not known up front, so it grows in chunks.
+    this->reset_arena(arena_t::default_chunk_size);
     this->stations_.reserve(json_stations.size());
     for (const Json::Value& json_cur_station : json_stations)
     {
-        station_market_t cur_station_market;
+        station_market_t cur_station_market(this->arena_.get());
         cur_station_market.read_from_json_json(json_cur_station);
-        this->stations_.emplace(cur_station_market.station_id(), cur_station_market);
+        uint64_t station_id = cur_station_market.station_id();
+        this->stations_.emplace(station_id, std::move(cur_station_market));
     }
     
 }
@@ -180,7 +444,7 @@ void regional_market_t::write_to_json_buffer(std::string& buffer, unsigned inden
         buffer += indent_2;
         unsigned num_stations_processed = 0;
         unsigned last_station_to_process = num_stations - 1;
-        for (const std::pair<uint64_t, station_market_t>& cur_pair : this->stations_)
+        for (const std::pair<const uint64_t, station_market_t>& cur_pair : this->stations_)
         {
             
             const station_market_t& cur_station_market = cur_pair.second;
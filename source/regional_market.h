@@ -9,10 +9,16 @@
 #define HEADER_GUARD_REGIONAL_MARKET
 
 #include <fstream>
+#include <memory>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include "arena.h"
 #include "error.h"
+#include "ingest_filter.h"
+#include "raw_order.h"
 #include "station_market.h"
 #include "json.h"
 
@@ -24,34 +30,73 @@ class regional_market_t
         
     public:
         
+        /// @brief Stations in this region, allocated from @ref arena_ when
+        /// there is one.
+        typedef std::unordered_map
+        <
+            uint64_t,
+            station_market_t,
+            std::hash<uint64_t>,
+            std::equal_to<uint64_t>,
+            arena_allocator_t< std::pair<const uint64_t, station_market_t> >
+        > station_map_t;
+        
         /// @brief Default constructor
         inline regional_market_t() = default;
         
+        /// @brief Copies are allocated on the heap and never share the arena
+        /// of the source.
+        inline regional_market_t(const regional_market_t& source)
+          : region_id_(source.region_id_),
+            stations_(source.stations_)
+        {
+            // All work done in initializer list
+        }
+        
+        inline regional_market_t(regional_market_t&& source) = default;
+        
         // Add member initialization constructors here
         // Try to use initializer lists when possible.
         
         // Add operators here if desired.
         
+        inline regional_market_t& operator=(const regional_market_t& source)
+        {
+            if (this != &source)
+                *this = regional_market_t(source);
+            return *this;
+        }
+        
+        /// @brief The old stations are destroyed before the old arena they
+        /// live in.
+        inline regional_market_t& operator=(regional_market_t&& source)
+        {
+            this->region_id_ = source.region_id_;
+            this->stations_ = std::move(source.stations_);
+            this->arena_ = std::move(source.arena_);
+            return *this;
+        }
+        
         /// @brief Iterator to the first element in this container.
-        inline std::unordered_map<uint64_t, station_market_t>::const_iterator begin() const
+        inline station_map_t::const_iterator begin() const
         {
             return this->stations_.begin();
         }
         
         /// @brief Iterator to the first element in this container.
-        inline std::unordered_map<uint64_t, station_market_t>::iterator begin()
+        inline station_map_t::iterator begin()
         {
             return this->stations_.begin();
         }
         
         /// @brief Iterator one past the end of this container
-        inline std::unordered_map<uint64_t, station_market_t>::const_iterator end() const
+        inline station_map_t::const_iterator end() const
         {
             return this->stations_.end();
         }
         
         /// @brief Iterator one past the end of this container
-        inline std::unordered_map<uint64_t, station_market_t>::iterator end()
+        inline station_map_t::iterator end()
         {
             return this->stations_.end();
         }
@@ -70,16 +115,23 @@ class regional_market_t
             this->region_id_ = new_region_id;
         }
         
-        const std::unordered_map<uint64_t, station_market_t>& stations() const
+        const station_map_t& stations() const
         {
             return this->stations_;
         }
         
+        /// @brief Arena which stations, items and orders are allocated from,
+        /// or null if they are on the heap.
+        inline const arena_t* arena() const
+        {
+            return this->arena_.get();
+        }
+        
         // Add special-purpose functions here
         
         inline void clear()
         {
-            this->stations_.clear();
+            this->reset_arena(0);
         }
         
         inline void add_new_station_market(const station_market_t& new_station_market)
@@ -93,12 +145,26 @@ class regional_market_t
         /// to the empty market.
         inline station_market_t& find_or_allocate(uint64_t station_id)
         {
-            return this->stations_[station_id];
+            return this->stations_.try_emplace(station_id, this->stations_.get_allocator().arena()).first->second;
+        }
+        
+        /// @brief Remove the market of a station, if there is one.
+        inline void erase_station_market(uint64_t station_id)
+        {
+            this->stations_.erase(station_id);
         }
         
         /// @brief Clear previous content and sort raw orders from a region into
         /// the corresponding @ref station_market_t "station" and
         /// @ref item_market_t "item" markets.
+        ///
+        /// The orders are counted first so that every station, item and
+        /// price list is usually allocated from a single arena, sized from
+        /// an estimate of the node and bucket overheads.  The
+        /// @ref raw_regional_market_t::ingest_filter "ingest filter" of the
+        /// raw market is applied while aggregating.  If it honours order ranges,
+        /// buy orders placed elsewhere also count as buy orders at each of
+        /// its range targets they can be filled at.
         void initialize_from_raw_regional_market(const raw_regional_market_t& raw_regional_market);
         
         /// @brief Remove all market data that is not at one of the stations
@@ -199,15 +265,40 @@ class regional_market_t
         
         // Try to make your members protected, even if they don't have to be.
         
+        /// @brief Destroy all stations, then replace @ref arena_ with a new
+        /// arena.  If initial_capacity is zero, no arena is created and new
+        /// stations go on the heap.
+        void reset_arena(size_t initial_capacity);
+        
+        /// @brief Append a copy of each buy order placed elsewhere at every
+        /// range target of ingest_filter which can fill it, as if it had been
+        /// placed there.  When culling orders, only the best order reaching
+        /// each target is copied.
+        ///
+        /// @exception error_message_t
+        static void add_ranged_buy_orders
+        (
+            const ingest_filter_t& ingest_filter,
+            uint64_t region_id,
+            std::vector<raw_order_t>& orders
+        );
+        
         /// @brief The integral uniquifier for this region, as used by the EvE
         /// Swagger API.
         uint64_t region_id_;
         
+        /// @brief Backing memory for @ref stations_ and everything inside it.
+        /// Declared before @ref stations_ so that it is destroyed after it.
+        ///
+        /// Held by pointer so that moving a regional market doesn't invalidate
+        /// the allocators inside @ref stations_.
+        std::unique_ptr<arena_t> arena_;
+        
         /// @brief All of the stations with a market hub in this region are
         /// listed here.
         ///
         /// Each station ID is replicated as a dictionary key for fast lookup.
-        std::unordered_map<uint64_t, station_market_t> stations_;
+        station_map_t stations_;
         
 };
 
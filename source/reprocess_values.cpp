@@ -0,0 +1,278 @@
+/// @file reprocess_values.cpp
+/// @brief Implementation of @ref reprocess_values_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "error.h"
+#include "galactic_market.h"
+#include "item_market.h"
+#include "item_quantity.h"
+#include "regional_market.h"
+#include "reprocess_values.h"
+#include "reprocessing.h"
+#include "sparse_matrix.h"
+#include "station_market.h"
+#include "task_scheduler.h"
+
+/// @brief Stations multiplied at once.  Enough to fill the widest SIMD
+/// registers, while a block of results for every type still fits in cache.
+static constexpr unsigned stations_per_block = 16;
+
+void reprocess_values_t::initialize_from_market
+(
+    const reprocessing_t& reprocessing,
+    const galactic_market_t& galactic_market,
+    double yield
+){
+    
+    this->stations_.clear();
+    
+    // One row per type and one column per material.  Materials rounded down
+    // to nothing are left out, so a material without a price can't turn
+    // 0 * infinity into NaN.
+    sparse_matrix_t matrix;
+    std::unordered_map<uint64_t, unsigned> type_rows;
+    std::vector<uint64_t> material_items;
+    std::unordered_map<uint64_t, unsigned> material_columns;
+    type_rows.reserve(reprocessing.types().size());
+    for (const std::pair<const uint64_t, reprocessing_t::type_t>& cur_type : reprocessing.types())
+    {
+        for (const item_quantity_t& cur_material : cur_type.second.materials.materials_list())
+        {
+            // The epsilon keeps yields like 0.29 * 100 from rounding down to 28
+            uint64_t quantity = uint64_t(std::floor(double(cur_material.quantity()) * yield + 1e-9));
+            if (quantity == 0)
+                continue;
+            std::pair<std::unordered_map<uint64_t, unsigned>::iterator, bool> column = material_columns.try_emplace(cur_material.item_id(), material_items.size());
+            if (column.second)
+                material_items.push_back(cur_material.item_id());
+            matrix.append(column.first->second, float(double(quantity) / cur_type.second.portion_size));
+        }
+        type_rows.emplace(cur_type.first, matrix.num_rows());
+        matrix.finish_row();
+    }
+    unsigned num_materials = material_items.size();
+    
+    // Stations in a fixed order, so the output doesn't depend on hashing
+    std::vector<const station_market_t*> station_markets;
+    for (const std::pair<const uint64_t, regional_market_t>& cur_regional_market : galactic_market)
+    {
+        for (const std::pair<const uint64_t, station_market_t>& cur_station_market : cur_regional_market.second)
+            station_markets.push_back(&cur_station_market.second);
+    }
+    std::sort
+    (
+        station_markets.begin(),
+        station_markets.end(),
+        [](const station_market_t* lhs, const station_market_t* rhs) -> bool
+        {
+            return lhs->station_id() < rhs->station_id();
+        }
+    );
+    unsigned num_stations = station_markets.size();
+    this->stations_.resize(num_stations);
+    
+    unsigned num_blocks = (num_stations + stations_per_block - 1) / stations_per_block;
+    task_scheduler_t::instance().parallel_for
+    (
+        num_blocks,
+        1,
+        [&](unsigned block_ix)
+        {
+            
+            unsigned first_station = block_ix * stations_per_block;
+            unsigned block_size = std::min(stations_per_block, num_stations - first_station);
+            
+            // Material prices of each station, interleaved by station
+            std::vector<float> prices(std::size_t(num_materials) * block_size);
+            for (unsigned station_ix = 0; station_ix < block_size; station_ix++)
+            {
+                const station_market_t& station_market = *station_markets[first_station + station_ix];
+                for (unsigned column = 0; column < num_materials; column++)
+                {
+                    station_market_t::item_map_t::const_iterator found = station_market.items().find(material_items[column]);
+                    if (found == station_market.items().end() || found->second.sell_orders().empty())
+                        prices[std::size_t(column) * block_size + station_ix] = std::numeric_limits<float>::infinity();
+                    else
+                        prices[std::size_t(column) * block_size + station_ix] = found->second.min_sell_order();
+                }
+            }
+            
+            std::vector<float> values;
+            matrix.multiply(prices, block_size, values);
+            
+            // Only items traded at a station are compared
+            for (unsigned station_ix = 0; station_ix < block_size; station_ix++)
+            {
+                
+                const station_market_t& station_market = *station_markets[first_station + station_ix];
+                station_values_t& station_values = this->stations_[first_station + station_ix];
+                station_values.station_id = station_market.station_id();
+                
+                for (const std::pair<const uint64_t, item_market_t>& cur_item : station_market.items())
+                {
+                    
+                    std::unordered_map<uint64_t, unsigned>::const_iterator row = type_rows.find(cur_item.first);
+                    if (row == type_rows.end())
+                        continue;
+                    float reprocess_value = values[std::size_t(row->second) * block_size + station_ix];
+                    if (!std::isfinite(reprocess_value))
+                        continue;
+                    
+                    item_value_t item_value;
+                    item_value.item_id = cur_item.first;
+                    item_value.reprocess_value = reprocess_value;
+                    item_value.min_sell_order = cur_item.second.sell_orders().empty() ? std::numeric_limits<float>::quiet_NaN() : cur_item.second.min_sell_order();
+                    item_value.max_buy_order = cur_item.second.buy_orders().empty() ? std::numeric_limits<float>::quiet_NaN() : cur_item.second.max_buy_order();
+                    item_value.margin = cur_item.second.buy_orders().empty() ? reprocess_value : reprocess_value - item_value.max_buy_order;
+                    station_values.items.push_back(item_value);
+                    
+                }
+                
+                std::sort
+                (
+                    station_values.items.begin(),
+                    station_values.items.end(),
+                    [](const item_value_t& lhs, const item_value_t& rhs) -> bool
+                    {
+                        if (lhs.margin != rhs.margin)
+                            return lhs.margin > rhs.margin;
+                        return lhs.item_id < rhs.item_id;
+                    }
+                );
+                
+            }
+            
+        }
+    );
+    
+}
+
+void reprocess_values_t::write_to_json_file
+(
+    std::ostream& file,
+    const std::unordered_map<uint64_t, std::string_view>& item_names,
+    unsigned indent_start,
+    unsigned spaces_per_tab
+) const {
+    std::string buffer;
+    this->write_to_json_buffer(buffer, item_names, indent_start, spaces_per_tab);
+    file << buffer;
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when encoding reprocess_values_t object.\n");
+}
+
+void reprocess_values_t::write_to_json_buffer
+(
+    std::string& buffer,
+    const std::unordered_map<uint64_t, std::string_view>& item_names,
+    unsigned indent_start,
+    unsigned spaces_per_tab
+) const {
+    
+    std::string indent_3(indent_start + 3 * spaces_per_tab, ' ');
+    std::string_view indent_2(indent_3.data(), indent_start + 2 * spaces_per_tab);
+    std::string_view indent_1(indent_3.data(), indent_start + spaces_per_tab);
+    std::string_view indent_0(indent_3.data(), indent_start);
+    
+    // Prettify empty arrays.
+    if (this->stations_.empty())
+    {
+        buffer += "[]";
+        return;
+    }
+    
+    // It is recommended not to start a new line before the opening brace, to
+    // enable chaining.
+    buffer += "[\n";
+    buffer += indent_1;
+    
+    for (unsigned ix = 0, last_ix = this->stations_.size() - 1; ix <= last_ix; ix++)
+    {
+        
+        const station_values_t& cur_station = this->stations_[ix];
+        buffer += "{\n";
+        
+        // Encode station_id
+        buffer += indent_2;
+        buffer += "\"station_id\": ";
+        buffer += std::to_string(cur_station.station_id);
+        buffer += ",\n";
+        
+        // Encode items, one per line
+        buffer += indent_2;
+        buffer += "\"items\": ";
+        if (cur_station.items.empty())
+        {
+            buffer += "[]\n";
+        } else {
+            buffer += "[\n";
+            for (unsigned item_ix = 0, last_item_ix = cur_station.items.size() - 1; item_ix <= last_item_ix; item_ix++)
+            {
+                
+                const item_value_t& cur_item = cur_station.items[item_ix];
+                buffer += indent_3;
+                buffer += "{\"item_id\": ";
+                buffer += std::to_string(cur_item.item_id);
+                std::unordered_map<uint64_t, std::string_view>::const_iterator name_match = item_names.find(cur_item.item_id);
+                if (name_match != item_names.end())
+                {
+                    buffer += ", \"item_name\": \"";
+                    buffer += name_match->second;
+                    buffer += '\"';
+                }
+                buffer += ", \"reprocess_value\": ";
+                buffer += std::to_string(cur_item.reprocess_value);
+                if (!std::isnan(cur_item.min_sell_order))
+                {
+                    buffer += ", \"min_sell_order\": ";
+                    buffer += std::to_string(cur_item.min_sell_order);
+                }
+                if (!std::isnan(cur_item.max_buy_order))
+                {
+                    buffer += ", \"max_buy_order\": ";
+                    buffer += std::to_string(cur_item.max_buy_order);
+                }
+                buffer += ", \"margin\": ";
+                buffer += std::to_string(cur_item.margin);
+                buffer += '}';
+                
+                if (item_ix == last_item_ix)
+                    buffer += '\n';
+                else
+                    buffer += ",\n";
+                    
+            }
+            buffer += indent_2;
+            buffer += "]\n";
+        }
+        
+        buffer += indent_1;
+        if (ix == last_ix)
+            buffer += "}\n";
+        else
+            buffer += "}, ";
+            
+    }
+    
+    // It is recommended to not put a newline on the last brace to allow
+    // comma chaining when this object is an element of an array.
+    buffer += indent_0;
+    buffer += ']';
+    
+}
+
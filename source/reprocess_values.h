@@ -0,0 +1,136 @@
+/// @file reprocess_values.h
+/// @brief Declaration of @ref reprocess_values_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_REPROCESS_VALUES
+#define HEADER_GUARD_REPROCESS_VALUES
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "error.h"
+
+class galactic_market_t;
+class reprocessing_t;
+
+/// @brief What each item is worth reprocessed at each station, next to what
+/// it sells for as it is.
+///
+/// The materials of every item type are compiled into a sparse matrix with
+/// one row per type and one column per material, holding the units of each
+/// material recovered per unit of the type at a given yield.  The value of
+/// every type at a station is then that matrix times the station's material
+/// prices.  Stations are multiplied a block at a time, with their prices
+/// interleaved so that each element of the matrix is applied to the whole
+/// block with SIMD instructions, and blocks run on separate cores.
+class reprocess_values_t
+{
+        
+    public:
+        
+        /// @brief One item at one station.
+        struct item_value_t
+        {
+            uint64_t item_id;
+            /// @brief Materials recovered from one unit, valued at the
+            /// station's lowest sell orders.
+            float reprocess_value;
+            /// @brief NaN if there are no sell orders.
+            float min_sell_order;
+            /// @brief NaN if there are no buy orders.
+            float max_buy_order;
+            /// @brief ISK gained per unit by reprocessing rather than selling
+            /// into the highest buy order, which counts as 0 if there are no
+            /// buy orders.
+            float margin;
+        };
+        
+        /// @brief Every item with orders at a station which can be
+        /// reprocessed and whose materials all have a price there, best
+        /// margin first.
+        struct station_values_t
+        {
+            uint64_t station_id;
+            std::vector<item_value_t> items;
+        };
+        
+        /// @brief Default constructor
+        inline reprocess_values_t() = default;
+        
+        // Add member read and write functions
+        
+        /// @brief By station ID.  Only valid after
+        /// @ref initialize_from_market.
+        inline const std::vector<station_values_t>& stations() const
+        {
+            return this->stations_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Value every item of reprocessing at every station of
+        /// galactic_market, clearing previous content.
+        void initialize_from_market
+        (
+            const reprocessing_t& reprocessing,
+            const galactic_market_t& galactic_market,
+            /// [in] Fraction of each material recovered, between 0 and 1.
+            /// Recovered quantities are rounded down per portion, as the game
+            /// does.
+            double yield
+        );
+        
+        // Add encoders/decoders here
+        
+        /// @brief Serialize the content of this file into a file that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_file
+        (
+            /// [out] Stream to append serialized object content to.
+            std::ostream& file,
+            /// [in] Allows human readable names to be displayed with each
+            /// item.
+            const std::unordered_map<uint64_t, std::string_view>& item_names,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Serialize the content of this file into a string that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_buffer
+        (
+            /// [out] This string is overwritten with serialzed JSON content.
+            std::string& buffer,
+            /// [in] Allows human readable names to be displayed with each
+            /// item.
+            const std::unordered_map<uint64_t, std::string_view>& item_names,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+    protected:
+        
+        /// @brief See @ref stations.
+        std::vector<station_values_t> stations_;
+        
+};
+
+#endif // Header Guard
+
@@ -0,0 +1,180 @@
+/// @file reprocessing.cpp
+/// @brief Implementation of @ref reprocessing_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "error.h"
+#include "item_quantities.h"
+#include "item_quantity.h"
+#include "json.h"
+#include "reprocessing.h"
+
+void reprocessing_t::read_from_json_file(std::istream& file)
+{
+    
+    // Get the number of characters in the input file.
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_SIZE_FAILED, "Error.  Failed to determine file size when decoding reprocessing_t object.\n");
+    file.seekg(0, std::ios_base::end);
+    unsigned file_size = file.tellg();
+    file.seekg(0, std::ios_base::beg);
+    
+    // Read the entire file into RAM at once
+    std::string buffer(file_size, '\0');
+    file.read(buffer.data(), file_size);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_READ_FAILED, "Error.  Failed to read file when decoding reprocessing_t object.\n");
+    this->read_from_json_buffer(std::string_view(buffer));
+    
+}
+
+void reprocessing_t::read_from_json_buffer(std::string_view buffer)
+{
+    
+    Json::CharReaderBuilder builder;
+    Json::CharReader* reader = builder.newCharReader();
+    
+    Json::Value json_root;
+    std::string error_message;
+    bool success = reader->parse(buffer.begin(), buffer.end(), &json_root, &error_message);
+    delete reader;
+    if (!success)
+        Json::throwRuntimeError(error_message);
+    
+    // Now that the JSON syntax is parsed, extract the reprocessing specific
+    // data.
+    this->read_from_json_structure(json_root);
+    
+}
+
+void reprocessing_t::read_from_json_structure(const Json::Value& json_root)
+{
+    
+    // Parse root
+    if (!json_root.isArray())
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  Root of reprocessing is not of type \"array\".\n");
+    
+    // Clear previous content
+    this->types_.clear();
+    
+    for (const Json::Value& json_cur_type : json_root)
+    {
+        
+        if (!json_cur_type.isObject())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <reprocessing>/<type> is not of type \"object\".\n");
+        
+        const Json::Value& json_item_id = json_cur_type["item_id"];
+        if (!json_item_id.isUInt64())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <reprocessing>/<type>/item_id was not found or not of type \"unsigned integer\".\n");
+        
+        // Parse optional portion_size
+        unsigned portion_size = 1;
+        const Json::Value& json_portion_size = json_cur_type["portion_size"];
+        if (!json_portion_size.isNull())
+        {
+            if (!json_portion_size.isUInt() || json_portion_size.asUInt() == 0)
+                throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <reprocessing>/<type>/portion_size was not a positive integer.\n");
+            portion_size = json_portion_size.asUInt();
+        }
+        
+        item_quantities_t materials;
+        materials.read_from_json_structure(json_cur_type["materials"]);
+        
+        this->add_type(json_item_id.asUInt64(), portion_size, materials);
+        
+    }
+    
+}
+
+void reprocessing_t::write_to_json_file(std::ostream& file, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    std::string buffer;
+    this->write_to_json_buffer(buffer, indent_start, spaces_per_tab);
+    file << buffer;
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when encoding reprocessing_t object.\n");
+}
+
+void reprocessing_t::write_to_json_buffer(std::string& buffer, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    
+    std::string indent_1(indent_start + 1 * spaces_per_tab, ' ');
+    std::string_view indent_0(indent_1.data(), indent_start);
+    
+    // Prettify empty arrays.
+    if (this->types_.empty())
+    {
+        buffer += "[]";
+        return;
+    }
+    
+    // It is recommended not to start a new line before the opening brace, to
+    // enable chaining.
+    buffer += "[\n";
+    
+    // One type per line since there are thousands of them
+    unsigned ix = 0;
+    unsigned last_ix = this->types_.size() - 1;
+    for (const std::pair<const uint64_t, type_t>& cur_type : this->types_)
+    {
+        
+        buffer += indent_1;
+        buffer += "{\"item_id\": ";
+        buffer += std::to_string(cur_type.first);
+        if (cur_type.second.portion_size != 1)
+        {
+            buffer += ", \"portion_size\": ";
+            buffer += std::to_string(cur_type.second.portion_size);
+        }
+        buffer += ", \"materials\": [";
+        const std::vector<item_quantity_t>& cur_materials = cur_type.second.materials.materials_list();
+        for (unsigned material_ix = 0, num_materials = cur_materials.size(); material_ix < num_materials; material_ix++)
+        {
+            if (material_ix != 0)
+                buffer += ", ";
+            buffer += "{\"item_id\": ";
+            buffer += std::to_string(cur_materials[material_ix].item_id());
+            buffer += ", \"quantity\": ";
+            buffer += std::to_string(cur_materials[material_ix].quantity());
+            buffer += '}';
+        }
+        buffer += "]}";
+        
+        if (ix == last_ix)
+            buffer += '\n';
+        else
+            buffer += ",\n";
+        ix++;
+        
+    }
+    
+    // It is recommended to not put a newline on the last brace to allow
+    // comma chaining when this object is an element of an array.
+    buffer += indent_0;
+    buffer += ']';
+    
+}
+
+std::istream& operator>>(std::istream& stream, reprocessing_t& destination)
+{
+    try
+    {
+        destination.read_from_json_file(stream);
+    } catch (const error_message_t& error) {
+        stream.setstate(std::ios::failbit);
+        throw error;
+    } catch (const Json::Exception& error) {
+        stream.setstate(std::ios::failbit);
+        throw error;
+    }
+    return stream;
+}
+
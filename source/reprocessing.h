@@ -0,0 +1,130 @@
+/// @file reprocessing.h
+/// @brief Declaration of @ref reprocessing_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_REPROCESSING
+#define HEADER_GUARD_REPROCESSING
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "error.h"
+#include "item_quantities.h"
+#include "json.h"
+
+/// @brief The materials each item reprocesses into, normally converted from
+/// CCP's static data export by blueprint_converter --ccp-materials-in.
+class reprocessing_t
+{
+        
+    public:
+        
+        /// @brief What one item type reprocesses into.
+        struct type_t
+        {
+            /// @brief Units reprocessed at a time.  @ref materials are for
+            /// this many units.
+            unsigned portion_size;
+            /// @brief Materials recovered from one portion at 100% yield.
+            item_quantities_t materials;
+        };
+        
+        /// @brief Default constructor
+        inline reprocessing_t() = default;
+        
+        // Add member read and write functions
+        
+        /// @brief Every item type which can be reprocessed, by item ID.
+        inline const std::map<uint64_t, type_t>& types() const
+        {
+            return this->types_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Add an item type, replacing it if it was already added.
+        inline void add_type(uint64_t item_id, unsigned portion_size, const item_quantities_t& materials)
+        {
+            type_t& type = this->types_[item_id];
+            type.portion_size = portion_size;
+            type.materials = materials;
+        }
+        
+        // Add encoders/decoders here
+        
+        /// @brief Open a file conforming to data/json/schema.json and use it
+        /// to initialize this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        /// @exception Json::Exception
+        void read_from_json_file(std::istream& file);
+        
+        /// @brief Decode serialized content conforming to
+        /// data/json/schema.json and use it to initialize this object,
+        /// clearing previous content.
+        ///
+        /// @exception error_message_t
+        /// @exception Json::Exception
+        void read_from_json_buffer(std::string_view buffer);
+        
+        /// @brief Extract required data fields from a pre-parsed JSON tree
+        /// and use them to initialize this object, clearing previous content.
+        ///
+        /// @exception error_message_t
+        void read_from_json_structure(const Json::Value& json_root);
+        
+        /// @brief Serialize the content of this file into a file that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_file
+        (
+            /// [out] Stream to append serialized object content to.
+            std::ostream& file,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Serialize the content of this file into a string that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_buffer
+        (
+            /// [out] This string is overwritten with serialzed JSON content.
+            std::string& buffer,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+    protected:
+        
+        /// @brief See @ref types.
+        std::map<uint64_t, type_t> types_;
+        
+};
+
+/// @brief Extraction operator for decoding.
+std::istream& operator>>(std::istream& stream, reprocessing_t& destination);
+
+/// @brief Convenience alias to allow printing directly via cout or similar.
+inline std::ostream& operator<<(std::ostream& stream, const reprocessing_t& source)
+{
+    source.write_to_json_file(stream);
+    return stream;
+}
+
+#endif // Header Guard
+
@@ -0,0 +1,94 @@
+/// @file sparse_matrix.cpp
+/// @brief Implementation of @ref sparse_matrix_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <cstddef>
+#include <vector>
+
+#include "sparse_matrix.h"
+
+void sparse_matrix_t::multiply(const std::vector<float>& vector, std::vector<float>& result) const
+{
+    
+    unsigned num_rows = this->num_rows();
+    result.resize(num_rows);
+    
+    const unsigned* row_offsets = this->row_offsets_.data();
+    const unsigned* columns = this->columns_.data();
+    const float* values = this->values_.data();
+    const float* x = vector.data();
+    float* y = result.data();
+    
+    for (unsigned row = 0; row < num_rows; row++)
+    {
+        float accumulator = 0.0f;
+        for (unsigned ix = row_offsets[row], end = row_offsets[row + 1]; ix < end; ix++)
+            accumulator += values[ix] * x[columns[ix]];
+        y[row] = accumulator;
+    }
+    
+}
+
+void sparse_matrix_t::multiply(const std::vector<float>& vectors, unsigned num_vectors, std::vector<float>& results) const
+{
+    
+    unsigned num_rows = this->num_rows();
+    results.assign(std::size_t(num_rows) * num_vectors, 0.0f);
+    
+    const unsigned* row_offsets = this->row_offsets_.data();
+    const unsigned* columns = this->columns_.data();
+    const float* values = this->values_.data();
+    const float* x = vectors.data();
+    float* y = results.data();
+    
+    for (unsigned row = 0; row < num_rows; row++)
+    {
+        float* y_row = y + std::size_t(row) * num_vectors;
+        for (unsigned ix = row_offsets[row], end = row_offsets[row + 1]; ix < end; ix++)
+        {
+            float value = values[ix];
+            const float* x_row = x + std::size_t(columns[ix]) * num_vectors;
+            #pragma omp simd
+            for (unsigned vector = 0; vector < num_vectors; vector++)
+                y_row[vector] += value * x_row[vector];
+        }
+    }
+    
+}
+
+sparse_matrix_t sparse_matrix_t::transpose() const
+{
+    
+    unsigned num_rows = this->num_rows();
+    unsigned num_nonzeros = this->num_nonzeros();
+    
+    sparse_matrix_t ret;
+    ret.num_columns_ = num_rows;
+    
+    // Count the elements of each column, then turn the counts into offsets
+    ret.row_offsets_.assign(this->num_columns_ + 1, 0);
+    for (unsigned column : this->columns_)
+        ret.row_offsets_[column + 1]++;
+    for (unsigned column = 0; column < this->num_columns_; column++)
+        ret.row_offsets_[column + 1] += ret.row_offsets_[column];
+    
+    // Visiting rows in order leaves each row of the result sorted
+    ret.columns_.resize(num_nonzeros);
+    ret.values_.resize(num_nonzeros);
+    std::vector<unsigned> next(ret.row_offsets_.begin(), ret.row_offsets_.end() - 1);
+    for (unsigned row = 0; row < num_rows; row++)
+    {
+        for (unsigned ix = this->row_offsets_[row], end = this->row_offsets_[row + 1]; ix < end; ix++)
+        {
+            unsigned destination = next[this->columns_[ix]]++;
+            ret.columns_[destination] = row;
+            ret.values_[destination] = this->values_[ix];
+        }
+    }
+    
+    return ret;
+    
+}
@@ -0,0 +1,148 @@
+/// @file sparse_matrix.h
+/// @brief Declaration of @ref sparse_matrix_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_SPARSE_MATRIX
+#define HEADER_GUARD_SPARSE_MATRIX
+
+#include <vector>
+
+/// @brief Matrix of floats in compressed sparse row format, built one row at
+/// a time.
+///
+/// Elements of a row are kept in the order they were appended, so that
+/// @ref multiply sums them in that order.  Columns may repeat within a row.
+class sparse_matrix_t
+{
+        
+    public:
+        
+        /// @brief Default constructor
+        inline sparse_matrix_t()
+          : row_offsets_(1, 0),
+            num_columns_(0)
+        {
+            // All work done in initializer list
+        }
+        
+        // Add member read and write functions
+        
+        inline unsigned num_rows() const
+        {
+            return this->row_offsets_.size() - 1;
+        }
+        
+        /// @brief One more than the largest column appended so far.
+        inline unsigned num_columns() const
+        {
+            return this->num_columns_;
+        }
+        
+        inline unsigned num_nonzeros() const
+        {
+            return this->values_.size();
+        }
+        
+        /// @brief Index into @ref columns and @ref values of the first
+        /// element of each row, followed by @ref num_nonzeros.
+        inline const std::vector<unsigned>& row_offsets() const
+        {
+            return this->row_offsets_;
+        }
+        
+        inline const std::vector<unsigned>& columns() const
+        {
+            return this->columns_;
+        }
+        
+        inline const std::vector<float>& values() const
+        {
+            return this->values_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Remove every row.
+        inline void clear()
+        {
+            this->row_offsets_.assign(1, 0);
+            this->columns_.clear();
+            this->values_.clear();
+            this->num_columns_ = 0;
+        }
+        
+        /// @brief Add an element to the row under construction.
+        inline void append(unsigned column, float value)
+        {
+            this->columns_.push_back(column);
+            this->values_.push_back(value);
+            if (column >= this->num_columns_)
+                this->num_columns_ = column + 1;
+        }
+        
+        /// @brief Close the row under construction and start the next one.
+        inline void finish_row()
+        {
+            this->row_offsets_.push_back(this->values_.size());
+        }
+        
+        /// @brief Calculate result = this * vector.
+        void multiply
+        (
+            /// [in] Must have at least @ref num_columns elements.
+            const std::vector<float>& vector,
+            /// [out] Resized to @ref num_rows elements.
+            std::vector<float>& result
+        ) const;
+        
+        /// @brief Same as above for many vectors at once, stored
+        /// interleaved so that element column of vector v is at
+        /// column * num_vectors + v.  The innermost loop runs across the
+        /// vectors, so one element of this matrix is applied to all of them
+        /// with SIMD instructions.
+        void multiply
+        (
+            /// [in] Must have at least @ref num_columns * num_vectors
+            /// elements.
+            const std::vector<float>& vectors,
+            unsigned num_vectors,
+            /// [out] Resized to @ref num_rows * num_vectors elements,
+            /// interleaved the same way.
+            std::vector<float>& results
+        ) const;
+        
+        /// @brief Dot product of one row with vector.
+        inline float multiply_row(unsigned row, const std::vector<float>& vector) const
+        {
+            float accumulator = 0.0f;
+            for (unsigned ix = this->row_offsets_[row], end = this->row_offsets_[row + 1]; ix < end; ix++)
+                accumulator += this->values_[ix] * vector[this->columns_[ix]];
+            return accumulator;
+        }
+        
+        /// @brief The transpose, so that the elements of a column of this
+        /// matrix are the elements of a row of the result.  Elements of each
+        /// row of the result are sorted by column.
+        sparse_matrix_t transpose() const;
+        
+    protected:
+        
+        /// @brief See @ref row_offsets.
+        std::vector<unsigned> row_offsets_;
+        
+        /// @brief See @ref columns.
+        std::vector<unsigned> columns_;
+        
+        /// @brief See @ref values.
+        std::vector<float> values_;
+        
+        /// @brief See @ref num_columns.
+        unsigned num_columns_;
+        
+};
+
+#endif // Header Guard
+
@@ -8,6 +8,7 @@
 #include <fstream>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include "item_market.h"
 #include "station_market.h"
@@ -75,9 +76,9 @@ void station_market_t::read_from_json_json(const Json::Value& json_root)
     this->items_.reserve(json_items.size());
     for (const Json::Value& json_cur_item : json_items)
     {
-        item_market_t cur_item_market;
+        item_market_t cur_item_market(this->arena());
         cur_item_market.read_from_json_json(json_cur_item);
-        this->items_.emplace(cur_item_market.item_id(), cur_item_market);
+        this->add_new_item_market(std::move(cur_item_market));
     }
     
 }
@@ -120,7 +121,7 @@ void station_market_t::write_to_json_buffer(std::string& buffer, unsigned indent
         buffer += indent_2;
         unsigned num_items_processed = 0;
         unsigned last_item_to_process = num_items - 1;
-        for (const std::pair<uint64_t, item_market_t>& cur_pair : this->items_)
+        for (const std::pair<const uint64_t, item_market_t>& cur_pair : this->items_)
         {
             
             const item_market_t& cur_item_market = cur_pair.second;
@@ -12,6 +12,7 @@
 #include <string_view>
 #include <unordered_map>
 
+#include "arena.h"
 #include "error.h"
 #include "item_market.h"
 #include "json.h"
@@ -22,34 +23,53 @@ class station_market_t
         
     public:
         
+        /// @brief Items at this station, allocated from the @ref arena_t of
+        /// the owning @ref regional_market_t when there is one.
+        typedef std::unordered_map
+        <
+            uint64_t,
+            item_market_t,
+            std::hash<uint64_t>,
+            std::equal_to<uint64_t>,
+            arena_allocator_t< std::pair<const uint64_t, item_market_t> >
+        > item_map_t;
+        
         /// @brief Default constructor
         inline station_market_t() = default;
         
         // Add member initialization constructors here
         // Try to use initializer lists when possible.
         
+        /// @brief Allocate items and their prices from an arena.  A null arena
+        /// uses the heap.
+        inline station_market_t(arena_t* arena)
+          : items_(item_map_t::allocator_type(arena))
+        {
+            // All work done in initializer list
+        }
+        
         // Add operators here if desired.
         
         /// @brief Iterator to the first element in this container.
-        inline std::unordered_map<uint64_t, item_market_t>::const_iterator begin() const
+        inline item_map_t::const_iterator begin() const
         {
             return this->items_.begin();
         }
         
         /// @brief Iterator to the first element in this container.
-        inline std::unordered_map<uint64_t, item_market_t>::iterator begin()
+        inline item_map_t::iterator begin()
         {
             return this->items_.begin();
         }
         
         /// @brief Iterator one past the end of this container
-        inline std::unordered_map<uint64_t, item_market_t>::const_iterator end() const
+        inline item_map_t::const_iterator end() const
         {
             return this->items_.end();
         }
         
         /// @brief Iterator one past the end of this container
-        inline std::unordered_map<uint64_t, item_market_t>::iterator end()
+        inline item_map_t::iterator end()
         {
             return this->items_.end();
         }
@@ -68,7 +88,7 @@ class station_market_t
             this->station_id_ = new_station_id;
         }
         
-        const std::unordered_map<uint64_t, item_market_t>& items() const
+        const item_map_t& items() const
         {
             return this->items_;
         }
@@ -91,7 +111,32 @@ class station_market_t
         /// to the empty market.
         inline item_market_t& find_or_allocate(uint64_t item_id)
         {
-            return this->items_[item_id];
+            return this->items_.try_emplace(item_id, this->arena()).first->second;
+        }
+        
+        /// @brief Remove the market of an item, if there is one.
+        inline void erase_item_market(uint64_t item_id)
+        {
+            this->items_.erase(item_id);
+        }
+        
+        /// @brief Arena which items are allocated from, or null for the heap.
+        inline arena_t* arena() const
+        {
+            return this->items_.get_allocator().arena();
+        }
+        
+        /// @brief Pre-size the hash table for this many items.
+        inline void reserve(unsigned num_items)
+        {
+            this->items_.reserve(num_items);
+        }
+        
+        /// @brief Take ownership of an item market without copying its orders.
+        inline void add_new_item_market(item_market_t&& new_item_market)
+        {
+            uint64_t item_id = new_item_market.item_id();
+            this->items_.emplace(item_id, std::move(new_item_market));
         }
         
         /// @brief Remove all orders that are not the minimum sell order for each
@@ -196,7 +241,7 @@ class station_market_t
         /// for these items.
         ///
         /// Each item ID is replicated as a dictionary key for fast lookup.
-        std::unordered_map<uint64_t, item_market_t> items_;
+        item_map_t items_;
         
 };
 
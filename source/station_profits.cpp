@@ -5,12 +5,14 @@
 /// * Date Created = Thursday November 16 2017
 /// * Documentation is generated by doxygen, see html/index.html
 
+#include <cmath>
 #include <fstream>
 #include <limits>
 #include <map>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "blueprints.h"
@@ -18,16 +20,58 @@
 #include "error.h"
 #include "json.h"
 #include "manufacturability.h"
+#include "profit_matrix.h"
 #include "station_market.h"
 #include "station_profits.h"
+#include "stats.h"
+#include "trace.h"
+#include "util.h"
+
+/// @brief Replace best with candidate if candidate is more profitable.  A
+/// candidate which could not be priced has no meaningful profit, so it is only
+/// kept if no candidate could be, the same choice as
+/// @ref price_sensitivity_t::best_row.
+static void keep_best
+(
+    blueprint_profit_t& candidate,
+    blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy,
+    /// [in] True for the first candidate of a blueprint.
+    bool first,
+    float& best_profit_amount,
+    blueprint_profit_t& best
+){
+    
+    if (!candidate.manufacturability().is_ok())
+    {
+        if (first)
+            best = std::move(candidate);
+        return;
+    }
+    
+    float candidate_profit_amount = candidate.profit(decryptor_optimization_strategy);
+    if (first || !best.manufacturability().is_ok() || candidate_profit_amount >= best_profit_amount)
+    {
+        best_profit_amount = candidate_profit_amount;
+        best = std::move(candidate);
+    }
+    
+}
 
 void station_profits_t::calculate_blueprint_profits
 (
     const blueprints_t& blueprints_in,
     const station_market_t& station_market,
-    blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy
+    blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy,
+    const best_price_index_t* best_prices,
+    const build_tree_t::item_costs_t* build_costs,
+    unsigned runs_per_job,
+    const industry_profile_t::modifiers_t& modifiers
 ){
     
+    stats_t* stats = this->debug_mode_.stats();
+    stats_t::scoped_timer_t timer(stats, stats_t::stage_t::PROFIT);
+    trace_t::scoped_span_t span(this->debug_mode_.trace(), "station_profits", "profit", station_market.station_id());
+    
     // Clear previous content
     this->blueprint_profits_.clear();
     this->blueprint_profits_.reserve(blueprints_in.storage().size());
@@ -54,36 +98,21 @@ void station_profits_t::calculate_blueprint_profits
                 
                 blueprint_profit_t candidate_blueprint_profit;
                 try {
-                    candidate_blueprint_profit.initialize_from_market(cur_blueprint.second, blueprints_in, station_market, cur_decryptor);
+                    candidate_blueprint_profit.initialize_from_market(cur_blueprint.second, blueprints_in, station_market, cur_decryptor, best_prices, build_costs, runs_per_job, modifiers);
                 } catch (const error_message_t& error) {
                     // Lack of market data will be written as a warning in the output JSON
                     if (error.error_code() != error_code_t::NO_ORDERS)
                         throw error;
                 }
-                
-                // Calculate profit using desired metric
-                float candidate_profit_amount;
-                switch (decryptor_optimization_strategy)
+                if (stats != nullptr)
                 {
-                    case blueprint_profit_t::sort_strategy_t::PROFIT_AMOUNT:
-                        candidate_profit_amount = candidate_blueprint_profit.profit_amount();
-                        break;
-                    case blueprint_profit_t::sort_strategy_t::PROFIT_PERCENT:
-                        candidate_profit_amount = candidate_blueprint_profit.profit_percent();
-                        break;
-                    case blueprint_profit_t::sort_strategy_t::PROFIT_PER_SECOND:
-                        candidate_profit_amount = candidate_blueprint_profit.profit_per_second();
-                        break;
-                    default:
-                        throw error_message_t(error_code_t::UNKNOWN_SORT_STRATEGY, "Error.  Encountered unknown enum for sort_strategy_t while writing station_profits_t.\n");
+                    stats->increment(stats_t::counter_t::BLUEPRINT_EVALUATIONS);
+                    if (candidate_blueprint_profit.manufacturability().status() == manufacturability_t::status_t::MISSING_MARKET_DATA)
+                        stats->increment(stats_t::counter_t::NO_ORDERS_MISSES);
                 }
                 
                 // If this decryptor yields a better profit, set it as the current best decryptor
-                if (candidate_profit_amount >= best_profit_amount)
-                {
-                    best_profit_amount = candidate_profit_amount;
-                    best_blueprint_profit = candidate_blueprint_profit;
-                }
+                keep_best(candidate_blueprint_profit, decryptor_optimization_strategy, cur_decryptor == decryptor_t::type_t(0), best_profit_amount, best_blueprint_profit);
                 
             }
             
@@ -91,12 +120,94 @@ void station_profits_t::calculate_blueprint_profits
             
             // If this is a T1 blueprint, don't use a decryptor
             try {
-                best_blueprint_profit.initialize_from_market(cur_blueprint.second, blueprints_in, station_market, decryptor_t::type_t::NO_DECRYPTOR);
+                best_blueprint_profit.initialize_from_market(cur_blueprint.second, blueprints_in, station_market, decryptor_t::type_t::NO_DECRYPTOR, best_prices, build_costs, runs_per_job, modifiers);
             } catch (const error_message_t& error) {
                 // Lack of market data will be written as a warning in the output JSON
                 if (error.error_code() != error_code_t::NO_ORDERS)
                     throw error;
             }
+            if (stats != nullptr)
+            {
+                stats->increment(stats_t::counter_t::BLUEPRINT_EVALUATIONS);
+                if (best_blueprint_profit.manufacturability().status() == manufacturability_t::status_t::MISSING_MARKET_DATA)
+                    stats->increment(stats_t::counter_t::NO_ORDERS_MISSES);
+            }
+            
+        }
+        
+        this->blueprint_profits_.emplace_back(std::move(best_blueprint_profit));
+        
+    }
+    
+}
+
+void station_profits_t::calculate_blueprint_profits
+(
+    const profit_matrix_t& profit_matrix,
+    const blueprints_t& blueprints_in,
+    const station_market_t& station_market,
+    blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy,
+    const best_price_index_t* best_prices
+){
+    
+    stats_t* stats = this->debug_mode_.stats();
+    stats_t::scoped_timer_t timer(stats, stats_t::stage_t::PROFIT);
+    trace_t::scoped_span_t span(this->debug_mode_.trace(), "station_profits", "profit", station_market.station_id());
+    
+    // Clear previous content
+    this->blueprint_profits_.clear();
+    this->blueprint_profits_.reserve(blueprints_in.storage().size());
+    
+    this->station_id_ = station_market.station_id();
+    
+    // Every row at once
+    std::vector<float> total_costs;
+    std::vector<float> output_values;
+    profit_matrix.evaluate(station_market, best_prices, total_costs, output_values);
+    
+    const std::vector<profit_matrix_t::row_t>& rows = profit_matrix.rows();
+    const std::vector<unsigned>& blueprint_offsets = profit_matrix.blueprint_offsets();
+    for (unsigned blueprint_ix = 0, num_blueprints = blueprint_offsets.size() - 1; blueprint_ix < num_blueprints; blueprint_ix++)
+    {
+        
+        float best_profit_amount = -1 * std::numeric_limits<float>::infinity();
+        blueprint_profit_t best_blueprint_profit;
+        
+        unsigned first_row = blueprint_offsets[blueprint_ix];
+        unsigned last_row = blueprint_offsets[blueprint_ix + 1];
+        for (unsigned row_ix = first_row; row_ix < last_row; row_ix++)
+        {
+            
+            // Rows the matrix couldn't price are redone the slow way, which
+            // also explains what is missing
+            const profit_matrix_t::row_t& row = rows[row_ix];
+            blueprint_profit_t candidate_blueprint_profit;
+            if (std::isfinite(total_costs[row_ix]) && std::isfinite(output_values[row_ix]))
+            {
+                candidate_blueprint_profit.initialize_from_totals(row.blueprint_id, row.decryptor, row.job, total_costs[row_ix], output_values[row_ix]);
+            } else {
+                try {
+                    candidate_blueprint_profit.initialize_from_market(blueprints_in.storage().at(row.blueprint_id), blueprints_in, station_market, row.decryptor, best_prices, nullptr, profit_matrix.runs_per_job(), profit_matrix.modifiers());
+                } catch (const error_message_t& error) {
+                    // Lack of market data will be written as a warning in the output JSON
+                    if (error.error_code() != error_code_t::NO_ORDERS)
+                        throw error;
+                }
+            }
+            if (stats != nullptr)
+            {
+                stats->increment(stats_t::counter_t::BLUEPRINT_EVALUATIONS);
+                if (candidate_blueprint_profit.manufacturability().status() == manufacturability_t::status_t::MISSING_MARKET_DATA)
+                    stats->increment(stats_t::counter_t::NO_ORDERS_MISSES);
+            }
+            
+            // T1 blueprints have a single row and don't need to compare
+            if (last_row - first_row == 1)
+            {
+                best_blueprint_profit = std::move(candidate_blueprint_profit);
+                break;
+            }
+            keep_best(candidate_blueprint_profit, decryptor_optimization_strategy, row_ix == first_row, best_profit_amount, best_blueprint_profit);
             
         }
         
@@ -157,6 +268,17 @@ void station_profits_t::read_from_json_structure(const Json::Value& json_root)
         throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <station_profits>/station_id was not found or not of type \"unsigned int\".\n");
     this->station_id_ = json_station_id.asUInt64();
     
+    // Parse optional profile
+    const Json::Value& json_profile = json_root["profile"];
+    if (json_profile.isNull())
+    {
+        this->profile_.clear();
+    } else if (json_profile.isString()) {
+        this->profile_ = json_profile.asString();
+    } else {
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <station_profits>/profile was not of type \"string\".\n");
+    }
+    
     // Parse profits array
     const Json::Value& json_profits = json_root["profits"];
     if (!json_profits.isArray())
@@ -213,6 +335,15 @@ void station_profits_t::write_to_json_buffer
     buffer += std::to_string(this->station_id_);
     buffer += ",\n";
     
+    // Encode profile, only if one was used
+    if (!this->profile_.empty())
+    {
+        buffer += indent_1;
+        buffer += "\"profile\": \"";
+        buffer += escape_quotes(this->profile_);
+        buffer += "\",\n";
+    }
+    
     // Encode profits array
     buffer += indent_1;
     buffer += "\"profits\": ";
@@ -9,13 +9,17 @@
 #define HEADER_GUARD_STATION_PROFITS
 
 #include <fstream>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
 
 #include "blueprint_profit.h"
+#include "debug_mode.h"
 #include "error.h"
+#include "industry_profile.h"
 #include "json.h"
+#include "profit_matrix.h"
 
 class blueprints_t;
 
@@ -33,7 +37,7 @@ class station_profits_t
         // Try to use initializer lists when possible.
         
         // Add operators here if desired.
-
+        
         // Add member read and write functions
         
         inline uint64_t station_id() const
@@ -41,11 +45,33 @@ class station_profits_t
             return this->station_id_;
         }
         
+        /// @brief Name of the @ref industry_profile_t these profits were
+        /// calculated for, or empty if no profile was used.
+        inline const std::string& profile() const
+        {
+            return this->profile_;
+        }
+        
+        inline void profile(std::string_view new_profile)
+        {
+            this->profile_ = new_profile;
+        }
+        
         inline const std::vector<blueprint_profit_t>& blueprint_profits() const
         {
             return this->blueprint_profits_;
         }
         
+        inline const debug_mode_t& debug_mode() const
+        {
+            return this->debug_mode_;
+        }
+        
+        inline void debug_mode(const debug_mode_t& new_debug_mode)
+        {
+            this->debug_mode_ = new_debug_mode;
+        }
+        
         // Add special-purpose functions here
         
         /// @brief Calculate the input cost and output value for each blueprint
@@ -54,7 +80,29 @@ class station_profits_t
         (
             const blueprints_t& blueprints_in,
             const station_market_t& station_market,
-            blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy
+            blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy,
+            /// See @ref blueprint_profit_t::initialize_from_market
+            const best_price_index_t* best_prices = nullptr,
+            /// See @ref blueprint_profit_t::initialize_from_market.  Must have
+            /// been resolved for station_market.
+            const build_tree_t::item_costs_t* build_costs = nullptr,
+            /// See @ref blueprint_profit_t::initialize_from_market
+            unsigned runs_per_job = 1,
+            /// See @ref blueprint_profit_t::initialize_from_market
+            const industry_profile_t::modifiers_t& modifiers = industry_profile_t::no_modifiers
+        );
+        
+        /// @brief Same as above, but every blueprint is evaluated at once
+        /// from a compiled @ref profit_matrix_t.  The results are the same.
+        void calculate_blueprint_profits
+        (
+            /// [in] Must have been compiled from blueprints_in.
+            const profit_matrix_t& profit_matrix,
+            const blueprints_t& blueprints_in,
+            const station_market_t& station_market,
+            blueprint_profit_t::sort_strategy_t decryptor_optimization_strategy,
+            /// See @ref blueprint_profit_t::initialize_from_market
+            const best_price_index_t* best_prices = nullptr
         );
         
         // Add encoders/decoders here
@@ -139,9 +187,15 @@ class station_profits_t
         /// each blueprint profit in @ref blueprint_profits_.
         uint64_t station_id_;
         
+        /// @brief See @ref profile.
+        std::string profile_;
+        
         /// @brief Set of all the station_profits owned by a player.
         std::vector<blueprint_profit_t> blueprint_profits_;
         
+        /// @brief Controls verbose printing and statistics collection
+        debug_mode_t debug_mode_;
+        
 };
 
 /// @brief Convenience alias to allow printing directly via cout or similar.
@@ -0,0 +1,177 @@
+/// @file stats.cpp
+/// @brief Implementation of @ref stats_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "error.h"
+#include "stats.h"
+
+const std::vector<std::string_view> stats_t::counter_names_ =
+{
+    "pages_fetched",
+    "bytes_received",
+    "fetch_failures",
+    "orders_decoded",
+    "orders_culled",
+    "stations_aggregated",
+    "items_aggregated",
+    "arena_bytes",
+    "blueprint_evaluations",
+    "no_orders_misses",
+    "output_bytes"
+};
+
+const std::vector<std::string_view> stats_t::stage_names_ =
+{
+    "fetch",
+    "parse",
+    "decode",
+    "aggregate",
+    "cull",
+    "read",
+    "profit",
+    "write"
+};
+
+/// @brief Read one of the POSIX CPU clocks in nanoseconds.
+static uint64_t clock_ns(clockid_t clock)
+{
+    timespec now;
+    if (clock_gettime(clock, &now) != 0)
+        return 0;
+    return uint64_t(now.tv_sec) * 1000000000ull + uint64_t(now.tv_nsec);
+}
+
+/// @brief Nanoseconds to seconds, for printing.
+static std::string ns_to_seconds_string(uint64_t ns)
+{
+    return std::to_string(double(ns) / 1.0e9);
+}
+
+stats_t::stats_t()
+{
+    this->clear();
+}
+
+void stats_t::clear()
+{
+    
+    for (std::atomic<uint64_t>& cur_counter : this->counters_)
+        cur_counter = 0;
+    
+    for (unsigned ix = 0; ix < unsigned(stage_t::NUM_ENUMS); ix++)
+    {
+        this->calls_[ix] = 0;
+        this->wall_ns_[ix] = 0;
+        this->cpu_ns_[ix] = 0;
+    }
+    
+    this->wall_start_ = std::chrono::steady_clock::now();
+    this->process_cpu_start_ = clock_ns(CLOCK_PROCESS_CPUTIME_ID);
+    
+}
+
+uint64_t stats_t::thread_cpu_ns()
+{
+    return clock_ns(CLOCK_THREAD_CPUTIME_ID);
+}
+
+void stats_t::write_to_json_file(std::ostream& file, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    file << this->write_to_json_buffer(indent_start, spaces_per_tab);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when encoding stats_t object.\n");
+}
+
+void stats_t::write_to_json_buffer(std::string& buffer, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    
+    std::string indent_3(indent_start + 3 * spaces_per_tab, ' ');
+    std::string_view indent_2(indent_3.data(), indent_start + 2 * spaces_per_tab);
+    std::string_view indent_1(indent_3.data(), indent_start + spaces_per_tab);
+    std::string_view indent_0(indent_3.data(), indent_start);
+    
+    uint64_t total_wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->wall_start_).count();
+    uint64_t total_cpu_ns = clock_ns(CLOCK_PROCESS_CPUTIME_ID) - this->process_cpu_start_;
+    
+    // It is recommended not to start a new line before the opening brace, to
+    // enable chaining.
+    buffer += "{\n";
+    
+    // Encode wall_seconds
+    buffer += indent_1;
+    buffer += "\"wall_seconds\": ";
+    buffer += ns_to_seconds_string(total_wall_ns);
+    buffer += ",\n";
+    
+    // Encode cpu_seconds
+    buffer += indent_1;
+    buffer += "\"cpu_seconds\": ";
+    buffer += ns_to_seconds_string(total_cpu_ns);
+    buffer += ",\n";
+    
+    // Encode counters
+    buffer += indent_1;
+    buffer += "\"counters\": {\n";
+    for (unsigned ix = 0, last_ix = unsigned(counter_t::NUM_ENUMS) - 1; ix <= last_ix; ix++)
+    {
+        buffer += indent_2;
+        buffer += '\"';
+        buffer += stats_t::counter_names_[ix];
+        buffer += "\": ";
+        buffer += std::to_string(this->counters_[ix].load(std::memory_order_relaxed));
+        buffer += ix == last_ix ? "\n" : ",\n";
+    }
+    buffer += indent_1;
+    buffer += "},\n";
+    
+    // Encode stages
+    buffer += indent_1;
+    buffer += "\"stages\": {\n";
+    for (unsigned ix = 0, last_ix = unsigned(stage_t::NUM_ENUMS) - 1; ix <= last_ix; ix++)
+    {
+        
+        buffer += indent_2;
+        buffer += '\"';
+        buffer += stats_t::stage_names_[ix];
+        buffer += "\": {\n";
+        
+        buffer += indent_3;
+        buffer += "\"calls\": ";
+        buffer += std::to_string(this->calls_[ix].load(std::memory_order_relaxed));
+        buffer += ",\n";
+        
+        buffer += indent_3;
+        buffer += "\"wall_seconds\": ";
+        buffer += ns_to_seconds_string(this->wall_ns_[ix].load(std::memory_order_relaxed));
+        buffer += ",\n";
+        
+        buffer += indent_3;
+        buffer += "\"cpu_seconds\": ";
+        buffer += ns_to_seconds_string(this->cpu_ns_[ix].load(std::memory_order_relaxed));
+        buffer += '\n';
+        
+        buffer += indent_2;
+        buffer += ix == last_ix ? "}\n" : "},\n";
+        
+    }
+    buffer += indent_1;
+    buffer += "}\n";
+    
+    // It is recommended to not put a newline on the last brace to allow
+    // comma chaining when this object is an element of an array.
+    buffer += indent_0;
+    buffer += '}';
+    
+}
+
@@ -0,0 +1,306 @@
+/// @file stats.h
+/// @brief Declaration of @ref stats_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_STATS
+#define HEADER_GUARD_STATS
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+#include "error.h"
+
+/// @brief Counters and per-stage timers which are accumulated while the
+/// program runs and dumped to the file named by --stats-out at exit.
+///
+/// All counters are atomic and may be incremented from any thread.  A pointer
+/// to one of these objects is carried around by @ref debug_mode_t and is null
+/// when statistics were not requested, in which case instrumented code only
+/// pays for a pointer comparison.
+class stats_t
+{
+        
+    public:
+        
+        /// @brief Things which can be counted.
+        enum class counter_t
+        {
+            /// Number of pages successfully downloaded from the EvE API.
+            PAGES_FETCHED,
+            /// Number of payload bytes downloaded from the EvE API.
+            BYTES_RECEIVED,
+            /// Number of HTTPS requests which failed.
+            FETCH_FAILURES,
+            /// Number of individual market orders decoded from payloads.
+            ORDERS_DECODED,
+            /// Number of decoded orders dropped by an @ref ingest_filter_t.
+            ORDERS_CULLED,
+            /// Number of @ref station_market_t objects produced from raw orders.
+            STATIONS_AGGREGATED,
+            /// Number of @ref item_market_t objects produced from raw orders.
+            ITEMS_AGGREGATED,
+            /// Number of bytes reserved by the arenas of aggregated regions.
+            ARENA_BYTES,
+            /// Number of calls to @ref blueprint_profit_t::initialize_from_market.
+            BLUEPRINT_EVALUATIONS,
+            /// Number of blueprint evaluations which lacked market data.
+            NO_ORDERS_MISSES,
+            /// Number of bytes written to output files.
+            OUTPUT_BYTES,
+            /// This must be last
+            NUM_ENUMS
+        };
+        
+        /// @brief Phases of program execution which are timed.
+        enum class stage_t
+        {
+            /// Waiting on HTTPS requests
+            FETCH,
+            /// Parsing JSON syntax of downloaded pages
+            PARSE,
+            /// Extracting market orders from parsed pages
+            DECODE,
+            /// Sorting raw orders into station and item markets
+            AGGREGATE,
+            /// Removing unwanted stations and orders
+            CULL,
+            /// Reading and decoding input files
+            READ,
+            /// Calculating blueprint profits
+            PROFIT,
+            /// Encoding and writing output files
+            WRITE,
+            /// This must be last
+            NUM_ENUMS
+        };
+        
+        /// @brief Records the wall and CPU time between construction and
+        /// destruction and adds them to a @ref stats_t stage.  Does nothing
+        /// if the stats pointer is null.
+        class scoped_timer_t
+        {
+                
+            public:
+                
+                inline scoped_timer_t(stats_t* stats, stage_t stage)
+                  : stats_(stats),
+                    stage_(stage)
+                {
+                    if (stats != nullptr)
+                    {
+                        this->wall_start_ = std::chrono::steady_clock::now();
+                        this->cpu_start_ = stats_t::thread_cpu_ns();
+                    }
+                }
+                
+                inline ~scoped_timer_t()
+                {
+                    if (this->stats_ != nullptr)
+                    {
+                        uint64_t wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->wall_start_).count();
+                        uint64_t cpu_ns = stats_t::thread_cpu_ns() - this->cpu_start_;
+                        this->stats_->add_time(this->stage_, wall_ns, cpu_ns);
+                    }
+                }
+                
+                scoped_timer_t(const scoped_timer_t&) = delete;
+                scoped_timer_t& operator=(const scoped_timer_t&) = delete;
+                
+            protected:
+                
+                /// @brief Destination of the measurement, or null when disabled.
+                stats_t* stats_;
+                
+                /// @brief Stage to accumulate the measured time into.
+                stage_t stage_;
+                
+                /// @brief Time at construction.
+                std::chrono::steady_clock::time_point wall_start_;
+                
+                /// @brief CPU time consumed by the constructing thread at
+                /// construction.
+                uint64_t cpu_start_;
+                
+        };
+        
+        /// @brief Default constructor.  All counters start at zero and the
+        /// total wall clock starts now.
+        stats_t();
+        
+        // Add member initialization constructors here
+        // Try to use initializer lists when possible.
+        
+        // Add operators here if desired.
+        
+        // Add member read and write functions
+        
+        inline uint64_t counter(counter_t counter) const
+        {
+            return this->counters_[unsigned(counter)].load(std::memory_order_relaxed);
+        }
+        
+        inline uint64_t calls(stage_t stage) const
+        {
+            return this->calls_[unsigned(stage)].load(std::memory_order_relaxed);
+        }
+        
+        inline uint64_t wall_ns(stage_t stage) const
+        {
+            return this->wall_ns_[unsigned(stage)].load(std::memory_order_relaxed);
+        }
+        
+        inline uint64_t cpu_ns(stage_t stage) const
+        {
+            return this->cpu_ns_[unsigned(stage)].load(std::memory_order_relaxed);
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Make counters human readable.
+        inline static std::string_view enum_to_string(counter_t counter)
+        {
+            return stats_t::counter_names_[unsigned(counter)];
+        }
+        
+        /// @brief Make stages human readable.
+        inline static std::string_view enum_to_string(stage_t stage)
+        {
+            return stats_t::stage_names_[unsigned(stage)];
+        }
+        
+        /// @brief Atomically add amount to a counter.  Safe to call from any
+        /// thread.
+        inline void increment(counter_t counter, uint64_t amount = 1)
+        {
+            this->counters_[unsigned(counter)].fetch_add(amount, std::memory_order_relaxed);
+        }
+        
+        /// @brief Atomically add one measurement to a stage.  Safe to call
+        /// from any thread.  Times from concurrent threads are summed, so the
+        /// wall time of a stage may exceed the wall time of the program.
+        inline void add_time(stage_t stage, uint64_t wall_ns, uint64_t cpu_ns)
+        {
+            this->calls_[unsigned(stage)].fetch_add(1, std::memory_order_relaxed);
+            this->wall_ns_[unsigned(stage)].fetch_add(wall_ns, std::memory_order_relaxed);
+            this->cpu_ns_[unsigned(stage)].fetch_add(cpu_ns, std::memory_order_relaxed);
+        }
+        
+        /// @brief Reset all counters and timers to zero and restart the total
+        /// wall clock.
+        void clear();
+        
+        /// @brief CPU time consumed by the calling thread in nanoseconds.
+        static uint64_t thread_cpu_ns();
+        
+        /// @brief Serialize the content of this file into a file that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_file
+        (
+            /// [out] Stream to append serialized object content to.
+            std::ostream& file,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            ///
+            /// Indentation typically increases after each opening bracket '['
+            /// or brace '{' and decreases after each closing bracket ']' or
+            /// brace '}'.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Serialize the content of this file into a string that
+        /// conforms to the schema data/json/schema.json.
+        ///
+        /// @exception error_message_t
+        void write_to_json_buffer
+        (
+            /// [out] This string is overwritten with serialzed JSON content.
+            std::string& buffer,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            ///
+            /// Indentation typically increases after each opening bracket '['
+            /// or brace '{' and decreases after each closing bracket ']' or
+            /// brace '}'.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Convinence method for pretty initialize-on-construction
+        /// syntax.
+        inline std::string write_to_json_buffer
+        (
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            ///
+            /// Indentation typically increases after each opening bracket '['
+            /// or brace '{' and decreases after each closing bracket ']' or
+            /// brace '}'.
+            unsigned spaces_per_tab = 4
+        ) const {
+            std::string buffer;
+            this->write_to_json_buffer(buffer, indent_start, spaces_per_tab);
+            return buffer;
+        }
+        
+    protected:
+        
+        // Try to make your members protected, even if they don't have to be.
+        
+        /// @brief String representations of @ref counter_t symbols, as they
+        /// appear in the serialized output.
+        static const std::vector<std::string_view> counter_names_;
+        
+        /// @brief String representations of @ref stage_t symbols, as they
+        /// appear in the serialized output.
+        static const std::vector<std::string_view> stage_names_;
+        
+        /// @brief Current value of each @ref counter_t.
+        std::atomic<uint64_t> counters_[unsigned(counter_t::NUM_ENUMS)];
+        
+        /// @brief Number of measurements added to each @ref stage_t.
+        std::atomic<uint64_t> calls_[unsigned(stage_t::NUM_ENUMS)];
+        
+        /// @brief Sum of the wall time of all measurements of each
+        /// @ref stage_t in nanoseconds.
+        std::atomic<uint64_t> wall_ns_[unsigned(stage_t::NUM_ENUMS)];
+        
+        /// @brief Sum of the CPU time of all measurements of each
+        /// @ref stage_t in nanoseconds.
+        std::atomic<uint64_t> cpu_ns_[unsigned(stage_t::NUM_ENUMS)];
+        
+        /// @brief Time at which this object was constructed or cleared.
+        std::chrono::steady_clock::time_point wall_start_;
+        
+        /// @brief CPU time consumed by the whole process when this object
+        /// was constructed or cleared.
+        uint64_t process_cpu_start_;
+        
+};
+
+/// @brief Convenience alias to allow printing directly via cout or similar.
+inline std::ostream& operator<<(std::ostream& stream, const stats_t& source)
+{
+    source.write_to_json_file(stream);
+    return stream;
+}
+
+#endif // Header Guard
+
@@ -0,0 +1,342 @@
+/// @file task_scheduler.cpp
+/// @brief Implementation of @ref task_scheduler_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "task_scheduler.h"
+
+/// @brief Index of the calling thread within its pool, or 0 outside of the
+/// scheduler.
+static thread_local unsigned current_worker_ix = 0;
+
+/// @brief Pool of the calling thread, or null outside of the scheduler.
+static thread_local const void* current_pool = nullptr;
+
+task_scheduler_t::task_group_t::~task_group_t()
+{
+    std::unique_lock<std::mutex> lock(this->lock_);
+    this->condition_.wait(lock, [this]{ return this->num_unfinished_ == 0; });
+}
+
+void task_scheduler_t::task_group_t::wait()
+{
+    
+    // A worker which just blocked could be holding up the very tasks it is
+    // waiting for, so it runs them itself first.
+    if (current_pool != nullptr)
+        task_scheduler_t::instance().help(*this);
+    
+    std::unique_lock<std::mutex> lock(this->lock_);
+    this->condition_.wait(lock, [this]{ return this->num_unfinished_ == 0; });
+    
+    // Only report the failure once
+    if (this->exception_ != nullptr)
+    {
+        std::exception_ptr exception = this->exception_;
+        this->exception_ = nullptr;
+        std::rethrow_exception(exception);
+    }
+    
+}
+
+task_scheduler_t::task_scheduler_t(unsigned num_threads)
+{
+    
+    for (unsigned pool_ix = 0; pool_ix < num_pools; pool_ix++)
+    {
+        pool_state_t& pool = this->pools_[pool_ix];
+        pool.num_queued = 0;
+        pool.stopping = false;
+        pool.next_queue = 0;
+        for (unsigned worker_ix = 0; worker_ix < num_threads; worker_ix++)
+            pool.queues.emplace_back(new worker_queue_t);
+    }
+    
+    // Queues must all exist before any worker tries to steal from them
+    for (unsigned pool_ix = 0; pool_ix < num_pools; pool_ix++)
+    {
+        for (unsigned worker_ix = 0; worker_ix < num_threads; worker_ix++)
+            this->pools_[pool_ix].workers.emplace_back(&task_scheduler_t::worker_function, this, pool_t(pool_ix), worker_ix);
+    }
+    
+}
+
+task_scheduler_t::~task_scheduler_t()
+{
+    
+    for (pool_state_t& cur_pool : this->pools_)
+    {
+        std::lock_guard<std::mutex> lock(cur_pool.sleep_lock);
+        cur_pool.stopping = true;
+        cur_pool.sleep_condition.notify_all();
+    }
+    
+    for (pool_state_t& cur_pool : this->pools_)
+    {
+        for (std::thread& cur_worker : cur_pool.workers)
+            cur_worker.join();
+    }
+    
+}
+
+task_scheduler_t& task_scheduler_t::instance()
+{
+    static task_scheduler_t scheduler(std::max(std::thread::hardware_concurrency(), 1u));
+    return scheduler;
+}
+
+unsigned task_scheduler_t::current_worker()
+{
+    return current_worker_ix;
+}
+
+task_scheduler_t::task_handle_t task_scheduler_t::submit
+(
+    task_group_t& group,
+    pool_t pool,
+    std::function<void()> function,
+    const std::vector<task_handle_t>& dependencies
+){
+    
+    task_handle_t task(new task_t);
+    task->function = std::move(function);
+    task->pool = pool;
+    task->group = &group;
+    task->finished = false;
+    
+    {
+        std::lock_guard<std::mutex> lock(group.lock_);
+        group.num_unfinished_++;
+    }
+    
+    // Hold one extra reference while registering so that dependencies
+    // finishing in the meantime can't queue the task early.
+    task->num_pending_dependencies = 1;
+    for (const task_handle_t& cur_dependency : dependencies)
+    {
+        std::lock_guard<std::mutex> lock(cur_dependency->lock);
+        if (!cur_dependency->finished)
+        {
+            task->num_pending_dependencies++;
+            cur_dependency->dependents.push_back(task);
+        }
+    }
+    if (--task->num_pending_dependencies == 0)
+        this->enqueue(task);
+    
+    return task;
+    
+}
+
+void task_scheduler_t::parallel_for(unsigned num_items, unsigned grain, const std::function<void(unsigned)>& function)
+{
+    
+    task_group_t group;
+    grain = std::max(grain, 1u);
+    for (unsigned first_ix = 0; first_ix < num_items; first_ix += grain)
+    {
+        unsigned last_ix = std::min(first_ix + grain, num_items);
+        this->submit
+        (
+            group,
+            pool_t::CPU,
+            [&function, &group, first_ix, last_ix]
+            {
+                for (unsigned ix = first_ix; ix < last_ix && !group.cancelled(); ix++)
+                    function(ix);
+            }
+        );
+    }
+    group.wait();
+    
+}
+
+void task_scheduler_t::enqueue(const task_handle_t& task)
+{
+    
+    pool_state_t& pool = this->pools_[unsigned(task->pool)];
+    
+    // Count the task before it becomes visible so that a worker which takes
+    // it straight away never sees the count go negative.
+    {
+        std::lock_guard<std::mutex> lock(pool.sleep_lock);
+        pool.num_queued++;
+    }
+    
+    // Workers keep their own follow-up work local, which is usually still
+    // warm in cache.  Everything else is spread round-robin.
+    unsigned queue_ix;
+    if (current_pool == &pool)
+        queue_ix = current_worker_ix;
+    else
+        queue_ix = pool.next_queue++ % pool.queues.size();
+    
+    worker_queue_t& queue = *pool.queues[queue_ix];
+    {
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.tasks.push_back(task);
+    }
+    
+    pool.sleep_condition.notify_one();
+    
+}
+
+task_scheduler_t::task_handle_t task_scheduler_t::take(pool_state_t& pool, unsigned worker_ix, const task_group_t* group)
+{
+    
+    task_handle_t task;
+    unsigned num_queues = pool.queues.size();
+    auto in_group = [group](const task_handle_t& cur_task)
+    {
+        return group == nullptr || cur_task->group == group;
+    };
+    
+    // Newest first from our own queue, oldest first from everybody else's
+    for (unsigned offset = 0; offset < num_queues && task == nullptr; offset++)
+    {
+        worker_queue_t& queue = *pool.queues[(worker_ix + offset) % num_queues];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (offset == 0)
+        {
+            auto found = std::find_if(queue.tasks.rbegin(), queue.tasks.rend(), in_group);
+            if (found == queue.tasks.rend())
+                continue;
+            task = std::move(*found);
+            queue.tasks.erase(std::next(found).base());
+        } else {
+            auto found = std::find_if(queue.tasks.begin(), queue.tasks.end(), in_group);
+            if (found == queue.tasks.end())
+                continue;
+            task = std::move(*found);
+            queue.tasks.erase(found);
+        }
+    }
+    
+    if (task != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(pool.sleep_lock);
+        pool.num_queued--;
+    }
+    
+    return task;
+    
+}
+
+void task_scheduler_t::run(const task_handle_t& task)
+{
+    
+    task_group_t& group = *task->group;
+    
+    if (!group.cancelled())
+    {
+        try
+        {
+            task->function();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(group.lock_);
+            if (group.exception_ == nullptr)
+                group.exception_ = std::current_exception();
+            group.cancel();
+        }
+    }
+    task->function = nullptr;
+    
+    // Release dependents before the group so that they are counted as
+    // unfinished while they are being queued.
+    std::vector<task_handle_t> dependents;
+    {
+        std::lock_guard<std::mutex> lock(task->lock);
+        task->finished = true;
+        dependents.swap(task->dependents);
+    }
+    for (const task_handle_t& cur_dependent : dependents)
+    {
+        if (--cur_dependent->num_pending_dependencies == 0)
+            this->enqueue(cur_dependent);
+    }
+    
+    // The group may be destroyed as soon as the count reaches 0, so notify
+    // while still holding its lock.
+    std::lock_guard<std::mutex> lock(group.lock_);
+    group.num_unfinished_--;
+    if (group.num_unfinished_ == 0)
+        group.condition_.notify_all();
+        
+}
+
+void task_scheduler_t::help(task_group_t& group)
+{
+    
+    for (pool_state_t& cur_pool : this->pools_)
+    {
+        
+        // Tasks of another pool would see the wrong current_worker, so those
+        // are left to that pool's own workers.
+        if (&cur_pool != current_pool)
+            continue;
+        
+        while (true)
+        {
+            
+            {
+                std::lock_guard<std::mutex> lock(group.lock_);
+                if (group.num_unfinished_ == 0)
+                    return;
+            }
+            
+            // Whatever is left is either running on another worker or
+            // waiting on a dependency, so blocking is now safe.
+            task_handle_t task = this->take(cur_pool, current_worker_ix, &group);
+            if (task == nullptr)
+                return;
+            this->run(task);
+            
+        }
+        
+    }
+    
+}
+
+void task_scheduler_t::worker_function(pool_t pool_ix, unsigned worker_ix)
+{
+    
+    pool_state_t& pool = this->pools_[unsigned(pool_ix)];
+    current_pool = &pool;
+    current_worker_ix = worker_ix;
+    
+    while (true)
+    {
+        
+        task_handle_t task = this->take(pool, worker_ix);
+        if (task != nullptr)
+        {
+            this->run(task);
+            continue;
+        }
+        
+        // A task may be counted but not pushed yet, in which case it is
+        // picked up on the next pass.
+        std::unique_lock<std::mutex> lock(pool.sleep_lock);
+        pool.sleep_condition.wait(lock, [&pool]{ return pool.num_queued != 0 || pool.stopping; });
+        if (pool.num_queued == 0)
+            return;
+            
+    }
+    
+}
+
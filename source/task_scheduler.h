@@ -0,0 +1,251 @@
+/// @file task_scheduler.h
+/// @brief Declaration of @ref task_scheduler_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_TASK_SCHEDULER
+#define HEADER_GUARD_TASK_SCHEDULER
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief One process-wide set of worker threads which every fetch, decode
+/// and aggregation stage submits its work to.
+///
+/// Workers are split into two pools so that threads blocked on the network
+/// never hold up CPU work and vice versa.  Each worker owns a queue, runs the
+/// newest task of its own queue first and steals the oldest task of another
+/// worker's queue when it runs dry.  A task may depend on other tasks, in
+/// which case it is only queued once they have all finished, so a decode can
+/// be submitted at the same time as the fetch it consumes.  Tasks belong to a
+/// @ref task_group_t which can be waited on and cancelled.
+///
+/// Workers are started the first time @ref instance is called, so modes which
+/// never submit anything don't pay for them.  Loops over blueprints, stations
+/// and the like use @ref parallel_for, and only SIMD kernels still use
+/// OpenMP.
+class task_scheduler_t
+{
+        
+    public:
+        
+        /// @brief Which set of workers a task runs on.
+        enum class pool_t
+        {
+            /// @brief Tasks which mostly wait on the network or disk.
+            IO,
+            /// @brief Tasks which keep a core busy, such as decoding.
+            CPU
+        };
+        
+        /// @brief Number of entries of @ref pool_t.
+        static constexpr unsigned num_pools = 2;
+        
+        /// @brief A batch of related tasks which is waited on and cancelled
+        /// as a whole.
+        ///
+        /// Cancellation is cooperative.  Tasks which haven't started yet are
+        /// skipped, while running tasks are expected to poll @ref cancelled
+        /// and return early.
+        class task_group_t
+        {
+                
+            public:
+                
+                /// @brief Default constructor
+                inline task_group_t()
+                  : num_unfinished_(0),
+                    cancelled_(false)
+                {
+                    // All work done in initializer list
+                }
+                
+                /// @brief Waits for every task of the group, discarding any
+                /// exception, since running tasks may still refer to it.
+                ~task_group_t();
+                
+                task_group_t(const task_group_t&) = delete;
+                task_group_t& operator=(const task_group_t&) = delete;
+                
+                // Add member read and write functions
+                
+                /// @brief True once @ref cancel was called or a task threw.
+                inline bool cancelled() const
+                {
+                    return this->cancelled_.load(std::memory_order_relaxed);
+                }
+                
+                // Add special-purpose functions here
+                
+                /// @brief Ask every task of the group to stop.  Safe to call
+                /// from any thread, including from inside a task.
+                inline void cancel()
+                {
+                    this->cancelled_.store(true, std::memory_order_relaxed);
+                }
+                
+                /// @brief Block until every task submitted to this group has
+                /// finished or been skipped.  When called from inside a task,
+                /// the worker runs this group's queued tasks of its own pool
+                /// while it waits, so nested waits can't starve the pool.
+                ///
+                /// @exception Rethrows the first exception which escaped a
+                /// task of this group.
+                void wait();
+                
+            protected:
+                
+                friend class task_scheduler_t;
+                
+                /// @brief Tasks submitted but not yet finished or skipped.
+                unsigned num_unfinished_;
+                
+                /// @brief See @ref cancelled.
+                std::atomic<bool> cancelled_;
+                
+                /// @brief First exception which escaped a task, or null.
+                std::exception_ptr exception_;
+                
+                /// @brief Guards @ref num_unfinished_ and @ref exception_.
+                std::mutex lock_;
+                
+                /// @brief Signalled when @ref num_unfinished_ reaches 0.
+                std::condition_variable condition_;
+                
+        };
+        
+        /// @brief Bookkeeping of one submitted task.
+        struct task_t
+        {
+            /// @brief Work to run.  Released once the task finishes.
+            std::function<void()> function;
+            /// @brief See @ref pool_t.
+            pool_t pool;
+            /// @brief Group the task was submitted to.
+            task_group_t* group;
+            /// @brief Dependencies which haven't finished yet.  The task is
+            /// queued when this reaches 0.
+            std::atomic<unsigned> num_pending_dependencies;
+            /// @brief True once the task has finished or been skipped.
+            bool finished;
+            /// @brief Tasks waiting for this one.
+            std::vector< std::shared_ptr<task_t> > dependents;
+            /// @brief Guards @ref finished and @ref dependents.
+            std::mutex lock;
+        };
+        
+        /// @brief Returned by @ref submit so that later tasks can depend on
+        /// it.
+        typedef std::shared_ptr<task_t> task_handle_t;
+        
+        /// @brief Stops and joins every worker.
+        ~task_scheduler_t();
+        
+        task_scheduler_t(const task_scheduler_t&) = delete;
+        task_scheduler_t& operator=(const task_scheduler_t&) = delete;
+        
+        /// @brief The scheduler shared by the whole process, starting its
+        /// workers on the first call.
+        static task_scheduler_t& instance();
+        
+        // Add member read and write functions
+        
+        /// @brief Number of worker threads in a pool.  Useful for sizing
+        /// per-worker scratch space indexed by @ref current_worker.
+        inline unsigned num_workers(pool_t pool) const
+        {
+            return this->pools_[unsigned(pool)].workers.size();
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Index of the calling worker within its pool, between 0 and
+        /// @ref num_workers - 1.  Only meaningful from inside a task.
+        static unsigned current_worker();
+        
+        /// @brief Queue function to run on pool once every dependency has
+        /// finished.  A dependency which was skipped or threw still counts as
+        /// finished, so tasks should check @ref task_group_t::cancelled if
+        /// they rely on the results of their dependencies.
+        task_handle_t submit
+        (
+            task_group_t& group,
+            pool_t pool,
+            std::function<void()> function,
+            const std::vector<task_handle_t>& dependencies = std::vector<task_handle_t>()
+        );
+        
+        /// @brief Call function once for each index below num_items on the
+        /// CPU pool and block until every call has returned.  Indices are
+        /// handed out in chunks of grain.  Scratch space which is reused
+        /// between calls can be indexed by @ref current_worker.  May be
+        /// called from inside a task, in which case the calling worker runs
+        /// chunks too.
+        ///
+        /// @exception Rethrows the first exception which escaped function.
+        void parallel_for(unsigned num_items, unsigned grain, const std::function<void(unsigned)>& function);
+        
+    protected:
+        
+        /// @brief Tasks queued on one worker.  Front is oldest.
+        struct worker_queue_t
+        {
+            std::deque<task_handle_t> tasks;
+            std::mutex lock;
+        };
+        
+        /// @brief The workers of one @ref pool_t.
+        struct pool_state_t
+        {
+            /// @brief One queue per worker.
+            std::vector< std::unique_ptr<worker_queue_t> > queues;
+            std::vector<std::thread> workers;
+            /// @brief Tasks pushed onto a queue but not yet taken.
+            unsigned num_queued;
+            /// @brief Round-robin queue for tasks submitted from outside the
+            /// pool.
+            std::atomic<unsigned> next_queue;
+            /// @brief Set by the destructor to make idle workers return.
+            bool stopping;
+            /// @brief Guards @ref num_queued and @ref stopping.
+            std::mutex sleep_lock;
+            /// @brief Wakes idle workers when tasks are queued.
+            std::condition_variable sleep_condition;
+        };
+        
+        /// @brief Start num_threads workers in each pool.
+        explicit task_scheduler_t(unsigned num_threads);
+        
+        /// @brief Push a task whose dependencies have all finished.
+        void enqueue(const task_handle_t& task);
+        
+        /// @brief Pop from the worker's own queue, else steal from another.
+        /// Only tasks of group are considered unless it is null.  Returns
+        /// null if no queue of the pool holds a matching task.
+        task_handle_t take(pool_state_t& pool, unsigned worker_ix, const task_group_t* group = nullptr);
+        
+        /// @brief Run queued tasks of group on the calling worker until none
+        /// are left to take.  Used by @ref task_group_t::wait.
+        void help(task_group_t& group);
+        
+        /// @brief Run or skip a task, then release its dependents.
+        void run(const task_handle_t& task);
+        
+        /// @brief Body of each worker thread.
+        void worker_function(pool_t pool, unsigned worker_ix);
+        
+        /// @brief Indexed by @ref pool_t.
+        pool_state_t pools_[num_pools];
+        
+};
+
+#endif // Header Guard
@@ -0,0 +1,218 @@
+/// @file trace.cpp
+/// @brief Implementation of @ref trace_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "error.h"
+#include "https_get.h"
+#include "trace.h"
+
+/// @brief Source of @ref trace_t::instance_id_.  Zero is never handed out so
+/// that it can mean "no trace" in the thread-local cache below.
+static std::atomic<uint64_t> next_instance_id(1);
+
+/// @brief The trace which the calling thread most recently recorded into.
+static thread_local uint64_t cached_instance_id = 0;
+
+/// @brief The calling thread's buffer within the trace named by
+/// @ref cached_instance_id.
+static thread_local void* cached_buffer = nullptr;
+
+/// @brief Nanoseconds to the fractional microseconds used by the Chrome
+/// Trace Event format.
+static std::string ns_to_microseconds_string(uint64_t ns)
+{
+    return std::to_string(double(ns) / 1.0e3);
+}
+
+trace_t::trace_t(unsigned events_per_thread)
+  : instance_id_(next_instance_id.fetch_add(1, std::memory_order_relaxed)),
+    start_(std::chrono::steady_clock::now()),
+    events_per_thread_(events_per_thread == 0 ? 1 : events_per_thread)
+{
+    // All work done in initializer list
+}
+
+trace_t::thread_buffer_t* trace_t::local_buffer()
+{
+    
+    // Fast path.  No locking once a thread has registered.
+    if (cached_instance_id == this->instance_id_)
+        return static_cast<thread_buffer_t*>(cached_buffer);
+    
+    // First event from this thread.  Events are allocated lazily so that idle
+    // threads don't cost a full ring.
+    std::unique_ptr<thread_buffer_t> new_buffer(new thread_buffer_t);
+    new_buffer->num_recorded = 0;
+    
+    thread_buffer_t* ret = new_buffer.get();
+    this->registration_lock_.lock();
+    new_buffer->thread_id = this->buffers_.size() + 1;
+    this->buffers_.emplace_back(std::move(new_buffer));
+    this->registration_lock_.unlock();
+    
+    cached_instance_id = this->instance_id_;
+    cached_buffer = ret;
+    return ret;
+    
+}
+
+void trace_t::record(const char* name, const char* category, uint64_t start_ns, uint64_t duration_ns, int64_t argument)
+{
+    
+    thread_buffer_t* buffer = this->local_buffer();
+    event_t event = {name, category, start_ns, duration_ns, argument};
+    
+    // Grow until full, then overwrite the oldest event.
+    if (buffer->events.size() < this->events_per_thread_)
+        buffer->events.push_back(event);
+    else
+        buffer->events[buffer->num_recorded % this->events_per_thread_] = event;
+    buffer->num_recorded++;
+    
+}
+
+void trace_t::record_https_get(uint64_t start_ns, const https_get_timing_t& timing, int64_t argument)
+{
+    
+    // curl reports seconds since the start of the request.
+    auto offset_ns = [start_ns](double seconds) -> uint64_t
+    {
+        return start_ns + uint64_t(seconds * 1.0e9);
+    };
+    
+    // https_get already clamps skipped phases to the previous one, so the
+    // offsets are monotonic.
+    uint64_t name_lookup_ns = offset_ns(timing.name_lookup);
+    uint64_t connect_ns = offset_ns(timing.connect);
+    uint64_t tls_handshake_ns = offset_ns(timing.tls_handshake);
+    uint64_t start_transfer_ns = offset_ns(timing.start_transfer);
+    uint64_t total_ns = offset_ns(timing.total);
+    
+    // Children are recorded after their parent so that viewers which don't
+    // sort by duration still nest them correctly.
+    this->record("https_get", "fetch", start_ns, total_ns - start_ns, argument);
+    if (name_lookup_ns > start_ns)
+        this->record("dns", "fetch,network", start_ns, name_lookup_ns - start_ns, argument);
+    if (connect_ns > name_lookup_ns)
+        this->record("tcp_connect", "fetch,network", name_lookup_ns, connect_ns - name_lookup_ns, argument);
+    if (tls_handshake_ns > connect_ns)
+        this->record("tls_handshake", "fetch,network", connect_ns, tls_handshake_ns - connect_ns, argument);
+    if (start_transfer_ns > tls_handshake_ns)
+        this->record("wait_first_byte", "fetch,network", tls_handshake_ns, start_transfer_ns - tls_handshake_ns, argument);
+    if (total_ns > start_transfer_ns)
+        this->record("transfer", "fetch,network", start_transfer_ns, total_ns - start_transfer_ns, argument);
+        
+}
+
+void trace_t::write_to_json_file(std::ostream& file, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    file << this->write_to_json_buffer(indent_start, spaces_per_tab);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when encoding trace_t object.\n");
+}
+
+void trace_t::write_to_json_buffer(std::string& buffer, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    
+    std::string indent_2(indent_start + 2 * spaces_per_tab, ' ');
+    std::string_view indent_1(indent_2.data(), indent_start + spaces_per_tab);
+    std::string_view indent_0(indent_2.data(), indent_start);
+    
+    uint64_t num_dropped = 0;
+    
+    // It is recommended not to start a new line before the opening brace, to
+    // enable chaining.
+    buffer += "{\n";
+    
+    // Encode traceEvents.  Each event is kept on a single line since traces
+    // can be very long.
+    buffer += indent_1;
+    buffer += "\"traceEvents\": [";
+    bool first = true;
+    for (const std::unique_ptr<thread_buffer_t>& cur_buffer : this->buffers_)
+    {
+        
+        std::string thread_id = std::to_string(cur_buffer->thread_id);
+        
+        // Name the thread so that viewers don't just show a bare number.
+        buffer += first ? "\n" : ",\n";
+        first = false;
+        buffer += indent_2;
+        buffer += "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": ";
+        buffer += thread_id;
+        buffer += ", \"args\": {\"name\": \"thread ";
+        buffer += thread_id;
+        buffer += "\"}}";
+        
+        // Once the ring has wrapped, the oldest surviving event is the one
+        // that would be overwritten next.
+        unsigned num_events = cur_buffer->events.size();
+        unsigned oldest_ix = 0;
+        if (cur_buffer->num_recorded > num_events)
+        {
+            num_dropped += cur_buffer->num_recorded - num_events;
+            oldest_ix = cur_buffer->num_recorded % num_events;
+        }
+        
+        for (unsigned ix = 0; ix < num_events; ix++)
+        {
+            
+            const event_t& cur_event = cur_buffer->events[(oldest_ix + ix) % num_events];
+            
+            buffer += ",\n";
+            buffer += indent_2;
+            buffer += "{\"name\": \"";
+            buffer += cur_event.name;
+            buffer += "\", \"cat\": \"";
+            buffer += cur_event.category;
+            buffer += "\", \"ph\": \"X\", \"ts\": ";
+            buffer += ns_to_microseconds_string(cur_event.start_ns);
+            buffer += ", \"dur\": ";
+            buffer += ns_to_microseconds_string(cur_event.duration_ns);
+            buffer += ", \"pid\": 1, \"tid\": ";
+            buffer += thread_id;
+            if (cur_event.argument >= 0)
+            {
+                buffer += ", \"args\": {\"value\": ";
+                buffer += std::to_string(cur_event.argument);
+                buffer += '}';
+            }
+            buffer += '}';
+            
+        }
+        
+    }
+    buffer += '\n';
+    buffer += indent_1;
+    buffer += "],\n";
+    
+    // Encode displayTimeUnit
+    buffer += indent_1;
+    buffer += "\"displayTimeUnit\": \"ms\",\n";
+    
+    // Encode otherData
+    buffer += indent_1;
+    buffer += "\"otherData\": {\"dropped_events\": ";
+    buffer += std::to_string(num_dropped);
+    buffer += "}\n";
+    
+    // It is recommended to not put a newline on the last brace to allow
+    // comma chaining when this object is an element of an array.
+    buffer += indent_0;
+    buffer += '}';
+    
+}
+
@@ -0,0 +1,246 @@
+/// @file trace.h
+/// @brief Declaration of @ref trace_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_TRACE
+#define HEADER_GUARD_TRACE
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "error.h"
+#include "https_get.h"
+
+/// @brief Records a timeline of spans from every thread and dumps them in
+/// the Chrome Trace Event format, which can be loaded by Perfetto or
+/// chrome://tracing.
+///
+/// Each thread records into its own fixed-capacity ring buffer which is
+/// registered the first time that thread records an event, so recording
+/// takes no locks.  When a ring buffer is full the oldest events of that
+/// thread are overwritten.  A pointer to one of these objects is carried by
+/// @ref debug_mode_t and is null unless --trace-out was passed.
+class trace_t
+{
+        
+    public:
+        
+        /// @brief One complete ("X" phase) event.
+        struct event_t
+        {
+            /// @brief Name displayed on the span.  Must be a string literal
+            /// since only the pointer is stored.
+            const char* name;
+            /// @brief Comma separated categories.  Must be a string literal.
+            const char* category;
+            /// @brief Nanoseconds between construction of the @ref trace_t and
+            /// the start of the span.
+            uint64_t start_ns;
+            /// @brief Length of the span in nanoseconds.
+            uint64_t duration_ns;
+            /// @brief Optional value such as a page number or station ID
+            /// attached to the span, or -1 if there is none.
+            int64_t argument;
+        };
+        
+        /// @brief Records a span covering the lifetime of this object.  Does
+        /// nothing if the trace pointer is null.
+        class scoped_span_t
+        {
+                
+            public:
+                
+                inline scoped_span_t(trace_t* trace, const char* name, const char* category, int64_t argument = -1)
+                  : trace_(trace),
+                    name_(name),
+                    category_(category),
+                    argument_(argument)
+                {
+                    if (trace != nullptr)
+                        this->start_ns_ = trace->now_ns();
+                }
+                
+                inline ~scoped_span_t()
+                {
+                    if (this->trace_ != nullptr)
+                        this->trace_->record(this->name_, this->category_, this->start_ns_, this->trace_->now_ns() - this->start_ns_, this->argument_);
+                }
+                
+                scoped_span_t(const scoped_span_t&) = delete;
+                scoped_span_t& operator=(const scoped_span_t&) = delete;
+                
+            protected:
+                
+                /// @brief Destination of the span, or null when disabled.
+                trace_t* trace_;
+                
+                /// @brief See @ref event_t::name.
+                const char* name_;
+                
+                /// @brief See @ref event_t::category.
+                const char* category_;
+                
+                /// @brief See @ref event_t::argument.
+                int64_t argument_;
+                
+                /// @brief See @ref event_t::start_ns.
+                uint64_t start_ns_;
+                
+        };
+        
+        /// @brief Initialization constructor.  Timestamps are measured
+        /// relative to construction.
+        trace_t(unsigned events_per_thread = 65536);
+        
+        trace_t(const trace_t&) = delete;
+        trace_t& operator=(const trace_t&) = delete;
+        
+        // Add member read and write functions
+        
+        inline unsigned events_per_thread() const
+        {
+            return this->events_per_thread_;
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Nanoseconds since this object was constructed.
+        inline uint64_t now_ns() const
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start_).count();
+        }
+        
+        /// @brief Append one span to the calling thread's ring buffer.  Safe
+        /// to call from any thread without locking, except for the first call
+        /// from each thread.
+        void record(const char* name, const char* category, uint64_t start_ns, uint64_t duration_ns, int64_t argument = -1);
+        
+        /// @brief Break a finished HTTPS request into nested spans for DNS
+        /// lookup, TCP connect, TLS handshake, waiting for the first byte and
+        /// transferring the payload.
+        void record_https_get
+        (
+            /// [in] Value of @ref now_ns from just before the request started.
+            uint64_t start_ns,
+            /// [in] Timing information reported by @ref https_get.
+            const https_get_timing_t& timing,
+            /// [in] See @ref event_t::argument.
+            int64_t argument = -1
+        );
+        
+        /// @brief Serialize all recorded events in the Chrome Trace Event
+        /// format.  Must not be called while other threads are recording.
+        void write_to_json_file
+        (
+            /// [out] Stream to append serialized object content to.
+            std::ostream& file,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            ///
+            /// Indentation typically increases after each opening bracket '['
+            /// or brace '{' and decreases after each closing bracket ']' or
+            /// brace '}'.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Serialize all recorded events in the Chrome Trace Event
+        /// format.  Must not be called while other threads are recording.
+        ///
+        /// @exception error_message_t
+        void write_to_json_buffer
+        (
+            /// [out] This string is overwritten with serialzed JSON content.
+            std::string& buffer,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            ///
+            /// Indentation typically increases after each opening bracket '['
+            /// or brace '{' and decreases after each closing bracket ']' or
+            /// brace '}'.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Convinence method for pretty initialize-on-construction
+        /// syntax.
+        inline std::string write_to_json_buffer
+        (
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            ///
+            /// Indentation typically increases after each opening bracket '['
+            /// or brace '{' and decreases after each closing bracket ']' or
+            /// brace '}'.
+            unsigned spaces_per_tab = 4
+        ) const {
+            std::string buffer;
+            this->write_to_json_buffer(buffer, indent_start, spaces_per_tab);
+            return buffer;
+        }
+        
+    protected:
+        
+        /// @brief Events recorded by a single thread.  Only the owning thread
+        /// writes to this object.
+        struct thread_buffer_t
+        {
+            /// @brief Small integer used as the "tid" of every event.
+            unsigned thread_id;
+            /// @brief Grows up to @ref events_per_thread_ and is then reused as
+            /// a ring.
+            std::vector<event_t> events;
+            /// @brief Total number of events ever recorded by this thread.
+            uint64_t num_recorded;
+        };
+        
+        /// @brief Return the calling thread's buffer, registering a new one
+        /// if this is the first time the thread recorded an event.
+        thread_buffer_t* local_buffer();
+        
+        /// @brief Unique for each object ever constructed, so that a stale
+        /// thread-local buffer pointer is never reused by a new trace that
+        /// happens to be allocated at the same address.
+        uint64_t instance_id_;
+        
+        /// @brief Time zero for all timestamps.
+        std::chrono::steady_clock::time_point start_;
+        
+        /// @brief Capacity of each thread's ring buffer.
+        unsigned events_per_thread_;
+        
+        /// @brief Guards @ref buffers_ while a new thread registers.
+        std::mutex registration_lock_;
+        
+        /// @brief One buffer for each thread that has recorded an event.
+        std::vector< std::unique_ptr<thread_buffer_t> > buffers_;
+        
+};
+
+/// @brief Convenience alias to allow printing directly via cout or similar.
+inline std::ostream& operator<<(std::ostream& stream, const trace_t& source)
+{
+    source.write_to_json_file(stream);
+    return stream;
+}
+
+#endif // Header Guard
+
@@ -0,0 +1,465 @@
+/// @file universe_topology.cpp
+/// @brief Implementation of @ref universe_topology_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "error.h"
+#include "json.h"
+#include "task_scheduler.h"
+#include "universe_topology.h"
+
+unsigned universe_topology_t::system_ix(uint64_t system_id)
+{
+    std::pair<std::unordered_map<uint64_t, unsigned>::iterator, bool> found = this->system_ixs_.try_emplace(system_id, this->system_ids_.size());
+    if (found.second)
+    {
+        this->system_ids_.push_back(system_id);
+        this->region_ids_.push_back(0);
+        this->neighbours_.emplace_back();
+        this->unmap();
+    }
+    return found.first->second;
+}
+
+void universe_topology_t::unmap()
+{
+    if (this->mapping_ != nullptr)
+        munmap(this->mapping_, this->mapping_size_);
+    this->mapping_ = nullptr;
+    this->mapping_size_ = 0;
+    std::vector<uint8_t>().swap(this->owned_distances_);
+    this->distances_ = nullptr;
+}
+
+void universe_topology_t::add_system(uint64_t system_id, uint64_t region_id)
+{
+    unsigned ix = this->system_ix(system_id);
+    if (region_id != 0)
+        this->region_ids_[ix] = region_id;
+}
+
+void universe_topology_t::add_stargate(uint64_t system_id, uint64_t neighbour_id)
+{
+    
+    unsigned from_ix = this->system_ix(system_id);
+    unsigned to_ix = this->system_ix(neighbour_id);
+    
+    // Gates are listed from both ends, so skip duplicates
+    std::vector<unsigned>& from_neighbours = this->neighbours_[from_ix];
+    for (unsigned cur_ix : from_neighbours)
+    {
+        if (cur_ix == to_ix)
+            return;
+    }
+    from_neighbours.push_back(to_ix);
+    this->neighbours_[to_ix].push_back(from_ix);
+    
+    // Distances found so far may be shorter now
+    this->unmap();
+    
+}
+
+void universe_topology_t::compute_distances()
+{
+    
+    this->unmap();
+    unsigned num_systems = this->system_ids_.size();
+    
+    // Sort systems by ID so that the output doesn't depend on input order
+    std::vector<unsigned> order(num_systems);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort
+    (
+        order.begin(),
+        order.end(),
+        [this](unsigned lhs, unsigned rhs)
+        {
+            return this->system_ids_[lhs] < this->system_ids_[rhs];
+        }
+    );
+    std::vector<unsigned> new_ixs(num_systems);
+    for (unsigned ix = 0; ix < num_systems; ix++)
+        new_ixs[order[ix]] = ix;
+    
+    std::vector<uint64_t> system_ids(num_systems);
+    std::vector<uint64_t> region_ids(num_systems);
+    std::vector< std::vector<unsigned> > neighbours(num_systems);
+    for (unsigned ix = 0; ix < num_systems; ix++)
+    {
+        unsigned old_ix = order[ix];
+        system_ids[ix] = this->system_ids_[old_ix];
+        region_ids[ix] = this->region_ids_[old_ix];
+        std::vector<unsigned>& cur_neighbours = neighbours[ix];
+        cur_neighbours.reserve(this->neighbours_[old_ix].size());
+        for (unsigned cur_ix : this->neighbours_[old_ix])
+            cur_neighbours.push_back(new_ixs[cur_ix]);
+        std::sort(cur_neighbours.begin(), cur_neighbours.end());
+        this->system_ixs_[system_ids[ix]] = ix;
+    }
+    this->system_ids_.swap(system_ids);
+    this->region_ids_.swap(region_ids);
+    this->neighbours_.swap(neighbours);
+    
+    // Flatten the stargates so that the searches walk contiguous memory
+    std::vector<unsigned> first_neighbours(num_systems + 1, 0);
+    std::vector<unsigned> all_neighbours;
+    for (unsigned ix = 0; ix < num_systems; ix++)
+    {
+        all_neighbours.insert(all_neighbours.end(), this->neighbours_[ix].begin(), this->neighbours_[ix].end());
+        first_neighbours[ix + 1] = all_neighbours.size();
+    }
+    
+    this->owned_distances_.assign(std::size_t(num_systems) * num_systems, unreachable);
+    uint8_t* distances = this->owned_distances_.data();
+    
+    // Breadth-first search from each system, one ring of systems per jump.
+    // Each search only writes its own row.  Frontiers are reused between
+    // searches by whichever worker runs them.
+    task_scheduler_t& scheduler = task_scheduler_t::instance();
+    std::vector< std::vector<unsigned> > worker_frontiers(scheduler.num_workers(task_scheduler_t::pool_t::CPU));
+    std::vector< std::vector<unsigned> > worker_next_frontiers(worker_frontiers.size());
+    scheduler.parallel_for
+    (
+        num_systems,
+        16,
+        [&](unsigned source_ix)
+        {
+            
+            std::vector<unsigned>& frontier = worker_frontiers[task_scheduler_t::current_worker()];
+            std::vector<unsigned>& next_frontier = worker_next_frontiers[task_scheduler_t::current_worker()];
+            
+            uint8_t* row = distances + std::size_t(source_ix) * num_systems;
+            row[source_ix] = 0;
+            frontier.assign(1, source_ix);
+            
+            for (unsigned jumps = 1; !frontier.empty(); jumps++)
+            {
+                uint8_t cur_distance = jumps < max_distance ? jumps : max_distance;
+                next_frontier.clear();
+                for (unsigned cur_ix : frontier)
+                {
+                    for (unsigned edge_ix = first_neighbours[cur_ix], end_ix = first_neighbours[cur_ix + 1]; edge_ix < end_ix; edge_ix++)
+                    {
+                        unsigned neighbour_ix = all_neighbours[edge_ix];
+                        if (row[neighbour_ix] != unreachable)
+                            continue;
+                        row[neighbour_ix] = cur_distance;
+                        next_frontier.push_back(neighbour_ix);
+                    }
+                }
+                frontier.swap(next_frontier);
+            }
+            
+        }
+    );
+    
+    this->distances_ = distances;
+    
+}
+
+void universe_topology_t::read_from_json_file(std::istream& file)
+{
+    
+    // Get the number of characters in the input file.
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_SIZE_FAILED, "Error.  Failed to determine file size when decoding universe_topology_t object.\n");
+    file.seekg(0, std::ios_base::end);
+    unsigned file_size = file.tellg();
+    file.seekg(0, std::ios_base::beg);
+    
+    // Read the entire file into RAM at once
+    std::string buffer(file_size, '\0');
+    file.read(buffer.data(), file_size);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_READ_FAILED, "Error.  Failed to read file when decoding universe_topology_t object.\n");
+    this->read_from_json_buffer(std::string_view(buffer));
+    
+}
+
+void universe_topology_t::read_from_json_buffer(std::string_view buffer)
+{
+    
+    Json::CharReaderBuilder builder;
+    Json::CharReader* reader = builder.newCharReader();
+    
+    Json::Value json_root;
+    std::string error_message;
+    bool success = reader->parse(buffer.begin(), buffer.end(), &json_root, &error_message);
+    delete reader;
+    if (!success)
+        Json::throwRuntimeError(error_message);
+    
+    // Now that the JSON syntax is parsed, extract the stat_list specific
+    // data.
+    this->read_from_json_json(json_root);
+    
+}
+
+void universe_topology_t::read_from_json_json(const Json::Value& json_root)
+{
+    
+    // Parse root
+    if (!json_root.isArray())
+        throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  Root of stargates is not of type \"array\".\n");
+    
+    // Clear previous content
+    this->unmap();
+    this->system_ids_.clear();
+    this->region_ids_.clear();
+    this->system_ixs_.clear();
+    this->neighbours_.clear();
+    
+    for (const Json::Value& json_cur_system : json_root)
+    {
+        
+        if (!json_cur_system.isObject())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <stargates>/<system> is not of type \"object\".\n");
+        
+        const Json::Value& json_system_id = json_cur_system["system_id"];
+        if (!json_system_id.isUInt64())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <stargates>/<system>/system_id was not found or not of type \"unsigned integer\".\n");
+        uint64_t system_id = json_system_id.asUInt64();
+        
+        // This is optional and left unknown if missing.
+        uint64_t region_id = 0;
+        const Json::Value& json_region_id = json_cur_system["region_id"];
+        if (!json_region_id.isNull())
+        {
+            if (!json_region_id.isUInt64())
+                throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <stargates>/<system>/region_id was not of type \"unsigned integer\".\n");
+            region_id = json_region_id.asUInt64();
+        }
+        this->add_system(system_id, region_id);
+        
+        const Json::Value& json_neighbours = json_cur_system["neighbours"];
+        if (!json_neighbours.isArray())
+            throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <stargates>/<system>/neighbours was not found or not of type \"array\".\n");
+        for (const Json::Value& json_cur_neighbour : json_neighbours)
+        {
+            if (!json_cur_neighbour.isUInt64())
+                throw error_message_t(error_code_t::JSON_SCHEMA_VIOLATION, "Error.  <stargates>/<system>/neighbours/<system_id> is not of type \"unsigned integer\".\n");
+            this->add_stargate(system_id, json_cur_neighbour.asUInt64());
+        }
+        
+    }
+    
+    this->compute_distances();
+    
+}
+
+void universe_topology_t::write_to_json_file(std::ostream& file, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    std::string buffer;
+    this->write_to_json_buffer(buffer, indent_start, spaces_per_tab);
+    file << buffer;
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when encoding universe_topology_t object.\n");
+}
+
+void universe_topology_t::write_to_json_buffer(std::string& buffer, unsigned indent_start, unsigned spaces_per_tab) const
+{
+    
+    std::string indent_1(indent_start + 1 * spaces_per_tab, ' ');
+    std::string_view indent_0(indent_1.data(), indent_start);
+    
+    // Prettify empty arrays.
+    if (this->system_ids_.empty())
+    {
+        buffer += "[]";
+        return;
+    }
+    
+    // It is recommended not to start a new line before the opening brace, to
+    // enable chaining.
+    buffer += "[\n";
+    
+    // One system per line since there are thousands of them
+    for (unsigned ix = 0, last_ix = this->system_ids_.size() - 1; ix <= last_ix; ix++)
+    {
+        
+        buffer += indent_1;
+        buffer += "{\"system_id\": ";
+        buffer += std::to_string(this->system_ids_[ix]);
+        if (this->region_ids_[ix] != 0)
+        {
+            buffer += ", \"region_id\": ";
+            buffer += std::to_string(this->region_ids_[ix]);
+        }
+        buffer += ", \"neighbours\": [";
+        const std::vector<unsigned>& cur_neighbours = this->neighbours_[ix];
+        for (unsigned neighbour_ix = 0, num_neighbours = cur_neighbours.size(); neighbour_ix < num_neighbours; neighbour_ix++)
+        {
+            if (neighbour_ix != 0)
+                buffer += ", ";
+            buffer += std::to_string(this->system_ids_[cur_neighbours[neighbour_ix]]);
+        }
+        buffer += "]}";
+        
+        if (ix == last_ix)
+            buffer += '\n';
+        else
+            buffer += ",\n";
+            
+    }
+    
+    // It is recommended to not put a newline on the last brace to allow
+    // comma chaining when this object is an element of an array.
+    buffer += indent_0;
+    buffer += ']';
+    
+}
+
+void universe_topology_t::map_binary_file(const std::string& path)
+{
+    
+    // Clear previous content
+    this->unmap();
+    this->system_ids_.clear();
+    this->region_ids_.clear();
+    this->system_ixs_.clear();
+    this->neighbours_.clear();
+    
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        throw error_message_t(error_code_t::FILE_READ_FAILED, "Error.  Failed to open \"" + path + "\" for reading.\n");
+    struct stat file_status;
+    if (fstat(file, &file_status) != 0)
+    {
+        close(file);
+        throw error_message_t(error_code_t::FILE_SIZE_FAILED, "Error.  Failed to determine the size of \"" + path + "\".\n");
+    }
+    std::size_t file_size = file_status.st_size;
+    
+    std::string corrupt_message("Error.  Universe topology file \"");
+    corrupt_message += path;
+    corrupt_message += "\" is truncated or has the wrong magic number.\n";
+    if (file_size < 16)
+    {
+        close(file);
+        throw error_message_t(error_code_t::TOPOLOGY_FILE_CORRUPT, corrupt_message);
+    }
+    
+    // The mapping stays valid after the file is closed
+    void* mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED)
+        throw error_message_t(error_code_t::FILE_READ_FAILED, "Error.  Failed to map \"" + path + "\" into memory.\n");
+    this->mapping_ = mapping;
+    this->mapping_size_ = file_size;
+    const char* data = static_cast<const char*>(mapping);
+    
+    uint32_t num_systems;
+    uint32_t num_stargates;
+    std::memcpy(&num_systems, data + 4, 4);
+    std::memcpy(&num_stargates, data + 8, 4);
+    std::size_t ids_offset = 16;
+    std::size_t regions_offset = ids_offset + 8 * std::size_t(num_systems);
+    std::size_t counts_offset = regions_offset + 8 * std::size_t(num_systems);
+    std::size_t neighbours_offset = counts_offset + 4 * std::size_t(num_systems);
+    std::size_t distances_offset = neighbours_offset + 4 * std::size_t(num_stargates);
+    if (std::memcmp(data, "EIU1", 4) != 0 || file_size != distances_offset + std::size_t(num_systems) * num_systems)
+    {
+        this->unmap();
+        throw error_message_t(error_code_t::TOPOLOGY_FILE_CORRUPT, corrupt_message);
+    }
+    
+    // Everything but the distances is small enough to copy.  Check that
+    // every stargate leads somewhere before keeping any of it.
+    std::vector<uint32_t> num_neighbours(num_systems);
+    std::vector<uint32_t> all_neighbours(num_stargates);
+    std::memcpy(num_neighbours.data(), data + counts_offset, 4 * std::size_t(num_systems));
+    std::memcpy(all_neighbours.data(), data + neighbours_offset, 4 * std::size_t(num_stargates));
+    std::size_t total_neighbours = 0;
+    for (uint32_t cur_num_neighbours : num_neighbours)
+        total_neighbours += cur_num_neighbours;
+    bool valid = total_neighbours == num_stargates;
+    for (uint32_t cur_ix : all_neighbours)
+        valid = valid && cur_ix < num_systems;
+    if (!valid)
+    {
+        this->unmap();
+        throw error_message_t(error_code_t::TOPOLOGY_FILE_CORRUPT, corrupt_message);
+    }
+    
+    this->system_ids_.resize(num_systems);
+    this->region_ids_.resize(num_systems);
+    std::memcpy(this->system_ids_.data(), data + ids_offset, 8 * std::size_t(num_systems));
+    std::memcpy(this->region_ids_.data(), data + regions_offset, 8 * std::size_t(num_systems));
+    this->system_ixs_.reserve(num_systems);
+    this->neighbours_.resize(num_systems);
+    std::vector<uint32_t>::const_iterator cur_neighbour = all_neighbours.begin();
+    for (unsigned ix = 0; ix < num_systems; ix++)
+    {
+        this->system_ixs_.emplace(this->system_ids_[ix], ix);
+        this->neighbours_[ix].assign(cur_neighbour, cur_neighbour + num_neighbours[ix]);
+        cur_neighbour += num_neighbours[ix];
+    }
+    
+    this->distances_ = reinterpret_cast<const uint8_t*>(data + distances_offset);
+    
+}
+
+void universe_topology_t::write_to_binary_file(std::ostream& file) const
+{
+    
+    if (this->distances_ == nullptr)
+        throw error_message_t(error_code_t::JUMP_DISTANCES_MISSING, "Error.  Jump distances were not computed since the last stargate was added.\n");
+    
+    uint32_t num_systems = this->system_ids_.size();
+    std::vector<uint32_t> num_neighbours;
+    std::vector<uint32_t> all_neighbours;
+    num_neighbours.reserve(num_systems);
+    for (const std::vector<unsigned>& cur_neighbours : this->neighbours_)
+    {
+        num_neighbours.push_back(cur_neighbours.size());
+        all_neighbours.insert(all_neighbours.end(), cur_neighbours.begin(), cur_neighbours.end());
+    }
+    uint32_t num_stargates = all_neighbours.size();
+    
+    char header[16] = {'E', 'I', 'U', '1'};
+    std::memcpy(header + 4, &num_systems, 4);
+    std::memcpy(header + 8, &num_stargates, 4);
+    file.write(header, 16);
+    file.write(reinterpret_cast<const char*>(this->system_ids_.data()), 8 * std::size_t(num_systems));
+    file.write(reinterpret_cast<const char*>(this->region_ids_.data()), 8 * std::size_t(num_systems));
+    file.write(reinterpret_cast<const char*>(num_neighbours.data()), 4 * std::size_t(num_systems));
+    file.write(reinterpret_cast<const char*>(all_neighbours.data()), 4 * std::size_t(num_stargates));
+    file.write(reinterpret_cast<const char*>(this->distances_), std::size_t(num_systems) * num_systems);
+    if (!file.good())
+        throw error_message_t(error_code_t::FILE_WRITE_FAILED, "Error.  Failed to write file when encoding universe_topology_t object.\n");
+        
+}
+
+std::istream& operator>>(std::istream& stream, universe_topology_t& destination)
+{
+    try
+    {
+        destination.read_from_json_file(stream);
+    } catch (error_message_t error) {
+        stream.setstate(std::ios::failbit);
+        throw error;
+    } catch (Json::Exception error) {
+        stream.setstate(std::ios::failbit);
+        throw error;
+    }
+    return stream;
+}
+
@@ -0,0 +1,254 @@
+/// @file universe_topology.h
+/// @brief Declaration of @ref universe_topology_t class
+/// 
+/// * Contact conor.gardner@arm.com if you have questions about this code.
+/// * Date Created = Monday October 19 2026
+/// * Documentation is generated by doxygen, see html/index.html
+
+#ifndef HEADER_GUARD_UNIVERSE_TOPOLOGY
+#define HEADER_GUARD_UNIVERSE_TOPOLOGY
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "error.h"
+#include "json.h"
+
+/// @brief Solar systems, the stargates between them, and the number of jumps
+/// between every pair of systems.
+///
+/// Stargates come from a JSON file, normally converted from CCP's static data
+/// export by blueprint_converter.  @ref compute_distances runs a
+/// breadth-first search from every system in parallel and fills an n by n
+/// matrix of one byte distances, after which @ref distance is a table
+/// lookup.  The result is cached in a binary file which
+/// @ref map_binary_file maps into memory rather than reading, so only the
+/// rows which are used are ever paged in.
+///
+/// The binary file is a 16 byte header followed by one column per field:
+///
+/// | Bytes         | Field                                      |
+/// | ------------- | ------------------------------------------ |
+/// | 4             | Magic "EIU1"                               |
+/// | 4             | Number of systems n                        |
+/// | 4             | Number of stargate ends m                  |
+/// | 4             | Reserved, zero                             |
+/// | 8n            | System ID, ascending                       |
+/// | 8n            | Region ID, or 0 if unknown                 |
+/// | 4n            | Number of stargates of each system         |
+/// | 4m            | Index of the system each stargate leads to |
+/// | n * n         | Jumps from each system to each system      |
+///
+/// All integers are in host byte order.
+class universe_topology_t
+{
+        
+    public:
+        
+        /// @brief Distances longer than this are stored as this.
+        static constexpr uint8_t max_distance = 254;
+        
+        /// @brief Returned by @ref distance for systems that no sequence of
+        /// stargates connects.
+        static constexpr uint8_t unreachable = 255;
+        
+        /// @brief Default constructor
+        inline universe_topology_t()
+          : distances_(nullptr),
+            mapping_(nullptr),
+            mapping_size_(0)
+        {
+            // All work done in initializer list
+        }
+        
+        /// @brief The distance matrix may be mapped from a file, which can't
+        /// be shared.
+        universe_topology_t(const universe_topology_t& source) = delete;
+        universe_topology_t& operator=(const universe_topology_t& source) = delete;
+        
+        /// @brief Unmaps the file of @ref map_binary_file, if any.
+        inline ~universe_topology_t()
+        {
+            this->unmap();
+        }
+        
+        // Add member read and write functions
+        
+        inline unsigned num_systems() const
+        {
+            return this->system_ids_.size();
+        }
+        
+        /// @brief Every system, ascending after @ref compute_distances.
+        inline const std::vector<uint64_t>& system_ids() const
+        {
+            return this->system_ids_;
+        }
+        
+        /// @brief True if @ref distance can be called.
+        inline bool has_distances() const
+        {
+            return this->distances_ != nullptr;
+        }
+        
+        /// @brief Region of a system, or 0 if unknown.
+        inline uint64_t region_id(uint64_t system_id) const
+        {
+            std::unordered_map<uint64_t, unsigned>::const_iterator found = this->system_ixs_.find(system_id);
+            if (found == this->system_ixs_.end())
+                return 0;
+            return this->region_ids_[found->second];
+        }
+        
+        /// @brief Jumps between two systems, @ref max_distance if at least
+        /// that many, or @ref unreachable.  Systems without stargates are
+        /// only reachable from themselves.
+        ///
+        /// @exception error_message_t
+        inline uint8_t distance(uint64_t source_system_id, uint64_t system_id) const
+        {
+            if (source_system_id == system_id)
+                return 0;
+            if (this->distances_ == nullptr)
+                throw error_message_t(error_code_t::JUMP_DISTANCES_MISSING, "Error.  Jump distances were not computed since the last stargate was added.\n");
+            std::unordered_map<uint64_t, unsigned>::const_iterator source = this->system_ixs_.find(source_system_id);
+            std::unordered_map<uint64_t, unsigned>::const_iterator destination = this->system_ixs_.find(system_id);
+            if (source == this->system_ixs_.end() || destination == this->system_ixs_.end())
+                return unreachable;
+            return this->distances_[std::size_t(source->second) * this->system_ids_.size() + destination->second];
+        }
+        
+        // Add special-purpose functions here
+        
+        /// @brief Add a system if it is new.  A non-zero region_id replaces
+        /// the region of a system which was already added.
+        void add_system(uint64_t system_id, uint64_t region_id = 0);
+        
+        /// @brief Connect two systems by a stargate in both directions,
+        /// adding them if they are new.  Discards computed distances.
+        void add_stargate(uint64_t system_id, uint64_t neighbour_id);
+        
+        /// @brief Sort the systems by ID and find the number of jumps between
+        /// every pair of them.  Each system is searched from on its own core.
+        void compute_distances();
+        
+        // Add encoders/decoders here
+        
+        /// @brief Open a file of stargates conforming to data/json/schema.json,
+        /// use it to initialize this object, clearing previous content, and
+        /// @ref compute_distances.
+        ///
+        /// @exception error_message_t
+        /// @exception Json::Exception
+        void read_from_json_file(std::istream& file);
+        
+        /// @brief Decode serialized stargates conforming to
+        /// data/json/schema.json, use them to initialize this object, clearing
+        /// previous content, and @ref compute_distances.
+        ///
+        /// @exception error_message_t
+        /// @exception Json::Exception
+        void read_from_json_buffer(std::string_view buffer);
+        
+        /// @brief Extract required data fields from a pre-parsed JSON tree,
+        /// use them to initialize this object, clearing previous content, and
+        /// @ref compute_distances.
+        ///
+        /// @exception error_message_t
+        void read_from_json_json(const Json::Value& json_root);
+        
+        /// @brief Serialize the stargates of this object into a file that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_file
+        (
+            /// [out] Stream to append serialized object content to.
+            std::ostream& file,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Serialize the stargates of this object into a string that
+        /// conforms to the schema data/json/schema.json.
+        void write_to_json_buffer
+        (
+            /// [out] This string is overwritten with serialzed JSON content.
+            std::string& buffer,
+            /// [in] The number of space ' ' characters to prepend to each line
+            /// in the serialized output.
+            unsigned indent_start = 0,
+            /// [in] The number of additional spaces ' ' on top of indent_start
+            /// to prepend to each line in the serialized output for each
+            /// additional level of nesting.
+            unsigned spaces_per_tab = 4
+        ) const;
+        
+        /// @brief Map a file written by @ref write_to_binary_file into memory,
+        /// clearing previous content.  The distance matrix stays in the file
+        /// and is paged in as it is used.
+        ///
+        /// @exception error_message_t
+        void map_binary_file(const std::string& path);
+        
+        /// @brief Write everything, including distances, in the format
+        /// described above.  The stream should be opened in binary mode.
+        ///
+        /// @exception error_message_t
+        void write_to_binary_file(std::ostream& file) const;
+        
+    protected:
+        
+        /// @brief Dense index of a system, added if it is new.
+        unsigned system_ix(uint64_t system_id);
+        
+        /// @brief Release the distance matrix, whether owned or mapped.
+        void unmap();
+        
+        /// @brief See @ref system_ids.
+        std::vector<uint64_t> system_ids_;
+        
+        /// @brief Region of each system, by index.
+        std::vector<uint64_t> region_ids_;
+        
+        /// @brief Inverse of @ref system_ids_.
+        std::unordered_map<uint64_t, unsigned> system_ixs_;
+        
+        /// @brief Indices of the systems each system's stargates lead to.
+        std::vector< std::vector<unsigned> > neighbours_;
+        
+        /// @brief Row-major distances between systems, by index.  Points
+        /// into either @ref owned_distances_ or @ref mapping_.
+        const uint8_t* distances_;
+        
+        /// @brief Storage of @ref distances_ after @ref compute_distances.
+        std::vector<uint8_t> owned_distances_;
+        
+        /// @brief The file of @ref map_binary_file.
+        void* mapping_;
+        
+        /// @brief Bytes of @ref mapping_.
+        std::size_t mapping_size_;
+        
+};
+
+/// @brief Extraction operator for decoding.
+std::istream& operator>>(std::istream& stream, universe_topology_t& destination);
+
+/// @brief Convenience alias to allow printing directly via cout or similar.
+inline std::ostream& operator<<(std::ostream& stream, const universe_topology_t& source)
+{
+    source.write_to_json_file(stream);
+    return stream;
+}
+
+#endif // Header Guard
+